@@ -28,6 +28,7 @@
 #include "Poco/Data/RowIterator.h"
 #include "Poco/Data/LOB.h"
 #include "Poco/String.h"
+#include "Poco/Arena.h"
 #include "Poco/Dynamic/Var.h"
 #include "Poco/Exception.h"
 #include <ostream>
@@ -82,6 +83,18 @@ public:
 		RowFormatter::Ptr pRowFormatter = 0);
 		/// Creates the RecordSet.
 
+	RecordSet(const Statement& rStatement,
+		Poco::Arena& arena,
+		RowFormatter::Ptr pRowFormatter = 0);
+		/// Creates the RecordSet. The rows of the RecordSet are
+		/// allocated from the given Arena, for example one that
+		/// belongs to the request being served. The RecordSet
+		/// must be destroyed before the Arena is reset.
+		///
+		/// Otherwise, every RecordSet allocates its rows from
+		/// an Arena of its own, which is released in one step
+		/// when the RecordSet is destroyed.
+
 	RecordSet(Session& rSession, 
 		const std::string& query,
 		RowFormatter::Ptr pRowFormatter = 0);
@@ -98,6 +111,8 @@ public:
 		_currentRow(0),
 		_pBegin(new RowIterator(this, 0 == rowsExtracted())),
 		_pEnd(new RowIterator(this, true)),
+		_pArena(&_arena),
+		_rowMap(std::less<std::size_t>(), *_pArena),
 		_pFilter(0),
 		_totalRowCount(UNKNOWN_TOTAL_ROW_COUNT)
 		/// Creates the RecordSet.
@@ -389,6 +404,9 @@ public:
 		/// Returns true if recordset is filtered.
 
 private:
+	typedef std::map<std::size_t, Row*, std::less<std::size_t>,
+		Poco::ArenaAllocator<std::pair<const std::size_t, Row*> > > ArenaRowMap;
+
 	RecordSet();
 
 	template<class C, class E>
@@ -471,7 +489,9 @@ private:
 	std::size_t  _currentRow;
 	RowIterator* _pBegin;
 	RowIterator* _pEnd;
-	RowMap       _rowMap;
+	Poco::Arena  _arena;
+	Poco::Arena* _pArena;
+	ArenaRowMap  _rowMap;
 	RowFilter*   _pFilter;
 	std::size_t  _totalRowCount;
 
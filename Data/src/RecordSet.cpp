@@ -41,6 +41,24 @@ RecordSet::RecordSet(const Statement& rStatement,
 	_currentRow(0),
 	_pBegin(new RowIterator(this, 0 == rowsExtracted())),
 	_pEnd(new RowIterator(this, true)),
+	_pArena(&_arena),
+	_rowMap(std::less<std::size_t>(), *_pArena),
+	_pFilter(0),
+	_totalRowCount(UNKNOWN_TOTAL_ROW_COUNT)
+{
+	if (pRowFormatter) setRowFormatter(pRowFormatter);
+}
+
+
+RecordSet::RecordSet(const Statement& rStatement,
+	Poco::Arena& arena,
+	RowFormatter::Ptr pRowFormatter): 
+	Statement(rStatement),
+	_currentRow(0),
+	_pBegin(new RowIterator(this, 0 == rowsExtracted())),
+	_pEnd(new RowIterator(this, true)),
+	_pArena(&arena),
+	_rowMap(std::less<std::size_t>(), *_pArena),
 	_pFilter(0),
 	_totalRowCount(UNKNOWN_TOTAL_ROW_COUNT)
 {
@@ -55,6 +73,8 @@ RecordSet::RecordSet(Session& rSession,
 	_currentRow(0),
 	_pBegin(new RowIterator(this, 0 == rowsExtracted())),
 	_pEnd(new RowIterator(this, true)),
+	_pArena(&_arena),
+	_rowMap(std::less<std::size_t>(), *_pArena),
 	_pFilter(0),
 	_totalRowCount(UNKNOWN_TOTAL_ROW_COUNT)
 {
@@ -67,6 +87,8 @@ RecordSet::RecordSet(const RecordSet& other):
 	_currentRow(other._currentRow),
 	_pBegin(new RowIterator(this, 0 == rowsExtracted())),
 	_pEnd(new RowIterator(this, true)),
+	_pArena(&_arena),
+	_rowMap(std::less<std::size_t>(), *_pArena),
 	_pFilter(other._pFilter),
 	_totalRowCount(other._totalRowCount)
 {
@@ -81,9 +103,11 @@ RecordSet::~RecordSet()
 		delete _pEnd;
 		if(_pFilter) _pFilter->release();
 
-		RowMap::iterator it = _rowMap.begin();
-		RowMap::iterator end = _rowMap.end();
-		for (; it != end; ++it) delete it->second;
+		ArenaRowMap::iterator it = _rowMap.begin();
+		ArenaRowMap::iterator end = _rowMap.end();
+		// Rows live in the arena, which frees
+		// their memory, so only destroy them.
+		for (; it != end; ++it) it->second->~Row();
 	}
 	catch (...)
 	{
@@ -163,30 +187,39 @@ Row& RecordSet::row(std::size_t pos)
 	if (0 == rowCnt || pos > rowCnt - 1)
 		throw RangeException("Invalid recordset row requested.");
 
-	RowMap::const_iterator it = _rowMap.find(pos);
+	ArenaRowMap::const_iterator it = _rowMap.find(pos);
 	Row* pRow = 0;
 	std::size_t columns = columnCount();
 	if (it == _rowMap.end())
 	{
-		if (_rowMap.size())
+		try
 		{
-			//reuse first row column names and sorting fields to save some memory 
-			pRow = new Row(_rowMap.begin()->second->names(),
-				_rowMap.begin()->second->getSortMap(),
-				getRowFormatter());
-
-			for (std::size_t col = 0; col < columns; ++col)
-				pRow->set(col, value(col, pos));
+			if (_rowMap.size())
+			{
+				//reuse first row column names and sorting fields to save some memory 
+				pRow = new (_pArena->allocate(sizeof(Row))) Row(_rowMap.begin()->second->names(),
+					_rowMap.begin()->second->getSortMap(),
+					getRowFormatter());
+
+				for (std::size_t col = 0; col < columns; ++col)
+					pRow->set(col, value(col, pos));
+			}
+			else 
+			{
+				pRow = new (_pArena->allocate(sizeof(Row))) Row;
+				pRow->setFormatter(getRowFormatter());
+				for (std::size_t col = 0; col < columns; ++col)
+					pRow->append(metaColumn(static_cast<UInt32>(col)).name(), value(col, pos));
+			}
+
+			_rowMap.insert(ArenaRowMap::value_type(pos, pRow));
 		}
-		else 
+		catch (...)
 		{
-			pRow = new Row;
-			pRow->setFormatter(getRowFormatter());
-			for (std::size_t col = 0; col < columns; ++col)
-				pRow->append(metaColumn(static_cast<UInt32>(col)).name(), value(col, pos));
+			// The destructor only destroys rows in _rowMap.
+			if (pRow) pRow->~Row();
+			throw;
 		}
-
-		_rowMap.insert(RowMap::value_type(pos, pRow));
 	}
 	else 
 	{
@@ -307,8 +340,8 @@ void RecordSet::setRowFormatter(RowFormatter::Ptr pRowFormatter)
 			pRowFormatter->setTotalRowCount(static_cast<int>(getTotalRowCount()));
 
 		Statement::setRowFormatter(pRowFormatter);
-		RowMap::iterator it = _rowMap.begin();
-		RowMap::iterator end = _rowMap.end();
+		ArenaRowMap::iterator it = _rowMap.begin();
+		ArenaRowMap::iterator end = _rowMap.end();
 		for (; it != end; ++it) it->second->setFormatter(getRowFormatter());
 	}
 	else
@@ -22,6 +22,7 @@
 #include "Poco/Any.h"
 #include "Poco/Tuple.h"
 #include "Poco/ActiveMethod.h"
+#include "Poco/AllocationTracker.h"
 #include <algorithm>
 
 
@@ -91,6 +92,8 @@ Statement& Statement::reset(Session& session)
 
 std::size_t Statement::execute(bool reset)
 {
+	Poco::AllocationScope scope(Poco::AllocationTracker::COMPONENT_DATA);
+
 	Mutex::ScopedLock lock(_mutex);
 	bool isDone = done();
 	if (initialized() || paused() || isDone)
@@ -26,6 +26,7 @@
 #include "Poco/ActiveResult.h"
 #include "Poco/ActiveMethod.h"
 #include "Poco/Mutex.h"
+#include "Poco/SnapshotHolder.h"
 
 
 namespace Poco {
@@ -177,7 +178,9 @@ public:
 		/// Exact behavior is determined by the TStrategy.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.add(aDelegate);
+		typename StrategyHolder::SnapshotPtr pStrategy(_strategy.clone());
+		pStrategy->value().add(aDelegate);
+		_strategy.publish(pStrategy.duplicate());
 	}
 	
 	void operator -= (const TDelegate& aDelegate)
@@ -186,7 +189,9 @@ public:
 		/// If the delegate is not found, this function does nothing.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.remove(aDelegate);
+		typename StrategyHolder::SnapshotPtr pStrategy(_strategy.clone());
+		pStrategy->value().remove(aDelegate);
+		_strategy.publish(pStrategy.duplicate());
 	}
 	
 	DelegateHandle add(const TDelegate& aDelegate)
@@ -198,7 +203,10 @@ public:
 		/// remove() to remove the delegate.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		return _strategy.add(aDelegate);
+		typename StrategyHolder::SnapshotPtr pStrategy(_strategy.clone());
+		DelegateHandle handle = pStrategy->value().add(aDelegate);
+		_strategy.publish(pStrategy.duplicate());
+		return handle;
 	}
 	
 	void remove(DelegateHandle delegateHandle)
@@ -208,7 +216,9 @@ public:
 		/// If the delegate is not found, this function does nothing.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.remove(delegateHandle);
+		typename StrategyHolder::SnapshotPtr pStrategy(_strategy.clone());
+		pStrategy->value().remove(delegateHandle);
+		_strategy.publish(pStrategy.duplicate());
 	}
 		
 	void operator () (const void* pSender, TArgs& args)
@@ -233,21 +243,19 @@ public:
 		/// invoked prior to removal). If one of the delegates throws an exception, 
 		/// the notify method is immediately aborted and the exception is propagated
 		/// to the caller.
+		///
+		/// Delegates are invoked from an immutable snapshot of the delegate
+		/// list, which adding and removing delegates replaces with a modified
+		/// copy. Therefore, notify() neither takes a lock nor allocates memory.
 	{
-		Poco::ScopedLockWithUnlock<TMutex> lock(_mutex);
-		
 		if (!_enabled) return;
 		
-		// thread-safeness: 
-		// copy should be faster and safer than blocking until
-		// execution ends
-		TStrategy strategy(_strategy);
-		lock.unlock();
-		strategy.notify(pSender, args);
+		typename StrategyHolder::ScopedRead strategy(_strategy);
+		strategy.value().notify(pSender, args);
 	}
 
 	bool hasDelegates() const {
-		return !(_strategy.empty());
+		return !empty();
 	}
 
 	ActiveResult<TArgs> notifyAsync(const void* pSender, const TArgs& args)
@@ -272,7 +280,7 @@ public:
 			// make a copy of the strategy here to guarantee that
 			// between notifyAsync and the execution of the method no changes can occur
 				
-			params.ptrStrat = SharedPtr<TStrategy>(new TStrategy(_strategy));
+			params.ptrStrat = SharedPtr<TStrategy>(new TStrategy(_strategy.current()));
 			params.enabled  = _enabled;
 		}
 		ActiveResult<TArgs> result = _executeAsync(params);
@@ -304,14 +312,16 @@ public:
 		/// Removes all delegates.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.clear();
+		typename StrategyHolder::SnapshotPtr pStrategy(_strategy.clone());
+		pStrategy->value().clear();
+		_strategy.publish(pStrategy.duplicate());
 	}
 	
 	bool empty() const
 		/// Checks if any delegates are registered at the delegate.
 	{
-		typename TMutex::ScopedLock lock(_mutex);
-		return _strategy.empty();
+		typename StrategyHolder::ScopedRead strategy(_strategy);
+		return strategy.value().empty();
 	}
 
 protected:
@@ -343,10 +353,13 @@ protected:
 		return retArgs;
 	}
 
-	TStrategy _strategy; /// The strategy used to notify observers.
-	bool      _enabled;  /// Stores if an event is enabled. Notifies on disabled events have no effect
-	                     /// but it is possible to change the observers.
-	mutable TMutex _mutex;
+	typedef SnapshotHolder<TStrategy> StrategyHolder;
+
+	StrategyHolder _strategy; /// The strategy used to notify observers.
+	                          /// Changes replace it with a modified copy.
+	volatile bool  _enabled;  /// Stores if an event is enabled. Notifies on disabled events have no effect
+	                          /// but it is possible to change the observers.
+	mutable TMutex _mutex;    /// Serializes changes to the strategy.
 
 private:
 	AbstractEvent(const AbstractEvent& other);
@@ -383,7 +396,9 @@ public:
 		/// Exact behavior is determined by the TStrategy.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.add(aDelegate);
+		typename StrategyHolder::SnapshotPtr pStrategy(_strategy.clone());
+		pStrategy->value().add(aDelegate);
+		_strategy.publish(pStrategy.duplicate());
 	}
 	
 	void operator -= (const TDelegate& aDelegate)
@@ -392,7 +407,9 @@ public:
 		/// If the delegate is not found, this function does nothing.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.remove(aDelegate);
+		typename StrategyHolder::SnapshotPtr pStrategy(_strategy.clone());
+		pStrategy->value().remove(aDelegate);
+		_strategy.publish(pStrategy.duplicate());
 	}
 
 	DelegateHandle add(const TDelegate& aDelegate)
@@ -404,7 +421,10 @@ public:
 		/// remove() to remove the delegate.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		return _strategy.add(aDelegate);
+		typename StrategyHolder::SnapshotPtr pStrategy(_strategy.clone());
+		DelegateHandle handle = pStrategy->value().add(aDelegate);
+		_strategy.publish(pStrategy.duplicate());
+		return handle;
 	}
 	
 	void remove(DelegateHandle delegateHandle)
@@ -414,7 +434,9 @@ public:
 		/// If the delegate is not found, this function does nothing.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.remove(delegateHandle);
+		typename StrategyHolder::SnapshotPtr pStrategy(_strategy.clone());
+		pStrategy->value().remove(delegateHandle);
+		_strategy.publish(pStrategy.duplicate());
 	}
 	
 	void operator () (const void* pSender)
@@ -439,17 +461,15 @@ public:
 		/// invoked prior to removal). If one of the delegates throws an exception, 
 		/// the notify method is immediately aborted and the exception is propagated
 		/// to the caller.
+		///
+		/// Delegates are invoked from an immutable snapshot of the delegate
+		/// list, which adding and removing delegates replaces with a modified
+		/// copy. Therefore, notify() neither takes a lock nor allocates memory.
 	{
-		Poco::ScopedLockWithUnlock<TMutex> lock(_mutex);
-		
 		if (!_enabled) return;
 		
-		// thread-safeness: 
-		// copy should be faster and safer than blocking until
-		// execution ends
-		TStrategy strategy(_strategy);
-		lock.unlock();
-		strategy.notify(pSender);
+		typename StrategyHolder::ScopedRead strategy(_strategy);
+		strategy.value().notify(pSender);
 	}
 
 	ActiveResult<void> notifyAsync(const void* pSender)
@@ -474,7 +494,7 @@ public:
 			// make a copy of the strategy here to guarantee that
 			// between notifyAsync and the execution of the method no changes can occur
 				
-			params.ptrStrat = SharedPtr<TStrategy>(new TStrategy(_strategy));
+			params.ptrStrat = SharedPtr<TStrategy>(new TStrategy(_strategy.current()));
 			params.enabled  = _enabled;
 		}
 		ActiveResult<void> result = _executeAsync(params);
@@ -506,14 +526,16 @@ public:
 		/// Removes all delegates.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.clear();
+		typename StrategyHolder::SnapshotPtr pStrategy(_strategy.clone());
+		pStrategy->value().clear();
+		_strategy.publish(pStrategy.duplicate());
 	}
 	
 	bool empty() const
 		/// Checks if any delegates are registered at the delegate.
 	{
-		typename TMutex::ScopedLock lock(_mutex);
-		return _strategy.empty();
+		typename StrategyHolder::ScopedRead strategy(_strategy);
+		return strategy.value().empty();
 	}
 
 protected:
@@ -543,10 +565,13 @@ protected:
 		return;
 	}
 
-	TStrategy _strategy; /// The strategy used to notify observers.
-	bool      _enabled;  /// Stores if an event is enabled. Notifies on disabled events have no effect
-	                     /// but it is possible to change the observers.
-	mutable TMutex _mutex;
+	typedef SnapshotHolder<TStrategy> StrategyHolder;
+
+	StrategyHolder _strategy; /// The strategy used to notify observers.
+	                          /// Changes replace it with a modified copy.
+	volatile bool  _enabled;  /// Stores if an event is enabled. Notifies on disabled events have no effect
+	                          /// but it is possible to change the observers.
+	mutable TMutex _mutex;    /// Serializes changes to the strategy.
 
 private:
 	AbstractEvent(const AbstractEvent& other);
@@ -0,0 +1,119 @@
+//
+// ActiveExecutor.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Threading
+// Module:  ActiveObjects
+//
+// Definition of the ActiveExecutor class and its subclasses.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_ActiveExecutor_INCLUDED
+#define Foundation_ActiveExecutor_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Runnable.h"
+
+
+namespace Poco {
+
+
+class ThreadPool;
+class WorkStealingThreadPool;
+
+
+class Foundation_API ActiveExecutor
+	/// An ActiveExecutor decides where an active method or an
+	/// ActiveResult continuation (see ActiveResult::then()) runs.
+	///
+	/// An ActiveMethod can be bound to an executor when it is
+	/// constructed, instead of being started by its StarterType.
+{
+public:
+	ActiveExecutor();
+		/// Creates the ActiveExecutor.
+
+	virtual ~ActiveExecutor();
+		/// Destroys the ActiveExecutor.
+
+	virtual void execute(Runnable& target) = 0;
+		/// Arranges for target to be run, usually in another
+		/// thread. Throws an exception if this is not possible,
+		/// in which case target is not run.
+};
+
+
+class Foundation_API ThreadPoolExecutor: public ActiveExecutor
+	/// An ActiveExecutor that runs Runnables in a ThreadPool.
+{
+public:
+	explicit ThreadPoolExecutor(ThreadPool& pool);
+		/// Creates the ThreadPoolExecutor for the given pool.
+
+	~ThreadPoolExecutor();
+		/// Destroys the ThreadPoolExecutor.
+
+	void execute(Runnable& target);
+		/// Starts target in a thread from the pool.
+		/// Throws a NoThreadAvailableException if the
+		/// pool has no thread available.
+
+private:
+	ThreadPool& _pool;
+};
+
+
+class Foundation_API WorkStealingExecutor: public ActiveExecutor
+	/// An ActiveExecutor that runs Runnables in a WorkStealingThreadPool.
+	///
+	/// Continuations that are scheduled from within the pool
+	/// end up in the scheduling worker's own queue, so a chain
+	/// of continuations tends to stay on one thread.
+{
+public:
+	explicit WorkStealingExecutor(WorkStealingThreadPool& pool);
+		/// Creates the WorkStealingExecutor for the given pool.
+
+	~WorkStealingExecutor();
+		/// Destroys the WorkStealingExecutor.
+
+	void execute(Runnable& target);
+		/// Queues target for execution in the pool.
+		/// Throws a NoThreadAvailableException if target is
+		/// started from outside the pool and the pool's
+		/// submission queue is full.
+
+private:
+	WorkStealingThreadPool& _pool;
+};
+
+
+class Foundation_API InlineExecutor: public ActiveExecutor
+	/// An ActiveExecutor that runs Runnables immediately
+	/// in the calling thread.
+{
+public:
+	InlineExecutor();
+		/// Creates the InlineExecutor.
+
+	~InlineExecutor();
+		/// Destroys the InlineExecutor.
+
+	void execute(Runnable& target);
+		/// Runs target in the calling thread.
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ActiveExecutor_INCLUDED
@@ -24,6 +24,7 @@
 #include "Poco/ActiveResult.h"
 #include "Poco/ActiveRunnable.h"
 #include "Poco/ActiveStarter.h"
+#include "Poco/ActiveExecutor.h"
 #include "Poco/AutoPtr.h"
 
 
@@ -70,6 +71,14 @@ class ActiveMethod
 	///
 	/// For an alternative implementation of StarterType, see ActiveDispatcher.
 	///
+	/// Alternatively, an ActiveMethod can be bound to an ActiveExecutor
+	/// when it is constructed, for example a ThreadPoolExecutor for a
+	/// pool other than the default one, or a WorkStealingExecutor.
+	/// The StarterType is not used then.
+	///
+	/// Use ActiveResult::then(), whenAll() and whenAny() to combine
+	/// results without blocking a thread while waiting for them.
+	///
 	/// For methods that do not require an argument or a return value, the Void
 	/// class can be used.
 {
@@ -80,24 +89,50 @@ public:
 
 	ActiveMethod(OwnerType* pOwner, Callback method):
 		_pOwner(pOwner),
-		_method(method)
+		_method(method),
+		_pExecutor(0)
 		/// Creates an ActiveMethod object.
 	{
 		poco_check_ptr (pOwner);
 	}
+
+	ActiveMethod(OwnerType* pOwner, Callback method, ActiveExecutor& executor):
+		_pOwner(pOwner),
+		_method(method),
+		_pExecutor(&executor)
+		/// Creates an ActiveMethod object that is run by the
+		/// given executor. The executor must outlive the
+		/// ActiveMethod.
+	{
+		poco_check_ptr (pOwner);
+	}
 	
 	ActiveResultType operator () (const ArgType& arg)
 		/// Invokes the ActiveMethod.
 	{
 		ActiveResultType result(new ActiveResultHolder<ResultType>());
 		ActiveRunnableBase::Ptr pRunnable(new ActiveRunnableType(_pOwner, _method, arg, result));
-		StarterType::start(_pOwner, pRunnable);
+		if (_pExecutor)
+		{
+			pRunnable->duplicate(); // The runnable will release itself.
+			try
+			{
+				_pExecutor->execute(*pRunnable);
+			}
+			catch (...)
+			{
+				pRunnable->release();
+				throw;
+			}
+		}
+		else StarterType::start(_pOwner, pRunnable);
 		return result;
 	}
 		
 	ActiveMethod(const ActiveMethod& other):
 		_pOwner(other._pOwner),
-		_method(other._method)
+		_method(other._method),
+		_pExecutor(other._pExecutor)
 	{
 	}
 
@@ -112,13 +147,15 @@ public:
 	{
 		std::swap(_pOwner, other._pOwner);
 		std::swap(_method, other._method);
+		std::swap(_pExecutor, other._pExecutor);
 	}
 
 private:
 	ActiveMethod();
 
-	OwnerType* _pOwner;
-	Callback   _method;
+	OwnerType*      _pOwner;
+	Callback        _method;
+	ActiveExecutor* _pExecutor;
 };
 
 
@@ -163,6 +200,14 @@ class ActiveMethod <ResultType, void, OwnerType, StarterType>
 	///
 	/// For an alternative implementation of StarterType, see ActiveDispatcher.
 	///
+	/// Alternatively, an ActiveMethod can be bound to an ActiveExecutor
+	/// when it is constructed, for example a ThreadPoolExecutor for a
+	/// pool other than the default one, or a WorkStealingExecutor.
+	/// The StarterType is not used then.
+	///
+	/// Use ActiveResult::then(), whenAll() and whenAny() to combine
+	/// results without blocking a thread while waiting for them.
+	///
 	/// For methods that do not require an argument or a return value, simply use void.
 {
 public:
@@ -172,24 +217,50 @@ public:
 
 	ActiveMethod(OwnerType* pOwner, Callback method):
 		_pOwner(pOwner),
-		_method(method)
+		_method(method),
+		_pExecutor(0)
 		/// Creates an ActiveMethod object.
 	{
 		poco_check_ptr (pOwner);
 	}
+
+	ActiveMethod(OwnerType* pOwner, Callback method, ActiveExecutor& executor):
+		_pOwner(pOwner),
+		_method(method),
+		_pExecutor(&executor)
+		/// Creates an ActiveMethod object that is run by the
+		/// given executor. The executor must outlive the
+		/// ActiveMethod.
+	{
+		poco_check_ptr (pOwner);
+	}
 	
 	ActiveResultType operator () (void)
 		/// Invokes the ActiveMethod.
 	{
 		ActiveResultType result(new ActiveResultHolder<ResultType>());
 		ActiveRunnableBase::Ptr pRunnable(new ActiveRunnableType(_pOwner, _method, result));
-		StarterType::start(_pOwner, pRunnable);
+		if (_pExecutor)
+		{
+			pRunnable->duplicate(); // The runnable will release itself.
+			try
+			{
+				_pExecutor->execute(*pRunnable);
+			}
+			catch (...)
+			{
+				pRunnable->release();
+				throw;
+			}
+		}
+		else StarterType::start(_pOwner, pRunnable);
 		return result;
 	}
 		
 	ActiveMethod(const ActiveMethod& other):
 		_pOwner(other._pOwner),
-		_method(other._method)
+		_method(other._method),
+		_pExecutor(other._pExecutor)
 	{
 	}
 
@@ -204,13 +275,15 @@ public:
 	{
 		std::swap(_pOwner, other._pOwner);
 		std::swap(_method, other._method);
+		std::swap(_pExecutor, other._pExecutor);
 	}
 
 private:
 	ActiveMethod();
 
-	OwnerType* _pOwner;
-	Callback   _method;
+	OwnerType*      _pOwner;
+	Callback        _method;
+	ActiveExecutor* _pExecutor;
 };
 
 
@@ -25,12 +25,75 @@
 #include "Poco/Event.h"
 #include "Poco/RefCountedObject.h"
 #include "Poco/Exception.h"
+#include "Poco/Runnable.h"
 #include <algorithm>
+#include <vector>
 
 
 namespace Poco {
 
 
+class ActiveExecutor;
+
+
+template <class RT, class NewRT, class C>
+class ActiveContinuationMethod;
+
+
+template <class RT, class NewRT, class Fn>
+class ActiveContinuation;
+
+
+class ActiveResultCallback
+	/// The base class for callbacks that are invoked when the
+	/// result of an asynchronous method invocation becomes
+	/// available. Callbacks are used to implement
+	/// ActiveResult::then(), whenAll() and whenAny().
+	///
+	/// A callback is invoked exactly once, either in the thread
+	/// that makes the result available, or, if the result is
+	/// already available when the callback is registered, in the
+	/// registering thread. completed() takes over responsibility
+	/// for deleting the callback and must not throw. Callbacks
+	/// that have not been invoked when the result is destroyed
+	/// are deleted with it.
+{
+public:
+	virtual ~ActiveResultCallback()
+	{
+	}
+
+	virtual void completed() = 0;
+		/// Called when the result becomes available.
+};
+
+
+class Foundation_API ActiveResultCallbackList
+	/// Keeps the callbacks registered for an ActiveResultHolder.
+	/// For internal use only.
+{
+public:
+	ActiveResultCallbackList();
+	~ActiveResultCallbackList();
+
+	void add(ActiveResultCallback* pCallback);
+		/// Adds the given callback, or invokes it immediately
+		/// if fire() has already been called.
+
+	void fire();
+		/// Invokes all registered callbacks.
+
+private:
+	typedef std::vector<ActiveResultCallback*> CallbackVec;
+
+	static void invoke(ActiveResultCallback* pCallback);
+
+	bool        _done;
+	CallbackVec _callbacks;
+	FastMutex   _mutex;
+};
+
+
 template <class ResultType>
 class ActiveResultHolder: public RefCountedObject
 	/// This class holds the result of an asynchronous method
@@ -84,9 +147,18 @@ public:
 	}
 	
 	void notify()
-		/// Notifies the invoking thread that the result became available.
+		/// Notifies the invoking thread that the result became available,
+		/// and invokes the registered callbacks.
 	{
 		_event.set();
+		_callbacks.fire();
+	}
+
+	void addCallback(ActiveResultCallback* pCallback)
+		/// Registers a callback that is invoked when the result
+		/// becomes available. Takes ownership of the callback.
+	{
+		_callbacks.add(pCallback);
 	}
 	
 	bool failed() const
@@ -139,6 +211,7 @@ private:
 	ResultType* _pData;
 	Exception*  _pExc;
 	Event       _event;
+	ActiveResultCallbackList _callbacks;
 };
 
 
@@ -177,9 +250,18 @@ public:
 	}
 	
 	void notify()
-		/// Notifies the invoking thread that the result became available.
+		/// Notifies the invoking thread that the result became available,
+		/// and invokes the registered callbacks.
 	{
 		_event.set();
+		_callbacks.fire();
+	}
+
+	void addCallback(ActiveResultCallback* pCallback)
+		/// Registers a callback that is invoked when the result
+		/// becomes available. Takes ownership of the callback.
+	{
+		_callbacks.add(pCallback);
 	}
 	
 	bool failed() const
@@ -230,6 +312,7 @@ protected:
 private:
 	Exception*  _pExc;
 	Event       _event;
+	ActiveResultCallbackList _callbacks;
 };
 
 
@@ -344,6 +427,49 @@ public:
 	{
 		_pHolder->notify();
 	}
+
+	template <class NewRT, class C>
+	ActiveResult<NewRT> then(C* pObject, NewRT (C::*method)(const ActiveResult&), ActiveExecutor* pExecutor = 0) const
+		/// Returns a new ActiveResult that receives the return value
+		/// of the given method, which is called with this result as
+		/// argument once this result becomes available. The caller
+		/// is never blocked.
+		///
+		/// If no executor is given, the method is called in the thread
+		/// that makes this result available, or immediately, if this
+		/// result is already available. Otherwise, the method is run by
+		/// the given executor, which must stay alive until it has done so.
+		///
+		/// The method is called even if this result has failed. If the
+		/// method throws, the returned result fails with that exception.
+		///
+		/// Example:
+		///
+		///     ActiveResult<int> lookup = db.lookup(key);
+		///     ActiveResult<std::string> page = lookup.then(&renderer, &Renderer::render);
+	{
+		typedef ActiveContinuationMethod<RT, NewRT, C> Fn;
+		return ActiveContinuation<RT, NewRT, Fn>::create(_pHolder, Fn(pObject, method), pExecutor);
+	}
+
+	template <class NewRT>
+	ActiveResult<NewRT> then(NewRT (*function)(const ActiveResult&), ActiveExecutor* pExecutor = 0) const
+		/// Returns a new ActiveResult that receives the return value
+		/// of the given function, which is called with this result as
+		/// argument once this result becomes available.
+		/// See the other then() overload for details.
+	{
+		typedef NewRT (*Fn)(const ActiveResult&);
+		return ActiveContinuation<RT, NewRT, Fn>::create(_pHolder, function, pExecutor);
+	}
+
+	void onCompletion(ActiveResultCallback* pCallback) const
+		/// Registers a callback that is invoked when the result
+		/// becomes available. Takes ownership of the callback.
+		/// See ActiveResultCallback for details.
+	{
+		_pHolder->addCallback(pCallback);
+	}
 	
 	ResultType& data()
 		/// Returns a non-const reference to the result data. For internal
@@ -471,6 +597,49 @@ public:
 	{
 		_pHolder->notify();
 	}
+
+	template <class NewRT, class C>
+	ActiveResult<NewRT> then(C* pObject, NewRT (C::*method)(const ActiveResult&), ActiveExecutor* pExecutor = 0) const
+		/// Returns a new ActiveResult that receives the return value
+		/// of the given method, which is called with this result as
+		/// argument once this result becomes available. The caller
+		/// is never blocked.
+		///
+		/// If no executor is given, the method is called in the thread
+		/// that makes this result available, or immediately, if this
+		/// result is already available. Otherwise, the method is run by
+		/// the given executor, which must stay alive until it has done so.
+		///
+		/// The method is called even if this result has failed. If the
+		/// method throws, the returned result fails with that exception.
+		///
+		/// Example:
+		///
+		///     ActiveResult<int> lookup = db.lookup(key);
+		///     ActiveResult<std::string> page = lookup.then(&renderer, &Renderer::render);
+	{
+		typedef ActiveContinuationMethod<void, NewRT, C> Fn;
+		return ActiveContinuation<void, NewRT, Fn>::create(_pHolder, Fn(pObject, method), pExecutor);
+	}
+
+	template <class NewRT>
+	ActiveResult<NewRT> then(NewRT (*function)(const ActiveResult&), ActiveExecutor* pExecutor = 0) const
+		/// Returns a new ActiveResult that receives the return value
+		/// of the given function, which is called with this result as
+		/// argument once this result becomes available.
+		/// See the other then() overload for details.
+	{
+		typedef NewRT (*Fn)(const ActiveResult&);
+		return ActiveContinuation<void, NewRT, Fn>::create(_pHolder, function, pExecutor);
+	}
+
+	void onCompletion(ActiveResultCallback* pCallback) const
+		/// Registers a callback that is invoked when the result
+		/// becomes available. Takes ownership of the callback.
+		/// See ActiveResultCallback for details.
+	{
+		_pHolder->addCallback(pCallback);
+	}
 	
 	void error(const std::string& msg)
 		/// Sets the failed flag and the exception message.
@@ -491,6 +660,278 @@ private:
 };
 
 
+template <class RT, class NewRT, class C>
+class ActiveContinuationMethod
+	/// Calls a member function with an ActiveResult as argument.
+	/// Used by ActiveResult::then(). For internal use only.
+{
+public:
+	typedef NewRT (C::*Method)(const ActiveResult<RT>&);
+
+	ActiveContinuationMethod(C* pObject, Method method):
+		_pObject(pObject),
+		_method(method)
+	{
+		poco_check_ptr (pObject);
+	}
+
+	NewRT operator () (const ActiveResult<RT>& result) const
+	{
+		return (_pObject->*_method)(result);
+	}
+
+private:
+	C*     _pObject;
+	Method _method;
+};
+
+
+template <class NewRT>
+struct ActiveContinuationInvoker
+	/// Stores the return value of a continuation in its result.
+	/// For internal use only.
+{
+	template <class Fn, class Source>
+	static void invoke(const Fn& fn, const Source& source, ActiveResult<NewRT>& target)
+	{
+		target.data(new NewRT(fn(source)));
+	}
+};
+
+
+template <>
+struct ActiveContinuationInvoker<void>
+{
+	template <class Fn, class Source>
+	static void invoke(const Fn& fn, const Source& source, ActiveResult<void>& /*target*/)
+	{
+		fn(source);
+	}
+};
+
+
+class Foundation_API ActiveContinuationBase: public Runnable, public ActiveResultCallback
+	/// The base class for ActiveContinuation.
+	/// For internal use only.
+{
+protected:
+	ActiveContinuationBase(ActiveExecutor* pExecutor);
+	~ActiveContinuationBase();
+
+	bool hasExecutor() const;
+		/// Returns true if the continuation runs in an executor.
+
+	void execute();
+		/// Hands the continuation to its executor.
+
+private:
+	ActiveExecutor* _pExecutor;
+};
+
+
+template <class RT, class NewRT, class Fn>
+class ActiveContinuation: public ActiveContinuationBase
+	/// Runs a continuation registered with ActiveResult::then().
+	/// For internal use only.
+{
+public:
+	typedef ActiveResultHolder<RT> SourceHolder;
+	typedef ActiveResult<NewRT> TargetType;
+
+	static TargetType create(SourceHolder* pSource, const Fn& fn, ActiveExecutor* pExecutor)
+	{
+		TargetType target(new ActiveResultHolder<NewRT>());
+		pSource->addCallback(new ActiveContinuation(pSource, fn, target, pExecutor));
+		return target;
+	}
+
+	void completed()
+	{
+		// Until now, the continuation has only been referenced by
+		// the source, so it did not keep the source alive. It may
+		// run later on another thread, so it needs a reference now.
+		_pSource->duplicate();
+		_ownSource = true;
+		if (hasExecutor())
+		{
+			try
+			{
+				execute();
+				return;
+			}
+			catch (Exception& exc)
+			{
+				_target.error(exc);
+			}
+			catch (std::exception& exc)
+			{
+				_target.error(exc.what());
+			}
+			catch (...)
+			{
+				_target.error("unknown exception");
+			}
+			_target.notify();
+			delete this;
+		}
+		else run();
+	}
+
+	void run()
+	{
+		ActiveResult<RT> source(_pSource);
+		_ownSource = false;
+		try
+		{
+			ActiveContinuationInvoker<NewRT>::invoke(_fn, source, _target);
+		}
+		catch (Exception& exc)
+		{
+			_target.error(exc);
+		}
+		catch (std::exception& exc)
+		{
+			_target.error(exc.what());
+		}
+		catch (...)
+		{
+			_target.error("unknown exception");
+		}
+		TargetType target(_target);
+		delete this;
+		target.notify();
+	}
+
+protected:
+	ActiveContinuation(SourceHolder* pSource, const Fn& fn, const TargetType& target, ActiveExecutor* pExecutor):
+		ActiveContinuationBase(pExecutor),
+		_pSource(pSource),
+		_ownSource(false),
+		_fn(fn),
+		_target(target)
+	{
+	}
+
+	~ActiveContinuation()
+	{
+		if (_ownSource) _pSource->release();
+	}
+
+private:
+	ActiveContinuation();
+	ActiveContinuation(const ActiveContinuation&);
+	ActiveContinuation& operator = (const ActiveContinuation&);
+
+	SourceHolder* _pSource;
+	bool          _ownSource;
+	Fn            _fn;
+	TargetType    _target;
+};
+
+
+class Foundation_API ActiveWhenAll
+	/// Used by whenAll(). For internal use only.
+{
+public:
+	ActiveWhenAll(const ActiveResult<void>& result, int count);
+		/// Creates an ActiveWhenAll that makes result available
+		/// once count callbacks have been invoked.
+
+	~ActiveWhenAll();
+
+	ActiveResultCallback* callback();
+		/// Returns a new callback to register with a result.
+
+private:
+	ActiveWhenAll(const ActiveWhenAll&);
+	ActiveWhenAll& operator = (const ActiveWhenAll&);
+
+	class State;
+	class Callback;
+
+	State* _pState;
+};
+
+
+class Foundation_API ActiveWhenAny
+	/// Used by whenAny(). For internal use only.
+{
+public:
+	explicit ActiveWhenAny(const ActiveResult<std::size_t>& result);
+		/// Creates an ActiveWhenAny that makes result available,
+		/// with the index of the first callback invoked as data.
+
+	~ActiveWhenAny();
+
+	ActiveResultCallback* callback(std::size_t index);
+		/// Returns a new callback with the given index
+		/// to register with a result.
+
+private:
+	ActiveWhenAny(const ActiveWhenAny&);
+	ActiveWhenAny& operator = (const ActiveWhenAny&);
+
+	class State;
+	class Callback;
+
+	State* _pState;
+};
+
+
+template <class RT>
+ActiveResult<void> whenAll(const std::vector<ActiveResult<RT> >& results)
+	/// Returns an ActiveResult that becomes available as soon as all
+	/// the given results are available, without blocking the caller.
+	/// The returned result never fails; check the given results
+	/// for errors.
+{
+	ActiveResult<void> result(new ActiveResultHolder<void>());
+	if (results.empty())
+	{
+		result.notify();
+	}
+	else
+	{
+		ActiveWhenAll callbacks(result, static_cast<int>(results.size()));
+		for (typename std::vector<ActiveResult<RT> >::const_iterator it = results.begin(); it != results.end(); ++it)
+		{
+			it->onCompletion(callbacks.callback());
+		}
+	}
+	return result;
+}
+
+
+template <class RT>
+ActiveResult<std::size_t> whenAny(const std::vector<ActiveResult<RT> >& results)
+	/// Returns an ActiveResult that becomes available as soon as one
+	/// of the given results is available, without blocking the caller.
+	/// Its data is the index of that result. The returned result never
+	/// fails; check the indicated result for errors.
+	///
+	/// Throws an InvalidArgumentException if results is empty.
+{
+	if (results.empty()) throw InvalidArgumentException("whenAny() requires at least one result");
+
+	ActiveResult<std::size_t> result(new ActiveResultHolder<std::size_t>());
+	ActiveWhenAny callbacks(result);
+	for (std::size_t i = 0; i < results.size(); ++i)
+	{
+		results[i].onCompletion(callbacks.callback(i));
+	}
+	return result;
+}
+
+
+//
+// inlines
+//
+inline bool ActiveContinuationBase::hasExecutor() const
+{
+	return _pExecutor != 0;
+}
+
+
 } // namespace Poco
 
 
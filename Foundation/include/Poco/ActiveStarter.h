@@ -38,8 +38,18 @@ class ActiveStarter
 public:
 	static void start(OwnerType* /*pOwner*/, ActiveRunnableBase::Ptr pRunnable)
 	{
-		ThreadPool::defaultPool().start(*pRunnable);
+		// Take the runnable's reference before starting it, as it
+		// may already be done before start() returns.
 		pRunnable->duplicate(); // The runnable will release itself.
+		try
+		{
+			ThreadPool::defaultPool().start(*pRunnable);
+		}
+		catch (...)
+		{
+			pRunnable->release();
+			throw;
+		}
 	}
 };
 
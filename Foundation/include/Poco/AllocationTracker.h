@@ -0,0 +1,238 @@
+//
+// AllocationTracker.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  AllocationTracker
+//
+// Definition of the AllocationTracker and AllocationScope classes.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_AllocationTracker_INCLUDED
+#define Foundation_AllocationTracker_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include <ostream>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API AllocationTracker
+	/// AllocationTracker counts memory allocations by component.
+	///
+	/// Tracking is only compiled in if POCO_ENABLE_ALLOCATION_TRACKING
+	/// is defined (see Config.h, or the CMake option of the same name).
+	/// Otherwise, all counters stay zero and the hooks compile to
+	/// nothing. On Windows, tracking requires static libraries, as
+	/// operator new and delete cannot be replaced from within a DLL.
+	///
+	/// With tracking enabled, Foundation replaces the global operator
+	/// new and operator delete. Every heap allocation is counted for
+	/// the component that the allocating thread is currently working
+	/// for, as set by an AllocationScope. The component is stored with
+	/// the block, so the block's release is counted for the same
+	/// component, whichever thread frees it. Allocations outside of
+	/// any AllocationScope are counted for COMPONENT_OTHER.
+	///
+	/// Blocks handed out and taken back by MemoryPool and
+	/// ThreadCachingMemoryPool are counted separately, as pool
+	/// allocations, for the component of the calling thread.
+	///
+	/// Associating allocations with components requires a native
+	/// thread local variable (see POCO_NO_THREAD_LOCAL). Where none
+	/// is available, everything is counted for COMPONENT_OTHER.
+{
+public:
+	enum Component
+	{
+		COMPONENT_OTHER = 0,
+		COMPONENT_NET,
+		COMPONENT_JSON,
+		COMPONENT_DATA,
+		COMPONENT_XML,
+		COMPONENT_LOGGING,
+		COMPONENT_COUNT
+	};
+
+	struct Statistics
+	{
+		Int64 allocations;
+			/// Number of heap blocks allocated.
+		Int64 deallocations;
+			/// Number of heap blocks freed.
+		Int64 bytesAllocated;
+			/// Total size of heap blocks allocated.
+		Int64 bytesDeallocated;
+			/// Total size of heap blocks freed.
+		Int64 poolAllocations;
+			/// Number of blocks taken from memory pools.
+		Int64 poolDeallocations;
+			/// Number of blocks returned to memory pools.
+		Int64 poolBytes;
+			/// Total size of blocks taken from memory pools.
+		Int64 poolBytesDeallocated;
+			/// Total size of blocks returned to memory pools.
+	};
+
+	static bool enabled();
+		/// Returns true if allocation tracking has been compiled in.
+
+	static void statistics(Component component, Statistics& stats);
+		/// Stores the current counters for the given component in stats.
+
+	static void reset();
+		/// Sets all counters to zero.
+
+	static void report(std::ostream& ostr);
+		/// Writes the counters of all components, one line
+		/// per component, to the given stream.
+
+	static const char* name(Component component);
+		/// Returns the name of the given component.
+
+	static Component current();
+		/// Returns the component the calling thread is working for.
+
+	static Component enter(Component component);
+		/// Makes the calling thread work for the given component
+		/// and returns the previous one. Use AllocationScope
+		/// instead of calling this directly.
+
+	static void leave(Component previous);
+		/// Restores the component returned by enter().
+
+	static void heapAllocated(Component component, std::size_t size);
+	static void heapDeallocated(Component component, std::size_t size);
+	static void poolAllocated(std::size_t size);
+	static void poolDeallocated(std::size_t size);
+		/// Hooks called by operator new and delete and by the
+		/// memory pools. Do nothing if tracking is not compiled in.
+
+private:
+	AllocationTracker();
+};
+
+
+class AllocationScope
+	/// An AllocationScope attributes all allocations the current
+	/// thread makes during its lifetime to the given component.
+	/// Scopes can be nested.
+	///
+	/// Example:
+	///     void Parser::parse()
+	///     {
+	///         AllocationScope scope(AllocationTracker::COMPONENT_JSON);
+	///         ...
+	///     }
+	///
+	/// If allocation tracking is not compiled in, an
+	/// AllocationScope does nothing.
+{
+public:
+	explicit AllocationScope(AllocationTracker::Component component);
+		/// Makes the calling thread work for the given component.
+
+	~AllocationScope();
+		/// Restores the previous component.
+
+private:
+	AllocationScope();
+	AllocationScope(const AllocationScope&);
+	AllocationScope& operator = (const AllocationScope&);
+
+#if defined(POCO_ENABLE_ALLOCATION_TRACKING)
+	AllocationTracker::Component _previous;
+#endif
+};
+
+
+//
+// inlines
+//
+inline bool AllocationTracker::enabled()
+{
+#if defined(POCO_ENABLE_ALLOCATION_TRACKING)
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+#if !defined(POCO_ENABLE_ALLOCATION_TRACKING)
+
+
+inline AllocationTracker::Component AllocationTracker::enter(Component)
+{
+	return COMPONENT_OTHER;
+}
+
+
+inline void AllocationTracker::leave(Component)
+{
+}
+
+
+inline void AllocationTracker::heapAllocated(Component, std::size_t)
+{
+}
+
+
+inline void AllocationTracker::heapDeallocated(Component, std::size_t)
+{
+}
+
+
+inline void AllocationTracker::poolAllocated(std::size_t)
+{
+}
+
+
+inline void AllocationTracker::poolDeallocated(std::size_t)
+{
+}
+
+
+inline AllocationScope::AllocationScope(AllocationTracker::Component)
+{
+}
+
+
+inline AllocationScope::~AllocationScope()
+{
+}
+
+
+#else
+
+
+inline AllocationScope::AllocationScope(AllocationTracker::Component component):
+	_previous(AllocationTracker::enter(component))
+{
+}
+
+
+inline AllocationScope::~AllocationScope()
+{
+	AllocationTracker::leave(_previous);
+}
+
+
+#endif // POCO_ENABLE_ALLOCATION_TRACKING
+
+
+} // namespace Poco
+
+
+#endif // Foundation_AllocationTracker_INCLUDED
@@ -41,10 +41,6 @@ template <class> class VarHolderImpl;
 
 #ifndef POCO_NO_SOO
 
-#ifndef POCO_ENABLE_CPP11
-	// C++11 needed for std::aligned_storage
-	#error "Any SOO can only be enabled with C++11 support"
-#endif
 
 template <typename PlaceholderT, unsigned int SizeV = POCO_SMALL_OBJECT_SIZE>
 union Placeholder
@@ -63,6 +59,36 @@ public:
 		static const unsigned int value = SizeV;
 	};
 
+	union Aligner
+		/// The types with the strictest alignment
+		/// a value stored locally may need.
+	{
+		Poco::Int64 i;
+		double      d;
+		void*       p;
+	};
+
+	template <typename T>
+	struct Probe
+		/// The offset of t is the alignment of T.
+	{
+		char c;
+		T    t;
+	};
+
+	template <typename T>
+	struct Fits
+		/// Fits<T>::value is true if an object of type T is small
+		/// enough for the local buffer and does not require a
+		/// stricter alignment than the buffer provides.
+	{
+		enum
+		{
+			value = sizeof(T) <= SizeV &&
+				sizeof(Probe<T>) - sizeof(T) <= sizeof(Probe<Aligner>) - sizeof(Aligner)
+		};
+	};
+
 	Placeholder ()
 	{
 		erase();
@@ -95,11 +121,9 @@ public:
 #if !defined(POCO_MSVC_VERSION) || (defined(POCO_MSVC_VERSION) && (POCO_MSVC_VERSION > 80))
 private:
 #endif
-	typedef typename std::aligned_storage<SizeV + 1>::type AlignerType;
-	
 	PlaceholderT* pHolder;
 	mutable char  holder [SizeV + 1];
-	AlignerType   aligner;
+	Aligner       aligner;
 
 	friend class Any;
 	friend class Dynamic::Var;
@@ -183,21 +207,14 @@ public:
 	Any(const Any& other)
 		/// Copy constructor, works with both empty and initialized Any values.
 	{
-		if ((this != &other) && !other.empty())
-			construct(other);
+		construct(other);
 	}
 
 	~Any()
 		/// Destructor. If Any is locally held, calls ValueHolder destructor;
 		/// otherwise, deletes the placeholder from the heap.
 	{
-		if (!empty())
-		{
-			if (_valueHolder.isLocal())
-				destruct();
-			else
-				delete content();
-		}
+		destruct();
 	}
 
 	Any& swap(Any& other)
@@ -215,18 +232,18 @@ public:
 		}
 		else
 		{
-			Any tmp(*this);
+			Any tmp;
+			tmp.take(*this);
 			try
 			{
-				if (_valueHolder.isLocal()) destruct();
-				construct(other);
-				other = tmp;
+				take(other);
 			}
 			catch (...)
 			{
-				construct(tmp);
+				take(tmp);
 				throw;
 			}
+			other.take(tmp);
 		}
 
 		return *this;
@@ -240,26 +257,42 @@ public:
 		///   Any a = 13; 
 		///   Any a = string("12345");
 	{
-		construct(rhs);
+		if (empty())
+		{
+			construct(rhs);
+		}
+		else
+		{
+			// rhs may refer to our own content
+			Any tmp(rhs);
+			destruct();
+			take(tmp);
+		}
 		return *this;
 	}
 	
 	Any& operator = (const Any& rhs)
 		/// Assignment operator for Any.
 	{
-		if ((this != &rhs) && !rhs.empty())
-			construct(rhs);
-		else if ((this != &rhs) && rhs.empty())
-			_valueHolder.erase();
+		if (this == &rhs) return *this;
 
+		if (empty())
+		{
+			construct(rhs);
+		}
+		else
+		{
+			Any tmp(rhs);
+			destruct();
+			take(tmp);
+		}
 		return *this;
 	}
 	
 	bool empty() const
 		/// Returns true if the Any is empty.
 	{
-		char buf[POCO_SMALL_OBJECT_SIZE] = { 0 };
-		return 0 == std::memcmp(_valueHolder.holder, buf, POCO_SMALL_OBJECT_SIZE);
+		return 0 == content();
 	}
 	
 	const std::type_info & type() const
@@ -300,7 +333,7 @@ private:
 
 		virtual void clone(Placeholder<ValueHolder>* pPlaceholder) const
 		{
-			if ((sizeof(Holder<ValueType>) <= POCO_SMALL_OBJECT_SIZE))
+			if (Placeholder<ValueHolder>::Fits<Holder>::value)
 			{
 				new ((ValueHolder*) pPlaceholder->holder) Holder(_held);
 				pPlaceholder->setLocal(true);
@@ -325,8 +358,9 @@ private:
 
 	template<typename ValueType>
 	void construct(const ValueType& value)
+		/// Stores the value. The Any must be empty.
 	{
-		if (sizeof(Holder<ValueType>) <= Placeholder<ValueType>::Size::value)
+		if (Placeholder<ValueHolder>::Fits<Holder<ValueType> >::value)
 		{
 			new (reinterpret_cast<ValueHolder*>(_valueHolder.holder)) Holder<ValueType>(value);
 			_valueHolder.setLocal(true);
@@ -339,16 +373,39 @@ private:
 	}
 
 	void construct(const Any& other)
+		/// Copies the content of other. The Any must be empty.
 	{
 		if (!other.empty())
 			other.content()->clone(&_valueHolder);
 		else
 			_valueHolder.erase();
 	}
+
+	void take(Any& other)
+		/// Moves the content of other, which is left empty,
+		/// into this Any, which must be empty. Only a locally
+		/// held value needs to be copied.
+	{
+		if (other._valueHolder.isLocal())
+		{
+			construct(other);
+			other.destruct();
+		}
+		else
+		{
+			_valueHolder.pHolder = other._valueHolder.pHolder;
+			other._valueHolder.erase();
+		}
+	}
 	
 	void destruct()
+		/// Destroys the content and leaves the Any empty.
 	{
-		content()->~ValueHolder();
+		if (_valueHolder.isLocal())
+			content()->~ValueHolder();
+		else
+			delete content();
+		_valueHolder.erase();
 	}
 
 	Placeholder<ValueHolder> _valueHolder;
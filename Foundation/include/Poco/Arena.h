@@ -0,0 +1,357 @@
+//
+// Arena.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  Arena
+//
+// Definition of the Arena class and the ArenaAllocator class template.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_Arena_INCLUDED
+#define Foundation_Arena_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include <cstddef>
+#include <new>
+
+
+namespace Poco {
+
+
+class Foundation_API Arena
+	/// An Arena is a monotonic allocator for objects that all
+	/// share the same lifetime, such as the data belonging to
+	/// one request.
+	///
+	/// Memory is handed out from large chunks by advancing a
+	/// pointer, so allocating takes only a few instructions.
+	/// Individual allocations are never freed; instead, all
+	/// memory obtained from the Arena is given up at once by
+	/// reset() or when the Arena is destroyed. reset() keeps the
+	/// first chunk, so an Arena used for one request after
+	/// another usually does not allocate memory at all once
+	/// it has warmed up.
+	///
+	/// The Arena does not run destructors. Objects that own
+	/// other resources must be destroyed explicitly before the
+	/// Arena is reset.
+	///
+	/// No memory is allocated before the first call to allocate().
+	///
+	/// An Arena is not thread safe.
+	///
+	/// Use ArenaAllocator to make standard containers
+	/// allocate their elements from an Arena.
+{
+public:
+	enum
+	{
+		DEFAULT_CHUNK_SIZE = 4096,
+		DEFAULT_ALIGNMENT  = 16
+	};
+
+	explicit Arena(std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+		/// Creates the Arena, which allocates memory from the
+		/// heap in chunks of the given size.
+
+	Arena(void* pBuffer, std::size_t size, std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+		/// Creates the Arena, which first hands out memory
+		/// from the given buffer, for example an array on
+		/// the stack, and then from chunks of the given size.
+		///
+		/// The buffer must stay valid as long as the Arena exists.
+
+	~Arena();
+		/// Destroys the Arena and frees all its memory.
+
+	void* allocate(std::size_t size, std::size_t alignment = DEFAULT_ALIGNMENT);
+		/// Returns a block of memory of the given size, aligned
+		/// to the given alignment, which must be a power of two.
+		///
+		/// The block stays valid until the Arena is reset or destroyed.
+		/// Throws std::bad_alloc if no memory can be allocated.
+
+	void reset();
+		/// Gives up all memory handed out so far. All chunks
+		/// except the first one are freed; the first chunk, or the
+		/// buffer given to the constructor, is used again.
+
+	void release();
+		/// Gives up all memory handed out so far
+		/// and frees all chunks.
+
+	std::size_t used() const;
+		/// Returns the number of bytes handed out since the
+		/// Arena has been created or reset, including
+		/// alignment padding.
+
+	std::size_t capacity() const;
+		/// Returns the number of bytes allocated from the heap.
+
+	std::size_t chunkSize() const;
+		/// Returns the size of a chunk.
+
+protected:
+	struct Chunk
+	{
+		Chunk*      pNext;
+		std::size_t size;
+	};
+
+	void* allocateChunk(std::size_t size, std::size_t alignment);
+	void freeChunks(Chunk* pChunk);
+	static char* align(char* p, std::size_t alignment);
+
+private:
+	Arena(const Arena&);
+	Arena& operator = (const Arena&);
+
+	std::size_t _chunkSize;
+	char*       _pBuffer;
+	std::size_t _bufferSize;
+	Chunk*      _pChunks;
+	char*       _pCurrent;
+	char*       _pEnd;
+	std::size_t _used;
+	std::size_t _capacity;
+};
+
+
+template <class T>
+class ArenaAllocator
+	/// An allocator for standard containers that takes its
+	/// memory from an Arena, for example:
+	///
+	///     Poco::Arena arena;
+	///     std::vector<int, Poco::ArenaAllocator<int> > vec(arena);
+	///
+	/// Deallocation does nothing; the memory is reclaimed when
+	/// the Arena is reset. The container must therefore be
+	/// destroyed before the Arena is reset.
+	///
+	/// A default constructed ArenaAllocator takes its memory
+	/// from the heap, like std::allocator.
+	///
+	/// Containers copy their allocator when they are copied,
+	/// so a copy of a container draws from the same Arena as
+	/// the original.
+{
+public:
+	typedef T                 value_type;
+	typedef T*                pointer;
+	typedef const T*          const_pointer;
+	typedef T&                reference;
+	typedef const T&          const_reference;
+	typedef std::size_t       size_type;
+	typedef std::ptrdiff_t    difference_type;
+
+	template <class U>
+	struct rebind
+	{
+		typedef ArenaAllocator<U> other;
+	};
+
+	ArenaAllocator():
+		_pArena(0)
+		/// Creates an ArenaAllocator that uses the heap.
+	{
+	}
+
+	ArenaAllocator(Arena& arena):
+		_pArena(&arena)
+		/// Creates an ArenaAllocator that uses the given Arena.
+	{
+	}
+
+	ArenaAllocator(const ArenaAllocator& alloc):
+		_pArena(alloc._pArena)
+	{
+	}
+
+	template <class U>
+	ArenaAllocator(const ArenaAllocator<U>& alloc):
+		_pArena(alloc.arena())
+	{
+	}
+
+	~ArenaAllocator()
+	{
+	}
+
+	ArenaAllocator& operator = (const ArenaAllocator& alloc)
+	{
+		_pArena = alloc._pArena;
+		return *this;
+	}
+
+	pointer address(reference value) const
+	{
+		return &value;
+	}
+
+	const_pointer address(const_reference value) const
+	{
+		return &value;
+	}
+
+	pointer allocate(size_type n, const void* = 0)
+	{
+		if (n > max_size()) throw std::bad_alloc();
+
+		if (_pArena)
+			return static_cast<pointer>(_pArena->allocate(n*sizeof(T), alignment()));
+		else
+			return static_cast<pointer>(::operator new(n*sizeof(T)));
+	}
+
+	void deallocate(pointer p, size_type)
+	{
+		if (!_pArena) ::operator delete(p);
+	}
+
+	void construct(pointer p, const T& value)
+	{
+		new (static_cast<void*>(p)) T(value);
+	}
+
+	void destroy(pointer p)
+	{
+		p->~T();
+	}
+
+	size_type max_size() const
+	{
+		return static_cast<size_type>(-1)/sizeof(T);
+	}
+
+	Arena* arena() const
+		/// Returns the Arena, or a null pointer
+		/// if the allocator uses the heap.
+	{
+		return _pArena;
+	}
+
+	static std::size_t alignment()
+		/// The alignment of a type always divides its size, so the
+		/// largest power of two dividing sizeof(T) is sufficient.
+	{
+		std::size_t a = sizeof(T) & (~sizeof(T) + 1);
+		return a < Arena::DEFAULT_ALIGNMENT ? a : std::size_t(Arena::DEFAULT_ALIGNMENT);
+	}
+
+private:
+	Arena* _pArena;
+};
+
+
+template <>
+class ArenaAllocator<void>
+{
+public:
+	typedef void        value_type;
+	typedef void*       pointer;
+	typedef const void* const_pointer;
+
+	template <class U>
+	struct rebind
+	{
+		typedef ArenaAllocator<U> other;
+	};
+
+	ArenaAllocator():
+		_pArena(0)
+	{
+	}
+
+	ArenaAllocator(Arena& arena):
+		_pArena(&arena)
+	{
+	}
+
+	template <class U>
+	ArenaAllocator(const ArenaAllocator<U>& alloc):
+		_pArena(alloc.arena())
+	{
+	}
+
+	Arena* arena() const
+	{
+		return _pArena;
+	}
+
+private:
+	Arena* _pArena;
+};
+
+
+template <class T, class U>
+inline bool operator == (const ArenaAllocator<T>& a1, const ArenaAllocator<U>& a2)
+{
+	return a1.arena() == a2.arena();
+}
+
+
+template <class T, class U>
+inline bool operator != (const ArenaAllocator<T>& a1, const ArenaAllocator<U>& a2)
+{
+	return a1.arena() != a2.arena();
+}
+
+
+//
+// inlines
+//
+inline char* Arena::align(char* p, std::size_t alignment)
+{
+	std::size_t mask = alignment - 1;
+	return reinterpret_cast<char*>((reinterpret_cast<std::size_t>(p) + mask) & ~mask);
+}
+
+
+inline void* Arena::allocate(std::size_t size, std::size_t alignment)
+{
+	poco_assert_dbg (alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+	char* p = align(_pCurrent, alignment);
+	if (p && p <= _pEnd && size <= static_cast<std::size_t>(_pEnd - p))
+	{
+		_used += (p - _pCurrent) + size;
+		_pCurrent = p + size;
+		return p;
+	}
+	return allocateChunk(size, alignment);
+}
+
+
+inline std::size_t Arena::used() const
+{
+	return _used;
+}
+
+
+inline std::size_t Arena::capacity() const
+{
+	return _capacity;
+}
+
+
+inline std::size_t Arena::chunkSize() const
+{
+	return _chunkSize;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_Arena_INCLUDED
@@ -29,7 +29,9 @@
 	#if !defined(POCO_HAVE_GCC_ATOMICS) && !defined(POCO_NO_GCC_ATOMICS)
 		#define POCO_HAVE_GCC_ATOMICS
 	#endif
-#elif ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 3) || __GNUC__ > 4)
+#elif ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 3) || __GNUC__ > 4) || defined(__clang__)
+	// Clang reports itself as GCC 4.2, but provides the
+	// __sync builtins on all targets.
 	#if !defined(POCO_HAVE_GCC_ATOMICS) && !defined(POCO_NO_GCC_ATOMICS)
 		#define POCO_HAVE_GCC_ATOMICS
 	#endif
@@ -103,6 +105,15 @@ public:
 	bool operator ! () const;
 		/// Returns true if the counter is zero, false otherwise.
 
+	bool compareAndSet(ValueType expected, ValueType desired);
+		/// Sets the counter to desired if, and only if, its
+		/// current value is expected, as a single atomic operation.
+		/// Returns true if the counter has been changed,
+		/// false otherwise.
+		///
+		/// Where atomic primitives are available, this also
+		/// acts as a full memory barrier.
+
 private:
 #if POCO_OS == POCO_OS_WINDOWS_NT
 	typedef volatile LONG ImplType;
@@ -175,6 +186,12 @@ inline bool AtomicCounter::operator ! () const
 }
 
 
+inline bool AtomicCounter::compareAndSet(ValueType expected, ValueType desired)
+{
+	return InterlockedCompareExchange(&_counter, desired, expected) == expected;
+}
+
+
 #elif POCO_OS == POCO_OS_MAC_OS_X
 //
 // Mac OS X
@@ -222,6 +239,12 @@ inline bool AtomicCounter::operator ! () const
 	return _counter == 0;
 }
 
+
+inline bool AtomicCounter::compareAndSet(ValueType expected, ValueType desired)
+{
+	return OSAtomicCompareAndSwap32Barrier(expected, desired, &_counter);
+}
+
 #elif defined(POCO_HAVE_GCC_ATOMICS)
 //
 // GCC 4.1+ atomic builtins.
@@ -268,6 +291,12 @@ inline bool AtomicCounter::operator ! () const
 }
 
 
+inline bool AtomicCounter::compareAndSet(ValueType expected, ValueType desired)
+{
+	return __sync_bool_compare_and_swap(&_counter, expected, desired);
+}
+
+
 #else
 //
 // Generic implementation based on FastMutex
@@ -349,6 +378,18 @@ inline bool AtomicCounter::operator ! () const
 }
 
 
+inline bool AtomicCounter::compareAndSet(ValueType expected, ValueType desired)
+{
+	FastMutex::ScopedLock lock(_counter.mutex);
+	if (_counter.value == expected)
+	{
+		_counter.value = desired;
+		return true;
+	}
+	return false;
+}
+
+
 #endif // POCO_OS
 
 
@@ -352,6 +352,55 @@ inline void swap(AutoPtr<C>& p1, AutoPtr<C>& p2)
 }
 
 
+template <class C>
+inline AutoPtr<C> makeAuto()
+	/// Creates an object of class C, which must support
+	/// reference counting like RefCountedObject does, and
+	/// returns an AutoPtr to it. The reference counter is part
+	/// of the object, so this takes a single allocation.
+	///
+	/// Up to five constructor arguments are supported, which
+	/// are passed by const reference.
+{
+	return AutoPtr<C>(new C);
+}
+
+
+template <class C, class A1>
+inline AutoPtr<C> makeAuto(const A1& a1)
+{
+	return AutoPtr<C>(new C(a1));
+}
+
+
+template <class C, class A1, class A2>
+inline AutoPtr<C> makeAuto(const A1& a1, const A2& a2)
+{
+	return AutoPtr<C>(new C(a1, a2));
+}
+
+
+template <class C, class A1, class A2, class A3>
+inline AutoPtr<C> makeAuto(const A1& a1, const A2& a2, const A3& a3)
+{
+	return AutoPtr<C>(new C(a1, a2, a3));
+}
+
+
+template <class C, class A1, class A2, class A3, class A4>
+inline AutoPtr<C> makeAuto(const A1& a1, const A2& a2, const A3& a3, const A4& a4)
+{
+	return AutoPtr<C>(new C(a1, a2, a3, a4));
+}
+
+
+template <class C, class A1, class A2, class A3, class A4, class A5>
+inline AutoPtr<C> makeAuto(const A1& a1, const A2& a2, const A3& a3, const A4& a4, const A5& a5)
+{
+	return AutoPtr<C>(new C(a1, a2, a3, a4, a5));
+}
+
+
 } // namespace Poco
 
 
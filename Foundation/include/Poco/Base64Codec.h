@@ -0,0 +1,146 @@
+//
+// Base64Codec.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Streams
+// Module:  Base64
+//
+// Definition of class Base64Codec.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_Base64Codec_INCLUDED
+#define Foundation_Base64Codec_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include <string>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API Base64Codec
+	/// Base64Codec encodes and decodes whole buffers
+	/// (RFC 4648, standard alphabet, with padding).
+	///
+	/// On x86 and x86_64 processors, the bulk of the data is
+	/// handled by SSSE3 or AVX2 kernels that encode 12 or 24 bytes
+	/// (or decode 16 or 32 characters) at a time. The best kernels
+	/// the processor supports are selected at run time. Elsewhere,
+	/// and for the tail of every buffer, portable code is used.
+	/// All implementations produce identical results.
+	///
+	/// Unlike Base64Encoder, Base64Codec does not insert line breaks,
+	/// and unlike Base64Decoder, it does not skip whitespace.
+	/// Base64Encoder and Base64Decoder use Base64Codec for
+	/// data written or read in blocks.
+{
+public:
+	enum Implementation
+	{
+		IMPL_SCALAR, /// Portable code.
+		IMPL_SSSE3,  /// SSSE3 kernels.
+		IMPL_AVX2    /// AVX2 kernels.
+	};
+
+	static std::size_t encodedLength(std::size_t length);
+		/// Returns the number of characters the encoding
+		/// of length bytes takes.
+
+	static std::size_t decodedLength(std::size_t length);
+		/// Returns the maximum number of bytes that decoding
+		/// length characters yields.
+
+	static std::size_t encode(const void* data, std::size_t length, char* encoded);
+		/// Encodes length bytes from data and stores the result,
+		/// which is encodedLength(length) characters long,
+		/// in encoded. The result is not zero-terminated.
+		///
+		/// Returns the number of characters written.
+
+	static std::size_t encode(const void* data, std::size_t length, char* encoded, Implementation impl);
+		/// Encodes length bytes from data, using the given implementation.
+		///
+		/// Throws an InvalidArgumentException if the processor
+		/// does not support the implementation.
+
+	static std::string encode(const std::string& data);
+		/// Returns the encoding of the given data.
+
+	static std::size_t decode(const char* encoded, std::size_t length, void* data);
+		/// Decodes length characters from encoded and stores
+		/// the result in data, which must have room for
+		/// decodedLength(length) bytes.
+		///
+		/// Returns the number of bytes written.
+		///
+		/// Throws a DataFormatException if length is not a multiple
+		/// of four, if encoded contains characters outside of the
+		/// Base64 alphabet, or if padding appears anywhere but
+		/// at the end.
+
+	static std::size_t decode(const char* encoded, std::size_t length, void* data, Implementation impl);
+		/// Decodes length characters from encoded, using the
+		/// given implementation.
+		///
+		/// Throws an InvalidArgumentException if the processor
+		/// does not support the implementation.
+
+	static std::string decode(const std::string& encoded);
+		/// Returns the decoding of the given characters.
+
+	static Implementation implementation();
+		/// Returns the implementation used by encode() and
+		/// decode(), which is the best one the processor supports.
+
+	static bool isSupported(Implementation impl);
+		/// Returns true if the processor supports the given implementation.
+
+	static const char* name(Implementation impl);
+		/// Returns the name of the given implementation.
+
+private:
+	Base64Codec();
+};
+
+
+//
+// inlines
+//
+inline std::size_t Base64Codec::encodedLength(std::size_t length)
+{
+	return 4*((length + 2)/3);
+}
+
+
+inline std::size_t Base64Codec::decodedLength(std::size_t length)
+{
+	return 3*(length/4);
+}
+
+
+inline std::size_t Base64Codec::encode(const void* data, std::size_t length, char* encoded)
+{
+	return encode(data, length, encoded, implementation());
+}
+
+
+inline std::size_t Base64Codec::decode(const char* encoded, std::size_t length, void* data)
+{
+	return decode(encoded, length, data, implementation());
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_Base64Codec_INCLUDED
@@ -37,6 +37,10 @@ class Foundation_API Base64DecoderBuf: public UnbufferedStreamBuf
 	/// underlying streambuf, so the state
 	/// of the istream will not reflect that of
 	/// its streambuf.
+	///
+	/// Data read in blocks (for example, with
+	/// std::istream::read()) is decoded with Base64Codec,
+	/// many groups at a time.
 {
 public:
 	Base64DecoderBuf(std::istream& istr);
@@ -45,6 +49,13 @@ public:
 private:
 	int readFromDevice();
 	int readOne();
+	std::streamsize xsgetn(char* s, std::streamsize count);
+	std::size_t decodeBlock(const char* encoded, std::size_t length, char* data);
+
+	enum
+	{
+		BUFFER_SIZE = 4096
+	};
 
 	unsigned char   _group[3];
 	int             _groupLength;
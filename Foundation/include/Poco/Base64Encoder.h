@@ -37,6 +37,10 @@ class Foundation_API Base64EncoderBuf: public UnbufferedStreamBuf
 	/// to the ostream's streambuf, thus bypassing
 	/// the ostream. The ostream's state is therefore
 	/// not updated to match the buffer's state.
+	///
+	/// Data written in blocks (for example, with
+	/// std::ostream::write()) is encoded with Base64Codec,
+	/// many groups at a time.
 {
 public:
 	Base64EncoderBuf(std::ostream& ostr);
@@ -58,6 +62,12 @@ public:
 	
 private:
 	int writeToDevice(char c);
+	std::streamsize xsputn(const char* s, std::streamsize count);
+
+	enum
+	{
+		BUFFER_SIZE = 4096
+	};
 
 	unsigned char   _group[3];
 	int             _groupLength;
@@ -0,0 +1,169 @@
+//
+// BatchStore.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  BatchStore
+//
+// Definition of the BatchStore template class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_BatchStore_INCLUDED
+#define Foundation_BatchStore_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/AtomicCounter.h"
+
+
+namespace Poco {
+
+
+template <class B>
+class BatchStore
+	/// A fixed number of slots, each of which can hold a pointer
+	/// to a batch of objects, for use by many threads at once.
+	/// Slots are claimed with compare-and-set operations, so no
+	/// thread ever waits for another one.
+	///
+	/// BatchStore is the central store of ThreadCachingMemoryPool
+	/// and ConcurrentObjectPool. It does not own the batches.
+{
+public:
+	explicit BatchStore(int slotCount):
+		/// Creates a BatchStore with the given number of slots.
+		_slotCount(slotCount),
+		_slots(new Slot[slotCount])
+	{
+		for (int i = 0; i < _slotCount; ++i)
+		{
+			_slots[i].pBatch = 0;
+		}
+	}
+
+	~BatchStore()
+		/// Destroys the BatchStore. Batches still in
+		/// the store must be taken out by the owner.
+	{
+		delete [] _slots;
+	}
+
+	bool push(B* pBatch)
+		/// Puts the batch into an empty slot. Returns false
+		/// if there is none.
+	{
+		for (int i = 0; i < _slotCount; ++i)
+		{
+			Slot& slot = _slots[i];
+			if (slot.state.value() == Slot::EMPTY && slot.state.compareAndSet(Slot::EMPTY, Slot::BUSY))
+			{
+				slot.pBatch = pBatch;
+				// compareAndSet() is a full barrier, so the batch
+				// pointer is visible before the slot is.
+				slot.state.compareAndSet(Slot::BUSY, Slot::FULL);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	B* pop()
+		/// Takes a batch out of the store.
+		/// Returns null if there is none.
+	{
+		for (int i = 0; i < _slotCount; ++i)
+		{
+			B* pBatch = claim(i);
+			if (pBatch)
+			{
+				unclaim(i, 0);
+				return pBatch;
+			}
+		}
+		return 0;
+	}
+
+	B* claim(int index)
+		/// Claims the slot with the given index and returns its
+		/// batch, which the caller may then modify or replace.
+		/// The slot must be given back with unclaim().
+		///
+		/// Returns null, without claiming the slot, if the slot
+		/// is empty or has been claimed by another thread.
+	{
+		poco_assert_dbg (index >= 0 && index < _slotCount);
+
+		Slot& slot = _slots[index];
+		if (slot.state.value() == Slot::FULL && slot.state.compareAndSet(Slot::FULL, Slot::BUSY))
+		{
+			return slot.pBatch;
+		}
+		return 0;
+	}
+
+	void unclaim(int index, B* pBatch)
+		/// Gives back a slot claimed with claim(). The slot then
+		/// holds the given batch, or is empty if pBatch is null.
+	{
+		poco_assert_dbg (index >= 0 && index < _slotCount);
+
+		Slot& slot = _slots[index];
+		slot.pBatch = pBatch;
+		slot.state.compareAndSet(Slot::BUSY, pBatch ? Slot::FULL : Slot::EMPTY);
+	}
+
+	int slotCount() const
+		/// Returns the number of slots.
+	{
+		return _slotCount;
+	}
+
+	static int add(AtomicCounter& counter, int n)
+		/// Adds n to counter and returns the new value.
+		/// Used by the owners to count the objects in the store.
+	{
+		AtomicCounter::ValueType value;
+		do
+		{
+			value = counter.value();
+		}
+		while (!counter.compareAndSet(value, value + n));
+		return value + n;
+	}
+
+private:
+	BatchStore();
+	BatchStore(const BatchStore&);
+	BatchStore& operator = (const BatchStore&);
+
+	struct Slot
+	{
+		enum State
+		{
+			EMPTY,
+			BUSY,
+			FULL
+		};
+
+		AtomicCounter state;
+		B*            pBatch;
+		char          pad[64];
+	};
+
+	int   _slotCount;
+	Slot* _slots;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_BatchStore_INCLUDED
@@ -0,0 +1,200 @@
+//
+// BoundedNotificationQueue.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  BoundedNotificationQueue
+//
+// Definition of the BoundedNotificationQueue class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_BoundedNotificationQueue_INCLUDED
+#define Foundation_BoundedNotificationQueue_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Notification.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/Semaphore.h"
+
+
+namespace Poco {
+
+
+class NotificationCenter;
+
+
+class Foundation_API BoundedNotificationQueue
+	/// A BoundedNotificationQueue is a fixed-capacity alternative
+	/// to NotificationQueue for use with many concurrent producers
+	/// and consumers.
+	///
+	/// Notifications are kept in a ring buffer whose slots are
+	/// claimed with atomic compare-and-set operations (see
+	/// AtomicCounter::compareAndSet()), so enqueueing and dequeueing
+	/// never take a lock on platforms that have atomic primitives.
+	/// The capacity is rounded up to the next power of two.
+	///
+	/// Threads that have to wait, either for a notification or,
+	/// if the queue is full, for a free slot, register in a counter
+	/// and sleep on a single shared Semaphore. Producers and
+	/// consumers only touch the Semaphore if the counter shows that
+	/// a thread is actually waiting, so no synchronization object
+	/// is created per waiting thread and none is used while the
+	/// queue is busy.
+	///
+	/// Unlike NotificationQueue, a BoundedNotificationQueue is strictly
+	/// FIFO. It does not support urgent notifications or removing
+	/// a given notification.
+	///
+	/// See NotificationQueue for the recommended way to shut down
+	/// a queue with worker threads waiting for notifications.
+{
+public:
+	explicit BoundedNotificationQueue(int capacity = 1024);
+		/// Creates the BoundedNotificationQueue with room for
+		/// at least the given number of notifications.
+
+	~BoundedNotificationQueue();
+		/// Destroys the BoundedNotificationQueue.
+
+	void enqueueNotification(Notification::Ptr pNotification);
+		/// Enqueues the given notification by adding it to
+		/// the end of the queue (FIFO). If the queue is full,
+		/// waits until a slot becomes available.
+		/// The queue takes ownership of the notification, thus
+		/// a call like
+		///     notificationQueue.enqueueNotification(new MyNotification);
+		/// does not result in a memory leak.
+
+	bool tryEnqueueNotification(Notification::Ptr pNotification);
+		/// Enqueues the given notification by adding it to
+		/// the end of the queue (FIFO).
+		/// Returns false if the queue is full.
+
+	Notification* dequeueNotification();
+		/// Dequeues the next pending notification.
+		/// Returns 0 (null) if no notification is available.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+		///
+		/// It is highly recommended that the result is immediately
+		/// assigned to a Notification::Ptr, to avoid potential
+		/// memory management issues.
+
+	Notification* waitDequeueNotification();
+		/// Dequeues the next pending notification.
+		/// If no notification is available, waits for a notification
+		/// to be enqueued.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+		/// This method returns 0 (null) if wakeUpAll()
+		/// has been called by another thread.
+		///
+		/// It is highly recommended that the result is immediately
+		/// assigned to a Notification::Ptr, to avoid potential
+		/// memory management issues.
+
+	Notification* waitDequeueNotification(long milliseconds);
+		/// Dequeues the next pending notification.
+		/// If no notification is available, waits for a notification
+		/// to be enqueued up to the specified time.
+		/// Returns 0 (null) if no notification is available.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+		///
+		/// It is highly recommended that the result is immediately
+		/// assigned to a Notification::Ptr, to avoid potential
+		/// memory management issues.
+
+	void dispatch(NotificationCenter& notificationCenter);
+		/// Dispatches all queued notifications to the given
+		/// notification center.
+
+	void wakeUpAll();
+		/// Wakes up all threads that wait for a notification.
+
+	bool empty() const;
+		/// Returns true iff the queue is empty.
+
+	int size() const;
+		/// Returns the number of notifications in the queue.
+		/// The result is only a snapshot if other threads
+		/// use the queue at the same time.
+
+	int capacity() const;
+		/// Returns the maximum number of notifications
+		/// the queue can hold.
+
+	void clear();
+		/// Removes all notifications from the queue.
+
+	bool hasIdleThreads() const;
+		/// Returns true if the queue has at least one thread waiting
+		/// for a notification.
+
+protected:
+	bool push(Notification* pNotification);
+	Notification* pop();
+	static bool claim(AtomicCounter& waiters);
+	static void wakeOne(AtomicCounter& waiters, Semaphore& sema);
+	static void cancelWait(AtomicCounter& waiters, Semaphore& sema);
+
+private:
+	BoundedNotificationQueue(const BoundedNotificationQueue&);
+	BoundedNotificationQueue& operator = (const BoundedNotificationQueue&);
+
+	enum
+	{
+		CACHE_LINE_SIZE = 64
+	};
+
+	struct Cell
+	{
+		AtomicCounter sequence;
+		Notification* pNf;
+	};
+
+	int           _capacity;
+	int           _mask;
+	Cell*         _cells;
+	char          _pad1[CACHE_LINE_SIZE];
+	AtomicCounter _enqueuePos;
+	char          _pad2[CACHE_LINE_SIZE];
+	AtomicCounter _dequeuePos;
+	char          _pad3[CACHE_LINE_SIZE];
+	AtomicCounter _consumers;
+	Semaphore     _consumerSema;
+	AtomicCounter _producers;
+	Semaphore     _producerSema;
+	AtomicCounter _wakeUps;
+};
+
+
+//
+// inlines
+//
+inline int BoundedNotificationQueue::capacity() const
+{
+	return _capacity;
+}
+
+
+inline bool BoundedNotificationQueue::hasIdleThreads() const
+{
+	return _consumers.value() > 0;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_BoundedNotificationQueue_INCLUDED
@@ -0,0 +1,93 @@
+//
+// CPUFeatures.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  CPUFeatures
+//
+// Definition of the CPUFeatures class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_CPUFeatures_INCLUDED
+#define Foundation_CPUFeatures_INCLUDED
+
+
+#include "Poco/Foundation.h"
+
+
+//
+// POCO_X86_SIMD is defined if the compiler can build functions using
+// SSE and AVX intrinsics for x86 or x86_64 processors, whatever the
+// target architecture level of the rest of the code. Such functions
+// must be marked with POCO_SIMD_TARGET and must only be called after
+// checking CPUFeatures.
+//
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && (defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+	#define POCO_X86_SIMD
+	#define POCO_SIMD_TARGET(t) __attribute__((target(t)))
+#elif defined(_MSC_VER) && _MSC_VER >= 1700 && (defined(_M_X64) || defined(_M_IX86))
+	#define POCO_X86_SIMD
+	#define POCO_SIMD_TARGET(t)
+#endif
+
+
+namespace Poco {
+
+
+class Foundation_API CPUFeatures
+	/// CPUFeatures tells which optional instruction set
+	/// extensions the processor supports. Support for
+	/// extensions that need operating system support
+	/// (such as AVX2) is only reported if the operating
+	/// system supports them, too.
+	///
+	/// The processor is queried once, when one of the
+	/// member functions is first called.
+{
+public:
+	static bool hasSSSE3();
+		/// Returns true if the processor supports SSSE3.
+
+	static bool hasAVX2();
+		/// Returns true if the processor supports AVX2.
+
+private:
+	CPUFeatures();
+
+	enum
+	{
+		FEATURE_SSSE3 = 0x01,
+		FEATURE_AVX2  = 0x02
+	};
+
+	static int features();
+};
+
+
+//
+// inlines
+//
+inline bool CPUFeatures::hasSSSE3()
+{
+	return (features() & FEATURE_SSSE3) != 0;
+}
+
+
+inline bool CPUFeatures::hasAVX2()
+{
+	return (features() & FEATURE_AVX2) != 0;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_CPUFeatures_INCLUDED
@@ -0,0 +1,114 @@
+//
+// CPUTopology.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Threading
+// Module:  CPUTopology
+//
+// Definition of the CPUTopology class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_CPUTopology_INCLUDED
+#define Foundation_CPUTopology_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include <vector>
+
+
+namespace Poco {
+
+
+class Foundation_API CPUTopology
+	/// CPUTopology describes how the processors of the system
+	/// are grouped into NUMA nodes.
+	///
+	/// On Linux, the topology is read from sysfs
+	/// (/sys/devices/system/node/node<n>/cpulist). On other
+	/// systems, or if sysfs does not provide the information,
+	/// all processors form a single node.
+	///
+	/// The class also provides the platform specific functions
+	/// needed to keep threads on the processors of a node.
+{
+public:
+	typedef std::vector<int> CPUSet;
+		/// A sorted list of processor numbers.
+
+	CPUTopology();
+		/// Creates the CPUTopology for the system.
+
+	explicit CPUTopology(const std::string& nodePath);
+		/// Creates the CPUTopology from the given directory,
+		/// which must have the same layout as
+		/// /sys/devices/system/node.
+
+	~CPUTopology();
+		/// Destroys the CPUTopology.
+
+	int nodeCount() const;
+		/// Returns the number of NUMA nodes that have processors.
+
+	const CPUSet& nodeCPUs(int node) const;
+		/// Returns the processors of the given node.
+		/// Nodes are numbered from 0 to nodeCount() - 1,
+		/// in the order of their system numbers.
+
+	int nodeOf(int cpu) const;
+		/// Returns the node the given processor belongs to,
+		/// or -1 if the processor is unknown.
+
+	static int currentCPU();
+		/// Returns the number of the processor the calling thread
+		/// is running on, or -1 if this cannot be determined.
+		///
+		/// The result is only a hint, as the thread may be moved
+		/// to another processor at any time.
+
+	static void bindCurrentThread(const CPUSet& cpus);
+		/// Restricts the calling thread to the given processors.
+		/// If cpus is empty, the thread may run on all processors.
+		///
+		/// Does nothing on platforms that do not support binding a
+		/// thread to a set of processors. Throws a SystemException
+		/// if binding fails.
+
+	static CPUSet parseCPUList(const std::string& list);
+		/// Parses a processor list in the format used by Linux,
+		/// for example "0-3,8,10-11", and returns the sorted list
+		/// of processors.
+		///
+		/// Throws a SyntaxException if the list is not valid.
+
+protected:
+	void load(const std::string& nodePath);
+	void addNode(const CPUSet& cpus);
+	static int parseCPU(std::string::const_iterator& it, std::string::const_iterator end, const std::string& list);
+
+private:
+	std::vector<CPUSet> _nodes;
+	std::vector<int>    _cpuNode;
+};
+
+
+//
+// inlines
+//
+inline int CPUTopology::nodeCount() const
+{
+	return static_cast<int>(_nodes.size());
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_CPUTopology_INCLUDED
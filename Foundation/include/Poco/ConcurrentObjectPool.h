@@ -0,0 +1,751 @@
+//
+// ConcurrentObjectPool.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  ConcurrentObjectPool
+//
+// Definition of the ConcurrentObjectPool template class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_ConcurrentObjectPool_INCLUDED
+#define Foundation_ConcurrentObjectPool_INCLUDED
+
+
+#include "Poco/ObjectPool.h"
+#include "Poco/RefCountedObject.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/BatchStore.h"
+#include "Poco/ThreadLocal.h"
+#include "Poco/Thread.h"
+#include "Poco/Mutex.h"
+#include "Poco/Activity.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Semaphore.h"
+#include "Poco/Event.h"
+#include "Poco/Timestamp.h"
+#include <vector>
+#include <algorithm>
+
+
+namespace Poco {
+
+
+template <class C, class P = C*, class F = PoolableObjectFactory<C, P> >
+class ConcurrentObjectPool
+	/// A ConcurrentObjectPool is an ObjectPool for use by many
+	/// threads at once. It uses the same PoolableObjectFactory
+	/// policy and has the same capacity semantics, but borrowing
+	/// and returning objects normally does not lock.
+	///
+	/// Every thread keeps a small cache (a "magazine") of idle
+	/// objects, so most calls to borrowObject() and returnObject()
+	/// do not touch memory shared with other threads. When its cache
+	/// runs empty, a thread takes a whole batch of objects from a
+	/// central store; when the cache holds two batches, the thread
+	/// gives one back. The central store is a BatchStore, as in
+	/// ThreadCachingMemoryPool. Up to capacity idle objects are kept
+	/// in the central store; objects that do not fit are destroyed.
+	///
+	/// A thread that finds neither an idle object nor room for a new
+	/// one below peak capacity moves the idle objects of all thread
+	/// caches that are not in use to the central store, and then
+	/// waits on a semaphore. While a thread waits, returned objects
+	/// and the caches of threads that borrow or return objects go
+	/// directly to the central store, so that no idle object stays
+	/// in a thread's cache.
+	///
+	/// Only threads started with Poco::Thread have their own cache.
+	/// All other threads, including the main thread, share a single
+	/// cache. A thread that finds its cache in use by another thread
+	/// works with the central store directly.
+	///
+	/// startMaintenance() starts a background activity that keeps at
+	/// least a given number of idle objects in the central store,
+	/// so that a burst of borrowers does not have to create objects
+	/// itself. The activity also validates the idle objects in the
+	/// central store, and while it is running, returnObject() does
+	/// not call validateObject(). Objects that stay in a thread's
+	/// cache are validated once they move to the central store.
+	///
+	/// A thread's cache is returned to the central store when the
+	/// thread's thread local storage is cleared (see
+	/// ThreadCachingMemoryPool), or when the thread calls flush().
+	/// Objects still held in thread caches when the pool is destroyed
+	/// are destroyed when these threads give them back.
+{
+public:
+	ConcurrentObjectPool(std::size_t capacity, std::size_t peakCapacity, int magazineSize = 8):
+		/// Creates a new ConcurrentObjectPool with the given capacity,
+		/// peak capacity and number of objects exchanged between
+		/// thread caches and the central store at once.
+		///
+		/// The PoolableObjectFactory must have a public default constructor.
+		_pDepot(new Depot(F(), capacity, peakCapacity, magazineSize)),
+		_maintenance(this, &ConcurrentObjectPool::maintain),
+		_lowWatermark(0),
+		_interval(0)
+	{
+		poco_assert (capacity <= peakCapacity && magazineSize > 0);
+
+		_sharedCache.pDepot = _pDepot;
+		_pDepot->addCache(&_sharedCache);
+	}
+
+	ConcurrentObjectPool(const F& factory, std::size_t capacity, std::size_t peakCapacity, int magazineSize = 8):
+		/// Creates a new ConcurrentObjectPool with the given
+		/// PoolableObjectFactory, capacity, peak capacity and
+		/// magazine size. The PoolableObjectFactory must have
+		/// a public copy constructor.
+		_pDepot(new Depot(factory, capacity, peakCapacity, magazineSize)),
+		_maintenance(this, &ConcurrentObjectPool::maintain),
+		_lowWatermark(0),
+		_interval(0)
+	{
+		poco_assert (capacity <= peakCapacity && magazineSize > 0);
+
+		_sharedCache.pDepot = _pDepot;
+		_pDepot->addCache(&_sharedCache);
+	}
+
+	~ConcurrentObjectPool()
+		/// Stops the maintenance activity and destroys the
+		/// ConcurrentObjectPool.
+	{
+		try
+		{
+			stopMaintenance();
+			flush();
+		}
+		catch (...)
+		{
+			poco_unexpected();
+		}
+	}
+
+	P borrowObject(long timeoutMilliseconds = 0)
+		/// Obtains an object from the calling thread's cache or the
+		/// central store, or creates a new object if peak capacity
+		/// has not been reached yet.
+		///
+		/// Returns null if no object is available after timeout.
+		///
+		/// If activating the object fails, the object is destroyed and
+		/// the exception is passed on to the caller.
+	{
+		P pObject;
+		if (takeObject(pObject)) return activateObject(pObject);
+		if (_pDepot->reserve()) return createObject();
+		bool reserved = false;
+		if (!waitObject(pObject, reserved, timeoutMilliseconds)) return 0;
+		return reserved ? createObject() : activateObject(pObject);
+	}
+
+	void returnObject(P pObject)
+		/// Returns an object to the pool.
+	{
+		Depot& d = *_pDepot;
+		if (!d.validateInBackground.value() && !d.factory.validateObject(pObject))
+		{
+			d.destroyObject(pObject);
+			return;
+		}
+		d.factory.deactivateObject(pObject);
+		if (d.waiters.value() == 0)
+		{
+			Cache* pCache = lockCache();
+			if (pCache)
+			{
+				try
+				{
+					pCache->release(pObject);
+				}
+				catch (...)
+				{
+					unlockCache(*pCache);
+					throw;
+				}
+				unlockCache(*pCache);
+				return;
+			}
+		}
+		d.push(new Batch(1, pObject));
+	}
+
+	void flush()
+		/// Returns all objects in the calling thread's cache
+		/// to the central store.
+	{
+		currentCache().tryFlush();
+	}
+
+	void startMaintenance(std::size_t lowWatermark, long intervalMilliseconds = 1000)
+		/// Starts a background activity that creates idle objects
+		/// whenever there are less than lowWatermark of them in
+		/// the central store (up to peak capacity), and validates
+		/// the idle objects every intervalMilliseconds.
+		///
+		/// While the activity is running, returned objects are
+		/// no longer validated in returnObject().
+	{
+		poco_assert (lowWatermark <= capacity());
+
+		_lowWatermark = lowWatermark;
+		_interval = intervalMilliseconds;
+		_pDepot->validateInBackground = 1;
+		_maintenance.start();
+		_wakeUp.set();
+	}
+
+	void stopMaintenance()
+		/// Stops the maintenance activity and waits for it
+		/// to finish.
+	{
+		if (_maintenance.isRunning())
+		{
+			_maintenance.stop();
+			_wakeUp.set();
+			_maintenance.wait();
+		}
+		_pDepot->validateInBackground = 0;
+	}
+
+	std::size_t capacity() const
+	{
+		return _pDepot->capacity;
+	}
+
+	std::size_t peakCapacity() const
+	{
+		return _pDepot->peakCapacity;
+	}
+
+	int magazineSize() const
+	{
+		return _pDepot->magazineSize;
+	}
+
+	std::size_t size() const
+		/// Returns the number of objects that currently exist,
+		/// including borrowed objects and objects in thread caches.
+	{
+		return _pDepot->size.value();
+	}
+
+	std::size_t idle() const
+		/// Returns the number of idle objects in the central store.
+		/// Objects in thread caches are not included.
+	{
+		return _pDepot->idle.value();
+	}
+
+protected:
+	typedef std::vector<P> Batch;
+	typedef BatchStore<Batch> Store;
+
+	class Cache;
+
+	class Depot: public RefCountedObject
+		/// The factory and the central store, shared with the thread
+		/// caches, which may outlive the pool.
+	{
+	public:
+		Depot(const F& f, std::size_t cap, std::size_t peakCap, int magSize):
+			factory(f),
+			capacity(cap),
+			peakCapacity(peakCap),
+			magazineSize(magSize),
+			sema(0, 0x7FFFFFFF),
+			_store(static_cast<int>(cap))
+		{
+		}
+
+		Batch* pop()
+			/// Takes a batch of idle objects from the central store.
+			/// Returns null if there is none.
+		{
+			if (idle.value() <= 0) return 0;
+
+			Batch* pBatch = _store.pop();
+			if (pBatch) Store::add(idle, -static_cast<int>(pBatch->size()));
+			return pBatch;
+		}
+
+		void push(Batch* pBatch)
+			/// Adds a batch of idle objects to the central store.
+			/// Objects exceeding capacity are destroyed.
+		{
+			int n = static_cast<int>(pBatch->size());
+			int room = static_cast<int>(capacity) - Store::add(idle, n) + n;
+			if (room < n)
+			{
+				int excess = n - (room > 0 ? room : 0);
+				Store::add(idle, -excess);
+				for (int i = 0; i < excess; ++i)
+				{
+					destroyObject(pBatch->back());
+					pBatch->pop_back();
+				}
+			}
+			if (!pBatch->empty())
+			{
+				if (_store.push(pBatch))
+				{
+					wakeUp();
+					return;
+				}
+				Store::add(idle, -static_cast<int>(pBatch->size()));
+				for (typename Batch::iterator it = pBatch->begin(); it != pBatch->end(); ++it)
+				{
+					destroyObject(*it);
+				}
+			}
+			delete pBatch;
+		}
+
+		bool take(P& pObject)
+			/// Takes a single idle object from the central store.
+			/// Returns false if there is none.
+		{
+			Batch* pBatch = pop();
+			if (!pBatch) return false;
+			pObject = pBatch->back();
+			pBatch->pop_back();
+			if (pBatch->empty())
+				delete pBatch;
+			else
+				push(pBatch);
+			return true;
+		}
+
+		void sweep()
+			/// Validates the idle objects in the central store
+			/// and destroys the invalid ones.
+		{
+			for (int i = 0; i < _store.slotCount(); ++i)
+			{
+				Batch* pBatch = _store.claim(i);
+				if (!pBatch) continue;
+
+				std::size_t n = 0;
+				for (std::size_t k = 0; k < pBatch->size(); ++k)
+				{
+					if (factory.validateObject((*pBatch)[k]))
+						(*pBatch)[n++] = (*pBatch)[k];
+					else
+						destroyObject((*pBatch)[k]);
+				}
+				Store::add(idle, static_cast<int>(n) - static_cast<int>(pBatch->size()));
+				pBatch->resize(n);
+				if (n == 0)
+				{
+					delete pBatch;
+					pBatch = 0;
+				}
+				_store.unclaim(i, pBatch);
+			}
+		}
+
+		bool reserve()
+			/// Reserves room for a new object.
+			/// Returns false if peak capacity has been reached.
+		{
+			AtomicCounter::ValueType n;
+			do
+			{
+				n = size.value();
+				if (n >= static_cast<AtomicCounter::ValueType>(peakCapacity)) return false;
+			}
+			while (!size.compareAndSet(n, n + 1));
+			return true;
+		}
+
+		void unreserve()
+			/// Gives back room reserved with reserve().
+		{
+			--size;
+			wakeUp();
+		}
+
+		void destroyObject(P pObject)
+		{
+			factory.destroyObject(pObject);
+			unreserve();
+		}
+
+		void wakeUp()
+			/// Wakes up a thread waiting in borrowObject(), if any.
+		{
+			if (waiters.value() > 0) sema.set();
+		}
+
+		void addCache(Cache* pCache)
+		{
+			FastMutex::ScopedLock lock(_cacheMutex);
+
+			_caches.push_back(pCache);
+		}
+
+		void removeCache(Cache* pCache)
+		{
+			FastMutex::ScopedLock lock(_cacheMutex);
+
+			typename std::vector<Cache*>::iterator it = std::find(_caches.begin(), _caches.end(), pCache);
+			if (it != _caches.end()) _caches.erase(it);
+		}
+
+		void reclaim()
+			/// Moves the idle objects of all thread caches
+			/// that are not in use to the central store.
+		{
+			FastMutex::ScopedLock lock(_cacheMutex);
+
+			for (typename std::vector<Cache*>::iterator it = _caches.begin(); it != _caches.end(); ++it)
+			{
+				(*it)->tryFlush();
+			}
+		}
+
+		F             factory;
+		std::size_t   capacity;
+		std::size_t   peakCapacity;
+		int           magazineSize;
+		AtomicCounter size;
+		AtomicCounter idle;
+		AtomicCounter waiters;
+		AtomicCounter validateInBackground;
+		Semaphore     sema;
+
+	protected:
+		~Depot()
+		{
+			try
+			{
+				while (Batch* pBatch = _store.pop())
+				{
+					for (typename Batch::iterator it = pBatch->begin(); it != pBatch->end(); ++it)
+					{
+						factory.destroyObject(*it);
+					}
+					delete pBatch;
+				}
+			}
+			catch (...)
+			{
+				poco_unexpected();
+			}
+		}
+
+	private:
+		Store               _store;
+		std::vector<Cache*> _caches;
+		FastMutex           _cacheMutex;
+	};
+
+	class Cache
+		/// A thread's cache of idle objects.
+	{
+	public:
+		Cache()
+		{
+		}
+
+		~Cache()
+		{
+			if (!pDepot) return;
+
+			try
+			{
+				pDepot->removeCache(this);
+				flush();
+			}
+			catch (...)
+			{
+				poco_unexpected();
+			}
+		}
+
+		bool tryLock()
+			/// Claims the cache for the calling thread.
+			/// Returns false, without waiting, if the
+			/// cache is in use by another thread.
+		{
+			return _busy.compareAndSet(0, 1);
+		}
+
+		void unlock()
+		{
+			_busy.compareAndSet(1, 0);
+		}
+
+		bool take(P& pObject)
+			/// Takes an object from the cache, which is refilled from
+			/// the central store if it is empty. Returns false if
+			/// there is no idle object.
+		{
+			if (objects.empty())
+			{
+				Batch* pBatch = pDepot->pop();
+				if (!pBatch) return false;
+				objects.swap(*pBatch);
+				delete pBatch;
+			}
+			pObject = objects.back();
+			objects.pop_back();
+			return true;
+		}
+
+		void release(P pObject)
+		{
+			objects.push_back(pObject);
+			std::size_t magazineSize = pDepot->magazineSize;
+			if (objects.size() >= 2*magazineSize)
+			{
+				// Keep one batch, give the other one back.
+				Batch* pBatch = new Batch(objects.begin() + magazineSize, objects.end());
+				objects.resize(magazineSize);
+				pDepot->push(pBatch);
+			}
+		}
+
+		void flush()
+		{
+			if (objects.empty()) return;
+			Batch* pBatch = new Batch;
+			pBatch->swap(objects);
+			pDepot->push(pBatch);
+		}
+
+		void tryFlush()
+			/// Flushes the cache, unless it is in use
+			/// by another thread.
+		{
+			if (!tryLock()) return;
+			try
+			{
+				flush();
+			}
+			catch (...)
+			{
+				unlock();
+				throw;
+			}
+			unlock();
+		}
+
+		Batch          objects;
+		AutoPtr<Depot> pDepot;
+
+	private:
+		Cache(const Cache&);
+		Cache& operator = (const Cache&);
+
+		AtomicCounter _busy;
+	};
+
+	Cache& cache()
+	{
+		Cache& c = *_cache;
+		if (!c.pDepot)
+		{
+			c.pDepot = _pDepot;
+			_pDepot->addCache(&c);
+		}
+		return c;
+	}
+
+	Cache& currentCache()
+	{
+		// The thread local storage of threads that are not
+		// Poco threads is shared, so they use the shared cache.
+		return Thread::current() ? cache() : _sharedCache;
+	}
+
+	Cache* lockCache()
+		/// Returns the calling thread's cache, claimed with
+		/// Cache::tryLock(), or null if it is in use.
+	{
+		Cache& c = currentCache();
+		return c.tryLock() ? &c : 0;
+	}
+
+	void unlockCache(Cache& c)
+	{
+		c.unlock();
+		// Do not keep idle objects while a thread waits. A waiter
+		// that found the cache in use has been registered before
+		// unlock(), so it is not missed here.
+		if (_pDepot->waiters.value() > 0) c.tryFlush();
+	}
+
+	bool takeObject(P& pObject)
+		/// Takes an idle object from the calling thread's
+		/// cache or the central store.
+	{
+		Cache* pCache = lockCache();
+		if (!pCache) return _pDepot->take(pObject);
+
+		bool found = pCache->take(pObject);
+		unlockCache(*pCache);
+		return found;
+	}
+
+	P createObject()
+		/// Creates and activates a new object. Room for it
+		/// must have been reserved.
+	{
+		Depot& d = *_pDepot;
+		P pObject;
+		try
+		{
+			pObject = d.factory.createObject();
+		}
+		catch (...)
+		{
+			d.unreserve();
+			throw;
+		}
+		if (d.validateInBackground.value()) _wakeUp.set();
+		return activateObject(pObject);
+	}
+
+	P activateObject(P pObject)
+	{
+		try
+		{
+			_pDepot->factory.activateObject(pObject);
+		}
+		catch (...)
+		{
+			_pDepot->destroyObject(pObject);
+			throw;
+		}
+		return pObject;
+	}
+
+	bool waitObject(P& pObject, bool& reserved, long timeoutMilliseconds)
+		/// Waits until either an idle object has been taken from
+		/// the central store, or room for a new object has been
+		/// reserved, in which case reserved is set to true.
+	{
+		Depot& d = *_pDepot;
+		Timestamp start;
+		Timestamp::TimeDiff timeout = Timestamp::TimeDiff(timeoutMilliseconds)*1000;
+		++d.waiters;
+		bool ok = false;
+		try
+		{
+			// Caches that are in use now are flushed by their
+			// threads, as there is a waiter.
+			d.reclaim();
+			for (;;)
+			{
+				// Check again after registering, as an object
+				// may have been returned in the meantime.
+				if (d.take(pObject))
+				{
+					ok = true;
+					break;
+				}
+				if (d.reserve())
+				{
+					ok = reserved = true;
+					break;
+				}
+				Timestamp::TimeDiff remaining = timeout - start.elapsed();
+				if (remaining <= 0 || !d.sema.tryWait(static_cast<long>((remaining + 999)/1000))) break;
+			}
+		}
+		catch (...)
+		{
+			--d.waiters;
+			throw;
+		}
+		--d.waiters;
+		return ok;
+	}
+
+	void maintain()
+	{
+		Depot& d = *_pDepot;
+		while (!_maintenance.isStopped())
+		{
+			try
+			{
+				d.sweep();
+				while (!_maintenance.isStopped() && d.idle.value() < static_cast<int>(_lowWatermark))
+				{
+					Batch* pBatch = new Batch;
+					try
+					{
+						while (pBatch->size() < static_cast<std::size_t>(d.magazineSize) &&
+						       d.idle.value() + static_cast<int>(pBatch->size()) < static_cast<int>(_lowWatermark) &&
+						       d.reserve())
+						{
+							try
+							{
+								pBatch->push_back(d.factory.createObject());
+							}
+							catch (...)
+							{
+								d.unreserve();
+								throw;
+							}
+						}
+					}
+					catch (...)
+					{
+						d.push(pBatch);
+						throw;
+					}
+					if (pBatch->empty())
+					{
+						delete pBatch;
+						break;
+					}
+					d.push(pBatch);
+				}
+			}
+			catch (Poco::Exception& exc)
+			{
+				ErrorHandler::handle(exc);
+			}
+			catch (std::exception& exc)
+			{
+				ErrorHandler::handle(exc);
+			}
+			catch (...)
+			{
+				ErrorHandler::handle();
+			}
+			_wakeUp.tryWait(_interval);
+		}
+	}
+
+private:
+	ConcurrentObjectPool();
+	ConcurrentObjectPool(const ConcurrentObjectPool&);
+	ConcurrentObjectPool& operator = (const ConcurrentObjectPool&);
+
+	AutoPtr<Depot>                 _pDepot;
+	ThreadLocal<Cache>             _cache;
+	Cache                          _sharedCache;
+	Activity<ConcurrentObjectPool> _maintenance;
+	Event                          _wakeUp;
+	std::size_t                    _lowWatermark;
+	long                           _interval;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ConcurrentObjectPool_INCLUDED
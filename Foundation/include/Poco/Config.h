@@ -82,23 +82,34 @@
 // candidates) will be auto-allocated on the stack in 
 // cases when value holder fits into POCO_SMALL_OBJECT_SIZE
 // (see below).
-// 
-// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-// !!! NOTE: Any/Dynamic::Var SOO will NOT work reliably   !!!
-// !!! without C++11 (std::aligned_storage in particular). !!!
-// !!! Only comment this out if your compiler has support  !!!
-// !!! for std::aligned_storage.                           !!!
-// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-// 
-#define POCO_NO_SOO
+// #define POCO_NO_SOO
 
 
 // Small object size in bytes. When assigned to Any or Var,
 // objects larger than this value will be alocated on the heap,
 // while those smaller will be placement new-ed into an
-// internal buffer.
+// internal buffer. The default leaves room for the value
+// holder's vtable pointer and a std::string, so that numbers
+// and short strings never cause a heap allocation.
 #if !defined(POCO_SMALL_OBJECT_SIZE) && !defined(POCO_NO_SOO)
-	#define POCO_SMALL_OBJECT_SIZE 32
+	#define POCO_SMALL_OBJECT_SIZE 40
+#endif
+
+
+// Define to prevent ThreadLocal from caching each thread's
+// storage in a native (compiler supported) thread local
+// variable.
+// #define POCO_NO_THREAD_LOCAL
+
+
+// Define to count heap and memory pool allocations
+// by component (Net, JSON, Data, XML, Logging).
+// Replaces the global operator new and operator delete,
+// so on Windows this requires static libraries (POCO_STATIC).
+// See Poco::AllocationTracker.
+// #define POCO_ENABLE_ALLOCATION_TRACKING
+#if defined(POCO_ENABLE_ALLOCATION_TRACKING) && (defined(_WIN32) || defined(_WIN32_WCE)) && !defined(POCO_STATIC)
+	#error "POCO_ENABLE_ALLOCATION_TRACKING requires POCO_STATIC on Windows"
 #endif
 
 
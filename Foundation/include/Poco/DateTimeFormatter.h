@@ -41,6 +41,10 @@ class Foundation_API DateTimeFormatter
 	///      the formatted value.
 	///    * append* functions append the formatted value to
 	///      an existing string.
+	///
+	/// DateTimeFormat::HTTP_FORMAT, ISO8601_FORMAT and ISO8601_FRAC_FORMAT
+	/// are formatted by specialised code, without interpreting the format
+	/// string.
 {
 public:
 	enum
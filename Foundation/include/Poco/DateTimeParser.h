@@ -55,6 +55,11 @@ class Foundation_API DateTimeParser
 	/// If more strict format validation of date/time strings is required, a regular
 	/// expression could be used for initial validation, before passing the string
 	/// to DateTimeParser.
+	///
+	/// Strings that strictly follow DateTimeFormat::HTTP_FORMAT, ISO8601_FORMAT or
+	/// ISO8601_FRAC_FORMAT are parsed by specialised code, which neither interprets
+	/// the format string nor throws exceptions. Other strings go to the generic
+	/// parser, with the same results as before.
 {
 public:
 	static void parse(const std::string& fmt, const std::string& str, DateTime& dateTime, int& timeZoneDifferential);
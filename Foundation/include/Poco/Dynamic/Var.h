@@ -233,7 +233,17 @@ public:
 		Var tmp(other);
 		swap(tmp);
 #else
-		construct(other);
+		if (isEmpty())
+		{
+			construct(other);
+		}
+		else
+		{
+			// other may refer to our own content
+			Var tmp(other);
+			destruct();
+			take(tmp);
+		}
 #endif
 		return *this;
 	}
@@ -616,8 +626,9 @@ private:
 
 	template<typename ValueType>
 	void construct(const ValueType& value)
+		/// Stores the value. The Var must be empty.
 	{
-		if (sizeof(VarHolderImpl<ValueType>) <= Placeholder<ValueType>::Size::value)
+		if (Placeholder<VarHolder>::Fits<VarHolderImpl<ValueType> >::value)
 		{
 			new (reinterpret_cast<VarHolder*>(_placeholder.holder)) VarHolderImpl<ValueType>(value);
 			_placeholder.setLocal(true);
@@ -631,20 +642,11 @@ private:
 
 	void construct(const char* value)
 	{
-		std::string val(value);
-		if (sizeof(VarHolderImpl<std::string>) <= Placeholder<std::string>::Size::value)
-		{
-			new (reinterpret_cast<VarHolder*>(_placeholder.holder)) VarHolderImpl<std::string>(val);
-			_placeholder.setLocal(true);
-		}
-		else
-		{
-			_placeholder.pHolder = new VarHolderImpl<std::string>(val);
-			_placeholder.setLocal(false);
-		}
+		construct(std::string(value));
 	}
 
 	void construct(const Var& other)
+		/// Copies the content of other. The Var must be empty.
 	{
 		if (!other.isEmpty())
 			other.content()->clone(&_placeholder);
@@ -652,17 +654,33 @@ private:
 			_placeholder.erase();
 	}
 
-	void destruct()
+	void take(Var& other)
+		/// Moves the content of other, which is left empty,
+		/// into this Var, which must be empty. Only a locally
+		/// held value needs to be copied.
 	{
-		if (!isEmpty())
+		if (other._placeholder.isLocal())
+		{
+			construct(other);
+			other.destruct();
+		}
+		else
 		{
-			if (_placeholder.isLocal())
-				content()->~VarHolder();
-			else
-				delete content();
+			_placeholder.pHolder = other._placeholder.pHolder;
+			other._placeholder.erase();
 		}
 	}
 
+	void destruct()
+		/// Destroys the content and leaves the Var empty.
+	{
+		if (_placeholder.isLocal())
+			content()->~VarHolder();
+		else
+			delete content();
+		_placeholder.erase();
+	}
+
 	Placeholder<VarHolder> _placeholder;
 
 #endif // POCO_NO_SOO
@@ -694,18 +712,18 @@ inline void Var::swap(Var& other)
 	}
 	else
 	{
-		Var tmp(*this);
+		Var tmp;
+		tmp.take(*this);
 		try
 		{
-			if (_placeholder.isLocal()) destruct();
-			construct(other);
-			other = tmp;
+			take(other);
 		}
 		catch (...)
 		{
-			construct(tmp);
+			take(tmp);
 			throw;
 		}
+		other.take(tmp);
 	}
 
 #endif
@@ -288,7 +288,7 @@ protected:
 		return new VarHolderImpl<T>(val);
 #else
 		poco_check_ptr (pVarHolder);
-		if ((sizeof(VarHolderImpl<T>) <= Placeholder<T>::Size::value))
+		if (Placeholder<VarHolder>::Fits<VarHolderImpl<T> >::value)
 		{
 			new ((VarHolder*) pVarHolder->holder) VarHolderImpl<T>(val);
 			pVarHolder->setLocal(true);
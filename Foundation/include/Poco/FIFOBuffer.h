@@ -26,6 +26,7 @@
 #include "Poco/BasicEvent.h"
 #include "Poco/Mutex.h"
 #include "Poco/Format.h"
+#include <algorithm>
 
 
 namespace Poco {
@@ -49,10 +50,36 @@ class BasicFIFOBuffer
 	///
 	/// This class is useful anywhere where a FIFO functionality
 	/// is needed.
+	///
+	/// By default, the buffer keeps its data in one contiguous
+	/// block and moves it to the front of the buffer when space
+	/// at the end runs out. In ring mode (MODE_RING), data wraps
+	/// around the end of the buffer instead and is never moved,
+	/// except by begin() and resize(), which make it contiguous
+	/// again.
+	///
+	/// readSegments() and writeSegments() give direct access to
+	/// the data and to the free space, as up to two contiguous
+	/// segments, similar to struct iovec. Together with drain()
+	/// and advance(), they allow reading and writing without
+	/// copying the data, for example with sockets.
 {
 public:
 	typedef T Type;
 
+	enum Mode
+	{
+		MODE_LINEAR, /// data is kept contiguous (default)
+		MODE_RING    /// data wraps around the end of the buffer
+	};
+
+	struct Segment
+		/// A contiguous part of the buffer.
+	{
+		T*          base;
+		std::size_t length;
+	};
+
 	mutable Poco::BasicEvent<bool> writable;
 		/// Event indicating "writability" of the buffer,
 		/// triggered as follows:
@@ -77,10 +104,11 @@ public:
 		///	  Readable event observers are notified, with true value
 		///	  as the argument
 
-	BasicFIFOBuffer(std::size_t size, bool notify = false):
+	BasicFIFOBuffer(std::size_t size, bool notify = false, Mode mode = MODE_LINEAR):
 		_buffer(size),
 		_begin(0),
 		_used(0),
+		_mode(mode),
 		_notify(notify),
 		_eof(false),
 		_error(false)
@@ -88,10 +116,11 @@ public:
 	{
 	}
 
-	BasicFIFOBuffer(T* pBuffer, std::size_t size, bool notify = false):
+	BasicFIFOBuffer(T* pBuffer, std::size_t size, bool notify = false, Mode mode = MODE_LINEAR):
 		_buffer(pBuffer, size),
 		_begin(0),
 		_used(0),
+		_mode(mode),
 		_notify(notify),
 		_eof(false),
 		_error(false)
@@ -99,10 +128,11 @@ public:
 	{
 	}
 
-	BasicFIFOBuffer(const T* pBuffer, std::size_t size, bool notify = false):
+	BasicFIFOBuffer(const T* pBuffer, std::size_t size, bool notify = false, Mode mode = MODE_LINEAR):
 		_buffer(pBuffer, size),
 		_begin(0),
 		_used(size),
+		_mode(mode),
 		_notify(notify),
 		_eof(false),
 		_error(false)
@@ -130,8 +160,13 @@ public:
 			throw InvalidAccessException("Can not resize FIFO without data loss.");
 		
 		std::size_t usedBefore = _used;
+		if (preserveContent) linearize();
 		_buffer.resize(newSize, preserveContent);
-		if (!preserveContent) _used = 0;
+		if (!preserveContent)
+		{
+			_begin = 0;
+			_used = 0;
+		}
 		if (_notify) notify(usedBefore);
 	}
 	
@@ -150,7 +185,13 @@ public:
 		Mutex::ScopedLock lock(_mutex);
 		if (!isReadable()) return 0;
 		if (length > _used) length = _used;
-		std::memcpy(pBuffer, _buffer.begin() + _begin, length * sizeof(T));
+		Segment segments[2];
+		int n = split(_begin, length, segments);
+		for (int i = 0; i < n; ++i)
+		{
+			std::memcpy(pBuffer, segments[i].base, segments[i].length * sizeof(T));
+			pBuffer += segments[i].length;
+		}
 		return length;
 	}
 	
@@ -187,9 +228,7 @@ public:
 		std::size_t usedBefore = _used;
 		std::size_t readLen = peek(pBuffer, length);
 		poco_assert (_used >= readLen);
-		_used -= readLen;
-		if (0 == _used) _begin = 0;
-		else _begin += length;
+		consume(readLen);
 
 		if (_notify) notify(usedBefore);
 
@@ -209,9 +248,7 @@ public:
 		std::size_t usedBefore = _used;
 		std::size_t readLen = peek(buffer, length);
 		poco_assert (_used >= readLen);
-		_used -= readLen;
-		if (0 == _used) _begin = 0;
-		else _begin += length;
+		consume(readLen);
 
 		if (_notify) notify(usedBefore);
 
@@ -235,6 +272,15 @@ public:
 		
 		if (!isWritable()) return 0;
 		
+		if (_mode == MODE_RING)
+		{
+			std::size_t usedBefore = _used;
+			std::size_t len = length > available() ? available() : length;
+			store(pBuffer, len);
+			if (_notify) notify(usedBefore);
+			return len;
+		}
+
 		if (_buffer.size() - (_begin + _used) < length)
 		{
 			std::memmove(_buffer.begin(), begin(), _used * sizeof(T));
@@ -301,11 +347,7 @@ public:
 			_begin = 0;
 			_used = 0;
 		}
-		else
-		{
-			_begin += length;
-			_used -= length;
-		}
+		else consume(length);
 
 		if (_notify) notify(usedBefore);
 	}
@@ -325,16 +367,24 @@ public:
 		if (!isWritable())
 			throw Poco::InvalidAccessException("Buffer not writable.");
 
-		std::memcpy(&_buffer[_used], ptr, length * sizeof(T));
 		std::size_t usedBefore = _used;
-		_used += length;
+		if (_mode == MODE_RING)
+		{
+			store(ptr, length);
+		}
+		else
+		{
+			std::memcpy(&_buffer[_used], ptr, length * sizeof(T));
+			_used += length;
+		}
 		if (_notify) notify(usedBefore);
 	}
 
 	void advance(std::size_t length)
 		/// Advances buffer by length elements.
 		/// Should be called AFTER the data 
-		/// was copied into the buffer.
+		/// was copied into the buffer, either at next()
+		/// or into the segments given by writeSegments().
 	{
 		Mutex::ScopedLock lock(_mutex);
 
@@ -344,7 +394,7 @@ public:
 		if (!isWritable())
 			throw Poco::InvalidAccessException("Buffer not writable.");
 
-		if (_buffer.size() - (_begin + _used) < length)
+		if (_mode == MODE_LINEAR && _buffer.size() - (_begin + _used) < length)
 		{
 			std::memmove(_buffer.begin(), begin(), _used * sizeof(T));
 			_begin = 0;
@@ -359,14 +409,7 @@ public:
 		/// Returns the pointer to the beginning of the buffer.
 	{
 		Mutex::ScopedLock lock(_mutex);
-		if (_begin != 0)
-		{
-			// Move the data to the start of the buffer so begin() and next()
-			// always return consistent pointers with each other and allow writing
-			// to the end of the buffer.
-			std::memmove(_buffer.begin(), _buffer.begin() + _begin, _used * sizeof(T));
-			_begin = 0;
-		}
+		linearize();
 		return _buffer.begin();
 	}
 
@@ -386,7 +429,7 @@ public:
 		if (index >= _used)
 			throw InvalidAccessException(format("Index out of bounds: %z (max index allowed: %z)", index, _used - 1));
 
-		return _buffer[_begin + index];
+		return _buffer[offset(index)];
 	}
 
 	const T& operator [] (std::size_t index) const
@@ -398,7 +441,7 @@ public:
 		if (index >= _used)
 			throw InvalidAccessException(format("Index out of bounds: %z (max index allowed: %z)", index, _used - 1));
 
-		return _buffer[_begin + index];
+		return _buffer[offset(index)];
 	}
 
 	const Buffer<T>& buffer() const
@@ -406,6 +449,45 @@ public:
 	{
 		return _buffer;
 	}
+
+	int readSegments(Segment* pSegments)
+		/// Stores the location of the data in the buffer in
+		/// pSegments, which must have room for two segments,
+		/// and returns the number of segments used. In ring mode,
+		/// wrapped data takes two segments; otherwise, one.
+		/// Returns zero if the buffer is not readable.
+		///
+		/// The data stays in the buffer until it is removed
+		/// with drain().
+	{
+		Mutex::ScopedLock lock(_mutex);
+		if (!isReadable()) return 0;
+		return split(_begin, _used, pSegments);
+	}
+
+	int writeSegments(Segment* pSegments)
+		/// Stores the location of the free space in the buffer
+		/// in pSegments, which must have room for two segments,
+		/// and returns the number of segments used. In ring mode,
+		/// free space that wraps around takes two segments;
+		/// otherwise, the data is moved to the front of the
+		/// buffer if necessary, and one segment is used.
+		/// Returns zero if the buffer is not writable.
+		///
+		/// Data written to the segments becomes part of
+		/// the buffer's content when advance() is called.
+	{
+		Mutex::ScopedLock lock(_mutex);
+		if (!isWritable()) return 0;
+		if (_mode == MODE_LINEAR) linearize();
+		return split(offset(_used), available(), pSegments);
+	}
+
+	Mode mode() const
+		/// Returns the buffer's mode.
+	{
+		return _mode;
+	}
 	
 	void setError(bool error = true)
 		/// Sets the error flag on the buffer and empties it.
@@ -423,6 +505,7 @@ public:
 			if (error && isReadable() && _notify) readable.notify(this, f);
 			if (error && isWritable() && _notify) writable.notify(this, f);
 			_error = error;
+			_begin = 0;
 			_used = 0;
 		}
 		else
@@ -518,6 +601,70 @@ public:
 	}
 
 private:
+	std::size_t offset(std::size_t index) const
+		/// Returns the position in _buffer of the
+		/// element at the given index.
+	{
+		std::size_t pos = _begin + index;
+		if (pos >= _buffer.size()) pos -= _buffer.size();
+		return pos;
+	}
+
+	int split(std::size_t pos, std::size_t length, Segment* pSegments) const
+		/// Divides the range of length elements starting at
+		/// position pos, which may wrap around the end of the
+		/// buffer, into contiguous segments.
+	{
+		if (0 == length) return 0;
+		T* pBegin = const_cast<T*>(_buffer.begin());
+		std::size_t first = _buffer.size() - pos;
+		pSegments[0].base = pBegin + pos;
+		if (length <= first)
+		{
+			pSegments[0].length = length;
+			return 1;
+		}
+		pSegments[0].length = first;
+		pSegments[1].base = pBegin;
+		pSegments[1].length = length - first;
+		return 2;
+	}
+
+	void store(const T* pBuffer, std::size_t length)
+		/// Appends length elements in ring mode.
+	{
+		Segment segments[2];
+		int n = split(offset(_used), length, segments);
+		for (int i = 0; i < n; ++i)
+		{
+			std::memcpy(segments[i].base, pBuffer, segments[i].length * sizeof(T));
+			pBuffer += segments[i].length;
+		}
+		_used += length;
+	}
+
+	void consume(std::size_t length)
+		/// Removes length elements from the front.
+	{
+		_used -= length;
+		if (0 == _used) _begin = 0;
+		else _begin = offset(length);
+	}
+
+	void linearize()
+		/// Moves the data to the start of the buffer, so that
+		/// begin() and next() always return consistent pointers
+		/// and the free space is at the end of the buffer.
+	{
+		if (_begin == 0) return;
+
+		if (_begin + _used <= _buffer.size())
+			std::memmove(_buffer.begin(), _buffer.begin() + _begin, _used * sizeof(T));
+		else
+			std::rotate(_buffer.begin(), _buffer.begin() + _begin, _buffer.begin() + _buffer.size());
+		_begin = 0;
+	}
+
 	void notify(std::size_t usedBefore)
 	{
 		bool t = true, f = false;
@@ -539,6 +686,7 @@ private:
 	Buffer<T>     _buffer;
 	std::size_t   _begin;
 	std::size_t   _used;
+	Mode          _mode;
 	bool          _notify;
 	mutable Mutex _mutex;
 	bool          _eof;
@@ -0,0 +1,114 @@
+//
+// FastHash.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Hashing
+// Module:  FastHash
+//
+// Definition of the FastHash class template.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_FastHash_INCLUDED
+#define Foundation_FastHash_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Hash.h"
+#include <cstddef>
+
+
+namespace Poco {
+
+
+std::size_t Foundation_API fastHash(const void* data, std::size_t length);
+	/// Returns a hash (MurmurHash64A) of the given bytes. Processes
+	/// eight bytes at a time and spreads every input bit over the
+	/// whole result, so both the low and the high bits of the hash
+	/// can be used.
+
+
+std::size_t fastHash(UInt64 n);
+	/// Returns a hash (the MurmurHash3 finalizer) of the given integer.
+
+
+template <class T>
+struct FastHash
+	/// A hash function for use with hash tables that take bits from
+	/// anywhere in the hash, like FlatHashTable.
+	///
+	/// Integers and strings are hashed with fastHash(). Other types
+	/// are hashed with Poco::hash(), whose result is then mixed with
+	/// fastHash().
+{
+	std::size_t operator () (const T& value) const
+	{
+		return fastHash(static_cast<UInt64>(Poco::hash(value)));
+	}
+};
+
+
+template <>
+struct FastHash<std::string>
+{
+	std::size_t operator () (const std::string& value) const
+	{
+		return fastHash(value.data(), value.size());
+	}
+};
+
+
+#define POCO_FAST_HASH_INTEGER(T) \
+	template <> \
+	struct FastHash<T> \
+	{ \
+		std::size_t operator () (T value) const \
+		{ \
+			return fastHash(static_cast<UInt64>(value)); \
+		} \
+	};
+
+
+POCO_FAST_HASH_INTEGER(char)
+POCO_FAST_HASH_INTEGER(signed char)
+POCO_FAST_HASH_INTEGER(unsigned char)
+POCO_FAST_HASH_INTEGER(short)
+POCO_FAST_HASH_INTEGER(unsigned short)
+POCO_FAST_HASH_INTEGER(int)
+POCO_FAST_HASH_INTEGER(unsigned int)
+POCO_FAST_HASH_INTEGER(long)
+POCO_FAST_HASH_INTEGER(unsigned long)
+#if defined(POCO_HAVE_INT64) && !defined(POCO_LONG_IS_64_BIT)
+POCO_FAST_HASH_INTEGER(Int64)
+POCO_FAST_HASH_INTEGER(UInt64)
+#endif
+
+
+#undef POCO_FAST_HASH_INTEGER
+
+
+//
+// inlines
+//
+inline std::size_t fastHash(UInt64 n)
+{
+	n ^= n >> 33;
+	n *= 0xff51afd7ed558ccdULL;
+	n ^= n >> 33;
+	n *= 0xc4ceb9fe1a85ec53ULL;
+	n ^= n >> 33;
+	return static_cast<std::size_t>(n);
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_FastHash_INCLUDED
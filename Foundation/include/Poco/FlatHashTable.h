@@ -0,0 +1,726 @@
+//
+// FlatHashTable.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Hashing
+// Module:  FlatHashTable
+//
+// Definition of the FlatHashTable class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_FlatHashTable_INCLUDED
+#define Foundation_FlatHashTable_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/FastHash.h"
+#include <iterator>
+#include <algorithm>
+#include <utility>
+#include <new>
+#include <cstring>
+#include <cstddef>
+
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define POCO_FLAT_HASH_TABLE_SSE2
+	#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+
+namespace Poco {
+
+
+class FlatHashGroup
+	/// This class is used internally by FlatHashTable.
+	///
+	/// A FlatHashGroup holds the control bytes of GROUP_SIZE
+	/// consecutive slots of a FlatHashTable and finds the slots
+	/// whose control byte matches a value, with a single SSE2
+	/// compare where available.
+	///
+	/// A control byte is EMPTY, DELETED, or, for a slot holding
+	/// a value, the lower seven bits of the value's hash.
+{
+public:
+	typedef signed char Ctrl;
+
+	enum
+	{
+		GROUP_SIZE = 16
+	};
+
+	static const Ctrl EMPTY   = -128;
+	static const Ctrl DELETED = -2;
+
+	explicit FlatHashGroup(const Ctrl* pCtrl)
+		/// Loads the GROUP_SIZE control bytes starting at pCtrl.
+	{
+#if defined(POCO_FLAT_HASH_TABLE_SSE2)
+		_ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCtrl));
+#else
+		std::memcpy(_ctrl, pCtrl, GROUP_SIZE);
+#endif
+	}
+
+	unsigned match(Ctrl h2) const
+		/// Returns a bit mask of the slots whose
+		/// control byte is h2.
+	{
+#if defined(POCO_FLAT_HASH_TABLE_SSE2)
+		return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_ctrl, _mm_set1_epi8(h2))));
+#else
+		unsigned mask = 0;
+		for (int i = 0; i < GROUP_SIZE; ++i)
+		{
+			if (_ctrl[i] == h2) mask |= 1U << i;
+		}
+		return mask;
+#endif
+	}
+
+	unsigned matchEmpty() const
+		/// Returns a bit mask of the empty slots.
+	{
+		return match(EMPTY);
+	}
+
+	unsigned matchEmptyOrDeleted() const
+		/// Returns a bit mask of the slots not holding a value.
+	{
+#if defined(POCO_FLAT_HASH_TABLE_SSE2)
+		// Only EMPTY and DELETED have the sign bit set.
+		return static_cast<unsigned>(_mm_movemask_epi8(_ctrl));
+#else
+		unsigned mask = 0;
+		for (int i = 0; i < GROUP_SIZE; ++i)
+		{
+			if (_ctrl[i] < 0) mask |= 1U << i;
+		}
+		return mask;
+#endif
+	}
+
+	static int lowestBit(unsigned mask)
+		/// Returns the index of the lowest bit set in mask,
+		/// which must not be zero.
+	{
+#if defined(__GNUC__)
+		return __builtin_ctz(mask);
+#elif defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return static_cast<int>(index);
+#else
+		int index = 0;
+		while (!(mask & 1))
+		{
+			mask >>= 1;
+			++index;
+		}
+		return index;
+#endif
+	}
+
+	static int highestBit(unsigned mask)
+		/// Returns the index of the highest bit set in mask,
+		/// which must not be zero.
+	{
+#if defined(__GNUC__)
+		return 31 - __builtin_clz(mask);
+#elif defined(_MSC_VER)
+		unsigned long index;
+		_BitScanReverse(&index, mask);
+		return static_cast<int>(index);
+#else
+		int index = -1;
+		while (mask)
+		{
+			mask >>= 1;
+			++index;
+		}
+		return index;
+#endif
+	}
+
+private:
+#if defined(POCO_FLAT_HASH_TABLE_SSE2)
+	__m128i _ctrl;
+#else
+	Ctrl _ctrl[GROUP_SIZE];
+#endif
+};
+
+
+template <class Value>
+struct FlatHashIdentity
+	/// This class template is used internally by FlatHashSet.
+{
+	const Value& operator () (const Value& value) const
+	{
+		return value;
+	}
+};
+
+
+template <class Key, class Value, class KeyOf, class HashFunc = FastHash<Key> >
+class FlatHashTable
+	/// This class implements an open addressing hash table that
+	/// stores its values in a single array (a "Swiss table").
+	///
+	/// Next to the array of values, the table keeps one control
+	/// byte per slot, holding seven bits of the hash of the value
+	/// stored in the slot, or a marker for an empty or deleted slot.
+	/// A lookup hashes the key once and then compares the control
+	/// bytes of sixteen slots at a time (with a single SSE2 instruction
+	/// where available), so that keys are compared only for slots
+	/// whose control byte matches, which almost always means the key
+	/// is found at the first comparison. Sixteen control bytes fit in a
+	/// quarter of a cache line, and the values need neither a separate
+	/// allocation nor a pointer each, as they do in LinearHashTable.
+	///
+	/// KeyOf is a function object returning the key of a value, and
+	/// HashFunc a function object returning the hash of a key. The
+	/// table takes bits from all over the hash; as weak hash functions
+	/// like Poco::Hash for integers leave the upper bits mostly unused,
+	/// the hash is mixed before use. Keys must support comparison for
+	/// equality.
+	///
+	/// The table grows by doubling when it becomes seven eighths full.
+	/// Erasing a value leaves a marker in its slot unless lookups
+	/// cannot run past the slot anyway. Markers are dropped when the
+	/// table grows, or is rebuilt instead of growing if many markers
+	/// have accumulated.
+	///
+	/// Inserting a value invalidates all iterators and pointers to
+	/// values, as the table may have to grow. Erasing a value only
+	/// invalidates iterators and pointers to that value.
+	///
+	/// The FlatHashTable is not thread safe.
+{
+public:
+	typedef Key          KeyType;
+	typedef Value        ValueType;
+	typedef Value&       Reference;
+	typedef const Value& ConstReference;
+	typedef Value*       Pointer;
+	typedef const Value* ConstPointer;
+	typedef HashFunc     Hash;
+	typedef FlatHashGroup::Ctrl Ctrl;
+
+	class ConstIterator: public std::iterator<std::forward_iterator_tag, Value>
+	{
+	public:
+		ConstIterator():
+			_pTable(0),
+			_index(0)
+		{
+		}
+
+		ConstIterator(const FlatHashTable* pTable, std::size_t index):
+			_pTable(pTable),
+			_index(index)
+		{
+		}
+
+		bool operator == (const ConstIterator& it) const
+		{
+			return _index == it._index;
+		}
+
+		bool operator != (const ConstIterator& it) const
+		{
+			return _index != it._index;
+		}
+
+		const Value& operator * () const
+		{
+			return _pTable->_pSlots[_index];
+		}
+
+		const Value* operator -> () const
+		{
+			return _pTable->_pSlots + _index;
+		}
+
+		ConstIterator& operator ++ () // prefix
+		{
+			_index = _pTable->next(_index + 1);
+			return *this;
+		}
+
+		ConstIterator operator ++ (int) // postfix
+		{
+			ConstIterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+		void swap(ConstIterator& it)
+		{
+			std::swap(_pTable, it._pTable);
+			std::swap(_index, it._index);
+		}
+
+	protected:
+		const FlatHashTable* _pTable;
+		std::size_t _index;
+
+		friend class FlatHashTable;
+	};
+
+	class Iterator: public ConstIterator
+	{
+	public:
+		Iterator()
+		{
+		}
+
+		Iterator(const FlatHashTable* pTable, std::size_t index):
+			ConstIterator(pTable, index)
+		{
+		}
+
+		Value& operator * ()
+		{
+			return const_cast<Value&>(ConstIterator::operator * ());
+		}
+
+		const Value& operator * () const
+		{
+			return ConstIterator::operator * ();
+		}
+
+		Value* operator -> ()
+		{
+			return const_cast<Value*>(ConstIterator::operator -> ());
+		}
+
+		const Value* operator -> () const
+		{
+			return ConstIterator::operator -> ();
+		}
+
+		Iterator& operator ++ () // prefix
+		{
+			ConstIterator::operator ++ ();
+			return *this;
+		}
+
+		Iterator operator ++ (int) // postfix
+		{
+			Iterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+		void swap(Iterator& it)
+		{
+			ConstIterator::swap(it);
+		}
+	};
+
+	FlatHashTable(std::size_t initialReserve = 0):
+		_pCtrl(0),
+		_pSlots(0),
+		_capacity(0),
+		_size(0),
+		_growthLeft(0)
+		/// Creates the FlatHashTable with room for
+		/// initialReserve values.
+	{
+		reserve(initialReserve);
+	}
+
+	FlatHashTable(const FlatHashTable& table):
+		_pCtrl(0),
+		_pSlots(0),
+		_capacity(0),
+		_size(0),
+		_growthLeft(0)
+		/// Creates the FlatHashTable by copying another one.
+	{
+		reserve(table._size);
+		try
+		{
+			for (ConstIterator it = table.begin(); it != table.end(); ++it)
+			{
+				insert(*it);
+			}
+		}
+		catch (...)
+		{
+			destroy();
+			throw;
+		}
+	}
+
+	~FlatHashTable()
+		/// Destroys the FlatHashTable.
+	{
+		destroy();
+	}
+
+	FlatHashTable& operator = (const FlatHashTable& table)
+		/// Assigns another FlatHashTable.
+	{
+		FlatHashTable tmp(table);
+		swap(tmp);
+		return *this;
+	}
+
+	void swap(FlatHashTable& table)
+		/// Swaps the FlatHashTable with another one.
+	{
+		std::swap(_pCtrl, table._pCtrl);
+		std::swap(_pSlots, table._pSlots);
+		std::swap(_capacity, table._capacity);
+		std::swap(_size, table._size);
+		std::swap(_growthLeft, table._growthLeft);
+	}
+
+	ConstIterator begin() const
+		/// Returns an iterator pointing to the first entry, if one exists.
+	{
+		return ConstIterator(this, next(0));
+	}
+
+	ConstIterator end() const
+		/// Returns an iterator pointing to the end of the table.
+	{
+		return ConstIterator(this, _capacity);
+	}
+
+	Iterator begin()
+		/// Returns an iterator pointing to the first entry, if one exists.
+	{
+		return Iterator(this, next(0));
+	}
+
+	Iterator end()
+		/// Returns an iterator pointing to the end of the table.
+	{
+		return Iterator(this, _capacity);
+	}
+
+	ConstIterator find(const KeyType& key) const
+		/// Finds the value with the given key.
+	{
+		return ConstIterator(this, lookup(key));
+	}
+
+	Iterator find(const KeyType& key)
+		/// Finds the value with the given key.
+	{
+		return Iterator(this, lookup(key));
+	}
+
+	std::size_t count(const KeyType& key) const
+		/// Returns the number of values with the given
+		/// key, which is either 1 or 0.
+	{
+		return lookup(key) != _capacity ? 1 : 0;
+	}
+
+	std::pair<Iterator, bool> insert(const ValueType& value)
+		/// Inserts a value into the table, unless a value with
+		/// the same key already exists.
+		///
+		/// Returns a pair holding an iterator pointing to the
+		/// inserted or existing value, and a flag which is
+		/// true if the value has been inserted.
+	{
+		UInt64 h = hashOf(KeyOf()(value));
+		std::size_t index = lookup(KeyOf()(value), h);
+		if (index != _capacity)
+			return std::make_pair(Iterator(this, index), false);
+
+		if (_capacity == 0)
+		{
+			rehash(MIN_CAPACITY);
+		}
+		index = findFree(h);
+		if (_growthLeft == 0 && _pCtrl[index] == FlatHashGroup::EMPTY)
+		{
+			grow();
+			index = findFree(h);
+		}
+		new (_pSlots + index) Value(value);
+		if (_pCtrl[index] == FlatHashGroup::EMPTY) --_growthLeft;
+		setCtrl(index, h2(h));
+		++_size;
+		return std::make_pair(Iterator(this, index), true);
+	}
+
+	void erase(Iterator it)
+		/// Erases the value pointed to by it.
+	{
+		if (it._index < _capacity)
+		{
+			eraseAt(it._index);
+		}
+	}
+
+	std::size_t erase(const KeyType& key)
+		/// Erases the value with the given key, if it exists.
+		/// Returns the number of erased values.
+	{
+		std::size_t index = lookup(key);
+		if (index == _capacity) return 0;
+		eraseAt(index);
+		return 1;
+	}
+
+	void clear()
+		/// Erases all values. Keeps the memory
+		/// allocated for the table.
+	{
+		for (std::size_t i = 0; i < _capacity; ++i)
+		{
+			if (_pCtrl[i] >= 0) _pSlots[i].~Value();
+		}
+		if (_capacity)
+		{
+			std::memset(_pCtrl, FlatHashGroup::EMPTY, _capacity + FlatHashGroup::GROUP_SIZE);
+		}
+		_size = 0;
+		_growthLeft = maxLoad(_capacity);
+	}
+
+	std::size_t size() const
+		/// Returns the number of values in the table.
+	{
+		return _size;
+	}
+
+	bool empty() const
+		/// Returns true iff the table is empty.
+	{
+		return _size == 0;
+	}
+
+	std::size_t capacity() const
+		/// Returns the number of slots in the table.
+	{
+		return _capacity;
+	}
+
+	void reserve(std::size_t n)
+		/// Makes room for n values, so that the table does
+		/// not have to grow until it holds more than n values.
+	{
+		std::size_t capacity = MIN_CAPACITY;
+		while (maxLoad(capacity) < n) capacity *= 2;
+		if (n > 0 && capacity > _capacity) rehash(capacity);
+	}
+
+private:
+	enum
+	{
+		MIN_CAPACITY = FlatHashGroup::GROUP_SIZE
+	};
+
+	static std::size_t maxLoad(std::size_t capacity)
+	{
+		return capacity - capacity/8;
+	}
+
+	static UInt64 hashOf(const KeyType& key)
+	{
+		// Spread the bits of weak hashes over the whole
+		// value, as both ends are used.
+		UInt64 h = static_cast<UInt64>(HashFunc()(key))*0x9e3779b97f4a7c15ULL;
+		return h ^ (h >> 32);
+	}
+
+	static Ctrl h2(UInt64 h)
+	{
+		return static_cast<Ctrl>(h & 0x7f);
+	}
+
+	std::size_t start(UInt64 h) const
+	{
+		return static_cast<std::size_t>(h >> 7) & (_capacity - 1);
+	}
+
+	std::size_t lookup(const KeyType& key) const
+	{
+		if (_size == 0) return _capacity;
+		return lookup(key, hashOf(key));
+	}
+
+	std::size_t lookup(const KeyType& key, UInt64 h) const
+		/// Returns the index of the value with the given key,
+		/// or _capacity if there is none.
+	{
+		if (_capacity == 0) return _capacity;
+
+		std::size_t mask = _capacity - 1;
+		std::size_t pos = start(h);
+		Ctrl c = h2(h);
+		for (std::size_t step = FlatHashGroup::GROUP_SIZE;; step += FlatHashGroup::GROUP_SIZE)
+		{
+			FlatHashGroup group(_pCtrl + pos);
+			for (unsigned m = group.match(c); m; m &= m - 1)
+			{
+				std::size_t index = (pos + FlatHashGroup::lowestBit(m)) & mask;
+				if (KeyOf()(_pSlots[index]) == key) return index;
+			}
+			if (group.matchEmpty()) return _capacity;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	std::size_t findFree(UInt64 h) const
+		/// Returns the index of the first empty or deleted
+		/// slot in the probe sequence for the given hash.
+	{
+		std::size_t mask = _capacity - 1;
+		std::size_t pos = start(h);
+		for (std::size_t step = FlatHashGroup::GROUP_SIZE;; step += FlatHashGroup::GROUP_SIZE)
+		{
+			FlatHashGroup group(_pCtrl + pos);
+			unsigned m = group.matchEmptyOrDeleted();
+			if (m) return (pos + FlatHashGroup::lowestBit(m)) & mask;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	std::size_t next(std::size_t index) const
+		/// Returns the index of the first value at or after
+		/// index, or _capacity if there is none.
+	{
+		while (index < _capacity && _pCtrl[index] < 0) ++index;
+		return index;
+	}
+
+	void setCtrl(std::size_t index, Ctrl c)
+	{
+		_pCtrl[index] = c;
+		// The first group is mirrored after the last slot,
+		// so that groups can be loaded at any position.
+		if (index < FlatHashGroup::GROUP_SIZE) _pCtrl[_capacity + index] = c;
+	}
+
+	void eraseAt(std::size_t index)
+	{
+		_pSlots[index].~Value();
+		--_size;
+
+		// If the run of occupied slots around the erased one is
+		// shorter than a group, every lookup that could have
+		// passed the slot sees an empty slot in the same group,
+		// and stops there anyway. The slot can then be marked
+		// empty again instead of deleted.
+		std::size_t mask = _capacity - 1;
+		unsigned emptyBefore = FlatHashGroup(_pCtrl + ((index - FlatHashGroup::GROUP_SIZE) & mask)).matchEmpty();
+		unsigned emptyAfter = FlatHashGroup(_pCtrl + index).matchEmpty();
+		if (emptyBefore && emptyAfter &&
+			FlatHashGroup::lowestBit(emptyAfter) + (FlatHashGroup::GROUP_SIZE - 1 - FlatHashGroup::highestBit(emptyBefore)) < FlatHashGroup::GROUP_SIZE)
+		{
+			setCtrl(index, FlatHashGroup::EMPTY);
+			++_growthLeft;
+		}
+		else
+		{
+			setCtrl(index, FlatHashGroup::DELETED);
+		}
+	}
+
+	void grow()
+	{
+		// Rebuild the table at the same size if dropping
+		// the deleted markers frees enough room.
+		if (_size <= maxLoad(_capacity)/2)
+			rehash(_capacity);
+		else
+			rehash(2*_capacity);
+	}
+
+	void rehash(std::size_t capacity)
+	{
+		FlatHashTable table;
+		table.allocate(capacity);
+		try
+		{
+			for (std::size_t i = 0; i < _capacity; ++i)
+			{
+				if (_pCtrl[i] >= 0)
+				{
+					UInt64 h = hashOf(KeyOf()(_pSlots[i]));
+					std::size_t index = table.findFree(h);
+					new (table._pSlots + index) Value(_pSlots[i]);
+					table.setCtrl(index, h2(h));
+					++table._size;
+					--table._growthLeft;
+				}
+			}
+		}
+		catch (...)
+		{
+			table.destroy();
+			throw;
+		}
+		swap(table);
+	}
+
+	void allocate(std::size_t capacity)
+	{
+		_pSlots = static_cast<Value*>(::operator new(capacity*sizeof(Value)));
+		try
+		{
+			_pCtrl = new Ctrl[capacity + FlatHashGroup::GROUP_SIZE];
+		}
+		catch (...)
+		{
+			::operator delete(_pSlots);
+			_pSlots = 0;
+			throw;
+		}
+		std::memset(_pCtrl, FlatHashGroup::EMPTY, capacity + FlatHashGroup::GROUP_SIZE);
+		_capacity = capacity;
+		_size = 0;
+		_growthLeft = maxLoad(capacity);
+	}
+
+	void destroy()
+	{
+		if (_capacity)
+		{
+			for (std::size_t i = 0; i < _capacity; ++i)
+			{
+				if (_pCtrl[i] >= 0) _pSlots[i].~Value();
+			}
+			delete [] _pCtrl;
+			::operator delete(_pSlots);
+		}
+		_pCtrl = 0;
+		_pSlots = 0;
+		_capacity = 0;
+		_size = 0;
+		_growthLeft = 0;
+	}
+
+	Ctrl*       _pCtrl;
+	Value*      _pSlots;
+	std::size_t _capacity;
+	std::size_t _size;
+	std::size_t _growthLeft;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_FlatHashTable_INCLUDED
@@ -24,6 +24,7 @@
 #include "Poco/Channel.h"
 #include "Poco/Message.h"
 #include "Poco/Format.h"
+#include "Poco/StringPool.h"
 #include <map>
 #include <vector>
 #include <cstddef>
@@ -487,7 +488,7 @@ public:
 	static const std::string ROOT; /// The name of the root logger ("").	
 		
 protected:
-	typedef std::map<std::string, Logger*> LoggerMap;
+	typedef std::map<InternedString, Logger*> LoggerMap;
 
 	Logger(const std::string& name, Channel* pChannel, int level);
 	~Logger();
@@ -505,9 +506,9 @@ private:
 	Logger(const Logger&);
 	Logger& operator = (const Logger&);
 	
-	std::string _name;
-	Channel*    _pChannel;
-	int         _level;
+	InternedString _name;
+	Channel*       _pChannel;
+	int            _level;
 
 	static LoggerMap* _pLoggerMap;
 	static Mutex      _mapMtx;
@@ -656,7 +657,7 @@ private:
 //
 inline const std::string& Logger::name() const
 {
-	return _name;
+	return _name.str();
 }
 
 
@@ -670,7 +671,7 @@ inline void Logger::log(const std::string& text, Message::Priority prio)
 {
 	if (_level >= prio && _pChannel)
 	{
-		_pChannel->log(Message(_name, text, prio));
+		_pChannel->log(Message(_name.str(), text, prio));
 	}
 }
 
@@ -679,7 +680,7 @@ inline void Logger::log(const std::string& text, Message::Priority prio, const c
 {
 	if (_level >= prio && _pChannel)
 	{
-		_pChannel->log(Message(_name, text, prio, file, line));
+		_pChannel->log(Message(_name.str(), text, prio, file, line));
 	}
 }
 
@@ -0,0 +1,210 @@
+//
+// MutexProfile.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Threading
+// Module:  MutexProfile
+//
+// Definition of the MutexProfile and MutexProfileRegistry classes.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_MutexProfile_INCLUDED
+#define Foundation_MutexProfile_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/RefCountedObject.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/Mutex.h"
+#include "Poco/Clock.h"
+#include <map>
+#include <vector>
+#include <ostream>
+
+
+namespace Poco {
+
+
+class Foundation_API MutexProfile: public RefCountedObject
+	/// A MutexProfile collects the statistics of
+	/// one or more ProfilingMutex objects sharing
+	/// the same name:
+	///   - the number of acquisitions,
+	///   - the number of contended acquisitions, i.e., those
+	///     that had to wait because another thread held the mutex,
+	///   - the total and maximum time spent waiting,
+	///   - a histogram of wait times, and
+	///   - the call sites that held the mutex when another
+	///     thread had to wait for it.
+	///
+	/// MutexProfile objects are created and kept by
+	/// the MutexProfileRegistry.
+{
+public:
+	typedef AutoPtr<MutexProfile> Ptr;
+
+	enum
+	{
+		HISTOGRAM_BUCKETS = 16,
+			/// Bucket i counts waits shorter than 2^i microseconds,
+			/// and at least 2^(i-1) microseconds. The last bucket
+			/// counts all longer waits.
+		MAX_SITES = 16
+			/// Number of different holder call sites recorded.
+	};
+
+	struct Site
+	{
+		const char* site;
+		int count;
+	};
+
+	const std::string& name() const;
+		/// Returns the name of the MutexProfile.
+
+	void acquired();
+		/// Counts an acquisition of the mutex.
+
+	void contended(Clock::ClockDiff waitTime, const char* holderSite);
+		/// Counts a contended acquisition that waited
+		/// for the given number of microseconds while the mutex
+		/// was held at the given call site (which may be null
+		/// if not known).
+
+	int acquisitions() const;
+		/// Returns the number of acquisitions, including
+		/// contended ones.
+
+	int contentions() const;
+		/// Returns the number of contended acquisitions.
+
+	Clock::ClockDiff totalWaitTime() const;
+		/// Returns the total time, in microseconds,
+		/// spent waiting for the mutex.
+
+	Clock::ClockDiff maxWaitTime() const;
+		/// Returns the longest time, in microseconds,
+		/// a thread waited for the mutex.
+
+	int histogram(int bucket) const;
+		/// Returns the number of contended acquisitions
+		/// that fell into the given bucket.
+
+	void holderSites(std::vector<Site>& sites) const;
+		/// Stores the recorded holder call sites in sites,
+		/// ordered by decreasing count.
+
+	void reset();
+		/// Sets all counters to zero.
+
+	void dump(std::ostream& ostr) const;
+		/// Writes the statistics to the given stream.
+
+protected:
+	MutexProfile(const std::string& name);
+	~MutexProfile();
+
+private:
+	MutexProfile();
+	MutexProfile(const MutexProfile&);
+	MutexProfile& operator = (const MutexProfile&);
+
+	std::string _name;
+	AtomicCounter _acquisitions;
+	int _contentions;
+	Clock::ClockDiff _totalWaitTime;
+	Clock::ClockDiff _maxWaitTime;
+	int _histogram[HISTOGRAM_BUCKETS];
+	Site _sites[MAX_SITES];
+	int _otherSites;
+	mutable FastMutex _mutex;
+
+	friend class MutexProfileRegistry;
+};
+
+
+class Foundation_API MutexProfileRegistry
+	/// The MutexProfileRegistry keeps the MutexProfile
+	/// objects of all ProfilingMutex instances, by name.
+	///
+	/// Profiles are never removed from the registry, so the
+	/// statistics of mutexes that no longer exist remain
+	/// available. Mutexes that are created and destroyed over
+	/// and over again, e.g. one per connection, should share
+	/// a name, so that their statistics are summed up in a
+	/// single profile.
+{
+public:
+	MutexProfileRegistry();
+		/// Creates the MutexProfileRegistry.
+
+	~MutexProfileRegistry();
+		/// Destroys the MutexProfileRegistry.
+
+	MutexProfile::Ptr profile(const std::string& name);
+		/// Returns the MutexProfile with the given name,
+		/// creating it if necessary.
+
+	bool has(const std::string& name) const;
+		/// Returns true if a MutexProfile with the
+		/// given name exists.
+
+	void names(std::vector<std::string>& names) const;
+		/// Stores the names of all profiles in names.
+
+	void dump(std::ostream& ostr) const;
+		/// Writes the statistics of all profiles
+		/// to the given stream, ordered by name.
+
+	void reset();
+		/// Sets the counters of all profiles to zero.
+
+	static MutexProfileRegistry& defaultRegistry();
+		/// Returns a reference to the default
+		/// MutexProfileRegistry.
+
+private:
+	MutexProfileRegistry(const MutexProfileRegistry&);
+	MutexProfileRegistry& operator = (const MutexProfileRegistry&);
+
+	typedef std::map<std::string, MutexProfile::Ptr> ProfileMap;
+
+	ProfileMap _profiles;
+	mutable FastMutex _mutex;
+};
+
+
+//
+// inlines
+//
+inline const std::string& MutexProfile::name() const
+{
+	return _name;
+}
+
+
+inline void MutexProfile::acquired()
+{
+	++_acquisitions;
+}
+
+
+inline int MutexProfile::acquisitions() const
+{
+	return _acquisitions.value();
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_MutexProfile_INCLUDED
@@ -36,6 +36,8 @@ class Foundation_API NumberFormatter
 	///      the formatted value.
 	///    * append* functions append the formatted value to
 	///      an existing string.
+	///    * formatTo functions write the formatted value to
+	///      a character buffer, without allocating memory.
 {
 public:
 	enum BoolFormat
@@ -47,6 +49,8 @@ public:
 
 	static const unsigned NF_MAX_INT_STRING_LEN = 32; // increase for 64-bit binary formatting support
 	static const unsigned NF_MAX_FLT_STRING_LEN = POCO_MAX_FLT_STRING_LEN;
+	static const unsigned NF_MAX_SHORTEST_STRING_LEN = 40;
+		/// Buffer size sufficient for formatTo() with any value.
 
 	static std::string format(int value);
 		/// Formats an integer value in decimal notation.
@@ -386,6 +390,52 @@ public:
 		/// sixteen (64-bit architectures) characters wide
 		/// field in hexadecimal notation.
 
+	static std::size_t formatTo(char* buffer, std::size_t length, int value);
+		/// Writes an integer value in decimal notation to the
+		/// given buffer and returns the number of characters written.
+		/// The result is not zero-terminated.
+		///
+		/// Throws a RangeException if the buffer is too small;
+		/// NF_MAX_SHORTEST_STRING_LEN characters are always enough.
+
+	static std::size_t formatTo(char* buffer, std::size_t length, unsigned value);
+		/// Writes an unsigned integer value in decimal notation
+		/// to the given buffer, like formatTo(char*, std::size_t, int).
+
+	static std::size_t formatTo(char* buffer, std::size_t length, long value);
+		/// Writes a long value in decimal notation to the given
+		/// buffer, like formatTo(char*, std::size_t, int).
+
+	static std::size_t formatTo(char* buffer, std::size_t length, unsigned long value);
+		/// Writes an unsigned long value in decimal notation to the
+		/// given buffer, like formatTo(char*, std::size_t, int).
+
+#if defined(POCO_HAVE_INT64) && !defined(POCO_LONG_IS_64_BIT)
+
+	static std::size_t formatTo(char* buffer, std::size_t length, Int64 value);
+		/// Writes a 64-bit integer value in decimal notation to the
+		/// given buffer, like formatTo(char*, std::size_t, int).
+
+	static std::size_t formatTo(char* buffer, std::size_t length, UInt64 value);
+		/// Writes an unsigned 64-bit integer value in decimal notation
+		/// to the given buffer, like formatTo(char*, std::size_t, int).
+
+#endif // defined(POCO_HAVE_INT64) && !defined(POCO_LONG_IS_64_BIT)
+
+	static std::size_t formatTo(char* buffer, std::size_t length, float value);
+		/// Writes the shortest representation of a float value that
+		/// reads back as the same value to the given buffer, in the
+		/// same notation as format(float), and returns the number of
+		/// characters written. The result is not zero-terminated.
+		///
+		/// Throws a RangeException if the buffer is too small;
+		/// NF_MAX_SHORTEST_STRING_LEN characters are always enough.
+
+	static std::size_t formatTo(char* buffer, std::size_t length, double value);
+		/// Writes the shortest representation of a double value
+		/// that reads back as the same value to the given buffer,
+		/// like formatTo(char*, std::size_t, float).
+
 private:
 };
 
@@ -396,9 +446,8 @@ private:
 
 inline std::string NumberFormatter::format(int value)
 {
-	std::string result;
-	intToStr(value, 10, result);
-	return result;
+	char result[NF_MAX_INT_STRING_LEN];
+	return std::string(result, formatTo(result, sizeof(result), value));
 }
 
 
@@ -436,9 +485,8 @@ inline std::string NumberFormatter::formatHex(int value, int width, bool prefix)
 
 inline std::string NumberFormatter::format(unsigned value)
 {
-	std::string result;
-	uIntToStr(value, 10, result);
-	return result;
+	char result[NF_MAX_INT_STRING_LEN];
+	return std::string(result, formatTo(result, sizeof(result), value));
 }
 
 
@@ -476,9 +524,8 @@ inline std::string NumberFormatter::formatHex(unsigned value, int width, bool pr
 
 inline std::string NumberFormatter::format(long value)
 {
-	std::string result;
-	intToStr(value, 10, result);
-	return result;
+	char result[NF_MAX_INT_STRING_LEN];
+	return std::string(result, formatTo(result, sizeof(result), value));
 }
 
 
@@ -516,9 +563,8 @@ inline std::string NumberFormatter::formatHex(long value, int width, bool prefix
 
 inline std::string NumberFormatter::format(unsigned long value)
 {
-	std::string result;
-	uIntToStr(value, 10, result);
-	return result;
+	char result[NF_MAX_INT_STRING_LEN];
+	return std::string(result, formatTo(result, sizeof(result), value));
 }
 
 
@@ -559,9 +605,8 @@ inline std::string NumberFormatter::formatHex(unsigned long value, int width, bo
 
 inline std::string NumberFormatter::format(Int64 value)
 {
-	std::string result;
-	intToStr(value, 10, result);
-	return result;
+	char result[NF_MAX_INT_STRING_LEN];
+	return std::string(result, formatTo(result, sizeof(result), value));
 }
 
 
@@ -599,9 +644,8 @@ inline std::string NumberFormatter::formatHex(Int64 value, int width, bool prefi
 
 inline std::string NumberFormatter::format(UInt64 value)
 {
-	std::string result;
-	uIntToStr(value, 10, result);
-	return result;
+	char result[NF_MAX_INT_STRING_LEN];
+	return std::string(result, formatTo(result, sizeof(result), value));
 }
 
 
@@ -37,6 +37,13 @@ class Foundation_API NumberParser
 	/// Note that leading or trailing whitespace is not allowed
 	/// in the string. Poco::trim() or Poco::trimInPlace()
 	/// can be used to remove leading or trailing whitespace.
+	///
+	/// The overloads taking a range of characters [begin, end) accept
+	/// only an optional sign followed by decimal digits (and, for
+	/// floating-point numbers, '.' as decimal point and an exponent).
+	/// They do not depend on the locale, never throw and never
+	/// allocate memory, and parse eight digits at a time. The
+	/// std::string overloads try them first.
 {
 public:
 	static const unsigned short NUM_BASE_OCT = 010;
@@ -51,6 +58,11 @@ public:
 		/// Parses an integer value in decimal notation from the given string.
 		/// Returns true if a valid integer has been found, false otherwise. 
 		/// If parsing was not successful, value is undefined.
+
+	static bool tryParse(const char* begin, const char* end, int& value);
+		/// Parses an integer value in decimal notation from the given range.
+		/// Returns true if a valid integer has been found, false otherwise. 
+		/// If parsing was not successful, value is undefined.
 	
 	static unsigned parseUnsigned(const std::string& s, char thousandSeparator = ',');
 		/// Parses an unsigned integer value in decimal notation from the given string.
@@ -61,6 +73,11 @@ public:
 		/// Returns true if a valid integer has been found, false otherwise. 
 		/// If parsing was not successful, value is undefined.
 
+	static bool tryParseUnsigned(const char* begin, const char* end, unsigned& value);
+		/// Parses an unsigned integer value in decimal notation from the given range.
+		/// Returns true if a valid integer has been found, false otherwise. 
+		/// If parsing was not successful, value is undefined.
+
 	static unsigned parseHex(const std::string& s);
 		/// Parses an integer value in hexadecimal notation from the given string.
 		/// Throws a SyntaxException if the string does not hold a number in
@@ -92,6 +109,11 @@ public:
 		/// Returns true if a valid integer has been found, false otherwise. 
 		/// If parsing was not successful, value is undefined.
 
+	static bool tryParse64(const char* begin, const char* end, Int64& value);
+		/// Parses a 64-bit integer value in decimal notation from the given range.
+		/// Returns true if a valid integer has been found, false otherwise. 
+		/// If parsing was not successful, value is undefined.
+
 	static UInt64 parseUnsigned64(const std::string& s, char thousandSeparator = ',');
 		/// Parses an unsigned 64-bit integer value in decimal notation from the given string.
 		/// Throws a SyntaxException if the string does not hold a number in decimal notation.
@@ -101,6 +123,11 @@ public:
 		/// Returns true if a valid integer has been found, false otherwise. 
 		/// If parsing was not successful, value is undefined.
 
+	static bool tryParseUnsigned64(const char* begin, const char* end, UInt64& value);
+		/// Parses an unsigned 64-bit integer value in decimal notation from the given range.
+		/// Returns true if a valid integer has been found, false otherwise. 
+		/// If parsing was not successful, value is undefined.
+
 	static UInt64 parseHex64(const std::string& s);
 		/// Parses a 64 bit-integer value in hexadecimal notation from the given string.
 		/// Throws a SyntaxException if the string does not hold a number in hexadecimal notation.
@@ -134,6 +161,13 @@ public:
 		/// false otherwise.
 		/// If parsing was not successful, value is undefined.
 
+	static bool tryParseFloat(const char* begin, const char* end, double& value);
+		/// Parses a double value in decimal floating point notation
+		/// from the given range. The result is correctly rounded.
+		/// Returns true if a valid floating point number has been found,
+		/// false otherwise.
+		/// If parsing was not successful, value is undefined.
+
 	static bool parseBool(const std::string& s);
 		/// Parses a bool value in decimal or string notation
 		/// from the given string.
@@ -23,6 +23,7 @@
 #include "Poco/Foundation.h"
 #include "Poco/Buffer.h"
 #include "Poco/FPEnvironment.h"
+#include "Poco/ByteOrder.h"
 #ifdef min
 	#undef min
 #endif
@@ -31,6 +32,7 @@
 #endif
 #include <limits>
 #include <cmath>
+#include <cstring>
 #if !defined(POCO_NO_LOCALE)
 	#include <locale>
 #endif
@@ -178,6 +180,56 @@ bool strToInt(const std::string& str, I& result, short base, char thSep = ',')
 }
 
 
+namespace Impl {
+
+	// Helpers for parsing eight decimal digits at a time (see Langdale
+	// and Lemire, "Parsing Gigabytes of JSON per Second", 2019).
+
+	inline UInt64 loadEight(const char* p)
+		/// Returns the eight characters at p, the first one in
+		/// the least significant byte.
+	{
+		UInt64 chunk;
+		std::memcpy(&chunk, p, sizeof(chunk));
+#if defined(POCO_ARCH_BIG_ENDIAN)
+		chunk = ByteOrder::flipBytes(chunk);
+#endif
+		return chunk;
+	}
+
+	inline bool isEightDigits(UInt64 chunk)
+		/// Returns true if all eight characters are decimal digits.
+	{
+		return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) | (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+	}
+
+	inline UInt32 parseEightDigits(UInt64 chunk)
+		/// Returns the value of eight decimal digits,
+		/// as loaded by loadEight().
+	{
+		chunk -= 0x3030303030303030ULL;
+		chunk = chunk*10 + (chunk >> 8);
+		chunk = (((chunk & 0x000000FF000000FFULL)*(100 + (1000000ULL << 32))) + (((chunk >> 16) & 0x000000FF000000FFULL)*(1 + (10000ULL << 32)))) >> 32;
+		return static_cast<UInt32>(chunk);
+	}
+
+	inline bool isDigit(char c)
+	{
+		return static_cast<unsigned>(c - '0') < 10;
+	}
+
+	inline const char* skipDigits(const char* p, const char* end)
+		/// Returns the position of the first character in
+		/// [p, end) that is not a decimal digit.
+	{
+		while (end - p >= 8 && isEightDigits(loadEight(p))) p += 8;
+		while (p != end && isDigit(*p)) ++p;
+		return p;
+	}
+
+} // namespace Impl
+
+
 //
 // Number to String Conversions
 //
@@ -513,6 +565,20 @@ Foundation_API bool strToDouble(const std::string& str, double& result, char dec
 	/// 
 	/// Returns true if successful, false otherwise.
 
+Foundation_API bool strToDouble(const char* begin, const char* end, double& result);
+	/// Converts the characters in [begin, end) into a double-precision
+	/// floating point number. The characters must form a number in
+	/// decimal notation, with an optional sign, '.' as decimal point
+	/// and an optional exponent; no whitespace, thousand separators,
+	/// infinities or NaNs are allowed. The locale is not used and no
+	/// memory is allocated.
+	///
+	/// Numbers whose significant digits fit into 53 bits, with small
+	/// exponents, are converted with a single exact multiplication or
+	/// division; others by double-conversion's Strtod().
+	///
+	/// Returns true if successful, false otherwise.
+
 //
 // end double-conversion functions declarations
 //
@@ -0,0 +1,171 @@
+//
+// PartitionedThreadPool.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Threading
+// Module:  PartitionedThreadPool
+//
+// Definition of the PartitionedThreadPool class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_PartitionedThreadPool_INCLUDED
+#define Foundation_PartitionedThreadPool_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/CPUTopology.h"
+#include "Poco/AtomicCounter.h"
+#include <vector>
+
+
+namespace Poco {
+
+
+class Foundation_API PartitionedThreadPool
+	/// A PartitionedThreadPool consists of several ThreadPool
+	/// partitions, each of which runs its threads only on a given
+	/// set of processors. By default, there is one partition per
+	/// NUMA node (see CPUTopology), so that work started in a
+	/// partition stays on the node and uses the node's memory.
+	///
+	/// start() runs a Runnable in the partition that contains the
+	/// processor the calling thread is currently running on. A
+	/// thread that has just received data on one node thus hands
+	/// the work to threads on the same node. If the local partition
+	/// has no thread available, the Runnable is started in the next
+	/// partition that has one.
+	///
+	/// Each partition is a ThreadPool of its own, with its own
+	/// capacity, and can be used directly via partition().
+{
+public:
+	typedef CPUTopology::CPUSet CPUSet;
+
+	PartitionedThreadPool(int minCapacity = 2,
+		int maxCapacity = 16,
+		int idleTime = 60,
+		int stackSize = POCO_THREAD_STACK_SIZE);
+		/// Creates a PartitionedThreadPool with one partition per
+		/// NUMA node of the system. The capacity arguments apply
+		/// to each partition; see ThreadPool for their meaning.
+
+	PartitionedThreadPool(const std::vector<CPUSet>& cpuSets,
+		int minCapacity = 2,
+		int maxCapacity = 16,
+		int idleTime = 60,
+		int stackSize = POCO_THREAD_STACK_SIZE);
+		/// Creates a PartitionedThreadPool with one partition for
+		/// each of the given processor sets, for example one per
+		/// physical core or per shared cache. The sets should not
+		/// overlap. An empty set creates a partition whose threads
+		/// may run on all processors.
+
+	~PartitionedThreadPool();
+		/// Stops all threads and destroys the PartitionedThreadPool.
+
+	int partitions() const;
+		/// Returns the number of partitions.
+
+	ThreadPool& partition(int index);
+		/// Returns the partition with the given index.
+
+	const CPUSet& cpus(int index) const;
+		/// Returns the processors of the partition with the given index.
+
+	int partitionOf(int cpu) const;
+		/// Returns the index of the partition that contains the
+		/// given processor, or -1 if no partition contains it.
+
+	int localPartition() const;
+		/// Returns the index of the partition that contains the
+		/// processor the calling thread is running on. If this
+		/// cannot be determined, partitions are handed out in
+		/// turn, so that the load is spread evenly.
+
+	void start(Runnable& target);
+		/// Starts the target in a thread from the local partition,
+		/// or, if the local partition has no thread available,
+		/// from the next partition that has one.
+		/// Throws a NoThreadAvailableException if no partition
+		/// has a thread available.
+
+	void start(Runnable& target, int partition);
+		/// Starts the target in a thread from the given partition,
+		/// with the same fallback as the other start() overload.
+
+	int capacity() const;
+		/// Returns the sum of the capacities of all partitions.
+
+	int used() const;
+		/// Returns the number of currently used threads
+		/// in all partitions.
+
+	int allocated() const;
+		/// Returns the number of currently allocated threads
+		/// in all partitions.
+
+	int available() const;
+		/// Returns the number of available threads
+		/// in all partitions.
+
+	void joinAll();
+		/// Waits for the threads of all partitions to complete.
+
+	void stopAll();
+		/// Stops the threads of all partitions.
+		/// See ThreadPool::stopAll().
+
+protected:
+	void create(const std::vector<CPUSet>& cpuSets, int minCapacity, int maxCapacity, int idleTime, int stackSize);
+
+private:
+	PartitionedThreadPool(const PartitionedThreadPool&);
+	PartitionedThreadPool& operator = (const PartitionedThreadPool&);
+
+	typedef std::vector<ThreadPool*> PoolVec;
+
+	PoolVec               _pools;
+	std::vector<CPUSet>   _cpuSets;
+	std::vector<int>      _cpuPartition;
+	mutable AtomicCounter _next;
+};
+
+
+//
+// inlines
+//
+inline int PartitionedThreadPool::partitions() const
+{
+	return static_cast<int>(_pools.size());
+}
+
+
+inline ThreadPool& PartitionedThreadPool::partition(int index)
+{
+	poco_assert (index >= 0 && index < partitions());
+
+	return *_pools[index];
+}
+
+
+inline const PartitionedThreadPool::CPUSet& PartitionedThreadPool::cpus(int index) const
+{
+	poco_assert (index >= 0 && index < partitions());
+
+	return _cpuSets[index];
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_PartitionedThreadPool_INCLUDED
@@ -0,0 +1,242 @@
+//
+// ProfilingMutex.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Threading
+// Module:  MutexProfile
+//
+// Definition of the ProfilingMutex class template.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_ProfilingMutex_INCLUDED
+#define Foundation_ProfilingMutex_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/MutexProfile.h"
+#include "Poco/Mutex.h"
+#include "Poco/Clock.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+
+
+template <class M = FastMutex>
+class ProfilingMutex
+	/// ProfilingMutex wraps a mutex (FastMutex by default, but
+	/// also Mutex, SpinMutex or any other class with the same
+	/// interface) and records how often it is acquired, how
+	/// often and how long threads have to wait for it, and
+	/// where it was held when they had to wait.
+	///
+	/// The statistics are kept in a MutexProfile, which is
+	/// shared by all ProfilingMutex objects with the same name,
+	/// and can be dumped at any time with
+	///     MutexProfileRegistry::defaultRegistry().dump(std::cout);
+	///
+	/// ProfilingMutex can be used in place of any mutex, and as
+	/// the mutex policy of class templates like BasicEvent or
+	/// AbstractCache. As it uses the default constructor, such
+	/// a policy shares a profile named "ProfilingMutex".
+	///
+	/// A call site is a string literal, usually given by the
+	/// POCO_LOCK_SITE macro, which expands to the file name and
+	/// line number. Call sites given to lockAt(), tryLockAt() or
+	/// the ScopedLock constructor are reported for the thread that held the mutex
+	/// when another thread had to wait for it. Reading the current
+	/// holder's call site is not synchronized, so the reported
+	/// call sites are an approximation.
+	///
+	/// Example:
+	///     Poco::ProfilingMutex<> mutex("SessionCache");
+	///     ...
+	///     Poco::ProfilingMutex<>::ScopedLock lock(mutex, POCO_LOCK_SITE);
+	///
+	/// Profiling adds an atomic increment to every uncontended
+	/// acquisition and reading the clock to every contended one.
+{
+public:
+	class ScopedLock
+		/// Locks the ProfilingMutex for the lifetime
+		/// of the ScopedLock.
+	{
+	public:
+		explicit ScopedLock(ProfilingMutex& mutex, const char* site = 0):
+			_mutex(mutex)
+		{
+			_mutex.lockAt(site);
+		}
+
+		ScopedLock(ProfilingMutex& mutex, long milliseconds, const char* site = 0):
+			_mutex(mutex)
+		{
+			if (!_mutex.tryLockAt(milliseconds, site))
+				throw TimeoutException();
+		}
+
+		~ScopedLock()
+		{
+			try
+			{
+				_mutex.unlock();
+			}
+			catch (...)
+			{
+				poco_unexpected();
+			}
+		}
+
+		void unlock()
+		{
+			_mutex.unlock();
+		}
+
+	private:
+		ScopedLock();
+		ScopedLock(const ScopedLock&);
+		ScopedLock& operator = (const ScopedLock&);
+
+		ProfilingMutex& _mutex;
+	};
+
+	ProfilingMutex():
+		_pProfile(MutexProfileRegistry::defaultRegistry().profile("ProfilingMutex")),
+		_pSite(0)
+		/// Creates the ProfilingMutex, using the
+		/// profile named "ProfilingMutex".
+	{
+	}
+
+	explicit ProfilingMutex(const std::string& name):
+		_pProfile(MutexProfileRegistry::defaultRegistry().profile(name)),
+		_pSite(0)
+		/// Creates the ProfilingMutex, using the
+		/// profile with the given name.
+	{
+	}
+
+	~ProfilingMutex()
+		/// Destroys the ProfilingMutex.
+	{
+	}
+
+	void lock()
+		/// Locks the mutex. Blocks if the mutex
+		/// is held by another thread.
+	{
+		lockAt(0);
+	}
+
+	void lock(long milliseconds)
+		/// Locks the mutex. Blocks up to the given number of milliseconds
+		/// if the mutex is held by another thread. Throws a TimeoutException
+		/// if the mutex can not be locked within the given timeout.
+	{
+		if (!tryLockAt(milliseconds, 0))
+			throw TimeoutException();
+	}
+
+	bool tryLock()
+		/// Tries to lock the mutex. Returns false immediately
+		/// if the mutex is already held by another thread.
+		/// Returns true if the mutex was successfully locked.
+	{
+		if (_mutex.tryLock())
+		{
+			_pProfile->acquired();
+			_pSite = 0;
+			return true;
+		}
+		return false;
+	}
+
+	bool tryLock(long milliseconds)
+		/// Locks the mutex. Blocks up to the given number of milliseconds
+		/// if the mutex is held by another thread.
+		/// Returns true if the mutex was successfully locked.
+	{
+		return tryLockAt(milliseconds, 0);
+	}
+
+	void lockAt(const char* site)
+		/// Locks the mutex, like lock(), and records the
+		/// given call site as the current holder.
+	{
+		if (_mutex.tryLock())
+		{
+			_pProfile->acquired();
+		}
+		else
+		{
+			const char* pHolderSite = _pSite;
+			Clock start;
+			_mutex.lock();
+			_pProfile->contended(start.elapsed(), pHolderSite);
+		}
+		_pSite = site;
+	}
+
+	bool tryLockAt(long milliseconds, const char* site)
+		/// Locks the mutex, like tryLock(milliseconds), and
+		/// records the given call site as the current holder.
+	{
+		if (_mutex.tryLock())
+		{
+			_pProfile->acquired();
+		}
+		else
+		{
+			const char* pHolderSite = _pSite;
+			Clock start;
+			if (!_mutex.tryLock(milliseconds)) return false;
+			_pProfile->contended(start.elapsed(), pHolderSite);
+		}
+		_pSite = site;
+		return true;
+	}
+
+	void unlock()
+		/// Unlocks the mutex so that it can be acquired by
+		/// other threads.
+	{
+		_pSite = 0;
+		_mutex.unlock();
+	}
+
+	MutexProfile& profile()
+		/// Returns the MutexProfile of the mutex.
+	{
+		return *_pProfile;
+	}
+
+private:
+	ProfilingMutex(const ProfilingMutex&);
+	ProfilingMutex& operator = (const ProfilingMutex&);
+
+	M _mutex;
+	MutexProfile::Ptr _pProfile;
+	const char* volatile _pSite;
+};
+
+
+} // namespace Poco
+
+
+#define POCO_LOCK_SITE_STR_(l) #l
+#define POCO_LOCK_SITE_STR(l) POCO_LOCK_SITE_STR_(l)
+#define POCO_LOCK_SITE __FILE__ ":" POCO_LOCK_SITE_STR(__LINE__)
+	/// Expands to a string literal holding the current
+	/// file name and line number, for use as call site
+	/// of a ProfilingMutex.
+
+
+#endif // Foundation_ProfilingMutex_INCLUDED
@@ -0,0 +1,268 @@
+//
+// ShardedRWLock.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Threading
+// Module:  ShardedRWLock
+//
+// Definition of the ShardedRWLock class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_ShardedRWLock_INCLUDED
+#define Foundation_ShardedRWLock_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/Mutex.h"
+
+
+namespace Poco {
+
+
+class ScopedShardedRWLock;
+class ScopedReadShardedRWLock;
+class ScopedWriteShardedRWLock;
+
+
+class Foundation_API ShardedRWLock
+	/// A ShardedRWLock (also known as a big-reader lock) is a
+	/// reader writer lock for data that is read very often and
+	/// changed rarely, such as configuration or routing tables.
+	///
+	/// With RWLock, every reader modifies the same lock word,
+	/// so under heavy read load the cache line holding it moves
+	/// between all processors taking part. A ShardedRWLock instead
+	/// keeps one reader counter per slot, each in its own cache line.
+	/// A thread always uses the same slot, which is selected by
+	/// its thread ID, and the number of slots defaults to twice the
+	/// number of processors, so concurrent readers mostly touch
+	/// memory no other processor uses.
+	///
+	/// The price is paid by writers: a writer blocks new readers
+	/// and then has to wait until the counters of all slots have
+	/// dropped to zero. Writers take precedence over readers that
+	/// have not yet acquired the lock.
+	///
+	/// The lock is not recursive. The results are undefined if a
+	/// thread that holds a read or write lock calls readLock() or
+	/// writeLock() on the same ShardedRWLock.
+{
+public:
+	typedef ScopedShardedRWLock ScopedLock;
+	typedef ScopedReadShardedRWLock ScopedReadLock;
+	typedef ScopedWriteShardedRWLock ScopedWriteLock;
+
+	explicit ShardedRWLock(int slots = 0);
+		/// Creates the ShardedRWLock with the given number
+		/// of reader slots, rounded up to the next power of two.
+		/// If slots is 0, twice the number of processors
+		/// is used.
+
+	~ShardedRWLock();
+		/// Destroys the ShardedRWLock.
+
+	void readLock();
+		/// Acquires a read lock. If another thread currently holds
+		/// or waits for a write lock, waits until the write lock
+		/// is released.
+
+	bool tryReadLock();
+		/// Tries to acquire a read lock. Immediately returns true if
+		/// successful, or false if another thread currently holds
+		/// or waits for a write lock.
+
+	void writeLock();
+		/// Acquires a write lock. Waits until all other threads
+		/// have released their locks.
+
+	bool tryWriteLock();
+		/// Tries to acquire a write lock. Immediately returns true
+		/// if successful, or false if one or more other threads
+		/// currently hold locks.
+
+	void unlock();
+		/// Releases the read or write lock.
+
+	void readUnlock();
+		/// Releases a read lock. Slightly faster than unlock().
+
+	void writeUnlock();
+		/// Releases a write lock. Slightly faster than unlock().
+
+	int slots() const;
+		/// Returns the number of reader slots.
+
+protected:
+	struct Slot
+	{
+		AtomicCounter readers;
+		char          pad[64];
+	};
+
+	Slot& slot();
+	bool enterRead(Slot& slot);
+	void waitForReaders();
+
+private:
+	ShardedRWLock(const ShardedRWLock&);
+	ShardedRWLock& operator = (const ShardedRWLock&);
+
+	int            _mask;
+	Slot*          _slots;
+	AtomicCounter  _writer;
+	volatile bool  _writeLocked;
+	FastMutex      _writeMutex;
+};
+
+
+class Foundation_API ScopedShardedRWLock
+	/// A variant of ScopedLock for ShardedRWLock.
+{
+public:
+	ScopedShardedRWLock(ShardedRWLock& rwl, bool write = false);
+	~ScopedShardedRWLock();
+
+private:
+	ShardedRWLock& _rwl;
+	bool _write;
+
+	ScopedShardedRWLock();
+	ScopedShardedRWLock(const ScopedShardedRWLock&);
+	ScopedShardedRWLock& operator = (const ScopedShardedRWLock&);
+};
+
+
+class Foundation_API ScopedReadShardedRWLock: public ScopedShardedRWLock
+	/// A variant of ScopedLock for ShardedRWLock reader locks.
+{
+public:
+	ScopedReadShardedRWLock(ShardedRWLock& rwl);
+	~ScopedReadShardedRWLock();
+};
+
+
+class Foundation_API ScopedWriteShardedRWLock: public ScopedShardedRWLock
+	/// A variant of ScopedLock for ShardedRWLock writer locks.
+{
+public:
+	ScopedWriteShardedRWLock(ShardedRWLock& rwl);
+	~ScopedWriteShardedRWLock();
+};
+
+
+//
+// inlines
+//
+inline bool ShardedRWLock::enterRead(Slot& slot)
+{
+	// Register first, then check for a writer. The increment is a
+	// full barrier, so either we see the writer's flag, or the
+	// writer sees our registration.
+	++slot.readers;
+	if (_writer.value() == 0) return true;
+	--slot.readers;
+	return false;
+}
+
+
+inline void ShardedRWLock::readLock()
+{
+	Slot& s = slot();
+	while (!enterRead(s))
+	{
+		// Wait for the writer to finish.
+		_writeMutex.lock();
+		_writeMutex.unlock();
+	}
+}
+
+
+inline bool ShardedRWLock::tryReadLock()
+{
+	return enterRead(slot());
+}
+
+
+inline void ShardedRWLock::readUnlock()
+{
+	--slot().readers;
+}
+
+
+inline void ShardedRWLock::unlock()
+{
+	// A write lock can only be held while no read lock is, so
+	// the flag can only be set here if we hold the write lock.
+	if (_writeLocked)
+		writeUnlock();
+	else
+		readUnlock();
+}
+
+
+inline int ShardedRWLock::slots() const
+{
+	return _mask + 1;
+}
+
+
+inline ScopedShardedRWLock::ScopedShardedRWLock(ShardedRWLock& rwl, bool write):
+	_rwl(rwl),
+	_write(write)
+{
+	if (write)
+		_rwl.writeLock();
+	else
+		_rwl.readLock();
+}
+
+
+inline ScopedShardedRWLock::~ScopedShardedRWLock()
+{
+	try
+	{
+		if (_write)
+			_rwl.writeUnlock();
+		else
+			_rwl.readUnlock();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+inline ScopedReadShardedRWLock::ScopedReadShardedRWLock(ShardedRWLock& rwl): ScopedShardedRWLock(rwl, false)
+{
+}
+
+
+inline ScopedReadShardedRWLock::~ScopedReadShardedRWLock()
+{
+}
+
+
+inline ScopedWriteShardedRWLock::ScopedWriteShardedRWLock(ShardedRWLock& rwl): ScopedShardedRWLock(rwl, true)
+{
+}
+
+
+inline ScopedWriteShardedRWLock::~ScopedWriteShardedRWLock()
+{
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ShardedRWLock_INCLUDED
@@ -31,9 +31,12 @@ namespace Poco {
 
 class ReferenceCounter
 	/// Simple ReferenceCounter object, does not delete itself when count reaches 0.
+	///
+	/// The counter is lock free on all platforms AtomicCounter
+	/// supports natively.
 {
 public:
-	ReferenceCounter(): _cnt(1)
+	ReferenceCounter(): _cnt(1), _pDispose(0)
 	{
 	}
 
@@ -52,8 +55,90 @@ public:
 		return _cnt.value();
 	}
 
+	bool dispose()
+		/// If the counter shares its memory block with the
+		/// object (see makeShared()), destroys the object,
+		/// frees the block and returns true. Otherwise,
+		/// returns false.
+	{
+		if (!_pDispose) return false;
+		_pDispose(this);
+		return true;
+	}
+
+protected:
+	typedef void (*Dispose)(ReferenceCounter*);
+
+	explicit ReferenceCounter(Dispose pDispose): _cnt(0), _pDispose(pDispose)
+		/// Creates a counter that lives in the same memory
+		/// block as the object. The count starts at zero and
+		/// is incremented by the SharedPtr taking it over.
+	{
+	}
+
 private:
 	AtomicCounter _cnt;
+	Dispose       _pDispose;
+};
+
+
+template <class C>
+class SharedBlock: public ReferenceCounter
+	/// The memory block allocated by makeShared(), holding
+	/// both the reference counter and the object.
+{
+public:
+	SharedBlock():
+		ReferenceCounter(&destroy),
+		object()
+	{
+	}
+
+	template <class A1>
+	SharedBlock(const A1& a1):
+		ReferenceCounter(&destroy),
+		object(a1)
+	{
+	}
+
+	template <class A1, class A2>
+	SharedBlock(const A1& a1, const A2& a2):
+		ReferenceCounter(&destroy),
+		object(a1, a2)
+	{
+	}
+
+	template <class A1, class A2, class A3>
+	SharedBlock(const A1& a1, const A2& a2, const A3& a3):
+		ReferenceCounter(&destroy),
+		object(a1, a2, a3)
+	{
+	}
+
+	template <class A1, class A2, class A3, class A4>
+	SharedBlock(const A1& a1, const A2& a2, const A3& a3, const A4& a4):
+		ReferenceCounter(&destroy),
+		object(a1, a2, a3, a4)
+	{
+	}
+
+	template <class A1, class A2, class A3, class A4, class A5>
+	SharedBlock(const A1& a1, const A2& a2, const A3& a3, const A4& a4, const A5& a5):
+		ReferenceCounter(&destroy),
+		object(a1, a2, a3, a4, a5)
+	{
+	}
+
+	C object;
+
+private:
+	SharedBlock(const SharedBlock&);
+	SharedBlock& operator = (const SharedBlock&);
+
+	static void destroy(ReferenceCounter* pCounter)
+	{
+		delete static_cast<SharedBlock*>(pCounter);
+	}
 };
 
 
@@ -130,6 +215,16 @@ public:
 		RP::release(ptr);
 	}
 
+	explicit SharedPtr(SharedBlock<C>& block):
+		_pCounter(&block),
+		_ptr(&block.object)
+		/// Takes over the object and the counter in the
+		/// given block, which must have been created with
+		/// new. Used by makeShared().
+	{
+		_pCounter->duplicate();
+	}
+
 	template <class Other, class OtherRP> 
 	SharedPtr(const SharedPtr<Other, RC, OtherRP>& ptr): _pCounter(ptr._pCounter), _ptr(const_cast<Other*>(ptr.get()))
 	{
@@ -393,14 +488,28 @@ private:
 		int i = _pCounter->release();
 		if (i == 0)
 		{
-			RP::release(_ptr);
+			destroy(_pCounter);
 			_ptr = 0;
-
-			delete _pCounter;
 			_pCounter = 0;
 		}
 	}
 
+	template <class OtherRC>
+	void destroy(OtherRC* pCounter)
+	{
+		RP::release(_ptr);
+		delete pCounter;
+	}
+
+	void destroy(ReferenceCounter* pCounter)
+	{
+		if (!pCounter->dispose())
+		{
+			RP::release(_ptr);
+			delete pCounter;
+		}
+	}
+
 	SharedPtr(RC* pCounter, C* ptr): _pCounter(pCounter), _ptr(ptr)
 		/// for cast operation
 	{
@@ -423,6 +532,54 @@ inline void swap(SharedPtr<C, RC, RP>& p1, SharedPtr<C, RC, RP>& p2)
 }
 
 
+template <class C>
+inline SharedPtr<C> makeShared()
+	/// Creates an object of class C, together with its reference
+	/// counter, in a single memory block and returns a SharedPtr
+	/// to it. This saves one allocation over SharedPtr<C>(new C).
+	///
+	/// Up to five constructor arguments are supported, which
+	/// are passed by const reference.
+{
+	return SharedPtr<C>(*new SharedBlock<C>);
+}
+
+
+template <class C, class A1>
+inline SharedPtr<C> makeShared(const A1& a1)
+{
+	return SharedPtr<C>(*new SharedBlock<C>(a1));
+}
+
+
+template <class C, class A1, class A2>
+inline SharedPtr<C> makeShared(const A1& a1, const A2& a2)
+{
+	return SharedPtr<C>(*new SharedBlock<C>(a1, a2));
+}
+
+
+template <class C, class A1, class A2, class A3>
+inline SharedPtr<C> makeShared(const A1& a1, const A2& a2, const A3& a3)
+{
+	return SharedPtr<C>(*new SharedBlock<C>(a1, a2, a3));
+}
+
+
+template <class C, class A1, class A2, class A3, class A4>
+inline SharedPtr<C> makeShared(const A1& a1, const A2& a2, const A3& a3, const A4& a4)
+{
+	return SharedPtr<C>(*new SharedBlock<C>(a1, a2, a3, a4));
+}
+
+
+template <class C, class A1, class A2, class A3, class A4, class A5>
+inline SharedPtr<C> makeShared(const A1& a1, const A2& a2, const A3& a3, const A4& a4, const A5& a5)
+{
+	return SharedPtr<C>(*new SharedBlock<C>(a1, a2, a3, a4, a5));
+}
+
+
 } // namespace Poco
 
 
@@ -0,0 +1,255 @@
+//
+// SnapshotHolder.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  SnapshotHolder
+//
+// Definition of the SnapshotHolder class template.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_SnapshotHolder_INCLUDED
+#define Foundation_SnapshotHolder_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/RefCountedObject.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/Mutex.h"
+#include <vector>
+
+
+namespace Poco {
+
+
+template <class T>
+class SnapshotHolder
+	/// SnapshotHolder keeps a value of type T in an immutable,
+	/// reference counted snapshot that can be read by any number
+	/// of threads without taking a lock or allocating memory.
+	///
+	/// Values are never changed in place. To modify the value, a
+	/// writer creates a copy of the current snapshot with clone(),
+	/// modifies the copy and makes it the current snapshot with
+	/// publish(). Threads that are reading the previous snapshot
+	/// at that time continue to use it undisturbed; it is deleted
+	/// when no more readers are active.
+	///
+	/// Readers use a ScopedRead object:
+	///
+	///     SnapshotHolder<std::vector<int> >::ScopedRead snapshot(holder);
+	///     for (std::vector<int>::const_iterator it = snapshot.value().begin(); ...)
+	///
+	/// Calls to clone(), publish() and current() must be serialized
+	/// by the caller, typically by holding a mutex.
+	///
+	/// Outdated snapshots are reclaimed when no reader is active,
+	/// either by a writer or by the last reader to leave. A reader
+	/// only ever tries to lock the internal mutex, so it never waits.
+	/// If readers are active all the time, outdated snapshots
+	/// accumulate until the next quiet moment.
+{
+public:
+	class Snapshot: public RefCountedObject
+		/// A reference counted snapshot of the value.
+	{
+	public:
+		Snapshot()
+		{
+		}
+
+		explicit Snapshot(const T& value):
+			_value(value)
+		{
+		}
+
+		T& value()
+			/// Returns the value. The value must not be
+			/// modified once the snapshot has been published.
+		{
+			return _value;
+		}
+
+	protected:
+		~Snapshot()
+		{
+		}
+
+	private:
+		T _value;
+	};
+
+	typedef AutoPtr<Snapshot> SnapshotPtr;
+
+	class ScopedRead
+		/// Gives access to the current snapshot for as
+		/// long as the ScopedRead object exists.
+	{
+	public:
+		explicit ScopedRead(const SnapshotHolder& holder):
+			_holder(holder),
+			_pSnapshot(holder.enter())
+		{
+		}
+
+		~ScopedRead()
+		{
+			try
+			{
+				_holder.leave();
+			}
+			catch (...)
+			{
+				poco_unexpected();
+			}
+		}
+
+		T& value() const
+		{
+			return _pSnapshot->value();
+		}
+
+		Snapshot* snapshot() const
+		{
+			return _pSnapshot;
+		}
+
+	private:
+		ScopedRead();
+		ScopedRead(const ScopedRead&);
+		ScopedRead& operator = (const ScopedRead&);
+
+		const SnapshotHolder& _holder;
+		Snapshot* _pSnapshot;
+	};
+
+	SnapshotHolder():
+		_pCurrent(new Snapshot)
+	{
+	}
+
+	explicit SnapshotHolder(const T& value):
+		_pCurrent(new Snapshot(value))
+	{
+	}
+
+	~SnapshotHolder()
+	{
+		poco_assert_dbg (_readers.value() == 0);
+
+		for (typename SnapshotVec::iterator it = _retired.begin(); it != _retired.end(); ++it)
+		{
+			(*it)->release();
+		}
+		_pCurrent->release();
+	}
+
+	SnapshotPtr acquire() const
+		/// Returns the current snapshot. The snapshot stays valid
+		/// as long as the returned pointer exists, even if it is
+		/// replaced in the meantime.
+	{
+		ScopedRead read(*this);
+		return SnapshotPtr(read.snapshot(), true);
+	}
+
+	const T& current() const
+		/// Returns the value of the current snapshot.
+		///
+		/// Must only be called by writers.
+	{
+		return _pCurrent->value();
+	}
+
+	Snapshot* clone() const
+		/// Returns a new snapshot holding a copy of the current value.
+		///
+		/// Must only be called by writers.
+	{
+		return new Snapshot(_pCurrent->value());
+	}
+
+	void publish(Snapshot* pSnapshot)
+		/// Makes the given snapshot, which must have been
+		/// created with clone(), the current snapshot.
+		/// Takes ownership of the snapshot.
+		///
+		/// Must only be called by writers.
+	{
+		poco_check_ptr (pSnapshot);
+
+		Snapshot* pOld = _pCurrent;
+		// The full barriers around the store make sure readers see a
+		// completely constructed snapshot, and that we see every reader
+		// that may still be using the old one. Aligned pointer stores and
+		// loads are atomic on all supported platforms.
+		++_publishCount;
+		_pCurrent = pSnapshot;
+		++_publishCount;
+
+		FastMutex::ScopedLock lock(_retireMutex);
+		_retired.push_back(pOld);
+		_retiredCount = static_cast<int>(_retired.size());
+		reclaim();
+	}
+
+private:
+	SnapshotHolder(const SnapshotHolder&);
+	SnapshotHolder& operator = (const SnapshotHolder&);
+
+	typedef std::vector<Snapshot*> SnapshotVec;
+
+	Snapshot* enter() const
+	{
+		// Register before loading the pointer, so that a writer
+		// replacing the snapshot will not reclaim it under us.
+		++_readers;
+		return _pCurrent;
+	}
+
+	void leave() const
+	{
+		if (--_readers == 0 && _retiredCount.value() > 0 && _retireMutex.tryLock())
+		{
+			reclaim();
+			_retireMutex.unlock();
+		}
+	}
+
+	void reclaim() const
+		/// Releases retired snapshots if no reader is active.
+		/// The caller must hold _retireMutex.
+	{
+		if (_readers.value() == 0)
+		{
+			for (typename SnapshotVec::iterator it = _retired.begin(); it != _retired.end(); ++it)
+			{
+				(*it)->release();
+			}
+			_retired.clear();
+			_retiredCount = 0;
+		}
+	}
+
+	Snapshot* volatile    _pCurrent;
+	mutable AtomicCounter _readers;
+	AtomicCounter         _publishCount;
+	mutable AtomicCounter _retiredCount;
+	mutable SnapshotVec   _retired;
+	mutable FastMutex     _retireMutex;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_SnapshotHolder_INCLUDED
@@ -0,0 +1,178 @@
+//
+// SpinMutex.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Threading
+// Module:  SpinMutex
+//
+// Definition of the SpinMutex class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_SpinMutex_INCLUDED
+#define Foundation_SpinMutex_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/Event.h"
+#include "Poco/ScopedLock.h"
+
+
+namespace Poco {
+
+
+class Foundation_API SpinMutex
+	/// A SpinMutex is a non-recursive mutex for very short
+	/// critical sections.
+	///
+	/// A thread that finds the SpinMutex locked first spins for
+	/// a while, waiting for the holder to release it, before it
+	/// parks itself until woken up by unlock(). The number of
+	/// spins is adapted at run time to how long the SpinMutex
+	/// usually stays locked, so that a thread does not burn
+	/// processor time waiting for a holder that will not release
+	/// the lock soon. On a single processor machine, threads
+	/// never spin.
+	///
+	/// Locking and unlocking an uncontended SpinMutex takes a
+	/// single atomic operation each and no system call.
+	///
+	/// The results are undefined if a thread that holds the
+	/// SpinMutex calls lock() again, or if a thread other than
+	/// the holder calls unlock().
+{
+public:
+	typedef Poco::ScopedLock<SpinMutex> ScopedLock;
+
+	SpinMutex();
+		/// Creates the SpinMutex.
+
+	~SpinMutex();
+		/// Destroys the SpinMutex.
+
+	void lock();
+		/// Locks the SpinMutex. Spins and then blocks if the
+		/// SpinMutex is held by another thread.
+
+	void lock(long milliseconds);
+		/// Locks the SpinMutex. Blocks up to the given number of
+		/// milliseconds if the SpinMutex is held by another thread.
+		/// Throws a TimeoutException if the SpinMutex can not be
+		/// locked within the given timeout.
+
+	bool tryLock();
+		/// Tries to lock the SpinMutex. Returns false immediately
+		/// if the SpinMutex is already held by another thread.
+		/// Returns true if the SpinMutex was successfully locked.
+
+	bool tryLock(long milliseconds);
+		/// Locks the SpinMutex. Blocks up to the given number of
+		/// milliseconds if the SpinMutex is held by another thread.
+		/// Returns true if the SpinMutex was successfully locked.
+
+	void unlock();
+		/// Unlocks the SpinMutex so that it can be acquired by
+		/// other threads.
+
+	int spinLimit() const;
+		/// Returns the number of spins a thread currently
+		/// makes before parking.
+
+	static void pause();
+		/// Tells the processor that the calling thread is
+		/// spinning. Does nothing on processors without
+		/// such an instruction.
+
+protected:
+	enum State
+	{
+		UNLOCKED = 0,
+		LOCKED   = 1,
+		CONTENDED = 2 // locked, and threads may be parked
+	};
+
+	bool spin();
+	void park();
+	bool park(long milliseconds);
+	int exchange(int state);
+
+private:
+	SpinMutex(const SpinMutex&);
+	SpinMutex& operator = (const SpinMutex&);
+
+	AtomicCounter _state;
+	int _spinLimit;
+	Event _wakeup;
+
+	static const int MAX_SPINS;
+};
+
+
+//
+// inlines
+//
+inline void SpinMutex::lock()
+{
+	if (!_state.compareAndSet(UNLOCKED, LOCKED) && !spin())
+	{
+		park();
+	}
+}
+
+
+inline bool SpinMutex::tryLock()
+{
+	return _state.compareAndSet(UNLOCKED, LOCKED);
+}
+
+
+inline void SpinMutex::unlock()
+{
+	if (exchange(UNLOCKED) == CONTENDED)
+	{
+		_wakeup.set();
+	}
+}
+
+
+inline int SpinMutex::spinLimit() const
+{
+	return _spinLimit;
+}
+
+
+inline void SpinMutex::pause()
+{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	YieldProcessor();
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	__asm__ __volatile__ ("pause");
+#elif defined(__GNUC__) && defined(__aarch64__)
+	__asm__ __volatile__ ("yield");
+#endif
+}
+
+
+inline int SpinMutex::exchange(int state)
+{
+	int previous = _state.value();
+	while (!_state.compareAndSet(previous, state))
+	{
+		previous = _state.value();
+	}
+	return previous;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_SpinMutex_INCLUDED
@@ -37,6 +37,9 @@ class Foundation_API StreamConverterBuf: public UnbufferedStreamBuf
 	/// is used instead.
 	/// If a byte sequence is not valid in inEncoding, defaultChar is used
 	/// instead and the encoding error count is incremented.
+	///
+	/// Valid UTF-8 written to a StreamConverterBuf that converts from
+	/// UTF-8 to UTF-8 (like XMLWriter's) is passed on in bulk.
 {
 public:
 	StreamConverterBuf(std::istream& istr, const TextEncoding& inEncoding, const TextEncoding& outEncoding, int defaultChar = '?');
@@ -58,6 +61,8 @@ protected:
 	int writeToDevice(char c);
 
 private:
+	std::streamsize xsputn(const char* s, std::streamsize count);
+
 	std::istream*       _pIstr;
 	std::ostream*       _pOstr;
 	const TextEncoding& _inEncoding;
@@ -67,6 +72,7 @@ private:
 	int                 _sequenceLength;
 	int                 _pos;
 	int                 _errors;
+	bool                _utf8;
 };
 
 
@@ -0,0 +1,264 @@
+//
+// StringPool.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  StringPool
+//
+// Definition of the StringPool and InternedString classes.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_StringPool_INCLUDED
+#define Foundation_StringPool_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/RWLock.h"
+#include <vector>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API InternedString
+	/// A handle to a string stored in a StringPool.
+	///
+	/// An InternedString is as small as a pointer and can be
+	/// copied freely. Two InternedStrings obtained from the same
+	/// StringPool are equal if and only if they refer to the
+	/// same string, so comparing them for equality takes
+	/// constant time. The hash of the string is computed once,
+	/// when the string is added to the pool.
+	///
+	/// operator < orders InternedStrings by identity, not
+	/// lexicographically; it is meant for use as a key in
+	/// sorted containers.
+	///
+	/// An InternedString remains valid as long as its StringPool
+	/// exists. A default-constructed InternedString refers to
+	/// the empty string, which is shared by all pools.
+{
+public:
+	InternedString();
+		/// Creates an InternedString referring to the empty string.
+
+	const std::string& str() const;
+		/// Returns the string.
+
+	operator const std::string& () const;
+		/// Returns the string.
+
+	std::size_t hash() const;
+		/// Returns the hash of the string, as computed by
+		/// StringPool::hash().
+
+	bool empty() const;
+		/// Returns true if the string is empty.
+
+	bool operator == (const InternedString& other) const;
+	bool operator != (const InternedString& other) const;
+	bool operator <  (const InternedString& other) const;
+
+	void swap(InternedString& other);
+		/// Swaps the InternedString with another one.
+
+protected:
+	struct Entry
+	{
+		std::string str;
+		std::size_t hash;
+	};
+
+	explicit InternedString(const Entry* pEntry);
+
+private:
+	const Entry* _pEntry;
+
+	static const Entry EMPTY;
+
+	friend class StringPool;
+};
+
+
+class Foundation_API StringPool
+	/// A StringPool stores one copy of every string added to it
+	/// and hands out InternedString handles to these copies.
+	///
+	/// A StringPool is meant for strings that occur over and over
+	/// again, such as logger names or configuration keys. Strings
+	/// are never removed from the pool, so it must not be used for
+	/// strings coming from an unbounded set, such as names received
+	/// from the network.
+	///
+	/// Logger keeps the names of all loggers in a StringPool.
+	/// Configuration keys are not interned by Poco itself:
+	/// AbstractConfiguration does not store keys, and the
+	/// subclasses that do, such as MapConfiguration, expose their
+	/// std::string maps to their own subclasses. Applications may
+	/// still intern the keys they look up repeatedly.
+	///
+	/// All member functions are thread safe. The pool is divided
+	/// into shards, each with its own open addressing hash table
+	/// and read/write lock, so that threads interning different
+	/// strings rarely wait for each other, and looking up a string
+	/// that is already in the pool only takes a read lock.
+{
+public:
+	explicit StringPool(int shards = 16);
+		/// Creates a StringPool with the given number
+		/// of shards, which is rounded up to the next
+		/// power of two.
+
+	~StringPool();
+		/// Destroys the StringPool and all its strings.
+
+	InternedString intern(const std::string& str);
+		/// Returns the InternedString for the given string,
+		/// adding the string to the pool if necessary.
+
+	InternedString intern(const char* str, std::size_t length);
+		/// Returns the InternedString for the given characters,
+		/// adding them to the pool if necessary.
+
+	bool find(const std::string& str, InternedString& result) const;
+		/// Looks up the given string without adding it to the pool.
+		/// Returns true and stores the handle in result if the
+		/// string is in the pool; returns false otherwise.
+
+	std::size_t size() const;
+		/// Returns the number of strings in the pool.
+
+	static std::size_t hash(const char* str, std::size_t length);
+		/// Returns the hash (FNV-1a) of the given characters.
+
+	static StringPool& defaultPool();
+		/// Returns a reference to the default StringPool.
+
+protected:
+	typedef InternedString::Entry Entry;
+
+	struct Shard
+	{
+		Shard();
+
+		RWLock              lock;
+		std::vector<Entry*> table;
+		std::size_t         count;
+	};
+
+	const Entry* lookup(const Shard& shard, const char* str, std::size_t length, std::size_t h) const;
+	void insert(Shard& shard, Entry* pEntry);
+	Shard& shardFor(std::size_t h) const;
+
+private:
+	StringPool(const StringPool&);
+	StringPool& operator = (const StringPool&);
+
+	int    _mask;
+	Shard* _shards;
+};
+
+
+std::size_t Foundation_API hash(const InternedString& str);
+	/// Returns the precomputed hash of the given InternedString,
+	/// for use with Poco::Hash and HashMap.
+
+
+//
+// inlines
+//
+inline InternedString::InternedString():
+	_pEntry(&EMPTY)
+{
+}
+
+
+inline InternedString::InternedString(const Entry* pEntry):
+	_pEntry(pEntry)
+{
+}
+
+
+inline const std::string& InternedString::str() const
+{
+	return _pEntry->str;
+}
+
+
+inline InternedString::operator const std::string& () const
+{
+	return _pEntry->str;
+}
+
+
+inline std::size_t InternedString::hash() const
+{
+	return _pEntry->hash;
+}
+
+
+inline bool InternedString::empty() const
+{
+	return _pEntry->str.empty();
+}
+
+
+inline bool InternedString::operator == (const InternedString& other) const
+{
+	return _pEntry == other._pEntry;
+}
+
+
+inline bool InternedString::operator != (const InternedString& other) const
+{
+	return _pEntry != other._pEntry;
+}
+
+
+inline bool InternedString::operator < (const InternedString& other) const
+{
+	return _pEntry < other._pEntry;
+}
+
+
+inline void InternedString::swap(InternedString& other)
+{
+	const Entry* pEntry = _pEntry;
+	_pEntry = other._pEntry;
+	other._pEntry = pEntry;
+}
+
+
+inline void swap(InternedString& s1, InternedString& s2)
+{
+	s1.swap(s2);
+}
+
+
+inline InternedString StringPool::intern(const std::string& str)
+{
+	return intern(str.data(), str.size());
+}
+
+
+inline StringPool::Shard& StringPool::shardFor(std::size_t h) const
+{
+	// The low bits select the slot in the shard's table,
+	// so use the high bits to select the shard.
+	return _shards[(h >> (sizeof(std::size_t)*8 - 8)) & _mask];
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_StringPool_INCLUDED
@@ -32,6 +32,11 @@ class TextEncoding;
 class Foundation_API TextConverter
 	/// A TextConverter converts strings from one encoding
 	/// into another.
+	///
+	/// Conversions from UTF-8 to UTF-8 (as done by UTF8::toUpper()
+	/// and UTF8::toLower(), for example) are done in bulk by
+	/// UTF8Codec wherever the text is valid and unchanged by the
+	/// transform function.
 {
 public:
 	typedef int (*Transform)(int);
@@ -86,6 +91,7 @@ private:
 	const TextEncoding& _inEncoding;
 	const TextEncoding& _outEncoding;
 	int                 _defaultChar;
+	bool                _utf8;
 };
 
 
@@ -0,0 +1,238 @@
+//
+// ThreadCachingMemoryPool.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  ThreadCachingMemoryPool
+//
+// Definition of the ThreadCachingMemoryPool class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_ThreadCachingMemoryPool_INCLUDED
+#define Foundation_ThreadCachingMemoryPool_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/RefCountedObject.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/BatchStore.h"
+#include "Poco/ThreadLocal.h"
+#include "Poco/Mutex.h"
+#include "Poco/AutoPtr.h"
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API ThreadCachingMemoryPool
+	/// A pool for fixed-size memory blocks, like MemoryPool,
+	/// for use by many threads at once.
+	///
+	/// Every thread keeps a small cache of free blocks, so most
+	/// calls to get() and release() neither lock nor touch memory
+	/// shared with other threads. When its cache runs empty, a
+	/// thread takes a whole batch of blocks from a central free
+	/// list; when the cache holds too many blocks, it gives a batch
+	/// back. The central free list is a BatchStore, so no thread
+	/// ever waits for another one there.
+	///
+	/// If the central free list is full, returned batches are freed.
+	/// The pool thus retains at most maxBatches*batchSize blocks,
+	/// plus the blocks in the thread caches.
+	///
+	/// A block may be released by a different thread than the
+	/// one that got it; it then goes to the releasing thread's
+	/// cache.
+	///
+	/// A thread's cache is returned to the central free list when
+	/// the thread's thread local storage is cleared, that is, when
+	/// its Thread object is destroyed or, for threads from a
+	/// ThreadPool, when the thread's current task is finished.
+	/// Blocks still held in thread caches when the pool is
+	/// destroyed are freed when these threads return them.
+	///
+	/// Only threads started with Poco::Thread have their own
+	/// cache. All other threads, including the main thread, share
+	/// a single cache that is protected by a mutex.
+	///
+	/// The statistics are collected per thread and added to the
+	/// pool's totals whenever a thread exchanges a batch with the
+	/// central free list, so they lag behind by up to one batch
+	/// per thread.
+{
+public:
+	ThreadCachingMemoryPool(std::size_t blockSize, int batchSize = 32, int maxBatches = 64);
+		/// Creates a ThreadCachingMemoryPool for blocks with the given
+		/// blockSize. Blocks are exchanged between the thread caches
+		/// and the central free list in batches of batchSize blocks.
+		/// The central free list holds up to maxBatches batches.
+
+	~ThreadCachingMemoryPool();
+		/// Destroys the ThreadCachingMemoryPool.
+
+	void* get();
+		/// Returns a memory block. If neither the calling thread's
+		/// cache nor the central free list has a free block, a new
+		/// batch of blocks is allocated.
+
+	void release(void* ptr);
+		/// Releases a memory block and returns it to
+		/// the calling thread's cache.
+
+	std::size_t blockSize() const;
+		/// Returns the block size.
+
+	int batchSize() const;
+		/// Returns the number of blocks in a batch.
+
+	int allocated() const;
+		/// Returns the number of allocated blocks.
+
+	int available() const;
+		/// Returns the number of blocks in the central free list.
+		/// Blocks in the thread caches are not included.
+
+	int outstanding() const;
+		/// Returns the number of blocks currently in use.
+
+	int hits() const;
+		/// Returns the number of calls to get() that were
+		/// served from the calling thread's cache.
+
+	int misses() const;
+		/// Returns the number of calls to get() that had to take
+		/// a batch from the central free list or allocate one.
+
+protected:
+	class Central: public RefCountedObject
+		/// The central free list, shared with the thread caches,
+		/// which may outlive the pool.
+	{
+	public:
+		Central(std::size_t size, int batch, int maxBatches);
+
+		char* pop();
+		void push(char* pBatch);
+		char* allocate();
+		void free(char* pBatch);
+
+		std::size_t   blockSize;
+		int           batchSize;
+		AtomicCounter allocated;
+		AtomicCounter available;
+		AtomicCounter outstanding;
+		AtomicCounter hits;
+		AtomicCounter misses;
+
+	protected:
+		~Central();
+
+	private:
+		BatchStore<char> _store;
+	};
+
+	class Cache
+		/// A thread's cache of free blocks.
+	{
+	public:
+		Cache();
+		~Cache();
+
+		void* get();
+		void release(void* ptr);
+		void flush();
+
+		AutoPtr<Central> pCentral;
+
+	private:
+		Cache(const Cache&);
+		Cache& operator = (const Cache&);
+
+		char* _pHead;
+		int   _count;
+		int   _hits;
+		int   _misses;
+		int   _outstanding;
+	};
+
+	Cache& cache();
+
+private:
+	ThreadCachingMemoryPool();
+	ThreadCachingMemoryPool(const ThreadCachingMemoryPool&);
+	ThreadCachingMemoryPool& operator = (const ThreadCachingMemoryPool&);
+
+	AutoPtr<Central>   _pCentral;
+	ThreadLocal<Cache> _cache;
+	Cache              _sharedCache;
+	FastMutex          _sharedMutex;
+};
+
+
+//
+// inlines
+//
+inline std::size_t ThreadCachingMemoryPool::blockSize() const
+{
+	return _pCentral->blockSize;
+}
+
+
+inline int ThreadCachingMemoryPool::batchSize() const
+{
+	return _pCentral->batchSize;
+}
+
+
+inline int ThreadCachingMemoryPool::allocated() const
+{
+	return _pCentral->allocated.value();
+}
+
+
+inline int ThreadCachingMemoryPool::available() const
+{
+	return _pCentral->available.value();
+}
+
+
+inline int ThreadCachingMemoryPool::outstanding() const
+{
+	return _pCentral->outstanding.value();
+}
+
+
+inline int ThreadCachingMemoryPool::hits() const
+{
+	return _pCentral->hits.value();
+}
+
+
+inline int ThreadCachingMemoryPool::misses() const
+{
+	return _pCentral->misses.value();
+}
+
+
+inline ThreadCachingMemoryPool::Cache& ThreadCachingMemoryPool::cache()
+{
+	Cache& c = *_cache;
+	if (!c.pCentral) c.pCentral = _pCentral;
+	return c;
+}
+
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ThreadCachingMemoryPool_INCLUDED
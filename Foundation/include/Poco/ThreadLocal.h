@@ -21,7 +21,7 @@
 
 
 #include "Poco/Foundation.h"
-#include <map>
+#include <vector>
 
 
 namespace Poco {
@@ -71,6 +71,14 @@ class Foundation_API ThreadLocalStorage
 	/// This class manages the local storage for each thread.
 	/// Never use this class directly, always use the
 	/// ThreadLocal template for managing thread local storage.
+	///
+	/// Every ThreadLocal object is assigned a small integer
+	/// index when it is created, and a thread's slots are kept
+	/// in a vector indexed by it, so finding a slot takes
+	/// constant time. Indexes of destroyed ThreadLocal objects
+	/// are reused. Each index therefore also carries a generation
+	/// number, so that a slot left behind by a destroyed
+	/// ThreadLocal is never handed out to its successor.
 {
 public:
 	ThreadLocalStorage();
@@ -79,21 +87,39 @@ public:
 	~ThreadLocalStorage();
 		/// Deletes the TLS.
 
-	TLSAbstractSlot*& get(const void* key);
-		/// Returns the slot for the given key.
+	TLSAbstractSlot*& get(int index, UInt32 generation);
+		/// Returns the slot for the given index and generation.
 		
 	static ThreadLocalStorage& current();
 		/// Returns the TLS object for the current thread
 		/// (which may also be the main thread).
+		///
+		/// Where the compiler supports it (and POCO_NO_THREAD_LOCAL
+		/// is not defined), the result is cached in a native
+		/// thread local variable.
 		
 	static void clear();
 		/// Clears the current thread's TLS object.
 		/// Does nothing in the main thread.
+
+	static int allocateIndex(UInt32& generation);
+		/// Reserves an index for a new ThreadLocal object
+		/// and returns it, together with its generation.
+
+	static void releaseIndex(int index);
+		/// Releases an index reserved with allocateIndex().
 	
 private:
-	typedef std::map<const void*, TLSAbstractSlot*> TLSMap;
-	
-	TLSMap _map;
+	struct Entry
+	{
+		TLSAbstractSlot* pSlot;
+		UInt32           generation;
+	};
+	typedef std::vector<Entry> EntryVec;
+
+	TLSAbstractSlot*& add(int index, UInt32 generation);
+
+	EntryVec _entries;
 
 	friend class Thread;
 };
@@ -117,12 +143,14 @@ class ThreadLocal
 	typedef TLSSlot<C> Slot;
 
 public:
-	ThreadLocal()
+	ThreadLocal():
+		_index(ThreadLocalStorage::allocateIndex(_generation))
 	{
 	}
 	
 	~ThreadLocal()
 	{
+		ThreadLocalStorage::releaseIndex(_index);
 	}
 	
 	C* operator -> ()
@@ -142,7 +170,7 @@ public:
 		/// Returns a reference to the underlying data object.
 		/// The reference can be used to modify the object.
 	{
-		TLSAbstractSlot*& p = ThreadLocalStorage::current().get(this);
+		TLSAbstractSlot*& p = ThreadLocalStorage::current().get(_index, _generation);
 		if (!p) p = new Slot;
 		return static_cast<Slot*>(p)->value();
 	}
@@ -150,9 +178,26 @@ public:
 private:
 	ThreadLocal(const ThreadLocal&);
 	ThreadLocal& operator = (const ThreadLocal&);
+
+	UInt32 _generation;
+	int    _index;
 };
 
 
+//
+// inlines
+//
+inline TLSAbstractSlot*& ThreadLocalStorage::get(int index, UInt32 generation)
+{
+	if (index < static_cast<int>(_entries.size()))
+	{
+		Entry& entry = _entries[index];
+		if (entry.generation == generation) return entry.pSlot;
+	}
+	return add(index, generation);
+}
+
+
 } // namespace Poco
 
 
@@ -106,6 +106,18 @@ public:
 	ThreadAffinityPolicy getAffinityPolicy();
 		/// Returns the thread affinity policy used to create new threads.
 
+	void setCPUSet(const std::vector<int>& cpus);
+		/// Restricts the threads of the pool to the given set of
+		/// processors (see CPUTopology). Threads that are currently
+		/// busy are moved when they start their next target.
+		/// An empty set allows the threads to run on all processors.
+		///
+		/// A cpu given to start() takes precedence over the set.
+
+	std::vector<int> getCPUSet() const;
+		/// Returns the set of processors the threads of
+		/// the pool are restricted to.
+
 	int used() const;
 		/// Returns the number of currently used threads.
 
@@ -199,6 +211,8 @@ private:
 	mutable FastMutex _mutex;
 	ThreadAffinityPolicy _affinityPolicy;
 	AtomicCounter _lastCpu;
+	std::vector<int> _cpus;
+	int _cpuSerial;
 };
 
 
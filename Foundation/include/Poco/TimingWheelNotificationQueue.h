@@ -0,0 +1,272 @@
+//
+// TimingWheelNotificationQueue.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  TimingWheelNotificationQueue
+//
+// Definition of the TimingWheelNotificationQueue class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_TimingWheelNotificationQueue_INCLUDED
+#define Foundation_TimingWheelNotificationQueue_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Notification.h"
+#include "Poco/Mutex.h"
+#include "Poco/Event.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Clock.h"
+#include <vector>
+
+
+namespace Poco {
+
+
+class Foundation_API TimingWheelNotificationQueue
+	/// A TimingWheelNotificationQueue provides timed, asynchronous
+	/// notifications like TimedNotificationQueue, but is designed
+	/// for very large numbers of pending notifications, most of
+	/// which are cancelled before they are due (for example, per
+	/// connection timeouts).
+	///
+	/// Instead of a sorted container, the queue uses a hierarchical
+	/// timing wheel: four wheels of 256 slots each, where a slot in
+	/// the first wheel covers one tick (the resolution given in the
+	/// constructor), a slot in the second wheel 256 ticks, and so on.
+	/// Notifications are appended to the slot covering their due
+	/// time and move down to finer wheels as time advances. Both
+	/// enqueueing and cancelling a notification take constant time,
+	/// and entries are recycled, so neither allocates memory once
+	/// the queue has grown to its working size.
+	///
+	/// Notifications are never delivered before their due time,
+	/// but may be delivered up to one tick late. Notifications that
+	/// fall into the same tick are delivered in the order in which
+	/// they were enqueued.
+	///
+	/// enqueueNotification() returns a Handle that can be passed
+	/// to cancel(). A Handle stays safe to use after its notification
+	/// has been delivered or cancelled; cancel() then simply
+	/// returns false.
+	///
+	/// Notifications removed by cancel() or clear() are released
+	/// after the queue's internal lock has been given up, so a
+	/// notification's destructor may safely call back into the queue.
+	///
+	/// Any number of threads may enqueue and cancel notifications,
+	/// but, as with TimedNotificationQueue, only one thread at a
+	/// time may dequeue notifications from the queue.
+{
+public:
+	class Handle
+		/// Identifies a notification in a TimingWheelNotificationQueue.
+	{
+	public:
+		Handle();
+			/// Creates a null Handle.
+
+		bool isNull() const;
+			/// Returns true iff the Handle does not refer to a notification.
+
+		bool operator == (const Handle& handle) const;
+		bool operator != (const Handle& handle) const;
+
+	private:
+		Handle(int index, UInt32 generation);
+
+		int    _index;
+		UInt32 _generation;
+
+		friend class TimingWheelNotificationQueue;
+	};
+
+	explicit TimingWheelNotificationQueue(Clock::ClockDiff resolution = 1000);
+		/// Creates the TimingWheelNotificationQueue.
+		///
+		/// The resolution is the length of one tick
+		/// in microseconds.
+
+	~TimingWheelNotificationQueue();
+		/// Destroys the TimingWheelNotificationQueue.
+
+	Handle enqueueNotification(Notification::Ptr pNotification, Timestamp timestamp);
+		/// Enqueues the given notification to become available
+		/// at the given time and returns a Handle for it.
+		/// The queue takes ownership of the notification, thus
+		/// a call like
+		///     notificationQueue.enqueueNotification(new MyNotification, someTime);
+		/// does not result in a memory leak.
+		///
+		/// The Timestamp is converted to an equivalent Clock value.
+
+	Handle enqueueNotification(Notification::Ptr pNotification, Clock clock);
+		/// Enqueues the given notification to become available
+		/// at the given clock value and returns a Handle for it.
+		/// The queue takes ownership of the notification.
+
+	bool cancel(const Handle& handle);
+		/// Removes the notification identified by the given handle
+		/// from the queue and releases it.
+		///
+		/// Returns true if the notification has been removed, or
+		/// false if it has already been dequeued or cancelled.
+
+	Notification* dequeueNotification();
+		/// Dequeues the next pending notification that is due.
+		/// Returns 0 (null) if no notification is available.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+		///
+		/// It is highly recommended that the result is immediately
+		/// assigned to a Notification::Ptr, to avoid potential
+		/// memory management issues.
+
+	Notification* waitDequeueNotification();
+		/// Dequeues the next pending notification.
+		/// If no notification is due, waits until one is.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+		///
+		/// It is highly recommended that the result is immediately
+		/// assigned to a Notification::Ptr, to avoid potential
+		/// memory management issues.
+
+	Notification* waitDequeueNotification(long milliseconds);
+		/// Dequeues the next pending notification.
+		/// If no notification is due, waits for one up to the
+		/// specified time.
+		/// Returns 0 (null) if no notification is available.
+		/// The caller gains ownership of the notification and
+		/// is expected to release it when done with it.
+		///
+		/// It is highly recommended that the result is immediately
+		/// assigned to a Notification::Ptr, to avoid potential
+		/// memory management issues.
+
+	bool empty() const;
+		/// Returns true iff the queue is empty.
+
+	int size() const;
+		/// Returns the number of notifications in the queue.
+
+	void clear();
+		/// Removes all notifications from the queue.
+		///
+		/// Calling clear() while another thread executes one of
+		/// the dequeue member functions will result in undefined
+		/// behavior.
+
+	Clock::ClockDiff resolution() const;
+		/// Returns the length of one tick in microseconds.
+
+protected:
+	enum
+	{
+		WHEEL_BITS  = 8,
+		WHEEL_SIZE  = 1 << WHEEL_BITS,
+		WHEEL_MASK  = WHEEL_SIZE - 1,
+		WHEELS      = 4,
+		READY_LIST  = WHEELS*WHEEL_SIZE,
+		LIST_COUNT  = READY_LIST + 1,
+		FREE_LIST   = -1
+	};
+
+	struct Entry
+	{
+		Notification* pNf;
+		Int64         tick;
+		int           prev;
+		int           next;
+		int           list;
+		UInt32        generation;
+	};
+
+	Handle insert(Notification::Ptr pNotification, Clock clock);
+	void schedule(int index);
+	void advance(Int64 tick);
+	void cascade(int wheel);
+	Int64 nextTick() const;
+	Int64 currentTick() const;
+	Notification* popReady();
+	int allocate();
+	void release(int index);
+	void append(int list, int index);
+	void unlink(int index);
+	void sleep(Int64 tick, Clock::ClockDiff maxInterval);
+
+private:
+	TimingWheelNotificationQueue(const TimingWheelNotificationQueue&);
+	TimingWheelNotificationQueue& operator = (const TimingWheelNotificationQueue&);
+
+	typedef std::vector<Entry> EntryVec;
+
+	Clock::ClockDiff  _resolution;
+	Clock             _base;
+	Int64             _tick;
+	EntryVec          _entries;
+	int               _free;
+	int               _head[LIST_COUNT];
+	int               _tail[LIST_COUNT];
+	int               _wheelCount[WHEELS];
+	int               _count;
+	Int64             _wakeUpTick;
+	Event             _nfAvailable;
+	mutable FastMutex _mutex;
+};
+
+
+//
+// inlines
+//
+inline TimingWheelNotificationQueue::Handle::Handle():
+	_index(-1),
+	_generation(0)
+{
+}
+
+
+inline TimingWheelNotificationQueue::Handle::Handle(int index, UInt32 generation):
+	_index(index),
+	_generation(generation)
+{
+}
+
+
+inline bool TimingWheelNotificationQueue::Handle::isNull() const
+{
+	return _index < 0;
+}
+
+
+inline bool TimingWheelNotificationQueue::Handle::operator == (const Handle& handle) const
+{
+	return _index == handle._index && _generation == handle._generation;
+}
+
+
+inline bool TimingWheelNotificationQueue::Handle::operator != (const Handle& handle) const
+{
+	return !(*this == handle);
+}
+
+
+inline Clock::ClockDiff TimingWheelNotificationQueue::resolution() const
+{
+	return _resolution;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_TimingWheelNotificationQueue_INCLUDED
@@ -0,0 +1,132 @@
+//
+// UTF8Codec.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Text
+// Module:  UTF8Codec
+//
+// Definition of the UTF8Codec class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_UTF8Codec_INCLUDED
+#define Foundation_UTF8Codec_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/UTFString.h"
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API UTF8Codec
+	/// UTF8Codec validates UTF-8 text and converts it to
+	/// and from UTF-16, a whole buffer at a time.
+	///
+	/// Unlike TextEncoding, which converts one character at
+	/// a time through virtual function calls, UTF8Codec works
+	/// on blocks of 16 or 32 bytes where possible: runs of
+	/// ASCII characters are found and converted with SSE2,
+	/// and validation uses the lookup table method of Keiser
+	/// and Lemire ("Validating UTF-8 In Less Than One
+	/// Instruction Per Byte") with SSSE3 or AVX2, selected at
+	/// run time. Other processors use portable code, which is
+	/// also used for the ends of buffers.
+	///
+	/// Valid UTF-8 is defined as in RFC 3629: overlong sequences,
+	/// surrogates and code points above U+10FFFF are invalid.
+	///
+	/// TextConverter, StreamConverter, UnicodeConverter and
+	/// UTF8::toUpper()/toLower() use UTF8Codec for UTF-8
+	/// text, and so does the JSON parser for string values.
+{
+public:
+	enum Implementation
+	{
+		IMPL_SCALAR, /// Portable code.
+		IMPL_SSSE3,  /// SSSE3 validation.
+		IMPL_AVX2    /// AVX2 validation.
+	};
+
+	static const std::size_t INVALID;
+		/// Returned by toUTF16() and fromUTF16() for invalid input.
+
+	static std::size_t asciiLength(const char* utf8, std::size_t length);
+		/// Returns the number of ASCII characters (bytes
+		/// below 0x80) at the start of the given buffer.
+
+	static std::size_t validLength(const char* utf8, std::size_t length);
+		/// Returns the length of the longest prefix of the given
+		/// buffer that consists of complete and valid UTF-8 sequences.
+		/// The result is less than length if the buffer contains an
+		/// invalid sequence, or ends with an incomplete one.
+
+	static std::size_t validLength(const char* utf8, std::size_t length, Implementation impl);
+		/// Returns the length of the longest valid prefix of the
+		/// given buffer, using the given implementation.
+		///
+		/// Throws an InvalidArgumentException if the processor
+		/// does not support the implementation.
+
+	static bool isValid(const char* utf8, std::size_t length);
+		/// Returns true if the given buffer contains valid UTF-8.
+
+	static std::size_t toUTF16(const char* utf8, std::size_t length, UTF16Char* utf16);
+		/// Converts the given UTF-8 text to UTF-16 and stores the
+		/// result in utf16, which must have room for length characters.
+		///
+		/// Returns the number of UTF-16 characters written, or INVALID
+		/// (leaving the contents of utf16 unspecified) if utf8 does
+		/// not contain valid UTF-8.
+
+	static std::size_t fromUTF16(const UTF16Char* utf16, std::size_t length, char* utf8);
+		/// Converts the given UTF-16 text to UTF-8 and stores the
+		/// result in utf8, which must have room for 3*length bytes.
+		///
+		/// Returns the number of bytes written, or INVALID
+		/// (leaving the contents of utf8 unspecified) if utf16
+		/// contains an unpaired surrogate.
+
+	static Implementation implementation();
+		/// Returns the implementation used by validLength(),
+		/// which is the best one the processor supports.
+
+	static bool isSupported(Implementation impl);
+		/// Returns true if the processor supports the given implementation.
+
+	static const char* name(Implementation impl);
+		/// Returns the name of the given implementation.
+
+private:
+	UTF8Codec();
+};
+
+
+//
+// inlines
+//
+inline std::size_t UTF8Codec::validLength(const char* utf8, std::size_t length)
+{
+	return validLength(utf8, length, implementation());
+}
+
+
+inline bool UTF8Codec::isValid(const char* utf8, std::size_t length)
+{
+	return validLength(utf8, length) == length;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_UTF8Codec_INCLUDED
@@ -0,0 +1,210 @@
+//
+// WorkStealingThreadPool.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Threading
+// Module:  WorkStealingThreadPool
+//
+// Definition of the WorkStealingThreadPool class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_WorkStealingThreadPool_INCLUDED
+#define Foundation_WorkStealingThreadPool_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Thread.h"
+#include "Poco/ThreadLocal.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include "Poco/AtomicCounter.h"
+#include <vector>
+#include <deque>
+
+
+namespace Poco {
+
+
+class Runnable;
+class WorkStealingWorker;
+
+
+class Foundation_API WorkStealingThreadPool
+	/// A WorkStealingThreadPool runs a large number of short
+	/// Runnables on a fixed set of worker threads.
+	///
+	/// In contrast to ThreadPool, which hands each Runnable to an
+	/// idle thread and throws a NoThreadAvailableException if there
+	/// is none, a WorkStealingThreadPool queues Runnables for later
+	/// execution. Every worker thread owns a double-ended queue of
+	/// Runnables, each protected by its own lock:
+	///
+	///   - Runnables started from within a worker thread (that is,
+	///     by another Runnable running in the pool) are pushed to
+	///     the back of that worker's own queue, and the worker
+	///     takes them from the back again (LIFO), which keeps
+	///     related work on the same thread and in the same caches.
+	///   - Runnables started from any other thread are placed in
+	///     a bounded submission queue shared by all workers.
+	///   - A worker that runs out of work takes Runnables from
+	///     the submission queue first, then steals from the front
+	///     of the other workers' queues.
+	///
+	/// Workers with nothing to do sleep until new work arrives.
+	///
+	/// The interface mirrors ThreadPool's start() and joinAll(),
+	/// so a WorkStealingThreadPool can be used in place of a
+	/// ThreadPool where queuing semantics are desired.
+	/// Runnables are not owned by the pool and must remain
+	/// valid until they have finished executing. Unlike ThreadPool,
+	/// the thread-local storage of a worker thread is not cleared
+	/// between Runnables.
+{
+public:
+	WorkStealingThreadPool(int threads = 0,
+		int queueCapacity = 1024,
+		int stackSize = POCO_THREAD_STACK_SIZE);
+		/// Creates a WorkStealingThreadPool with the given number of
+		/// worker threads, all of which are started immediately.
+		/// If threads is 0, one worker per processor is created.
+		///
+		/// At most queueCapacity Runnables can be waiting in
+		/// the submission queue at the same time.
+
+	WorkStealingThreadPool(const std::string& name,
+		int threads = 0,
+		int queueCapacity = 1024,
+		int stackSize = POCO_THREAD_STACK_SIZE);
+		/// Creates a WorkStealingThreadPool with the given name.
+		/// See the other constructor for a description of
+		/// the remaining arguments.
+
+	~WorkStealingThreadPool();
+		/// Stops all worker threads. Runnables that have not
+		/// yet been started are discarded.
+
+	void start(Runnable& target);
+		/// Queues the target for execution by one of the
+		/// worker threads.
+		///
+		/// Throws a NoThreadAvailableException if the target
+		/// is started from outside the pool and the submission
+		/// queue is full.
+
+	bool tryStart(Runnable& target);
+		/// Queues the target for execution by one of the
+		/// worker threads.
+		///
+		/// Returns false if the submission queue is full.
+
+	void joinAll();
+		/// Waits until all Runnables started so far, including
+		/// the ones they start in turn, have completed.
+		///
+		/// Must not be called from within a Runnable running
+		/// in this pool.
+
+	void stopAll();
+		/// Stops all worker threads and waits for their completion.
+		/// Runnables that have not yet been started are discarded.
+		///
+		/// If used, this method should be the last action before
+		/// the pool is deleted.
+
+	int capacity() const;
+		/// Returns the number of worker threads.
+
+	int queueCapacity() const;
+		/// Returns the capacity of the submission queue.
+
+	int queued() const;
+		/// Returns the number of Runnables waiting for execution.
+
+	int pending() const;
+		/// Returns the number of Runnables that have been started
+		/// but not yet completed.
+
+	const std::string& name() const;
+		/// Returns the name of the pool,
+		/// or an empty string if no name has been
+		/// specified in the constructor.
+
+protected:
+	void init(int threads, int stackSize);
+	Runnable* next(WorkStealingWorker* pWorker);
+	void completed();
+	void park();
+	void wakeUp();
+	WorkStealingWorker* currentWorker();
+
+private:
+	WorkStealingThreadPool(const WorkStealingThreadPool& pool);
+	WorkStealingThreadPool& operator = (const WorkStealingThreadPool& pool);
+
+	typedef std::vector<WorkStealingWorker*> WorkerVec;
+	typedef std::deque<Runnable*> TaskQueue;
+
+	std::string       _name;
+	int               _queueCapacity;
+	WorkerVec         _workers;
+	ThreadLocal<WorkStealingWorker*> _currentWorker;
+	TaskQueue         _queue;
+	mutable FastMutex _queueMutex;
+	AtomicCounter     _queued;
+	AtomicCounter     _pending;
+	AtomicCounter     _idle;
+	FastMutex         _parkMutex;
+	Condition         _workAvailable;
+	FastMutex         _doneMutex;
+	Condition         _done;
+	volatile bool     _stopped;
+
+	friend class WorkStealingWorker;
+};
+
+
+//
+// inlines
+//
+inline int WorkStealingThreadPool::capacity() const
+{
+	return static_cast<int>(_workers.size());
+}
+
+
+inline int WorkStealingThreadPool::queueCapacity() const
+{
+	return _queueCapacity;
+}
+
+
+inline int WorkStealingThreadPool::queued() const
+{
+	return _queued.value();
+}
+
+
+inline int WorkStealingThreadPool::pending() const
+{
+	return _pending.value();
+}
+
+
+inline const std::string& WorkStealingThreadPool::name() const
+{
+	return _name;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_WorkStealingThreadPool_INCLUDED
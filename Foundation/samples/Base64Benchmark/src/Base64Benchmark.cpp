@@ -0,0 +1,174 @@
+//
+// Base64Benchmark.cpp
+//
+// $Id$
+//
+// This sample measures the throughput of Base64Codec, with
+// every implementation the processor supports, and of the
+// Base64Encoder and Base64Decoder streams.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Base64Codec.h"
+#include "Poco/Base64Encoder.h"
+#include "Poco/Base64Decoder.h"
+#include "Poco/Random.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+
+using Poco::Base64Codec;
+
+
+void printResult(const std::string& name, const char* op, std::size_t size, std::size_t bytes, const Poco::Stopwatch& sw)
+{
+	double mbPerSec = sw.elapsed() > 0 ? bytes/(double) sw.elapsed() : 0.0;
+	std::cout << std::setw(24) << std::left << name
+	          << std::setw(10) << std::left << op
+	          << std::setw(10) << std::right << size
+	          << std::setw(12) << std::fixed << std::setprecision(1) << mbPerSec << " [MB/s]" << std::endl;
+}
+
+
+void benchmarkCodec(const std::string& data, int rounds)
+{
+	std::vector<char> encoded(Base64Codec::encodedLength(data.size()));
+	std::vector<char> decoded(Base64Codec::decodedLength(encoded.size()));
+	for (int impl = Base64Codec::IMPL_SCALAR; impl <= Base64Codec::implementation(); ++impl)
+	{
+		Base64Codec::Implementation im = static_cast<Base64Codec::Implementation>(impl);
+		std::string name = std::string("Base64Codec/") + Base64Codec::name(im);
+		Poco::Stopwatch sw;
+
+		std::size_t n = 0;
+		sw.start();
+		for (int i = 0; i < rounds; ++i)
+		{
+			n = Base64Codec::encode(data.data(), data.size(), &encoded[0], im);
+		}
+		sw.stop();
+		printResult(name, "encode", data.size(), rounds*data.size(), sw);
+
+		std::size_t m = 0;
+		sw.restart();
+		for (int i = 0; i < rounds; ++i)
+		{
+			m = Base64Codec::decode(&encoded[0], n, &decoded[0], im);
+		}
+		sw.stop();
+		printResult(name, "decode", data.size(), rounds*data.size(), sw);
+
+		if (m != data.size() || std::string(&decoded[0], m) != data)
+		{
+			std::cerr << name << ": unexpected result" << std::endl;
+		}
+	}
+}
+
+
+void benchmarkStreams(const std::string& data, int rounds)
+{
+	Poco::Stopwatch sw;
+	std::string encoded;
+
+	sw.start();
+	for (int i = 0; i < rounds; ++i)
+	{
+		std::ostringstream ostr;
+		Poco::Base64Encoder encoder(ostr);
+		encoder.write(data.data(), static_cast<std::streamsize>(data.size()));
+		encoder.close();
+		encoded = ostr.str();
+	}
+	sw.stop();
+	printResult("Base64Encoder", "write", data.size(), rounds*data.size(), sw);
+
+	sw.restart();
+	for (int i = 0; i < rounds; ++i)
+	{
+		std::ostringstream ostr;
+		Poco::Base64Encoder encoder(ostr);
+		for (std::string::const_iterator it = data.begin(); it != data.end(); ++it)
+		{
+			encoder.put(*it);
+		}
+		encoder.close();
+	}
+	sw.stop();
+	printResult("Base64Encoder", "put", data.size(), rounds*data.size(), sw);
+
+	std::vector<char> buffer(data.size());
+	std::streamsize n = 0;
+	sw.restart();
+	for (int i = 0; i < rounds; ++i)
+	{
+		std::istringstream istr(encoded);
+		Poco::Base64Decoder decoder(istr);
+		decoder.read(&buffer[0], static_cast<std::streamsize>(buffer.size()));
+		n = decoder.gcount();
+	}
+	sw.stop();
+	printResult("Base64Decoder", "read", data.size(), rounds*data.size(), sw);
+
+	if (n != static_cast<std::streamsize>(data.size()) || std::string(&buffer[0], n) != data)
+	{
+		std::cerr << "Base64Decoder: unexpected result" << std::endl;
+	}
+
+	sw.restart();
+	for (int i = 0; i < rounds; ++i)
+	{
+		std::istringstream istr(encoded);
+		Poco::Base64Decoder decoder(istr);
+		for (std::size_t k = 0; k < buffer.size(); ++k)
+		{
+			buffer[k] = static_cast<char>(decoder.get());
+		}
+	}
+	sw.stop();
+	printResult("Base64Decoder", "get", data.size(), rounds*data.size(), sw);
+	std::cout << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	// Usage: Base64Benchmark [<size>]
+	std::size_t size = argc > 1 ? std::atoi(argv[1]) : 0;
+	std::vector<std::size_t> sizes;
+	if (size > 0)
+	{
+		sizes.push_back(size);
+	}
+	else
+	{
+		sizes.push_back(64);
+		sizes.push_back(4096);
+		sizes.push_back(1024*1024);
+	}
+
+	std::cout << "Base64Codec uses " << Base64Codec::name(Base64Codec::implementation()) << "." << std::endl << std::endl;
+
+	Poco::Random rnd;
+	for (std::vector<std::size_t>::const_iterator it = sizes.begin(); it != sizes.end(); ++it)
+	{
+		std::string data;
+		for (std::size_t i = 0; i < *it; ++i) data += rnd.nextChar();
+
+		// Process about 64 MB per measurement.
+		int rounds = static_cast<int>(64*1024*1024/(*it)) + 1;
+		benchmarkCodec(data, rounds);
+		benchmarkStreams(data, rounds/8 + 1);
+	}
+	return 0;
+}
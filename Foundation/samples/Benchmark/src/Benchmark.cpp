@@ -3,7 +3,9 @@
 //
 // $Id$
 //
-// This sample shows a benchmark of various mutex implementations.
+// This sample shows a benchmark of various mutex implementations,
+// uncontended and contended, and compares RWLock and ShardedRWLock
+// under read-mostly load.
 //
 // Copyright (c) 2012, Applied Informatics Software Engineering GmbH.
 // and Contributors.
@@ -13,9 +15,19 @@
 
 
 #include "Poco/Mutex.h"
+#include "Poco/SpinMutex.h"
+#include "Poco/ProfilingMutex.h"
+#include "Poco/RWLock.h"
+#include "Poco/ShardedRWLock.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Event.h"
 #include "Poco/Stopwatch.h"
 #include <iostream>
 #include <iomanip>
+#include <cstring>
+#include <vector>
+
 
 template<typename Mtx>
 void Benchmark(Mtx& mtx, std::string const& label)
@@ -41,7 +53,199 @@ void Benchmark(Mtx& mtx, std::string const& label)
 }
 
 
-int main(int argc, char** argv)
+template<typename Mtx>
+class Locker: public Poco::Runnable
+	/// Repeatedly locks the mutex for a short critical section.
+{
+public:
+	Locker(Mtx& mtx, volatile int& value, Poco::Event& start, int iterations):
+		_mtx(mtx),
+		_value(value),
+		_start(start),
+		_iterations(iterations)
+	{
+	}
+
+	void run()
+	{
+		_start.wait();
+		for (int i = 0; i < _iterations; ++i)
+		{
+			_mtx.lock();
+			++_value;
+			_mtx.unlock();
+		}
+	}
+
+private:
+	Mtx& _mtx;
+	volatile int& _value;
+	Poco::Event& _start;
+	int _iterations;
+};
+
+
+template<typename Mtx>
+void ContendedBenchmark(Mtx& mtx, std::string const& label, int threads)
+{
+	const int ITERATIONS = 1000000;
+
+	volatile int value = 0;
+	Poco::Event start(false);
+	std::vector<Locker<Mtx>*> runnables;
+	std::vector<Poco::Thread*> lockers;
+	for (int i = 0; i < threads; ++i)
+	{
+		runnables.push_back(new Locker<Mtx>(mtx, value, start, ITERATIONS));
+		lockers.push_back(new Poco::Thread);
+		lockers.back()->start(*runnables.back());
+	}
+
+	Poco::Stopwatch sw;
+	sw.start();
+	start.set();
+	for (int i = 0; i < threads; ++i)
+	{
+		lockers[i]->join();
+	}
+	sw.stop();
+
+	for (int i = 0; i < threads; ++i)
+	{
+		delete lockers[i];
+		delete runnables[i];
+	}
+
+	double nsPerLock = 1000.0*sw.elapsed()/(double(ITERATIONS)*threads);
+	std::cout << std::setw(26) << std::left << label << std::right
+		<< std::setw(3) << threads << " threads: "
+		<< std::setw(10) << sw.elapsed() << " [us], "
+		<< std::setw(8) << std::fixed << std::setprecision(2) << nsPerLock << " [ns/lock]" << std::endl;
+}
+
+
+void ContendedMutexBenchmark()
+{
+	for (int threads = 1; threads <= 16; threads *= 2)
+	{
+		{
+			Poco::FastMutex mtx;
+			ContendedBenchmark(mtx, "FastMutex", threads);
+		}
+		{
+			Poco::SpinMutex mtx;
+			ContendedBenchmark(mtx, "SpinMutex", threads);
+		}
+		{
+			Poco::ProfilingMutex<Poco::FastMutex> mtx("FastMutex");
+			ContendedBenchmark(mtx, "ProfilingMutex<FastMutex>", threads);
+		}
+	}
+	Poco::MutexProfileRegistry::defaultRegistry().dump(std::cout);
+}
+
+
+template<typename RWLck>
+class Reader: public Poco::Runnable
+	/// Repeatedly acquires a read lock and reads the shared value.
+{
+public:
+	Reader(RWLck& lock, const volatile int& value, Poco::Event& start, int iterations):
+		_lock(lock),
+		_value(value),
+		_start(start),
+		_iterations(iterations),
+		_sum(0)
+	{
+	}
+
+	void run()
+	{
+		_start.wait();
+		for (int i = 0; i < _iterations; ++i)
+		{
+			_lock.readLock();
+			_sum += _value;
+			_lock.unlock();
+		}
+	}
+
+private:
+	RWLck& _lock;
+	const volatile int& _value;
+	Poco::Event& _start;
+	int _iterations;
+	int _sum;
+};
+
+
+template<typename RWLck>
+void ReadBenchmark(RWLck& lock, std::string const& label, int readers)
+{
+	const int ITERATIONS = 1000000;
+
+	volatile int value = 42;
+	Poco::Event start(false);
+	std::vector<Reader<RWLck>*> runnables;
+	std::vector<Poco::Thread*> threads;
+	for (int i = 0; i < readers; ++i)
+	{
+		runnables.push_back(new Reader<RWLck>(lock, value, start, ITERATIONS));
+		threads.push_back(new Poco::Thread);
+		threads.back()->start(*runnables.back());
+	}
+
+	Poco::Stopwatch sw;
+	sw.start();
+	start.set();
+
+	// A writer updates the value once per millisecond, as a
+	// configuration or routing table would be updated.
+	int writes = 0;
+	for (int i = 0; i < readers; ++i)
+	{
+		while (!threads[i]->tryJoin(1))
+		{
+			lock.writeLock();
+			++value;
+			lock.unlock();
+			++writes;
+		}
+	}
+	sw.stop();
+
+	for (int i = 0; i < readers; ++i)
+	{
+		delete threads[i];
+		delete runnables[i];
+	}
+
+	double nsPerRead = 1000.0*sw.elapsed()/(double(ITERATIONS)*readers);
+	std::cout << std::setw(16) << std::left << label << std::right
+		<< std::setw(3) << readers << " readers: "
+		<< std::setw(10) << sw.elapsed() << " [us], "
+		<< std::setw(8) << std::fixed << std::setprecision(2) << nsPerRead << " [ns/read], "
+		<< writes << " writes" << std::endl;
+}
+
+
+void RWLockBenchmark()
+{
+	for (int readers = 1; readers <= 64; readers *= 2)
+	{
+		{
+			Poco::RWLock lock;
+			ReadBenchmark(lock, "RWLock", readers);
+		}
+		{
+			Poco::ShardedRWLock lock;
+			ReadBenchmark(lock, "ShardedRWLock", readers);
+		}
+	}
+}
+
+
+void MutexBenchmark()
 {
 	{
 		Poco::NullMutex mtx;
@@ -63,5 +267,28 @@ int main(int argc, char** argv)
 		Benchmark(mtx, "FastMutex");
 	}
 
+	{
+		Poco::SpinMutex mtx;
+		Benchmark(mtx, "SpinMutex");
+	}
+
+	{
+		Poco::ProfilingMutex<Poco::FastMutex> mtx;
+		Benchmark(mtx, "ProfilingMutex<FastMutex>");
+	}
+}
+
+
+int main(int argc, char** argv)
+{
+	// Usage: MutexBenchmark [mutex|contended|rwlock]
+	bool all = argc < 2;
+	if (all || std::strcmp(argv[1], "mutex") == 0)
+		MutexBenchmark();
+	if (all || std::strcmp(argv[1], "contended") == 0)
+		ContendedMutexBenchmark();
+	if (all || std::strcmp(argv[1], "rwlock") == 0)
+		RWLockBenchmark();
+
 	return 0;
 }
@@ -0,0 +1,156 @@
+//
+// HashMapBenchmark.cpp
+//
+// $Id$
+//
+// This sample compares std::map, HashMap and FlatHashMap
+// when inserting, finding and erasing integer and string keys.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/HashMap.h"
+#include "Poco/FlatHashMap.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Random.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <map>
+#include <string>
+#include <cstdlib>
+
+
+void printResult(const std::string& name, const char* op, std::size_t size, std::size_t ops, const Poco::Stopwatch& sw)
+{
+	double nsPerOp = sw.elapsed()*1000.0/ops;
+	std::cout << std::setw(36) << std::left << name
+	          << std::setw(10) << std::left << op
+	          << std::setw(10) << std::right << size
+	          << std::setw(12) << std::fixed << std::setprecision(1) << nsPerOp << " [ns/op]" << std::endl;
+}
+
+
+template <class Map, class Key>
+void benchmark(const std::string& name, const std::vector<Key>& keys, const std::vector<Key>& missing)
+{
+	Map map;
+	Poco::Stopwatch sw;
+
+	sw.start();
+	for (typename std::vector<Key>::const_iterator it = keys.begin(); it != keys.end(); ++it)
+	{
+		map[*it] = 1;
+	}
+	sw.stop();
+	printResult(name, "insert", keys.size(), keys.size(), sw);
+
+	// Look up the keys in a different order than they were inserted.
+	std::size_t found = 0;
+	sw.restart();
+	for (int round = 0; round < 4; ++round)
+	{
+		for (typename std::vector<Key>::const_reverse_iterator it = keys.rbegin(); it != keys.rend(); ++it)
+		{
+			found += map.count(*it);
+		}
+	}
+	sw.stop();
+	printResult(name, "find", keys.size(), 4*keys.size(), sw);
+
+	sw.restart();
+	for (int round = 0; round < 4; ++round)
+	{
+		for (typename std::vector<Key>::const_iterator it = missing.begin(); it != missing.end(); ++it)
+		{
+			found += map.count(*it);
+		}
+	}
+	sw.stop();
+	printResult(name, "miss", keys.size(), 4*missing.size(), sw);
+
+	sw.restart();
+	for (typename std::vector<Key>::const_iterator it = keys.begin(); it != keys.end(); ++it)
+	{
+		map.erase(*it);
+	}
+	sw.stop();
+	printResult(name, "erase", keys.size(), keys.size(), sw);
+
+	if (found != 4*keys.size() || !map.empty())
+	{
+		std::cerr << name << ": unexpected result" << std::endl;
+	}
+}
+
+
+void benchmarkInt(std::size_t size)
+{
+	Poco::Random rnd;
+	std::vector<int> keys;
+	std::vector<int> missing;
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		// Even keys are inserted, odd ones are missing.
+		int key = static_cast<int>(rnd.next() & 0x3ffffffe);
+		keys.push_back(key);
+		missing.push_back(key + 1);
+	}
+	// Random may repeat itself; keep every key once.
+	std::map<int, int> unique;
+	std::vector<int> uniqueKeys;
+	for (std::size_t i = 0; i < keys.size(); ++i)
+	{
+		if (unique[keys[i]]++ == 0) uniqueKeys.push_back(keys[i]);
+	}
+
+	benchmark<std::map<int, int> >("std::map<int>", uniqueKeys, missing);
+	benchmark<Poco::HashMap<int, int> >("HashMap<int>", uniqueKeys, missing);
+	benchmark<Poco::FlatHashMap<int, int, Poco::Hash<int> > >("FlatHashMap<int, Hash>", uniqueKeys, missing);
+	benchmark<Poco::FlatHashMap<int, int> >("FlatHashMap<int, FastHash>", uniqueKeys, missing);
+	std::cout << std::endl;
+}
+
+
+void benchmarkString(std::size_t size)
+{
+	std::vector<std::string> keys;
+	std::vector<std::string> missing;
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		keys.push_back("/api/v1/resource/" + Poco::NumberFormatter::format(2*i));
+		missing.push_back("/api/v1/resource/" + Poco::NumberFormatter::format(2*i + 1));
+	}
+
+	benchmark<std::map<std::string, int> >("std::map<string>", keys, missing);
+	benchmark<Poco::HashMap<std::string, int> >("HashMap<string>", keys, missing);
+	benchmark<Poco::FlatHashMap<std::string, int, Poco::Hash<std::string> > >("FlatHashMap<string, Hash>", keys, missing);
+	benchmark<Poco::FlatHashMap<std::string, int> >("FlatHashMap<string, FastHash>", keys, missing);
+	std::cout << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	// Usage: HashMapBenchmark [<size>]
+	std::size_t size = argc > 1 ? std::atoi(argv[1]) : 0;
+	for (std::size_t n = 1000; n <= 1000000; n *= 10)
+	{
+		if (size == 0 || size == n)
+		{
+			benchmarkInt(n);
+			benchmarkString(n);
+		}
+	}
+	if (size != 0 && size != 1000 && size != 10000 && size != 100000 && size != 1000000)
+	{
+		benchmarkInt(size);
+		benchmarkString(size);
+	}
+	return 0;
+}
@@ -0,0 +1,183 @@
+//
+// NumberParserBenchmark.cpp
+//
+// $Id$
+//
+// This sample compares the std::string and the range
+// overloads of NumberParser with strtol() and strtod(),
+// for integers and floating-point numbers.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/NumberParser.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Random.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cmath>
+
+
+using Poco::NumberParser;
+using Poco::NumberFormatter;
+
+
+void printResult(const std::string& name, std::size_t count, std::size_t bytes, const Poco::Stopwatch& sw)
+{
+	double nsPerNumber = count > 0 ? sw.elapsed()*1000.0/count : 0.0;
+	double mbPerSec = sw.elapsed() > 0 ? bytes/(double) sw.elapsed() : 0.0;
+	std::cout << std::setw(40) << std::left << name
+	          << std::setw(10) << std::right << std::fixed << std::setprecision(1) << nsPerNumber << " [ns]"
+	          << std::setw(10) << mbPerSec << " [MB/s]" << std::endl;
+}
+
+
+std::size_t totalSize(const std::vector<std::string>& numbers)
+{
+	std::size_t size = 0;
+	for (std::vector<std::string>::const_iterator it = numbers.begin(); it != numbers.end(); ++it)
+	{
+		size += it->size();
+	}
+	return size;
+}
+
+
+#if defined(POCO_HAVE_INT64)
+
+
+void benchmarkIntegers(const std::vector<std::string>& numbers, int rounds)
+{
+	std::size_t count = rounds*numbers.size();
+	std::size_t bytes = rounds*totalSize(numbers);
+	Poco::Stopwatch sw;
+	Poco::Int64 sum = 0;
+	Poco::Int64 value = 0;
+
+	sw.start();
+	for (int i = 0; i < rounds; ++i)
+	{
+		for (std::vector<std::string>::const_iterator it = numbers.begin(); it != numbers.end(); ++it)
+		{
+			sum += NumberParser::parse64(*it);
+		}
+	}
+	sw.stop();
+	printResult("NumberParser::parse64(string)", count, bytes, sw);
+
+	sw.restart();
+	for (int i = 0; i < rounds; ++i)
+	{
+		for (std::vector<std::string>::const_iterator it = numbers.begin(); it != numbers.end(); ++it)
+		{
+			if (NumberParser::tryParse64(it->data(), it->data() + it->size(), value)) sum -= value;
+		}
+	}
+	sw.stop();
+	printResult("NumberParser::tryParse64(begin, end)", count, bytes, sw);
+
+	sw.restart();
+	for (int i = 0; i < rounds; ++i)
+	{
+		for (std::vector<std::string>::const_iterator it = numbers.begin(); it != numbers.end(); ++it)
+		{
+			sum += std::strtoll(it->c_str(), 0, 10);
+		}
+	}
+	sw.stop();
+	printResult("strtoll()", count, bytes, sw);
+
+	std::cout << "(checksum " << sum << ")" << std::endl << std::endl;
+}
+
+
+#endif // POCO_HAVE_INT64
+
+
+void benchmarkFloats(const std::vector<std::string>& numbers, int rounds)
+{
+	std::size_t count = rounds*numbers.size();
+	std::size_t bytes = rounds*totalSize(numbers);
+	Poco::Stopwatch sw;
+	double sum = 0;
+	double value = 0;
+
+	sw.start();
+	for (int i = 0; i < rounds; ++i)
+	{
+		for (std::vector<std::string>::const_iterator it = numbers.begin(); it != numbers.end(); ++it)
+		{
+			sum += NumberParser::parseFloat(*it);
+		}
+	}
+	sw.stop();
+	printResult("NumberParser::parseFloat(string)", count, bytes, sw);
+
+	sw.restart();
+	for (int i = 0; i < rounds; ++i)
+	{
+		for (std::vector<std::string>::const_iterator it = numbers.begin(); it != numbers.end(); ++it)
+		{
+			if (NumberParser::tryParseFloat(it->data(), it->data() + it->size(), value)) sum -= value;
+		}
+	}
+	sw.stop();
+	printResult("NumberParser::tryParseFloat(begin, end)", count, bytes, sw);
+
+	sw.restart();
+	for (int i = 0; i < rounds; ++i)
+	{
+		for (std::vector<std::string>::const_iterator it = numbers.begin(); it != numbers.end(); ++it)
+		{
+			sum += std::strtod(it->c_str(), 0);
+		}
+	}
+	sw.stop();
+	printResult("strtod()", count, bytes, sw);
+
+	std::cout << "(checksum " << sum << ")" << std::endl << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	// Usage: NumberParserBenchmark [<count>]
+	int count = argc > 1 ? std::atoi(argv[1]) : 0;
+	if (count <= 0) count = 100000;
+	int rounds = 10000000/count + 1;
+
+	Poco::Random rnd;
+
+#if defined(POCO_HAVE_INT64)
+	std::vector<std::string> integers;
+	for (int i = 0; i < count; ++i)
+	{
+		Poco::Int64 n = static_cast<Poco::Int64>((static_cast<Poco::UInt64>(rnd.next()) << 32) | rnd.next()) >> rnd.next(64);
+		integers.push_back(NumberFormatter::format(n));
+	}
+	std::cout << "Integers (" << totalSize(integers)/integers.size() << " characters on average):" << std::endl;
+	benchmarkIntegers(integers, rounds);
+#endif // POCO_HAVE_INT64
+
+	std::vector<std::string> shortFloats;
+	std::vector<std::string> longFloats;
+	for (int i = 0; i < count; ++i)
+	{
+		shortFloats.push_back(NumberFormatter::format(rnd.next(1000000)/100.0, 2));
+		longFloats.push_back(NumberFormatter::format((rnd.nextDouble() - 0.5)*std::pow(10.0, static_cast<int>(rnd.next(40)) - 20)));
+	}
+	std::cout << "Floating-point numbers with two decimals:" << std::endl;
+	benchmarkFloats(shortFloats, rounds);
+	std::cout << "Floating-point numbers with 17 significant digits:" << std::endl;
+	benchmarkFloats(longFloats, rounds);
+
+	return 0;
+}
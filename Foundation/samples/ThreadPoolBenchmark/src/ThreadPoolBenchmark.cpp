@@ -0,0 +1,176 @@
+//
+// ThreadPoolBenchmark.cpp
+//
+// $Id$
+//
+// This sample compares ThreadPool and WorkStealingThreadPool
+// when running a large number of short tasks.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/ThreadPool.h"
+#include "Poco/WorkStealingThreadPool.h"
+#include "Poco/Runnable.h"
+#include "Poco/Thread.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/Environment.h"
+#include "Poco/Exception.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
+#include <cstdlib>
+
+
+class Task: public Poco::Runnable
+	/// A small CPU-bound task.
+{
+public:
+	Task(int work):
+		_work(work)
+	{
+	}
+
+	void run()
+	{
+		volatile unsigned x = 0;
+		for (int i = 0; i < _work; ++i)
+		{
+			x = x*31 + i;
+		}
+		++_done;
+	}
+
+	int done() const
+	{
+		return _done.value();
+	}
+
+private:
+	int _work;
+	Poco::AtomicCounter _done;
+};
+
+
+class FanOut: public Poco::Runnable
+	/// Starts a number of tasks from within the pool.
+{
+public:
+	FanOut(Poco::WorkStealingThreadPool& pool, Poco::Runnable& task, int n):
+		_pool(pool),
+		_task(task),
+		_n(n)
+	{
+	}
+
+	void run()
+	{
+		for (int i = 0; i < _n; ++i)
+		{
+			_pool.start(_task);
+		}
+	}
+
+private:
+	Poco::WorkStealingThreadPool& _pool;
+	Poco::Runnable& _task;
+	int _n;
+};
+
+
+void benchmarkThreadPool(int threads, int tasks, int work)
+{
+	Poco::ThreadPool pool(threads, threads);
+	Task task(work);
+
+	Poco::Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < tasks; ++i)
+	{
+		// ThreadPool cannot queue, so callers have to retry
+		// until a thread becomes available.
+		for (;;)
+		{
+			try
+			{
+				pool.start(task);
+				break;
+			}
+			catch (Poco::NoThreadAvailableException&)
+			{
+				Poco::Thread::yield();
+			}
+		}
+	}
+	pool.joinAll();
+	sw.stop();
+
+	std::cout << "ThreadPool             " << sw.elapsed() << " [us] (" << task.done() << " tasks)" << std::endl;
+}
+
+
+void benchmarkWorkStealingThreadPool(int threads, int tasks, int work)
+{
+	Poco::WorkStealingThreadPool pool(threads, 1024);
+	Task task(work);
+
+	Poco::Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < tasks; ++i)
+	{
+		// retry while the submission queue is full
+		while (!pool.tryStart(task))
+		{
+			Poco::Thread::yield();
+		}
+	}
+	pool.joinAll();
+	sw.stop();
+
+	std::cout << "WorkStealingThreadPool " << sw.elapsed() << " [us] (" << task.done() << " tasks)" << std::endl;
+}
+
+
+void benchmarkWorkStealingFanOut(int threads, int tasks, int work)
+{
+	Poco::WorkStealingThreadPool pool(threads, 1024);
+	Task task(work);
+	const int FAN_OUT = 1000;
+	FanOut fanOut(pool, task, FAN_OUT);
+
+	Poco::Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < tasks/FAN_OUT; ++i)
+	{
+		while (!pool.tryStart(fanOut))
+		{
+			Poco::Thread::yield();
+		}
+	}
+	pool.joinAll();
+	sw.stop();
+
+	std::cout << "WorkStealingThreadPool " << sw.elapsed() << " [us] (" << task.done() << " tasks, fan-out from workers)" << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	int threads = Poco::Environment::processorCount();
+	int tasks   = 100000;
+	int work    = 1000;
+	if (argc > 1) threads = std::atoi(argv[1]);
+	if (argc > 2) tasks = std::atoi(argv[2]);
+	if (argc > 3) work = std::atoi(argv[3]);
+
+	std::cout << threads << " threads, " << tasks << " tasks, " << work << " iterations per task" << std::endl;
+
+	benchmarkThreadPool(threads, tasks, work);
+	benchmarkWorkStealingThreadPool(threads, tasks, work);
+	benchmarkWorkStealingFanOut(threads, tasks, work);
+
+	return 0;
+}
@@ -0,0 +1,117 @@
+//
+// TimingWheelBenchmark.cpp
+//
+// $Id$
+//
+// This sample compares how TimedNotificationQueue and
+// TimingWheelNotificationQueue scale with the number of
+// pending notifications when scheduling and cancelling
+// timeouts.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/TimedNotificationQueue.h"
+#include "Poco/TimingWheelNotificationQueue.h"
+#include "Poco/Notification.h"
+#include "Poco/Clock.h"
+#include "Poco/Random.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+
+
+const Poco::Clock::ClockDiff MAX_DELAY = 60*Poco::Clock::ClockDiff(1000000);
+
+
+void printResult(const char* name, int size, int ops, const Poco::Stopwatch& sw)
+{
+	double nsPerOp = sw.elapsed()*1000.0/ops;
+	std::cout << std::setw(34) << std::left << name
+	          << std::setw(10) << std::right << size
+	          << std::setw(12) << std::fixed << std::setprecision(1) << nsPerOp << " [ns/op]"
+	          << std::setw(14) << static_cast<long>(1e9/nsPerOp) << " [op/s]" << std::endl;
+}
+
+
+void benchmarkTimedQueue(int size, int ops)
+{
+	Poco::TimedNotificationQueue queue;
+	Poco::Notification::Ptr pNf = new Poco::Notification;
+	Poco::Random rnd;
+	Poco::Clock now;
+	for (int i = 0; i < size; ++i)
+	{
+		queue.enqueueNotification(pNf, now + 1000000 + rnd.next(static_cast<Poco::UInt32>(MAX_DELAY)));
+	}
+
+	// TimedNotificationQueue cannot cancel a single notification,
+	// so only the cost of scheduling is measured.
+	Poco::Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < ops; ++i)
+	{
+		queue.enqueueNotification(pNf, now + 1000000 + rnd.next(static_cast<Poco::UInt32>(MAX_DELAY)));
+	}
+	sw.stop();
+	printResult("TimedNotificationQueue (enqueue)", size, ops, sw);
+}
+
+
+void benchmarkTimingWheel(int size, int ops)
+{
+	Poco::TimingWheelNotificationQueue queue;
+	Poco::Notification::Ptr pNf = new Poco::Notification;
+	Poco::Random rnd;
+	Poco::Clock now;
+	for (int i = 0; i < size; ++i)
+	{
+		queue.enqueueNotification(pNf, now + 1000000 + rnd.next(static_cast<Poco::UInt32>(MAX_DELAY)));
+	}
+
+	Poco::Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < ops; ++i)
+	{
+		queue.enqueueNotification(pNf, now + 1000000 + rnd.next(static_cast<Poco::UInt32>(MAX_DELAY)));
+	}
+	sw.stop();
+	printResult("TimingWheel (enqueue)", size, ops, sw);
+
+	std::vector<Poco::TimingWheelNotificationQueue::Handle> handles;
+	handles.reserve(ops);
+	sw.restart();
+	for (int i = 0; i < ops; ++i)
+	{
+		handles.push_back(queue.enqueueNotification(pNf, now + 1000000 + rnd.next(static_cast<Poco::UInt32>(MAX_DELAY))));
+		if (i % 2) queue.cancel(handles[i - 1]);
+	}
+	sw.stop();
+	printResult("TimingWheel (enqueue/cancel)", size, ops, sw);
+}
+
+
+int main(int argc, char** argv)
+{
+	int ops = 200000;
+	int maxSize = 1000000;
+	if (argc > 1) ops = std::atoi(argv[1]);
+	if (argc > 2) maxSize = std::atoi(argv[2]);
+
+	std::cout << ops << " operations per run, delays up to " << MAX_DELAY/1000000 << " s" << std::endl;
+	std::cout << std::setw(34) << std::left << "queue" << std::setw(10) << std::right << "pending" << std::endl;
+
+	for (int size = 1000; size <= maxSize; size *= 10)
+	{
+		benchmarkTimedQueue(size, ops);
+		benchmarkTimingWheel(size, ops);
+	}
+
+	return 0;
+}
@@ -0,0 +1,85 @@
+//
+// ActiveExecutor.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Threading
+// Module:  ActiveObjects
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/ActiveExecutor.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/WorkStealingThreadPool.h"
+
+
+namespace Poco {
+
+
+ActiveExecutor::ActiveExecutor()
+{
+}
+
+
+ActiveExecutor::~ActiveExecutor()
+{
+}
+
+
+ThreadPoolExecutor::ThreadPoolExecutor(ThreadPool& pool):
+	_pool(pool)
+{
+}
+
+
+ThreadPoolExecutor::~ThreadPoolExecutor()
+{
+}
+
+
+void ThreadPoolExecutor::execute(Runnable& target)
+{
+	_pool.start(target);
+}
+
+
+WorkStealingExecutor::WorkStealingExecutor(WorkStealingThreadPool& pool):
+	_pool(pool)
+{
+}
+
+
+WorkStealingExecutor::~WorkStealingExecutor()
+{
+}
+
+
+void WorkStealingExecutor::execute(Runnable& target)
+{
+	_pool.start(target);
+}
+
+
+InlineExecutor::InlineExecutor()
+{
+}
+
+
+InlineExecutor::~InlineExecutor()
+{
+}
+
+
+void InlineExecutor::execute(Runnable& target)
+{
+	target.run();
+}
+
+
+} // namespace Poco
@@ -0,0 +1,245 @@
+//
+// ActiveResult.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Threading
+// Module:  ActiveObjects
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/ActiveResult.h"
+#include "Poco/ActiveExecutor.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/AutoPtr.h"
+
+
+namespace Poco {
+
+
+//
+// ActiveResultCallbackList
+//
+
+
+ActiveResultCallbackList::ActiveResultCallbackList():
+	_done(false)
+{
+}
+
+
+ActiveResultCallbackList::~ActiveResultCallbackList()
+{
+	for (CallbackVec::iterator it = _callbacks.begin(); it != _callbacks.end(); ++it)
+	{
+		delete *it;
+	}
+}
+
+
+void ActiveResultCallbackList::add(ActiveResultCallback* pCallback)
+{
+	poco_check_ptr (pCallback);
+
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		if (!_done)
+		{
+			_callbacks.push_back(pCallback);
+			return;
+		}
+	}
+	invoke(pCallback);
+}
+
+
+void ActiveResultCallbackList::fire()
+{
+	CallbackVec callbacks;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		_done = true;
+		callbacks.swap(_callbacks);
+	}
+	for (CallbackVec::iterator it = callbacks.begin(); it != callbacks.end(); ++it)
+	{
+		invoke(*it);
+	}
+}
+
+
+void ActiveResultCallbackList::invoke(ActiveResultCallback* pCallback)
+{
+	try
+	{
+		pCallback->completed();
+	}
+	catch (...)
+	{
+		ErrorHandler::handle();
+	}
+}
+
+
+//
+// ActiveContinuationBase
+//
+
+
+ActiveContinuationBase::ActiveContinuationBase(ActiveExecutor* pExecutor):
+	_pExecutor(pExecutor)
+{
+}
+
+
+ActiveContinuationBase::~ActiveContinuationBase()
+{
+}
+
+
+void ActiveContinuationBase::execute()
+{
+	_pExecutor->execute(*this);
+}
+
+
+//
+// ActiveWhenAll
+//
+
+
+class ActiveWhenAll::State: public RefCountedObject
+{
+public:
+	State(const ActiveResult<void>& result, int count):
+		_result(result),
+		_pending(count)
+	{
+	}
+
+	void completed()
+	{
+		if (--_pending == 0) _result.notify();
+	}
+
+private:
+	ActiveResult<void> _result;
+	AtomicCounter      _pending;
+};
+
+
+class ActiveWhenAll::Callback: public ActiveResultCallback
+{
+public:
+	Callback(State* pState):
+		_pState(pState, true)
+	{
+	}
+
+	void completed()
+	{
+		AutoPtr<State> pState(_pState);
+		delete this;
+		pState->completed();
+	}
+
+private:
+	AutoPtr<State> _pState;
+};
+
+
+ActiveWhenAll::ActiveWhenAll(const ActiveResult<void>& result, int count):
+	_pState(new State(result, count))
+{
+}
+
+
+ActiveWhenAll::~ActiveWhenAll()
+{
+	_pState->release();
+}
+
+
+ActiveResultCallback* ActiveWhenAll::callback()
+{
+	return new Callback(_pState);
+}
+
+
+//
+// ActiveWhenAny
+//
+
+
+class ActiveWhenAny::State: public RefCountedObject
+{
+public:
+	State(const ActiveResult<std::size_t>& result):
+		_result(result)
+	{
+	}
+
+	void completed(std::size_t index)
+	{
+		if (++_completed == 1)
+		{
+			_result.data(new std::size_t(index));
+			_result.notify();
+		}
+	}
+
+private:
+	ActiveResult<std::size_t> _result;
+	AtomicCounter             _completed;
+};
+
+
+class ActiveWhenAny::Callback: public ActiveResultCallback
+{
+public:
+	Callback(State* pState, std::size_t index):
+		_pState(pState, true),
+		_index(index)
+	{
+	}
+
+	void completed()
+	{
+		AutoPtr<State> pState(_pState);
+		std::size_t index = _index;
+		delete this;
+		pState->completed(index);
+	}
+
+private:
+	AutoPtr<State> _pState;
+	std::size_t    _index;
+};
+
+
+ActiveWhenAny::ActiveWhenAny(const ActiveResult<std::size_t>& result):
+	_pState(new State(result))
+{
+}
+
+
+ActiveWhenAny::~ActiveWhenAny()
+{
+	_pState->release();
+}
+
+
+ActiveResultCallback* ActiveWhenAny::callback(std::size_t index)
+{
+	return new Callback(_pState, index);
+}
+
+
+} // namespace Poco
@@ -0,0 +1,369 @@
+//
+// AllocationTracker.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  AllocationTracker
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/AllocationTracker.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/Mutex.h"
+#include <new>
+#include <cstdlib>
+
+
+#if defined(POCO_ENABLE_ALLOCATION_TRACKING) && !defined(POCO_NO_THREAD_LOCAL)
+	#if defined(_MSC_VER) && _MSC_VER >= 1900
+		#define POCO_THREAD_LOCAL __declspec(thread)
+	#elif defined(__GNUC__) && (POCO_OS == POCO_OS_LINUX || POCO_OS == POCO_OS_FREE_BSD) && !defined(POCO_ANDROID)
+		#define POCO_THREAD_LOCAL __thread
+	#endif
+#endif
+
+
+namespace Poco {
+
+
+namespace
+{
+	const char* componentNames[AllocationTracker::COMPONENT_COUNT] =
+	{
+		"Other",
+		"Net",
+		"JSON",
+		"Data",
+		"XML",
+		"Logging"
+	};
+
+	enum Counter
+	{
+		ALLOCATIONS,
+		DEALLOCATIONS,
+		BYTES_ALLOCATED,
+		BYTES_DEALLOCATED,
+		POOL_ALLOCATIONS,
+		POOL_DEALLOCATIONS,
+		POOL_BYTES,
+		POOL_BYTES_DEALLOCATED,
+		COUNTER_COUNT
+	};
+
+	// Zero-initialized before any constructor runs, so
+	// allocations made during static initialization are
+	// counted, too.
+	Int64 counters[AllocationTracker::COMPONENT_COUNT][COUNTER_COUNT];
+
+#if !defined(POCO_HAVE_GCC_ATOMICS) && POCO_OS != POCO_OS_WINDOWS_NT
+	FastMutex counterMutex;
+#endif
+
+	inline void add(Int64& counter, Int64 n)
+	{
+#if defined(POCO_HAVE_GCC_ATOMICS)
+		__sync_fetch_and_add(&counter, n);
+#elif POCO_OS == POCO_OS_WINDOWS_NT
+		InterlockedExchangeAdd64(&counter, n);
+#else
+		FastMutex::ScopedLock lock(counterMutex);
+		counter += n;
+#endif
+	}
+
+	inline Int64 get(Int64& counter)
+	{
+#if defined(POCO_HAVE_GCC_ATOMICS)
+		return __sync_fetch_and_add(&counter, 0);
+#elif POCO_OS == POCO_OS_WINDOWS_NT
+		return InterlockedExchangeAdd64(&counter, 0);
+#else
+		FastMutex::ScopedLock lock(counterMutex);
+		return counter;
+#endif
+	}
+
+#if defined(POCO_THREAD_LOCAL)
+	POCO_THREAD_LOCAL int currentComponent = AllocationTracker::COMPONENT_OTHER;
+#endif
+}
+
+
+void AllocationTracker::statistics(Component component, Statistics& stats)
+{
+	poco_assert (component >= 0 && component < COMPONENT_COUNT);
+
+	Int64* c = counters[component];
+	stats.allocations          = get(c[ALLOCATIONS]);
+	stats.deallocations        = get(c[DEALLOCATIONS]);
+	stats.bytesAllocated       = get(c[BYTES_ALLOCATED]);
+	stats.bytesDeallocated     = get(c[BYTES_DEALLOCATED]);
+	stats.poolAllocations      = get(c[POOL_ALLOCATIONS]);
+	stats.poolDeallocations    = get(c[POOL_DEALLOCATIONS]);
+	stats.poolBytes            = get(c[POOL_BYTES]);
+	stats.poolBytesDeallocated = get(c[POOL_BYTES_DEALLOCATED]);
+}
+
+
+void AllocationTracker::reset()
+{
+	for (int i = 0; i < COMPONENT_COUNT; ++i)
+	{
+		for (int k = 0; k < COUNTER_COUNT; ++k)
+		{
+			add(counters[i][k], -get(counters[i][k]));
+		}
+	}
+}
+
+
+void AllocationTracker::report(std::ostream& ostr)
+{
+	for (int i = 0; i < COMPONENT_COUNT; ++i)
+	{
+		Statistics stats;
+		statistics(static_cast<Component>(i), stats);
+		ostr << componentNames[i]
+		     << ": allocations=" << stats.allocations
+		     << " deallocations=" << stats.deallocations
+		     << " bytes=" << stats.bytesAllocated
+		     << " live=" << stats.bytesAllocated - stats.bytesDeallocated
+		     << " poolAllocations=" << stats.poolAllocations
+		     << " poolDeallocations=" << stats.poolDeallocations
+		     << " poolBytes=" << stats.poolBytes
+		     << " poolLive=" << stats.poolBytes - stats.poolBytesDeallocated
+		     << "\n";
+	}
+}
+
+
+const char* AllocationTracker::name(Component component)
+{
+	poco_assert (component >= 0 && component < COMPONENT_COUNT);
+
+	return componentNames[component];
+}
+
+
+AllocationTracker::Component AllocationTracker::current()
+{
+#if defined(POCO_THREAD_LOCAL)
+	return static_cast<Component>(currentComponent);
+#else
+	return COMPONENT_OTHER;
+#endif
+}
+
+
+#if defined(POCO_ENABLE_ALLOCATION_TRACKING)
+
+
+AllocationTracker::Component AllocationTracker::enter(Component component)
+{
+#if defined(POCO_THREAD_LOCAL)
+	Component previous = static_cast<Component>(currentComponent);
+	currentComponent = component;
+	return previous;
+#else
+	return COMPONENT_OTHER;
+#endif
+}
+
+
+void AllocationTracker::leave(Component previous)
+{
+#if defined(POCO_THREAD_LOCAL)
+	currentComponent = previous;
+#endif
+}
+
+
+void AllocationTracker::heapAllocated(Component component, std::size_t size)
+{
+	add(counters[component][ALLOCATIONS], 1);
+	add(counters[component][BYTES_ALLOCATED], static_cast<Int64>(size));
+}
+
+
+void AllocationTracker::heapDeallocated(Component component, std::size_t size)
+{
+	add(counters[component][DEALLOCATIONS], 1);
+	add(counters[component][BYTES_DEALLOCATED], static_cast<Int64>(size));
+}
+
+
+void AllocationTracker::poolAllocated(std::size_t size)
+{
+	Component component = current();
+	add(counters[component][POOL_ALLOCATIONS], 1);
+	add(counters[component][POOL_BYTES], static_cast<Int64>(size));
+}
+
+
+void AllocationTracker::poolDeallocated(std::size_t size)
+{
+	Component component = current();
+	add(counters[component][POOL_DEALLOCATIONS], 1);
+	add(counters[component][POOL_BYTES_DEALLOCATED], static_cast<Int64>(size));
+}
+
+
+#endif // POCO_ENABLE_ALLOCATION_TRACKING
+
+
+} // namespace Poco
+
+
+#if defined(POCO_ENABLE_ALLOCATION_TRACKING)
+
+
+//
+// Replacements for the global operator new and operator delete.
+// Every block is preceded by a header holding its size and
+// the component it was allocated for.
+//
+
+
+#if __cplusplus >= 201103L
+	#define POCO_NEW_THROWS
+	#define POCO_NEW_NOTHROW noexcept
+#else
+	#define POCO_NEW_THROWS throw(std::bad_alloc)
+	#define POCO_NEW_NOTHROW throw()
+#endif
+
+
+namespace
+{
+	struct BlockHeader
+	{
+		std::size_t size;
+		int         component;
+	};
+
+	enum
+	{
+		HEADER_SIZE = 16 // keeps blocks aligned like malloc() does
+	};
+
+	void* trackedAlloc(std::size_t size)
+	{
+		for (;;)
+		{
+			char* p = static_cast<char*>(std::malloc(size + HEADER_SIZE));
+			if (p)
+			{
+				BlockHeader* pHeader = reinterpret_cast<BlockHeader*>(p);
+				pHeader->size = size;
+				pHeader->component = Poco::AllocationTracker::current();
+				Poco::AllocationTracker::heapAllocated(static_cast<Poco::AllocationTracker::Component>(pHeader->component), size);
+				return p + HEADER_SIZE;
+			}
+			std::new_handler handler = std::set_new_handler(0);
+			std::set_new_handler(handler);
+			if (!handler) throw std::bad_alloc();
+			handler();
+		}
+	}
+
+	void trackedFree(void* ptr)
+	{
+		if (!ptr) return;
+
+		char* p = static_cast<char*>(ptr) - HEADER_SIZE;
+		BlockHeader* pHeader = reinterpret_cast<BlockHeader*>(p);
+		Poco::AllocationTracker::heapDeallocated(static_cast<Poco::AllocationTracker::Component>(pHeader->component), pHeader->size);
+		std::free(p);
+	}
+}
+
+
+void* operator new(std::size_t size) POCO_NEW_THROWS
+{
+	return trackedAlloc(size);
+}
+
+
+void* operator new[](std::size_t size) POCO_NEW_THROWS
+{
+	return trackedAlloc(size);
+}
+
+
+void* operator new(std::size_t size, const std::nothrow_t&) POCO_NEW_NOTHROW
+{
+	try
+	{
+		return trackedAlloc(size);
+	}
+	catch (...)
+	{
+		return 0;
+	}
+}
+
+
+void* operator new[](std::size_t size, const std::nothrow_t&) POCO_NEW_NOTHROW
+{
+	try
+	{
+		return trackedAlloc(size);
+	}
+	catch (...)
+	{
+		return 0;
+	}
+}
+
+
+void operator delete(void* ptr) POCO_NEW_NOTHROW
+{
+	trackedFree(ptr);
+}
+
+
+void operator delete[](void* ptr) POCO_NEW_NOTHROW
+{
+	trackedFree(ptr);
+}
+
+
+void operator delete(void* ptr, const std::nothrow_t&) POCO_NEW_NOTHROW
+{
+	trackedFree(ptr);
+}
+
+
+void operator delete[](void* ptr, const std::nothrow_t&) POCO_NEW_NOTHROW
+{
+	trackedFree(ptr);
+}
+
+
+#if __cplusplus >= 201402L
+
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	trackedFree(ptr);
+}
+
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+	trackedFree(ptr);
+}
+
+
+#endif
+
+
+#endif // POCO_ENABLE_ALLOCATION_TRACKING
@@ -0,0 +1,141 @@
+//
+// Arena.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  Arena
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Arena.h"
+
+
+namespace Poco {
+
+
+Arena::Arena(std::size_t chunkSize):
+	_chunkSize(chunkSize),
+	_pBuffer(0),
+	_bufferSize(0),
+	_pChunks(0),
+	_pCurrent(0),
+	_pEnd(0),
+	_used(0),
+	_capacity(0)
+{
+	poco_assert (chunkSize > sizeof(Chunk));
+}
+
+
+Arena::Arena(void* pBuffer, std::size_t size, std::size_t chunkSize):
+	_chunkSize(chunkSize),
+	_pBuffer(static_cast<char*>(pBuffer)),
+	_bufferSize(size),
+	_pChunks(0),
+	_pCurrent(static_cast<char*>(pBuffer)),
+	_pEnd(static_cast<char*>(pBuffer) + size),
+	_used(0),
+	_capacity(0)
+{
+	poco_check_ptr (pBuffer);
+	poco_assert (chunkSize > sizeof(Chunk));
+}
+
+
+Arena::~Arena()
+{
+	freeChunks(_pChunks);
+}
+
+
+void Arena::reset()
+{
+	if (_pBuffer)
+	{
+		freeChunks(_pChunks);
+		_pChunks  = 0;
+		_capacity = 0;
+		_pCurrent = _pBuffer;
+		_pEnd     = _pBuffer + _bufferSize;
+	}
+	else if (_pChunks)
+	{
+		// Chunks are linked newest first, so the first
+		// chunk is the last one in the list.
+		Chunk* pFirst = _pChunks;
+		Chunk* pPrev = 0;
+		while (pFirst->pNext)
+		{
+			pPrev = pFirst;
+			pFirst = pFirst->pNext;
+		}
+		if (pPrev)
+		{
+			pPrev->pNext = 0;
+			freeChunks(_pChunks);
+		}
+		_pChunks  = pFirst;
+		_capacity = pFirst->size;
+		_pCurrent = reinterpret_cast<char*>(pFirst) + sizeof(Chunk);
+		_pEnd     = reinterpret_cast<char*>(pFirst) + pFirst->size;
+	}
+	_used = 0;
+}
+
+
+void Arena::release()
+{
+	freeChunks(_pChunks);
+	_pChunks  = 0;
+	_capacity = 0;
+	_pCurrent = _pBuffer;
+	_pEnd     = _pBuffer ? _pBuffer + _bufferSize : 0;
+	_used     = 0;
+}
+
+
+void* Arena::allocateChunk(std::size_t size, std::size_t alignment)
+{
+	std::size_t needed = sizeof(Chunk) + size + alignment;
+	if (needed < size) throw std::bad_alloc();
+	bool dedicated = needed > _chunkSize;
+	std::size_t chunkSize = dedicated ? needed : _chunkSize;
+
+	Chunk* pChunk = reinterpret_cast<Chunk*>(new char[chunkSize]);
+	pChunk->size  = chunkSize;
+	pChunk->pNext = _pChunks;
+	_pChunks = pChunk;
+	_capacity += chunkSize;
+
+	char* p = align(reinterpret_cast<char*>(pChunk) + sizeof(Chunk), alignment);
+	_used += size;
+	if (!dedicated)
+	{
+		// An oversized block gets a chunk of its own, so that
+		// the rest of the current chunk is not wasted.
+		_pCurrent = p + size;
+		_pEnd = reinterpret_cast<char*>(pChunk) + chunkSize;
+	}
+	return p;
+}
+
+
+void Arena::freeChunks(Chunk* pChunk)
+{
+	while (pChunk)
+	{
+		Chunk* pNext = pChunk->pNext;
+		delete [] reinterpret_cast<char*>(pChunk);
+		pChunk = pNext;
+	}
+}
+
+
+} // namespace Poco
@@ -0,0 +1,361 @@
+//
+// Base64Codec.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Streams
+// Module:  Base64
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Base64Codec.h"
+#include "Poco/Exception.h"
+#include "Poco/CPUFeatures.h"
+#if defined(POCO_X86_SIMD)
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#endif
+	#include <immintrin.h>
+#endif
+
+
+namespace Poco {
+
+
+namespace
+{
+	const char ENCODING[64] =
+	{
+		'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H',
+		'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
+		'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X',
+		'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
+		'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n',
+		'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
+		'w', 'x', 'y', 'z', '0', '1', '2', '3',
+		'4', '5', '6', '7', '8', '9', '+', '/'
+	};
+
+	const unsigned char INVALID = 0xFF;
+
+	const unsigned char DECODING[256] =
+	{
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+		0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+		0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+		0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+	};
+
+	std::size_t encodeScalar(const unsigned char* data, std::size_t length, char* encoded)
+	{
+		char* p = encoded;
+		std::size_t i = 0;
+		for (; length - i >= 3; i += 3)
+		{
+			UInt32 v = (UInt32(data[i]) << 16) | (UInt32(data[i + 1]) << 8) | data[i + 2];
+			*p++ = ENCODING[v >> 18];
+			*p++ = ENCODING[(v >> 12) & 0x3F];
+			*p++ = ENCODING[(v >> 6) & 0x3F];
+			*p++ = ENCODING[v & 0x3F];
+		}
+		if (length - i == 1)
+		{
+			UInt32 v = UInt32(data[i]) << 16;
+			*p++ = ENCODING[v >> 18];
+			*p++ = ENCODING[(v >> 12) & 0x3F];
+			*p++ = '=';
+			*p++ = '=';
+		}
+		else if (length - i == 2)
+		{
+			UInt32 v = (UInt32(data[i]) << 16) | (UInt32(data[i + 1]) << 8);
+			*p++ = ENCODING[v >> 18];
+			*p++ = ENCODING[(v >> 12) & 0x3F];
+			*p++ = ENCODING[(v >> 6) & 0x3F];
+			*p++ = '=';
+		}
+		return p - encoded;
+	}
+
+	std::size_t decodeScalar(const unsigned char* encoded, std::size_t length, unsigned char* data)
+	{
+		unsigned char* p = data;
+		const unsigned char* end = encoded + length;
+		for (const unsigned char* q = encoded; q < end; q += 4)
+		{
+			UInt32 a = DECODING[q[0]];
+			UInt32 b = DECODING[q[1]];
+			UInt32 c = DECODING[q[2]];
+			UInt32 d = DECODING[q[3]];
+			if ((a | b | c | d) & 0x80)
+			{
+				// Either an invalid character or padding,
+				// which is only allowed in the last group.
+				if (q + 4 == end && a != INVALID && b != INVALID && q[3] == '=')
+				{
+					if (q[2] == '=')
+					{
+						*p++ = static_cast<unsigned char>((a << 2) | (b >> 4));
+						break;
+					}
+					else if (c != INVALID)
+					{
+						*p++ = static_cast<unsigned char>((a << 2) | (b >> 4));
+						*p++ = static_cast<unsigned char>((b << 4) | (c >> 2));
+						break;
+					}
+				}
+				throw DataFormatException("Invalid Base64 data");
+			}
+			UInt32 v = (a << 18) | (b << 12) | (c << 6) | d;
+			*p++ = static_cast<unsigned char>(v >> 16);
+			*p++ = static_cast<unsigned char>(v >> 8);
+			*p++ = static_cast<unsigned char>(v);
+		}
+		return p - data;
+	}
+
+#if defined(POCO_X86_SIMD)
+
+	//
+	// The SIMD kernels follow Wojciech Mula and Daniel Lemire,
+	// "Faster Base64 Encoding and Decoding Using AVX2 Instructions".
+	//
+	// Encoding shuffles every three input bytes into a 32-bit lane,
+	// moves their four sextets into the four bytes of the lane with
+	// two multiplications, and maps each sextet to its character by
+	// adding an offset looked up from its range.
+	//
+	// Decoding classifies every character by looking up bit sets
+	// for its low and high nibbles; the character is valid if the
+	// two sets are disjoint. The high nibble (and whether the
+	// character is '/') selects the offset that turns it into its
+	// sextet, and two multiply-adds pack four sextets into three
+	// bytes. A block containing anything else, such as padding,
+	// is left to the scalar code.
+	//
+	// Kernels read and write up to 16 (SSSE3) or 32 (AVX2) bytes
+	// at a time, so they stop early enough to stay within the
+	// caller's buffers.
+	//
+
+	POCO_SIMD_TARGET("ssse3")
+	std::size_t encodeSSSE3(const unsigned char* data, std::size_t length, char* encoded)
+	{
+		const __m128i shuffle = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+		const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+		std::size_t i = 0;
+		for (; length - i >= 16; i += 12)
+		{
+			__m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+			in = _mm_shuffle_epi8(in, shuffle);
+			__m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+			__m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+			__m128i sextets = _mm_or_si128(t0, t1);
+			__m128i range = _mm_subs_epu8(sextets, _mm_set1_epi8(51));
+			range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), sextets), _mm_set1_epi8(13)));
+			__m128i out = _mm_add_epi8(sextets, _mm_shuffle_epi8(offsets, range));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(encoded + i/3*4), out);
+		}
+		return i;
+	}
+
+	POCO_SIMD_TARGET("avx2")
+	std::size_t encodeAVX2(const unsigned char* data, std::size_t length, char* encoded)
+	{
+		const __m256i shuffle = _mm256_setr_epi8(
+			1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+			1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+		const __m256i offsets = _mm256_setr_epi8(
+			'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+			'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+		std::size_t i = 0;
+		for (; length - i >= 28; i += 24)
+		{
+			__m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+			__m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 12));
+			__m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+			in = _mm256_shuffle_epi8(in, shuffle);
+			__m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+			__m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+			__m256i sextets = _mm256_or_si256(t0, t1);
+			__m256i range = _mm256_subs_epu8(sextets, _mm256_set1_epi8(51));
+			range = _mm256_or_si256(range, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), sextets), _mm256_set1_epi8(13)));
+			__m256i out = _mm256_add_epi8(sextets, _mm256_shuffle_epi8(offsets, range));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(encoded + i/3*4), out);
+		}
+		return i;
+	}
+
+	POCO_SIMD_TARGET("ssse3")
+	std::size_t decodeSSSE3(const unsigned char* encoded, std::size_t length, unsigned char* data)
+	{
+		const __m128i lowLUT = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+		const __m128i highLUT = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+		const __m128i offsetLUT = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+		const __m128i mask = _mm_set1_epi8(0x2F);
+		const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+		std::size_t i = 0;
+		for (; length - i >= 24; i += 16)
+		{
+			__m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(encoded + i));
+			__m128i high = _mm_and_si128(_mm_srli_epi32(in, 4), mask);
+			__m128i lowClass = _mm_shuffle_epi8(lowLUT, _mm_and_si128(in, mask));
+			__m128i highClass = _mm_shuffle_epi8(highLUT, high);
+			__m128i invalid = _mm_cmpeq_epi8(_mm_and_si128(lowClass, highClass), _mm_setzero_si128());
+			if (_mm_movemask_epi8(invalid) != 0xFFFF) break;
+
+			__m128i offset = _mm_shuffle_epi8(offsetLUT, _mm_add_epi8(_mm_cmpeq_epi8(in, mask), high));
+			__m128i sextets = _mm_add_epi8(in, offset);
+			__m128i out = _mm_madd_epi16(_mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+			out = _mm_shuffle_epi8(out, pack);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(data + i/4*3), out);
+		}
+		return i;
+	}
+
+	POCO_SIMD_TARGET("avx2")
+	std::size_t decodeAVX2(const unsigned char* encoded, std::size_t length, unsigned char* data)
+	{
+		const __m256i lowLUT = _mm256_setr_epi8(
+			0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+			0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+		const __m256i highLUT = _mm256_setr_epi8(
+			0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+			0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+		const __m256i offsetLUT = _mm256_setr_epi8(
+			0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+			0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+		const __m256i mask = _mm256_set1_epi8(0x2F);
+		const __m256i pack = _mm256_setr_epi8(
+			2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+			2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+		const __m256i join = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+		std::size_t i = 0;
+		for (; length - i >= 44; i += 32)
+		{
+			__m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(encoded + i));
+			__m256i high = _mm256_and_si256(_mm256_srli_epi32(in, 4), mask);
+			__m256i lowClass = _mm256_shuffle_epi8(lowLUT, _mm256_and_si256(in, mask));
+			__m256i highClass = _mm256_shuffle_epi8(highLUT, high);
+			if (!_mm256_testz_si256(lowClass, highClass)) break;
+
+			__m256i offset = _mm256_shuffle_epi8(offsetLUT, _mm256_add_epi8(_mm256_cmpeq_epi8(in, mask), high));
+			__m256i sextets = _mm256_add_epi8(in, offset);
+			__m256i out = _mm256_madd_epi16(_mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+			out = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(out, pack), join);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i/4*3), out);
+		}
+		return i;
+	}
+
+#endif // POCO_X86_SIMD
+
+	void checkSupported(Base64Codec::Implementation impl)
+	{
+		if (!Base64Codec::isSupported(impl))
+			throw InvalidArgumentException("Base64 implementation not supported by this processor", Base64Codec::name(impl));
+	}
+}
+
+
+std::size_t Base64Codec::encode(const void* data, std::size_t length, char* encoded, Implementation impl)
+{
+	checkSupported(impl);
+
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	std::size_t done = 0;
+#if defined(POCO_X86_SIMD)
+	if (impl == IMPL_AVX2)
+		done = encodeAVX2(p, length, encoded);
+	if (impl >= IMPL_SSSE3)
+		done += encodeSSSE3(p + done, length - done, encoded + done/3*4);
+#endif
+	return done/3*4 + encodeScalar(p + done, length - done, encoded + done/3*4);
+}
+
+
+std::string Base64Codec::encode(const std::string& data)
+{
+	std::string encoded(encodedLength(data.size()), '\0');
+	if (!data.empty()) encode(data.data(), data.size(), &encoded[0]);
+	return encoded;
+}
+
+
+std::size_t Base64Codec::decode(const char* encoded, std::size_t length, void* data, Implementation impl)
+{
+	checkSupported(impl);
+	if (length % 4 != 0) throw DataFormatException("Base64 data length is not a multiple of four");
+
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(encoded);
+	unsigned char* q = static_cast<unsigned char*>(data);
+	std::size_t done = 0;
+#if defined(POCO_X86_SIMD)
+	if (impl == IMPL_AVX2)
+		done = decodeAVX2(p, length, q);
+	if (impl >= IMPL_SSSE3)
+		done += decodeSSSE3(p + done, length - done, q + done/4*3);
+#endif
+	return done/4*3 + decodeScalar(p + done, length - done, q + done/4*3);
+}
+
+
+std::string Base64Codec::decode(const std::string& encoded)
+{
+	if (encoded.size() % 4 != 0) throw DataFormatException("Base64 data length is not a multiple of four");
+
+	std::string data(decodedLength(encoded.size()), '\0');
+	if (!data.empty()) data.resize(decode(encoded.data(), encoded.size(), &data[0]));
+	return data;
+}
+
+
+Base64Codec::Implementation Base64Codec::implementation()
+{
+	if (CPUFeatures::hasAVX2())
+		return IMPL_AVX2;
+	else if (CPUFeatures::hasSSSE3())
+		return IMPL_SSSE3;
+	else
+		return IMPL_SCALAR;
+}
+
+
+bool Base64Codec::isSupported(Implementation impl)
+{
+	return impl >= IMPL_SCALAR && impl <= implementation();
+}
+
+
+const char* Base64Codec::name(Implementation impl)
+{
+	switch (impl)
+	{
+	case IMPL_SCALAR: return "scalar";
+	case IMPL_SSSE3:  return "SSSE3";
+	case IMPL_AVX2:   return "AVX2";
+	default:          return "unknown";
+	}
+}
+
+
+} // namespace Poco
@@ -16,6 +16,7 @@
 
 #include "Poco/Base64Decoder.h"
 #include "Poco/Base64Encoder.h"
+#include "Poco/Base64Codec.h"
 #include "Poco/Exception.h"
 #include "Poco/Mutex.h"
 
@@ -108,6 +109,79 @@ int Base64DecoderBuf::readOne()
 }
 
 
+std::streamsize Base64DecoderBuf::xsgetn(char* s, std::streamsize count)
+{
+	static const int eof = std::char_traits<char>::eof();
+
+	if (count <= 0) return 0;
+
+	// The first character goes through uflow(), which takes
+	// care of a character that has been peeked at or put back.
+	int c = uflow();
+	if (c == eof) return 0;
+	s[0] = static_cast<char>(c);
+	std::streamsize n = 1;
+	while (n < count && _groupIndex < _groupLength)
+	{
+		s[n++] = _group[_groupIndex++];
+	}
+
+	char buffer[BUFFER_SIZE];
+	while (count - n >= 3)
+	{
+		// Read just as many characters as needed
+		// for the requested number of bytes.
+		std::streamsize wanted = 4*((count - n)/3);
+		if (wanted > BUFFER_SIZE) wanted = BUFFER_SIZE;
+		std::streamsize length = 0;
+		bool atEnd = false;
+		while (length < wanted && !atEnd)
+		{
+			// A short read means the end of the data. Some streambufs
+			// must not be read again after they have reported it.
+			std::streamsize requested = wanted - length;
+			std::streamsize nRead = _buf.sgetn(buffer + length, requested);
+			atEnd = nRead < requested;
+			const char* it = buffer + length;
+			const char* end = it + (nRead > 0 ? nRead : 0);
+			for (; it != end; ++it)
+			{
+				if (*it != ' ' && *it != '\r' && *it != '\t' && *it != '\n')
+					buffer[length++] = *it;
+			}
+		}
+		if (length % 4 != 0) throw DataFormatException();
+		n += static_cast<std::streamsize>(decodeBlock(buffer, static_cast<std::size_t>(length), s + n));
+		if (atEnd) return n;
+	}
+	while (n < count)
+	{
+		c = readFromDevice();
+		if (c == eof) break;
+		s[n++] = static_cast<char>(c);
+	}
+	return n;
+}
+
+
+std::size_t Base64DecoderBuf::decodeBlock(const char* encoded, std::size_t length, char* data)
+{
+	// Base64Codec only accepts padding in the last group, so
+	// decode up to and including every padded group separately.
+	std::size_t n = 0;
+	std::size_t pos = 0;
+	while (pos < length)
+	{
+		std::size_t next = pos;
+		while (next < length && encoded[next] != '=') ++next;
+		next = next < length ? (next/4 + 1)*4 : length;
+		n += Base64Codec::decode(encoded + pos, next - pos, data + n);
+		pos = next;
+	}
+	return n;
+}
+
+
 Base64DecoderIOS::Base64DecoderIOS(std::istream& istr): _buf(istr)
 {
 	poco_ios_init(&_buf);
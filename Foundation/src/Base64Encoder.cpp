@@ -15,6 +15,7 @@
 
 
 #include "Poco/Base64Encoder.h"
+#include "Poco/Base64Codec.h"
 
 
 namespace Poco {
@@ -95,33 +96,59 @@ int Base64EncoderBuf::writeToDevice(char c)
 }
 
 
-int Base64EncoderBuf::close()
+std::streamsize Base64EncoderBuf::xsputn(const char* s, std::streamsize count)
 {
 	static const int eof = std::char_traits<char>::eof();
 
-	if (sync() == eof) return eof;
-	if (_groupLength == 1)
+	const char* p = s;
+	const char* end = s + count;
+	while (_groupLength > 0 && p < end)
 	{
-		_group[1] = 0;
-		unsigned char idx;
-		idx = _group[0] >> 2;
-		if (_buf.sputc(OUT_ENCODING[idx]) == eof) return eof;
-		idx = ((_group[0] & 0x03) << 4) | (_group[1] >> 4);
-		if (_buf.sputc(OUT_ENCODING[idx]) == eof) return eof;
-		if (_buf.sputc('=') == eof) return eof;
-		if (_buf.sputc('=') == eof) return eof;
+		if (writeToDevice(*p) == eof) return p - s;
+		++p;
 	}
-	else if (_groupLength == 2)
+	char buffer[BUFFER_SIZE];
+	while (end - p >= 3)
 	{
-		_group[2] = 0;
-		unsigned char idx;
-		idx = _group[0] >> 2;
-		if (_buf.sputc(OUT_ENCODING[idx]) == eof) return eof;
-		idx = ((_group[0] & 0x03) << 4) | (_group[1] >> 4);
-		if (_buf.sputc(OUT_ENCODING[idx]) == eof) return eof;
-		idx = ((_group[1] & 0x0F) << 2) | (_group[2] >> 6);
-		if (_buf.sputc(OUT_ENCODING[idx]) == eof) return eof;
-		if (_buf.sputc('=') == eof) return eof;
+		std::streamsize groups = (end - p)/3;
+		if (groups > BUFFER_SIZE/4) groups = BUFFER_SIZE/4;
+		if (_lineLength > 0)
+		{
+			// A line ends after the first group that reaches the line length.
+			std::streamsize groupsLeft = (_lineLength + 3)/4 - _pos/4;
+			if (groupsLeft < 1) groupsLeft = 1;
+			if (groups > groupsLeft) groups = groupsLeft;
+		}
+		std::streamsize n = static_cast<std::streamsize>(Base64Codec::encode(p, static_cast<std::size_t>(3*groups), buffer));
+		if (_buf.sputn(buffer, n) != n) return p - s;
+		p += 3*groups;
+		_pos += static_cast<int>(n);
+		if (_lineLength > 0 && _pos >= _lineLength) 
+		{
+			if (_buf.sputc('\r') == eof) return p - s;
+			if (_buf.sputc('\n') == eof) return p - s;
+			_pos = 0;
+		}
+	}
+	while (p < end)
+	{
+		if (writeToDevice(*p) == eof) return p - s;
+		++p;
+	}
+	return count;
+}
+
+
+int Base64EncoderBuf::close()
+{
+	static const int eof = std::char_traits<char>::eof();
+
+	if (sync() == eof) return eof;
+	if (_groupLength > 0)
+	{
+		char buffer[4];
+		Base64Codec::encode(_group, _groupLength, buffer);
+		if (_buf.sputn(buffer, 4) != 4) return eof;
 	}
 	_groupLength = 0;
 	return _buf.pubsync();
@@ -0,0 +1,312 @@
+//
+// BoundedNotificationQueue.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  BoundedNotificationQueue
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/BoundedNotificationQueue.h"
+#include "Poco/NotificationCenter.h"
+#include "Poco/Timestamp.h"
+
+
+namespace Poco {
+
+
+namespace
+{
+	// Positions and sequence numbers wrap around, so all
+	// arithmetic on them is done with unsigned integers.
+
+	inline int add(int a, int b)
+	{
+		return static_cast<int>(static_cast<unsigned>(a) + static_cast<unsigned>(b));
+	}
+
+	inline int diff(int a, int b)
+	{
+		return static_cast<int>(static_cast<unsigned>(a) - static_cast<unsigned>(b));
+	}
+}
+
+
+BoundedNotificationQueue::BoundedNotificationQueue(int capacity):
+	_capacity(2),
+	_mask(0),
+	_cells(0),
+	_consumerSema(0, 0x7FFFFFFF),
+	_producerSema(0, 0x7FFFFFFF)
+{
+	poco_assert (capacity > 0 && capacity <= 0x40000000);
+
+	while (_capacity < capacity) _capacity <<= 1;
+	_mask = _capacity - 1;
+	_cells = new Cell[_capacity];
+	for (int i = 0; i < _capacity; ++i)
+	{
+		_cells[i].sequence = i;
+		_cells[i].pNf = 0;
+	}
+}
+
+
+BoundedNotificationQueue::~BoundedNotificationQueue()
+{
+	try
+	{
+		clear();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+	delete [] _cells;
+}
+
+
+void BoundedNotificationQueue::enqueueNotification(Notification::Ptr pNotification)
+{
+	poco_check_ptr (pNotification);
+
+	Notification* pNf = pNotification.duplicate();
+	while (!push(pNf))
+	{
+		++_producers;
+		if (push(pNf))
+		{
+			cancelWait(_producers, _producerSema);
+			break;
+		}
+		_producerSema.wait();
+	}
+	wakeOne(_consumers, _consumerSema);
+}
+
+
+bool BoundedNotificationQueue::tryEnqueueNotification(Notification::Ptr pNotification)
+{
+	poco_check_ptr (pNotification);
+
+	Notification* pNf = pNotification.duplicate();
+	if (push(pNf))
+	{
+		wakeOne(_consumers, _consumerSema);
+		return true;
+	}
+	pNf->release();
+	return false;
+}
+
+
+Notification* BoundedNotificationQueue::dequeueNotification()
+{
+	Notification* pNf = pop();
+	if (pNf) wakeOne(_producers, _producerSema);
+	return pNf;
+}
+
+
+Notification* BoundedNotificationQueue::waitDequeueNotification()
+{
+	Notification* pNf = pop();
+	while (!pNf)
+	{
+		int wakeUps = _wakeUps.value();
+		++_consumers;
+		pNf = pop();
+		if (pNf || _wakeUps.value() != wakeUps)
+		{
+			cancelWait(_consumers, _consumerSema);
+			break;
+		}
+		_consumerSema.wait();
+		if (_wakeUps.value() != wakeUps) return 0;
+		pNf = pop();
+	}
+	if (pNf) wakeOne(_producers, _producerSema);
+	return pNf;
+}
+
+
+Notification* BoundedNotificationQueue::waitDequeueNotification(long milliseconds)
+{
+	Notification* pNf = pop();
+	if (!pNf)
+	{
+		Timestamp deadline;
+		deadline += Timestamp::TimeDiff(milliseconds)*1000;
+		long remaining = milliseconds;
+		while (!pNf && remaining >= 0)
+		{
+			int wakeUps = _wakeUps.value();
+			++_consumers;
+			pNf = pop();
+			if (pNf || _wakeUps.value() != wakeUps)
+			{
+				cancelWait(_consumers, _consumerSema);
+				break;
+			}
+			if (!_consumerSema.tryWait(remaining))
+			{
+				cancelWait(_consumers, _consumerSema);
+				pNf = pop();
+				break;
+			}
+			if (_wakeUps.value() != wakeUps) break;
+			pNf = pop();
+			remaining = static_cast<long>((deadline - Timestamp())/1000);
+		}
+	}
+	if (pNf) wakeOne(_producers, _producerSema);
+	return pNf;
+}
+
+
+void BoundedNotificationQueue::dispatch(NotificationCenter& notificationCenter)
+{
+	Notification::Ptr pNf = dequeueNotification();
+	while (pNf)
+	{
+		notificationCenter.postNotification(pNf);
+		pNf = dequeueNotification();
+	}
+}
+
+
+void BoundedNotificationQueue::wakeUpAll()
+{
+	++_wakeUps;
+	while (claim(_consumers))
+	{
+		_consumerSema.set();
+	}
+}
+
+
+bool BoundedNotificationQueue::empty() const
+{
+	return size() == 0;
+}
+
+
+int BoundedNotificationQueue::size() const
+{
+	int n = diff(_enqueuePos.value(), _dequeuePos.value());
+	if (n < 0) return 0;
+	if (n > _capacity) return _capacity;
+	return n;
+}
+
+
+void BoundedNotificationQueue::clear()
+{
+	Notification* pNf = dequeueNotification();
+	while (pNf)
+	{
+		pNf->release();
+		pNf = dequeueNotification();
+	}
+}
+
+
+bool BoundedNotificationQueue::push(Notification* pNotification)
+{
+	int pos = _enqueuePos.value();
+	for (;;)
+	{
+		Cell& cell = _cells[pos & _mask];
+		int seq = cell.sequence.value();
+		int dif = diff(seq, pos);
+		if (dif == 0)
+		{
+			// The cell is free. Claim it by advancing the
+			// enqueue position, then fill it and publish it
+			// to consumers by advancing its sequence number.
+			if (_enqueuePos.compareAndSet(pos, add(pos, 1)))
+			{
+				cell.pNf = pNotification;
+				cell.sequence.compareAndSet(seq, add(pos, 1));
+				return true;
+			}
+		}
+		else if (dif < 0)
+		{
+			// The cell still holds a notification from the
+			// previous round, so the queue is full.
+			return false;
+		}
+		pos = _enqueuePos.value();
+	}
+}
+
+
+Notification* BoundedNotificationQueue::pop()
+{
+	int pos = _dequeuePos.value();
+	for (;;)
+	{
+		Cell& cell = _cells[pos & _mask];
+		int seq = cell.sequence.value();
+		int dif = diff(seq, add(pos, 1));
+		if (dif == 0)
+		{
+			if (_dequeuePos.compareAndSet(pos, add(pos, 1)))
+			{
+				Notification* pNf = cell.pNf;
+				cell.pNf = 0;
+				// hand the cell over to the producers of the next round
+				cell.sequence.compareAndSet(seq, add(pos, _capacity));
+				return pNf;
+			}
+		}
+		else if (dif < 0)
+		{
+			// The cell has not been filled yet, so the queue is empty.
+			return 0;
+		}
+		pos = _dequeuePos.value();
+	}
+}
+
+
+bool BoundedNotificationQueue::claim(AtomicCounter& waiters)
+{
+	int n = waiters.value();
+	while (n > 0)
+	{
+		if (waiters.compareAndSet(n, n - 1)) return true;
+		n = waiters.value();
+	}
+	return false;
+}
+
+
+void BoundedNotificationQueue::wakeOne(AtomicCounter& waiters, Semaphore& sema)
+{
+	// A waiting thread increments the counter before it checks the
+	// queue for the last time, and we have changed the queue with a
+	// full barrier before looking at the counter. So either the
+	// waiter sees our change, or we see the waiter.
+	if (claim(waiters)) sema.set();
+}
+
+
+void BoundedNotificationQueue::cancelWait(AtomicCounter& waiters, Semaphore& sema)
+{
+	// If we cannot take back our registration, another thread has
+	// already claimed it and is going to signal the semaphore.
+	// That signal is meant for us, so consume it.
+	if (!claim(waiters)) sema.wait();
+}
+
+
+} // namespace Poco
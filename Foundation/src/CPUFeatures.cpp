@@ -0,0 +1,58 @@
+//
+// CPUFeatures.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  CPUFeatures
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/CPUFeatures.h"
+#if defined(POCO_X86_SIMD) && defined(_MSC_VER)
+	#include <intrin.h>
+	#include <immintrin.h>
+#endif
+
+
+namespace Poco {
+
+
+int CPUFeatures::features()
+{
+	// Detection has no side effects, so it does
+	// not matter if two threads happen to run it.
+	static int features = -1;
+	if (features >= 0) return features;
+
+	int result = 0;
+#if defined(POCO_X86_SIMD) && defined(__GNUC__)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("ssse3")) result |= FEATURE_SSSE3;
+	if (__builtin_cpu_supports("avx2")) result |= FEATURE_AVX2;
+#elif defined(POCO_X86_SIMD)
+	int info[4];
+	__cpuid(info, 0);
+	int maxLeaf = info[0];
+	__cpuid(info, 1);
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+	if (info[2] & (1 << 9)) result |= FEATURE_SSSE3;
+	if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 6) == 6)
+	{
+		__cpuidex(info, 7, 0);
+		if (info[1] & (1 << 5)) result |= FEATURE_AVX2;
+	}
+#endif
+	features = result;
+	return features;
+}
+
+
+} // namespace Poco
@@ -0,0 +1,225 @@
+//
+// CPUTopology.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Threading
+// Module:  CPUTopology
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/CPUTopology.h"
+#include "Poco/Environment.h"
+#include "Poco/DirectoryIterator.h"
+#include "Poco/FileStream.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Ascii.h"
+#include "Poco/Path.h"
+#include "Poco/File.h"
+#include "Poco/Exception.h"
+#include <algorithm>
+#include <map>
+#if POCO_OS == POCO_OS_LINUX
+#include <sched.h>
+#elif defined(POCO_OS_FAMILY_WINDOWS)
+#include "Poco/UnWindows.h"
+#endif
+
+
+namespace Poco {
+
+
+namespace
+{
+	const int MAX_CPU = 65535;
+}
+
+
+CPUTopology::CPUTopology()
+{
+#if POCO_OS == POCO_OS_LINUX
+	try
+	{
+		load("/sys/devices/system/node");
+	}
+	catch (Exception&)
+	{
+		_nodes.clear();
+		_cpuNode.clear();
+	}
+#endif
+	if (_nodes.empty())
+	{
+		CPUSet cpus;
+		int count = static_cast<int>(Environment::processorCount());
+		for (int i = 0; i < count; ++i) cpus.push_back(i);
+		addNode(cpus);
+	}
+}
+
+
+CPUTopology::CPUTopology(const std::string& nodePath)
+{
+	load(nodePath);
+}
+
+
+CPUTopology::~CPUTopology()
+{
+}
+
+
+const CPUTopology::CPUSet& CPUTopology::nodeCPUs(int node) const
+{
+	poco_assert (node >= 0 && node < nodeCount());
+
+	return _nodes[node];
+}
+
+
+int CPUTopology::nodeOf(int cpu) const
+{
+	if (cpu >= 0 && cpu < static_cast<int>(_cpuNode.size()))
+		return _cpuNode[cpu];
+	else
+		return -1;
+}
+
+
+void CPUTopology::load(const std::string& nodePath)
+{
+	// Directory entries come in no particular order,
+	// so sort the nodes by their system numbers.
+	std::map<int, CPUSet> nodes;
+	DirectoryIterator end;
+	for (DirectoryIterator it(nodePath); it != end; ++it)
+	{
+		const std::string& name = it.name();
+		int node;
+		if (name.compare(0, 4, "node") == 0 && NumberParser::tryParse(name.substr(4), node))
+		{
+			Path cpuListPath(it.path(), "cpulist");
+			if (File(cpuListPath).exists())
+			{
+				FileInputStream istr(cpuListPath.toString());
+				std::string list;
+				std::getline(istr, list);
+				nodes[node] = parseCPUList(list);
+			}
+		}
+	}
+	for (std::map<int, CPUSet>::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+	{
+		// Nodes without processors (memory only) are of no interest.
+		if (!it->second.empty()) addNode(it->second);
+	}
+}
+
+
+void CPUTopology::addNode(const CPUSet& cpus)
+{
+	int node = nodeCount();
+	_nodes.push_back(cpus);
+	for (CPUSet::const_iterator it = cpus.begin(); it != cpus.end(); ++it)
+	{
+		if (*it >= static_cast<int>(_cpuNode.size())) _cpuNode.resize(*it + 1, -1);
+		_cpuNode[*it] = node;
+	}
+}
+
+
+int CPUTopology::currentCPU()
+{
+#if POCO_OS == POCO_OS_LINUX && defined(__GLIBC__)
+	return sched_getcpu();
+#elif defined(POCO_OS_FAMILY_WINDOWS) && !defined(_WIN32_WCE)
+	return static_cast<int>(GetCurrentProcessorNumber());
+#else
+	return -1;
+#endif
+}
+
+
+void CPUTopology::bindCurrentThread(const CPUSet& cpus)
+{
+	CPUSet all;
+	if (cpus.empty())
+	{
+		int count = static_cast<int>(Environment::processorCount());
+		for (int i = 0; i < count; ++i) all.push_back(i);
+	}
+	const CPUSet& set = cpus.empty() ? all : cpus;
+
+#if POCO_OS == POCO_OS_LINUX && defined(CPU_SET)
+	cpu_set_t cpuset;
+	CPU_ZERO(&cpuset);
+	for (CPUSet::const_iterator it = set.begin(); it != set.end(); ++it)
+	{
+		if (*it < CPU_SETSIZE) CPU_SET(*it, &cpuset);
+	}
+	if (sched_setaffinity(0, sizeof(cpuset), &cpuset) != 0)
+		throw SystemException("cannot bind thread to processors");
+#elif defined(POCO_OS_FAMILY_WINDOWS) && !defined(_WIN32_WCE)
+	DWORD_PTR mask = 0;
+	for (CPUSet::const_iterator it = set.begin(); it != set.end(); ++it)
+	{
+		if (*it < static_cast<int>(8*sizeof(mask))) mask |= DWORD_PTR(1) << *it;
+	}
+	if (SetThreadAffinityMask(GetCurrentThread(), mask) == 0)
+		throw SystemException("cannot bind thread to processors");
+#else
+	(void) set;
+#endif
+}
+
+
+CPUTopology::CPUSet CPUTopology::parseCPUList(const std::string& list)
+{
+	CPUSet cpus;
+	std::string::const_iterator it = list.begin();
+	std::string::const_iterator end = list.end();
+	while (it != end && Ascii::isSpace(*it)) ++it;
+	while (it != end)
+	{
+		int first = parseCPU(it, end, list);
+		int last = first;
+		if (it != end && *it == '-')
+		{
+			++it;
+			last = parseCPU(it, end, list);
+			if (last < first) throw SyntaxException("invalid CPU list", list);
+		}
+		for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+		while (it != end && Ascii::isSpace(*it)) ++it;
+		if (it != end)
+		{
+			if (*it != ',') throw SyntaxException("invalid CPU list", list);
+			++it;
+		}
+	}
+	std::sort(cpus.begin(), cpus.end());
+	cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+	return cpus;
+}
+
+
+int CPUTopology::parseCPU(std::string::const_iterator& it, std::string::const_iterator end, const std::string& list)
+{
+	if (it == end || !Ascii::isDigit(*it)) throw SyntaxException("invalid CPU list", list);
+	int cpu = 0;
+	while (it != end && Ascii::isDigit(*it))
+	{
+		cpu = cpu*10 + (*it++ - '0');
+		if (cpu > MAX_CPU) throw SyntaxException("CPU number out of range", list);
+	}
+	return cpu;
+}
+
+
+} // namespace Poco
@@ -20,6 +20,86 @@
 #include "Poco/NumberFormatter.h"
 
 
+namespace
+{
+	using Poco::DateTime;
+	using Poco::DateTimeFormat;
+
+	inline char* format2(char* p, int value)
+	{
+		*p++ = static_cast<char>('0' + value/10);
+		*p++ = static_cast<char>('0' + value%10);
+		return p;
+	}
+
+	inline char* format3(char* p, int value)
+	{
+		*p++ = static_cast<char>('0' + value/100);
+		return format2(p, value%100);
+	}
+
+	inline char* format4(char* p, int value)
+	{
+		p = format2(p, value/100);
+		return format2(p, value%100);
+	}
+
+	inline char* formatName(char* p, const std::string& name)
+	{
+		*p++ = name[0];
+		*p++ = name[1];
+		*p++ = name[2];
+		return p;
+	}
+
+	char* formatHTTP(char* p, const DateTime& dateTime)
+		/// Writes the date and time in HTTP_FORMAT,
+		/// without the time zone.
+	{
+		p = formatName(p, DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()]);
+		*p++ = ',';
+		*p++ = ' ';
+		p = format2(p, dateTime.day());
+		*p++ = ' ';
+		p = formatName(p, DateTimeFormat::MONTH_NAMES[dateTime.month() - 1]);
+		*p++ = ' ';
+		p = format4(p, dateTime.year());
+		*p++ = ' ';
+		p = format2(p, dateTime.hour());
+		*p++ = ':';
+		p = format2(p, dateTime.minute());
+		*p++ = ':';
+		p = format2(p, dateTime.second());
+		*p++ = ' ';
+		return p;
+	}
+
+	char* formatISO8601(char* p, const DateTime& dateTime, bool fraction)
+		/// Writes the date and time in ISO8601_FORMAT or
+		/// ISO8601_FRAC_FORMAT, without the time zone.
+	{
+		p = format4(p, dateTime.year());
+		*p++ = '-';
+		p = format2(p, dateTime.month());
+		*p++ = '-';
+		p = format2(p, dateTime.day());
+		*p++ = 'T';
+		p = format2(p, dateTime.hour());
+		*p++ = ':';
+		p = format2(p, dateTime.minute());
+		*p++ = ':';
+		p = format2(p, dateTime.second());
+		if (fraction)
+		{
+			*p++ = '.';
+			p = format3(p, dateTime.millisecond());
+			p = format3(p, dateTime.microsecond());
+		}
+		return p;
+	}
+}
+
+
 namespace Poco {
 
 
@@ -31,6 +111,25 @@ void DateTimeFormatter::append(std::string& str, const LocalDateTime& dateTime,
 
 void DateTimeFormatter::append(std::string& str, const DateTime& dateTime, const std::string& fmt, int timeZoneDifferential)
 {
+	// The most common formats have their own code, which avoids
+	// interpreting the format string.
+	if (dateTime.year() >= 0 && dateTime.year() <= 9999)
+	{
+		char buffer[32];
+		if (fmt == DateTimeFormat::HTTP_FORMAT)
+		{
+			str.append(buffer, formatHTTP(buffer, dateTime) - buffer);
+			tzdRFC(str, timeZoneDifferential);
+			return;
+		}
+		else if (fmt == DateTimeFormat::ISO8601_FORMAT || fmt == DateTimeFormat::ISO8601_FRAC_FORMAT)
+		{
+			str.append(buffer, formatISO8601(buffer, dateTime, fmt == DateTimeFormat::ISO8601_FRAC_FORMAT) - buffer);
+			tzdISO(str, timeZoneDifferential);
+			return;
+		}
+	}
+
 	std::string::const_iterator it  = fmt.begin();
 	std::string::const_iterator end = fmt.end();
 	while (it != end)
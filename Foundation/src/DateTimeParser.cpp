@@ -19,6 +19,108 @@
 #include "Poco/DateTime.h"
 #include "Poco/Exception.h"
 #include "Poco/Ascii.h"
+#include <cstring>
+
+
+namespace
+{
+	using Poco::Ascii;
+	using Poco::DateTime;
+	using Poco::DateTimeFormat;
+
+	bool parseDigits(const char* p, int n, int& value)
+	{
+		value = 0;
+		for (int i = 0; i < n; ++i)
+		{
+			if (!Ascii::isDigit(p[i])) return false;
+			value = value*10 + (p[i] - '0');
+		}
+		return true;
+	}
+
+	bool assign(DateTime& dateTime, int year, int month, int day, int hour, int minute, int second, int millis = 0, int micros = 0)
+	{
+		if (!DateTime::isValid(year, month, day, hour, minute, second, millis, micros)) return false;
+		dateTime.assign(year, month, day, hour, minute, second, millis, micros);
+		return true;
+	}
+
+	bool parseHTTP(const std::string& str, DateTime& dateTime, int& timeZoneDifferential)
+		/// Parses a date in HTTP_FORMAT, such as "Sun, 06 Nov 1994 08:49:37 GMT",
+		/// exactly as specified in RFC 7231. Returns false for anything else,
+		/// which is then left to the generic parser.
+	{
+		if (str.size() != 29) return false;
+		const char* p = str.data();
+		if (!Ascii::isAlpha(p[0]) || !Ascii::isAlpha(p[1]) || !Ascii::isAlpha(p[2])
+		 || p[3] != ',' || p[4] != ' ' || p[7] != ' ' || p[11] != ' ' || p[16] != ' '
+		 || p[19] != ':' || p[22] != ':' || p[25] != ' ' || std::memcmp(p + 26, "GMT", 3) != 0)
+			return false;
+
+		int month = 0;
+		while (month < 12 && DateTimeFormat::MONTH_NAMES[month].compare(0, 3, p + 8, 3) != 0) ++month;
+		if (month == 12) return false;
+
+		int day, year, hour, minute, second;
+		if (!parseDigits(p + 5, 2, day) || !parseDigits(p + 12, 4, year) || !parseDigits(p + 17, 2, hour)
+		 || !parseDigits(p + 20, 2, minute) || !parseDigits(p + 23, 2, second))
+			return false;
+		if (!assign(dateTime, year, month + 1, day, hour, minute, second)) return false;
+		timeZoneDifferential = 0;
+		return true;
+	}
+
+	bool parseISO8601(const std::string& str, bool fraction, DateTime& dateTime, int& timeZoneDifferential)
+		/// Parses a date in ISO8601_FORMAT, such as "2005-01-08T12:30:00Z",
+		/// or in ISO8601_FRAC_FORMAT if fraction is true, with an optional
+		/// fraction of seconds. The time zone is "Z", "+hh:mm", "-hh:mm" or
+		/// missing. Returns false for anything else, which is then left
+		/// to the generic parser.
+	{
+		if (str.size() < 19) return false;
+		const char* p = str.data();
+		const char* end = p + str.size();
+		if (p[4] != '-' || p[7] != '-' || p[10] != 'T' || p[13] != ':' || p[16] != ':') return false;
+
+		int year, month, day, hour, minute, second;
+		if (!parseDigits(p, 4, year) || !parseDigits(p + 5, 2, month) || !parseDigits(p + 8, 2, day)
+		 || !parseDigits(p + 11, 2, hour) || !parseDigits(p + 14, 2, minute) || !parseDigits(p + 17, 2, second))
+			return false;
+
+		const char* it = p + 19;
+		int micros = 0;
+		if (fraction && it != end && (*it == '.' || *it == ','))
+		{
+			// Like "%s", use six digits and ignore the rest.
+			const char* digits = ++it;
+			int n = 0;
+			for (; it != end && Ascii::isDigit(*it); ++it)
+			{
+				if (n < 6)
+				{
+					micros = micros*10 + (*it - '0');
+					++n;
+				}
+			}
+			if (it == digits) return false;
+			for (; n < 6; ++n) micros *= 10;
+		}
+
+		int tzd = 0;
+		if (it != end && !(*it == 'Z' && end - it == 1))
+		{
+			int tzdHours, tzdMinutes;
+			if (end - it != 6 || (*it != '+' && *it != '-') || it[3] != ':'
+			 || !parseDigits(it + 1, 2, tzdHours) || !parseDigits(it + 4, 2, tzdMinutes))
+				return false;
+			tzd = (*it == '+' ? 1 : -1)*(tzdHours*3600 + tzdMinutes*60);
+		}
+		if (!assign(dateTime, year, month, day, hour, minute, second, micros/1000, micros%1000)) return false;
+		timeZoneDifferential = tzd;
+		return true;
+	}
+}
 
 
 namespace Poco {
@@ -49,6 +151,18 @@ void DateTimeParser::parse(const std::string& fmt, const std::string& str, DateT
 	if (fmt.empty() || str.empty())
 		throw SyntaxException("Empty string.");
 
+	// Strings in the most common formats are parsed by specialised
+	// code, which falls back to the generic parser if they do not
+	// strictly follow the format.
+	if (fmt == DateTimeFormat::HTTP_FORMAT)
+	{
+		if (parseHTTP(str, dateTime, timeZoneDifferential)) return;
+	}
+	else if (fmt == DateTimeFormat::ISO8601_FORMAT || fmt == DateTimeFormat::ISO8601_FRAC_FORMAT)
+	{
+		if (parseISO8601(str, fmt == DateTimeFormat::ISO8601_FRAC_FORMAT, dateTime, timeZoneDifferential)) return;
+	}
+
 	int year   = 0;
 	int month  = 0;
 	int day    = 0;
@@ -223,7 +337,7 @@ bool DateTimeParser::tryParse(const std::string& str, DateTime& dateTime, int& t
 	if (str.length() < 4) return false;
 	
 	if (str[3] == ',')
-		return tryParse("%w, %e %b %r %H:%M:%S %Z", str, dateTime, timeZoneDifferential);
+		return parseHTTP(str, dateTime, timeZoneDifferential) || tryParse("%w, %e %b %r %H:%M:%S %Z", str, dateTime, timeZoneDifferential);
 	else if (str[3] == ' ')
 		return tryParse(DateTimeFormat::ASCTIME_FORMAT, str, dateTime, timeZoneDifferential);
 	else if (str.find(',') < 10)
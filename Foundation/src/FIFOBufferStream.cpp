@@ -27,7 +27,7 @@ namespace Poco {
 
 FIFOBufferStreamBuf::FIFOBufferStreamBuf():
 	BufferedBidirectionalStreamBuf(STREAM_BUFFER_SIZE + 4, std::ios::in | std::ios::out),
-	_pFIFOBuffer(new FIFOBuffer(STREAM_BUFFER_SIZE, true)),
+	_pFIFOBuffer(new FIFOBuffer(STREAM_BUFFER_SIZE, true, FIFOBuffer::MODE_RING)),
 	_fifoBuffer(*_pFIFOBuffer)
 {
 }
@@ -60,7 +60,7 @@ FIFOBufferStreamBuf::FIFOBufferStreamBuf(const char* pBuffer, std::size_t length
 
 FIFOBufferStreamBuf::FIFOBufferStreamBuf(std::size_t length):
 	BufferedBidirectionalStreamBuf(length + 4, std::ios::in | std::ios::out),
-	_pFIFOBuffer(new FIFOBuffer(length, true)),
+	_pFIFOBuffer(new FIFOBuffer(length, true, FIFOBuffer::MODE_RING)),
 	_fifoBuffer(*_pFIFOBuffer)
 {
 }
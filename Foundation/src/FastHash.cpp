@@ -0,0 +1,83 @@
+//
+// FastHash.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Hashing
+// Module:  FastHash
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/FastHash.h"
+#include "Poco/ByteOrder.h"
+#include <cstring>
+
+
+namespace Poco {
+
+
+std::size_t fastHash(const void* data, std::size_t length)
+{
+	// MurmurHash64A, by Austin Appleby (public domain).
+	const UInt64 m = 0xc6a4a7935bd1e995ULL;
+	const int r = 47;
+
+	UInt64 h = 0x8445d61a4e774912ULL ^ (length*m);
+
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	const unsigned char* end = p + (length & ~std::size_t(7));
+	while (p != end)
+	{
+		UInt64 k;
+		std::memcpy(&k, p, sizeof(k));
+		k = ByteOrder::toLittleEndian(k);
+		p += 8;
+
+		k *= m;
+		k ^= k >> r;
+		k *= m;
+
+		h ^= k;
+		h *= m;
+	}
+
+	switch (length & 7)
+	{
+	case 7:
+		h ^= UInt64(p[6]) << 48;
+		// fallthrough
+	case 6:
+		h ^= UInt64(p[5]) << 40;
+		// fallthrough
+	case 5:
+		h ^= UInt64(p[4]) << 32;
+		// fallthrough
+	case 4:
+		h ^= UInt64(p[3]) << 24;
+		// fallthrough
+	case 3:
+		h ^= UInt64(p[2]) << 16;
+		// fallthrough
+	case 2:
+		h ^= UInt64(p[1]) << 8;
+		// fallthrough
+	case 1:
+		h ^= UInt64(p[0]);
+		h *= m;
+	}
+
+	h ^= h >> r;
+	h *= m;
+	h ^= h >> r;
+
+	return static_cast<std::size_t>(h);
+}
+
+
+} // namespace Poco
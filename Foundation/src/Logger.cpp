@@ -21,6 +21,9 @@
 #include "Poco/NumberFormatter.h"
 #include "Poco/NumberParser.h"
 #include "Poco/String.h"
+#include "Poco/AllocationTracker.h"
+#include "Poco/SingletonHolder.h"
+#include <algorithm>
 
 
 namespace Poco {
@@ -31,7 +34,15 @@ Mutex Logger::_mapMtx;
 const std::string Logger::ROOT;
 
 
-Logger::Logger(const std::string& name, Channel* pChannel, int level): _name(name), _pChannel(pChannel), _level(level)
+namespace
+{
+	// Defined before AutoLoggerShutdown below, so that
+	// it outlives the loggers that refer to its strings.
+	static SingletonHolder<StringPool> namePool;
+}
+
+
+Logger::Logger(const std::string& name, Channel* pChannel, int level): _name(namePool.get()->intern(name)), _pChannel(pChannel), _level(level)
 {
 	if (pChannel) pChannel->duplicate();
 }
@@ -84,6 +95,7 @@ void Logger::log(const Message& msg)
 {
 	if (_level >= msg.getPriority() && _pChannel)
 	{
+		AllocationScope scope(AllocationTracker::COMPONENT_LOGGING);
 		_pChannel->log(msg);
 	}
 }
@@ -107,7 +119,7 @@ void Logger::dump(const std::string& msg, const void* buffer, std::size_t length
 	{
 		std::string text(msg);
 		formatDump(text, buffer, length);
-		_pChannel->log(Message(_name, text, prio));
+		_pChannel->log(Message(_name.str(), text, prio));
 	}
 }
 
@@ -121,8 +133,9 @@ void Logger::setLevel(const std::string& name, int level)
 		std::string::size_type len = name.length();
 		for (LoggerMap::iterator it = _pLoggerMap->begin(); it != _pLoggerMap->end(); ++it)
 		{
-			if (len == 0 || 
-				(it->first.compare(0, len, name) == 0 && (it->first.length() == len || it->first[len] == '.')))
+			const std::string& loggerName = it->first.str();
+			if (len == 0 ||
+				(loggerName.compare(0, len, name) == 0 && (loggerName.length() == len || loggerName[len] == '.')))
 			{
 				it->second->setLevel(level);
 			}
@@ -140,8 +153,9 @@ void Logger::setChannel(const std::string& name, Channel* pChannel)
 		std::string::size_type len = name.length();
 		for (LoggerMap::iterator it = _pLoggerMap->begin(); it != _pLoggerMap->end(); ++it)
 		{
+			const std::string& loggerName = it->first.str();
 			if (len == 0 ||
-				(it->first.compare(0, len, name) == 0 && (it->first.length() == len || it->first[len] == '.')))
+				(loggerName.compare(0, len, name) == 0 && (loggerName.length() == len || loggerName[len] == '.')))
 			{
 				it->second->setChannel(pChannel);
 			}
@@ -159,8 +173,9 @@ void Logger::setProperty(const std::string& loggerName, const std::string& prope
 		std::string::size_type len = loggerName.length();
 		for (LoggerMap::iterator it = _pLoggerMap->begin(); it != _pLoggerMap->end(); ++it)
 		{
+			const std::string& name = it->first.str();
 			if (len == 0 ||
-				(it->first.compare(0, len, loggerName) == 0 && (it->first.length() == len || it->first[len] == '.')))
+				(name.compare(0, len, loggerName) == 0 && (name.length() == len || name[len] == '.')))
 			{
 				it->second->setProperty(propertyName, value);
 			}
@@ -355,9 +370,11 @@ void Logger::shutdown()
 
 Logger* Logger::find(const std::string& name)
 {
-	if (_pLoggerMap)
+	// A name that is not in the pool cannot be in the map.
+	InternedString key;
+	if (_pLoggerMap && namePool.get()->find(name, key))
 	{
-		LoggerMap::iterator it = _pLoggerMap->find(name);
+		LoggerMap::iterator it = _pLoggerMap->find(key);
 		if (it != _pLoggerMap->end())
 			return it->second;
 	}
@@ -369,9 +386,10 @@ void Logger::destroy(const std::string& name)
 {
 	Mutex::ScopedLock lock(_mapMtx);
 
-	if (_pLoggerMap)
+	InternedString key;
+	if (_pLoggerMap && namePool.get()->find(name, key))
 	{
-		LoggerMap::iterator it = _pLoggerMap->find(name);
+		LoggerMap::iterator it = _pLoggerMap->find(key);
 		if (it != _pLoggerMap->end())
 		{
 			it->second->release();
@@ -390,8 +408,10 @@ void Logger::names(std::vector<std::string>& names)
 	{
 		for (LoggerMap::const_iterator it = _pLoggerMap->begin(); it != _pLoggerMap->end(); ++it)
 		{
-			names.push_back(it->first);
+			names.push_back(it->first.str());
 		}
+		// The map is ordered by identity, not by name.
+		std::sort(names.begin(), names.end());
 	}
 }
 
@@ -478,7 +498,7 @@ void Logger::add(Logger* pLogger)
 {
 	if (!_pLoggerMap)
 		_pLoggerMap = new LoggerMap;
-	_pLoggerMap->insert(LoggerMap::value_type(pLogger->name(), pLogger));
+	_pLoggerMap->insert(LoggerMap::value_type(pLogger->_name, pLogger));
 }
 
 
@@ -16,6 +16,7 @@
 
 #include "Poco/MemoryPool.h"
 #include "Poco/Exception.h"
+#include "Poco/AllocationTracker.h"
 
 
 namespace Poco {
@@ -59,8 +60,10 @@ void* MemoryPool::get()
 	{
 		if (_maxAlloc == 0 || _allocated < _maxAlloc)
 		{
+			char* ptr = new char[_blockSize];
 			++_allocated;
-			return new char[_blockSize];
+			AllocationTracker::poolAllocated(_blockSize);
+			return ptr;
 		}
 		else throw OutOfMemoryException("MemoryPool exhausted");
 	}
@@ -68,6 +71,7 @@ void* MemoryPool::get()
 	{
 		char* ptr = _blocks.back();
 		_blocks.pop_back();
+		AllocationTracker::poolAllocated(_blockSize);
 		return ptr;
 	}
 }
@@ -75,6 +79,8 @@ void* MemoryPool::get()
 	
 void MemoryPool::release(void* ptr)
 {
+	AllocationTracker::poolDeallocated(_blockSize);
+
 	FastMutex::ScopedLock lock(_mutex);
 	
 	_blocks.push_back(reinterpret_cast<char*>(ptr));
@@ -0,0 +1,268 @@
+//
+// MutexProfile.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Threading
+// Module:  MutexProfile
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/MutexProfile.h"
+#include "Poco/SingletonHolder.h"
+#include <algorithm>
+
+
+namespace Poco {
+
+
+namespace
+{
+	bool moreFrequent(const MutexProfile::Site& s1, const MutexProfile::Site& s2)
+	{
+		return s1.count > s2.count;
+	}
+}
+
+
+//
+// MutexProfile
+//
+
+
+MutexProfile::MutexProfile(const std::string& name):
+	_name(name)
+{
+	reset();
+}
+
+
+MutexProfile::~MutexProfile()
+{
+}
+
+
+void MutexProfile::contended(Clock::ClockDiff waitTime, const char* holderSite)
+{
+	++_acquisitions;
+
+	int bucket = 0;
+	while (bucket < HISTOGRAM_BUCKETS - 1 && (Clock::ClockDiff(1) << bucket) <= waitTime) ++bucket;
+
+	FastMutex::ScopedLock lock(_mutex);
+	++_contentions;
+	_totalWaitTime += waitTime;
+	if (waitTime > _maxWaitTime) _maxWaitTime = waitTime;
+	++_histogram[bucket];
+
+	if (!holderSite)
+	{
+		++_otherSites;
+		return;
+	}
+	for (int i = 0; i < MAX_SITES; ++i)
+	{
+		if (_sites[i].site == holderSite)
+		{
+			++_sites[i].count;
+			return;
+		}
+		else if (!_sites[i].site)
+		{
+			_sites[i].site = holderSite;
+			_sites[i].count = 1;
+			return;
+		}
+	}
+	++_otherSites;
+}
+
+
+int MutexProfile::contentions() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+	return _contentions;
+}
+
+
+Clock::ClockDiff MutexProfile::totalWaitTime() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+	return _totalWaitTime;
+}
+
+
+Clock::ClockDiff MutexProfile::maxWaitTime() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+	return _maxWaitTime;
+}
+
+
+int MutexProfile::histogram(int bucket) const
+{
+	poco_assert (bucket >= 0 && bucket < HISTOGRAM_BUCKETS);
+
+	FastMutex::ScopedLock lock(_mutex);
+	return _histogram[bucket];
+}
+
+
+void MutexProfile::holderSites(std::vector<Site>& sites) const
+{
+	sites.clear();
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		for (int i = 0; i < MAX_SITES && _sites[i].site; ++i)
+		{
+			sites.push_back(_sites[i]);
+		}
+	}
+	std::stable_sort(sites.begin(), sites.end(), moreFrequent);
+}
+
+
+void MutexProfile::reset()
+{
+	FastMutex::ScopedLock lock(_mutex);
+	_acquisitions = 0;
+	_contentions = 0;
+	_totalWaitTime = 0;
+	_maxWaitTime = 0;
+	for (int i = 0; i < HISTOGRAM_BUCKETS; ++i)
+	{
+		_histogram[i] = 0;
+	}
+	for (int i = 0; i < MAX_SITES; ++i)
+	{
+		_sites[i].site = 0;
+		_sites[i].count = 0;
+	}
+	_otherSites = 0;
+}
+
+
+void MutexProfile::dump(std::ostream& ostr) const
+{
+	std::vector<Site> sites;
+	holderSites(sites);
+
+	FastMutex::ScopedLock lock(_mutex);
+	ostr << _name
+	     << ": acquisitions=" << _acquisitions.value()
+	     << " contended=" << _contentions
+	     << " totalWait=" << _totalWaitTime << "us"
+	     << " maxWait=" << _maxWaitTime << "us"
+	     << "\n";
+	if (_contentions == 0) return;
+
+	ostr << "  wait:";
+	for (int i = 0; i < HISTOGRAM_BUCKETS; ++i)
+	{
+		if (_histogram[i] == 0) continue;
+		if (i < HISTOGRAM_BUCKETS - 1)
+			ostr << " <" << (Clock::ClockDiff(1) << i) << "us:" << _histogram[i];
+		else
+			ostr << " >=" << (Clock::ClockDiff(1) << (i - 1)) << "us:" << _histogram[i];
+	}
+	ostr << "\n";
+	for (std::vector<Site>::const_iterator it = sites.begin(); it != sites.end(); ++it)
+	{
+		ostr << "  held at " << it->site << ": " << it->count << "\n";
+	}
+	if (_otherSites)
+	{
+		ostr << "  held at unknown sites: " << _otherSites << "\n";
+	}
+}
+
+
+//
+// MutexProfileRegistry
+//
+
+
+MutexProfileRegistry::MutexProfileRegistry()
+{
+}
+
+
+MutexProfileRegistry::~MutexProfileRegistry()
+{
+}
+
+
+MutexProfile::Ptr MutexProfileRegistry::profile(const std::string& name)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	ProfileMap::iterator it = _profiles.find(name);
+	if (it != _profiles.end()) return it->second;
+
+	MutexProfile::Ptr pProfile = new MutexProfile(name);
+	_profiles[name] = pProfile;
+	return pProfile;
+}
+
+
+bool MutexProfileRegistry::has(const std::string& name) const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _profiles.find(name) != _profiles.end();
+}
+
+
+void MutexProfileRegistry::names(std::vector<std::string>& names) const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	names.clear();
+	for (ProfileMap::const_iterator it = _profiles.begin(); it != _profiles.end(); ++it)
+	{
+		names.push_back(it->first);
+	}
+}
+
+
+void MutexProfileRegistry::dump(std::ostream& ostr) const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	for (ProfileMap::const_iterator it = _profiles.begin(); it != _profiles.end(); ++it)
+	{
+		it->second->dump(ostr);
+	}
+}
+
+
+void MutexProfileRegistry::reset()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	for (ProfileMap::iterator it = _profiles.begin(); it != _profiles.end(); ++it)
+	{
+		it->second->reset();
+	}
+}
+
+
+namespace
+{
+	static SingletonHolder<MutexProfileRegistry> sh;
+}
+
+
+MutexProfileRegistry& MutexProfileRegistry::defaultRegistry()
+{
+	return *sh.get();
+}
+
+
+} // namespace Poco
@@ -16,11 +16,13 @@
 
 #include "Poco/NumberFormatter.h"
 #include "Poco/MemoryStream.h"
+#include "Poco/Exception.h"
 #include <iomanip>
 #if !defined(POCO_NO_LOCALE)
 #include <locale>
 #endif
 #include <cstdio>
+#include <cstring>
 
 
 #if defined(_MSC_VER) || defined(__MINGW32__)
@@ -32,6 +34,76 @@
 #endif
 
 
+namespace
+{
+	const char DIGIT_PAIRS[] =
+		"00010203040506070809"
+		"10111213141516171819"
+		"20212223242526272829"
+		"30313233343536373839"
+		"40414243444546474849"
+		"50515253545556575859"
+		"60616263646566676869"
+		"70717273747576777879"
+		"80818283848586878889"
+		"90919293949596979899";
+
+	template <typename T>
+	char* formatDigits(T value, char* end)
+		/// Writes the decimal digits of value backwards,
+		/// two at a time, ending at end. Returns the
+		/// position of the first digit.
+	{
+		while (value >= 100)
+		{
+			unsigned i = static_cast<unsigned>(value % 100)*2;
+			value /= 100;
+			*--end = DIGIT_PAIRS[i + 1];
+			*--end = DIGIT_PAIRS[i];
+		}
+		if (value >= 10)
+		{
+			unsigned i = static_cast<unsigned>(value)*2;
+			*--end = DIGIT_PAIRS[i + 1];
+			*--end = DIGIT_PAIRS[i];
+		}
+		else *--end = static_cast<char>('0' + value);
+		return end;
+	}
+
+	std::size_t copyResult(char* buffer, std::size_t length, const char* begin, const char* end)
+	{
+		std::size_t n = end - begin;
+		if (n > length) throw Poco::RangeException("Buffer too small for formatted number");
+		std::memcpy(buffer, begin, n);
+		return n;
+	}
+
+	template <typename T>
+	std::size_t formatUnsigned(char* buffer, std::size_t length, T value)
+	{
+		char digits[Poco::NumberFormatter::NF_MAX_INT_STRING_LEN];
+		char* end = digits + sizeof(digits);
+		return copyResult(buffer, length, formatDigits(value, end), end);
+	}
+
+	template <typename U, typename T>
+	std::size_t formatSigned(char* buffer, std::size_t length, T value)
+	{
+		char digits[Poco::NumberFormatter::NF_MAX_INT_STRING_LEN];
+		char* end = digits + sizeof(digits);
+		char* begin;
+		if (value < 0)
+		{
+			begin = formatDigits(static_cast<U>(0 - static_cast<U>(value)), end);
+			*--begin = '-';
+		}
+		else begin = formatDigits(static_cast<U>(value), end);
+		return copyResult(buffer, length, begin, end);
+	}
+}
+
+
 namespace Poco {
 
 
@@ -59,9 +131,7 @@ std::string NumberFormatter::format(bool value, BoolFormat format)
 void NumberFormatter::append(std::string& str, int value)
 {
 	char result[NF_MAX_INT_STRING_LEN];
-	std::size_t sz = NF_MAX_INT_STRING_LEN;
-	intToStr(value, 10, result, sz);
-	str.append(result, sz);
+	str.append(result, formatTo(result, sizeof(result), value));
 }
 
 
@@ -104,9 +174,7 @@ void NumberFormatter::appendHex(std::string& str, int value, int width)
 void NumberFormatter::append(std::string& str, unsigned value)
 {
 	char result[NF_MAX_INT_STRING_LEN];
-	std::size_t sz = NF_MAX_INT_STRING_LEN;
-	uIntToStr(value, 10, result, sz);
-	str.append(result, sz);
+	str.append(result, formatTo(result, sizeof(result), value));
 }
 
 
@@ -149,9 +217,7 @@ void NumberFormatter::appendHex(std::string& str, unsigned value, int width)
 void NumberFormatter::append(std::string& str, long value)
 {
 	char result[NF_MAX_INT_STRING_LEN];
-	std::size_t sz = NF_MAX_INT_STRING_LEN;
-	intToStr(value, 10, result, sz);
-	str.append(result, sz);
+	str.append(result, formatTo(result, sizeof(result), value));
 }
 
 
@@ -194,9 +260,7 @@ void NumberFormatter::appendHex(std::string& str, long value, int width)
 void NumberFormatter::append(std::string& str, unsigned long value)
 {
 	char result[NF_MAX_INT_STRING_LEN];
-	std::size_t sz = NF_MAX_INT_STRING_LEN;
-	uIntToStr(value, 10, result, sz);
-	str.append(result, sz);
+	str.append(result, formatTo(result, sizeof(result), value));
 }
 
 
@@ -242,9 +306,7 @@ void NumberFormatter::appendHex(std::string& str, unsigned long value, int width
 void NumberFormatter::append(std::string& str, Int64 value)
 {
 	char result[NF_MAX_INT_STRING_LEN];
-	std::size_t sz = NF_MAX_INT_STRING_LEN;
-	intToStr(value, 10, result, sz);
-	str.append(result, sz);
+	str.append(result, formatTo(result, sizeof(result), value));
 }
 
 
@@ -287,9 +349,7 @@ void NumberFormatter::appendHex(std::string& str, Int64 value, int width)
 void NumberFormatter::append(std::string& str, UInt64 value)
 {
 	char result[NF_MAX_INT_STRING_LEN];
-	std::size_t sz = NF_MAX_INT_STRING_LEN;
-	uIntToStr(value, 10, result, sz);
-	str.append(result, sz);
+	str.append(result, formatTo(result, sizeof(result), value));
 }
 
 
@@ -362,6 +422,64 @@ void NumberFormatter::append(std::string& str, double value, int width, int prec
 }
 
 
+std::size_t NumberFormatter::formatTo(char* buffer, std::size_t length, int value)
+{
+	return formatSigned<unsigned>(buffer, length, value);
+}
+
+
+std::size_t NumberFormatter::formatTo(char* buffer, std::size_t length, unsigned value)
+{
+	return formatUnsigned(buffer, length, value);
+}
+
+
+std::size_t NumberFormatter::formatTo(char* buffer, std::size_t length, long value)
+{
+	return formatSigned<unsigned long>(buffer, length, value);
+}
+
+
+std::size_t NumberFormatter::formatTo(char* buffer, std::size_t length, unsigned long value)
+{
+	return formatUnsigned(buffer, length, value);
+}
+
+
+#if defined(POCO_HAVE_INT64) && !defined(POCO_LONG_IS_64_BIT)
+
+
+std::size_t NumberFormatter::formatTo(char* buffer, std::size_t length, Int64 value)
+{
+	return formatSigned<UInt64>(buffer, length, value);
+}
+
+
+std::size_t NumberFormatter::formatTo(char* buffer, std::size_t length, UInt64 value)
+{
+	return formatUnsigned(buffer, length, value);
+}
+
+
+#endif // defined(POCO_HAVE_INT64) && !defined(POCO_LONG_IS_64_BIT)
+
+
+std::size_t NumberFormatter::formatTo(char* buffer, std::size_t length, float value)
+{
+	char result[NF_MAX_SHORTEST_STRING_LEN];
+	floatToStr(result, sizeof(result), value);
+	return copyResult(buffer, length, result, result + std::strlen(result));
+}
+
+
+std::size_t NumberFormatter::formatTo(char* buffer, std::size_t length, double value)
+{
+	char result[NF_MAX_SHORTEST_STRING_LEN];
+	doubleToStr(result, sizeof(result), value);
+	return copyResult(buffer, length, result, result + std::strlen(result));
+}
+
+
 void NumberFormatter::append(std::string& str, const void* ptr)
 {
 	char buffer[24];
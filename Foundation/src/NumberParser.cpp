@@ -21,6 +21,7 @@
 #include <cstdio>
 #include <cctype>
 #include <stdlib.h>
+#include <limits>
 #if !defined(POCO_NO_LOCALE)
 	#include <locale>
 #endif
@@ -40,6 +41,70 @@
 namespace Poco {
 
 
+namespace
+{
+	bool parseDecimal(const char* p, const char* end, UInt64 limit, UInt64& value)
+		/// Parses the decimal digits in [p, end), which must
+		/// not be empty, into a value not greater than limit.
+	{
+		if (p == end) return false;
+		while (p != end && *p == '0') ++p;
+
+		// Up to 19 digits cannot overflow, the 20th may.
+		if (end - p > 20) return false;
+		const char* last = end - p == 20 ? end - 1 : end;
+		UInt64 result = 0;
+		for (; last - p >= 8; p += 8)
+		{
+			UInt64 chunk = Impl::loadEight(p);
+			if (!Impl::isEightDigits(chunk)) return false;
+			result = 100000000*result + Impl::parseEightDigits(chunk);
+		}
+		for (; p != last; ++p)
+		{
+			if (!Impl::isDigit(*p)) return false;
+			result = 10*result + (*p - '0');
+		}
+		if (last != end)
+		{
+			if (!Impl::isDigit(*last)) return false;
+			unsigned digit = *last - '0';
+			if (result > (limit - digit)/10) return false;
+			result = 10*result + digit;
+		}
+		else if (result > limit) return false;
+		value = result;
+		return true;
+	}
+
+	template <typename I>
+	bool parseSignedRange(const char* begin, const char* end, I& value)
+	{
+		bool negative = false;
+		if (begin != end && (*begin == '-' || *begin == '+'))
+		{
+			negative = (*begin == '-');
+			++begin;
+		}
+		UInt64 limit = static_cast<UInt64>(std::numeric_limits<I>::max()) + (negative ? 1 : 0);
+		UInt64 result;
+		if (!parseDecimal(begin, end, limit, result)) return false;
+		value = (negative && result > 0) ? -static_cast<I>(result - 1) - 1 : static_cast<I>(result);
+		return true;
+	}
+
+	template <typename I>
+	bool parseUnsignedRange(const char* begin, const char* end, I& value)
+	{
+		if (begin != end && *begin == '+') ++begin;
+		UInt64 result;
+		if (!parseDecimal(begin, end, std::numeric_limits<I>::max(), result)) return false;
+		value = static_cast<I>(result);
+		return true;
+	}
+}
+
+
 int NumberParser::parse(const std::string& s, char thSep)
 {
 	int result;
@@ -52,7 +117,13 @@ int NumberParser::parse(const std::string& s, char thSep)
 
 bool NumberParser::tryParse(const std::string& s, int& value, char thSep)
 {
-	return strToInt(s.c_str(), value, NUM_BASE_DEC, thSep);
+	return tryParse(s.data(), s.data() + s.size(), value) || strToInt(s.c_str(), value, NUM_BASE_DEC, thSep);
+}
+
+
+bool NumberParser::tryParse(const char* begin, const char* end, int& value)
+{
+	return parseSignedRange(begin, end, value);
 }
 
 
@@ -68,7 +139,13 @@ unsigned NumberParser::parseUnsigned(const std::string& s, char thSep)
 
 bool NumberParser::tryParseUnsigned(const std::string& s, unsigned& value, char thSep)
 {
-	return strToInt(s.c_str(), value, NUM_BASE_DEC, thSep);
+	return tryParseUnsigned(s.data(), s.data() + s.size(), value) || strToInt(s.c_str(), value, NUM_BASE_DEC, thSep);
+}
+
+
+bool NumberParser::tryParseUnsigned(const char* begin, const char* end, unsigned& value)
+{
+	return parseUnsignedRange(begin, end, value);
 }
 
 
@@ -121,7 +198,13 @@ Int64 NumberParser::parse64(const std::string& s, char thSep)
 
 bool NumberParser::tryParse64(const std::string& s, Int64& value, char thSep)
 {
-	return strToInt(s.c_str(), value, NUM_BASE_DEC, thSep);
+	return tryParse64(s.data(), s.data() + s.size(), value) || strToInt(s.c_str(), value, NUM_BASE_DEC, thSep);
+}
+
+
+bool NumberParser::tryParse64(const char* begin, const char* end, Int64& value)
+{
+	return parseSignedRange(begin, end, value);
 }
 
 
@@ -137,7 +220,13 @@ UInt64 NumberParser::parseUnsigned64(const std::string& s, char thSep)
 
 bool NumberParser::tryParseUnsigned64(const std::string& s, UInt64& value, char thSep)
 {
-	return strToInt(s.c_str(), value, NUM_BASE_DEC, thSep);
+	return tryParseUnsigned64(s.data(), s.data() + s.size(), value) || strToInt(s.c_str(), value, NUM_BASE_DEC, thSep);
+}
+
+
+bool NumberParser::tryParseUnsigned64(const char* begin, const char* end, UInt64& value)
+{
+	return parseUnsignedRange(begin, end, value);
 }
 
 
@@ -190,7 +279,14 @@ double NumberParser::parseFloat(const std::string& s, char decSep, char thSep)
 
 bool NumberParser::tryParseFloat(const std::string& s, double& value, char decSep, char thSep)
 {
-	return strToDouble(s.c_str(), value, decSep, thSep);
+	if (decSep == '.' && tryParseFloat(s.data(), s.data() + s.size(), value)) return true;
+	return strToDouble(s, value, decSep, thSep);
+}
+
+
+bool NumberParser::tryParseFloat(const char* begin, const char* end, double& value)
+{
+	return strToDouble(begin, end, value);
 }
 
 
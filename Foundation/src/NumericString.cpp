@@ -246,4 +246,116 @@ bool strToDouble(const std::string& str, double& result, char decSep, char thSep
 }
 
 
+bool strToDouble(const char* begin, const char* end, double& result)
+{
+	using namespace double_conversion;
+
+	const char* p = begin;
+	bool negative = false;
+	if (p != end && (*p == '-' || *p == '+'))
+	{
+		negative = (*p == '-');
+		++p;
+	}
+
+	const char* intBegin = p;
+	const char* intEnd = p = Impl::skipDigits(p, end);
+	const char* fracBegin = p;
+	const char* fracEnd = p;
+	if (p != end && *p == '.')
+	{
+		fracBegin = ++p;
+		fracEnd = p = Impl::skipDigits(p, end);
+	}
+	if (intBegin == intEnd && fracBegin == fracEnd) return false;
+
+	int exponent = 0;
+	if (p != end && (*p == 'e' || *p == 'E'))
+	{
+		++p;
+		bool negativeExponent = false;
+		if (p != end && (*p == '-' || *p == '+'))
+		{
+			negativeExponent = (*p == '-');
+			++p;
+		}
+		if (p == end || !Impl::isDigit(*p)) return false;
+		for (; p != end && Impl::isDigit(*p); ++p)
+		{
+			// Anything beyond is infinity or zero anyway.
+			if (exponent < 100000) exponent = 10*exponent + (*p - '0');
+		}
+		if (negativeExponent) exponent = -exponent;
+	}
+	if (p != end) return false;
+
+	// Collect the significant digits, such that the number is
+	// digits*10^exponent, without leading and trailing zeros
+	// and cut like Strtod() does.
+	char digits[kMaxSignificantDecimalDigits];
+	int length = 0;
+	int count = 0;
+	int significant = 0;
+	exponent -= static_cast<int>(fracEnd - fracBegin);
+	for (int part = 0; part < 2; ++part)
+	{
+		const char* it = part == 0 ? intBegin : fracBegin;
+		const char* itEnd = part == 0 ? intEnd : fracEnd;
+		if (count == 0)
+		{
+			while (it != itEnd && *it == '0') ++it;
+		}
+		for (; it != itEnd; ++it)
+		{
+			if (length < kMaxSignificantDecimalDigits) digits[length++] = *it;
+			++count;
+			if (*it != '0') significant = count;
+		}
+	}
+	if (significant == 0)
+	{
+		result = negative ? -0.0 : 0.0;
+		return true;
+	}
+	exponent += count - significant;
+	if (significant > kMaxSignificantDecimalDigits)
+	{
+		digits[kMaxSignificantDecimalDigits - 1] = '1';
+		exponent += significant - kMaxSignificantDecimalDigits;
+		length = kMaxSignificantDecimalDigits;
+	}
+	else length = significant;
+
+	double value;
+#if defined(DOUBLE_CONVERSION_CORRECT_DOUBLE_OPERATIONS)
+	if (length <= 19 && exponent > -kExactPowersOfTenSize && exponent < kExactPowersOfTenSize)
+	{
+		UInt64 mantissa = 0;
+		int i = 0;
+		for (; length - i >= 8; i += 8)
+			mantissa = 100000000*mantissa + Impl::parseEightDigits(Impl::loadEight(digits + i));
+		for (; i < length; ++i)
+			mantissa = 10*mantissa + (digits[i] - '0');
+
+		if (mantissa <= (UInt64(1) << 53))
+		{
+			// Both the mantissa and the power of ten are exact,
+			// so IEEE arithmetic rounds the result correctly.
+			value = static_cast<double>(mantissa);
+			if (exponent < 0)
+				value /= exact_powers_of_ten[-exponent];
+			else
+				value *= exact_powers_of_ten[exponent];
+			result = negative ? -value : value;
+			return true;
+		}
+	}
+#endif
+	value = Strtod(Vector<const char>(digits, length), exponent);
+	if (FPEnvironment::isInfinite(value)) return false;
+	result = negative ? -value : value;
+	return true;
+}
+
+
 } // namespace Poco
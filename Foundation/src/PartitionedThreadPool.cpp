@@ -0,0 +1,189 @@
+//
+// PartitionedThreadPool.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Threading
+// Module:  PartitionedThreadPool
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/PartitionedThreadPool.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+
+
+PartitionedThreadPool::PartitionedThreadPool(int minCapacity, int maxCapacity, int idleTime, int stackSize)
+{
+	CPUTopology topology;
+	std::vector<CPUSet> cpuSets;
+	for (int i = 0; i < topology.nodeCount(); ++i)
+	{
+		cpuSets.push_back(topology.nodeCPUs(i));
+	}
+	create(cpuSets, minCapacity, maxCapacity, idleTime, stackSize);
+}
+
+
+PartitionedThreadPool::PartitionedThreadPool(const std::vector<CPUSet>& cpuSets, int minCapacity, int maxCapacity, int idleTime, int stackSize)
+{
+	poco_assert (!cpuSets.empty());
+
+	create(cpuSets, minCapacity, maxCapacity, idleTime, stackSize);
+}
+
+
+PartitionedThreadPool::~PartitionedThreadPool()
+{
+	try
+	{
+		stopAll();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+	for (PoolVec::iterator it = _pools.begin(); it != _pools.end(); ++it)
+	{
+		delete *it;
+	}
+}
+
+
+void PartitionedThreadPool::create(const std::vector<CPUSet>& cpuSets, int minCapacity, int maxCapacity, int idleTime, int stackSize)
+{
+	_cpuSets = cpuSets;
+	for (int i = 0; i < static_cast<int>(cpuSets.size()); ++i)
+	{
+		ThreadPool* pPool = new ThreadPool("Partition" + NumberFormatter::format(i), minCapacity, maxCapacity, idleTime, stackSize);
+		_pools.push_back(pPool);
+		pPool->setCPUSet(cpuSets[i]);
+		for (CPUSet::const_iterator it = cpuSets[i].begin(); it != cpuSets[i].end(); ++it)
+		{
+			if (*it >= static_cast<int>(_cpuPartition.size())) _cpuPartition.resize(*it + 1, -1);
+			if (_cpuPartition[*it] < 0) _cpuPartition[*it] = i;
+		}
+	}
+}
+
+
+int PartitionedThreadPool::partitionOf(int cpu) const
+{
+	if (cpu >= 0 && cpu < static_cast<int>(_cpuPartition.size()))
+		return _cpuPartition[cpu];
+	else
+		return -1;
+}
+
+
+int PartitionedThreadPool::localPartition() const
+{
+	int partition = partitionOf(CPUTopology::currentCPU());
+	if (partition < 0)
+	{
+		unsigned next = static_cast<unsigned>(_next++);
+		partition = static_cast<int>(next % _pools.size());
+	}
+	return partition;
+}
+
+
+void PartitionedThreadPool::start(Runnable& target)
+{
+	start(target, localPartition());
+}
+
+
+void PartitionedThreadPool::start(Runnable& target, int partition)
+{
+	poco_assert (partition >= 0 && partition < partitions());
+
+	int n = partitions();
+	for (int i = 0; i < n; ++i)
+	{
+		ThreadPool& pool = *_pools[(partition + i) % n];
+		try
+		{
+			pool.start(target);
+			return;
+		}
+		catch (NoThreadAvailableException&)
+		{
+			if (i == n - 1) throw;
+		}
+	}
+}
+
+
+int PartitionedThreadPool::capacity() const
+{
+	int result = 0;
+	for (PoolVec::const_iterator it = _pools.begin(); it != _pools.end(); ++it)
+	{
+		result += (*it)->capacity();
+	}
+	return result;
+}
+
+
+int PartitionedThreadPool::used() const
+{
+	int result = 0;
+	for (PoolVec::const_iterator it = _pools.begin(); it != _pools.end(); ++it)
+	{
+		result += (*it)->used();
+	}
+	return result;
+}
+
+
+int PartitionedThreadPool::allocated() const
+{
+	int result = 0;
+	for (PoolVec::const_iterator it = _pools.begin(); it != _pools.end(); ++it)
+	{
+		result += (*it)->allocated();
+	}
+	return result;
+}
+
+
+int PartitionedThreadPool::available() const
+{
+	int result = 0;
+	for (PoolVec::const_iterator it = _pools.begin(); it != _pools.end(); ++it)
+	{
+		result += (*it)->available();
+	}
+	return result;
+}
+
+
+void PartitionedThreadPool::joinAll()
+{
+	for (PoolVec::iterator it = _pools.begin(); it != _pools.end(); ++it)
+	{
+		(*it)->joinAll();
+	}
+}
+
+
+void PartitionedThreadPool::stopAll()
+{
+	for (PoolVec::iterator it = _pools.begin(); it != _pools.end(); ++it)
+	{
+		(*it)->stopAll();
+	}
+}
+
+
+} // namespace Poco
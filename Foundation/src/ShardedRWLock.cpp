@@ -0,0 +1,123 @@
+//
+// ShardedRWLock.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Threading
+// Module:  ShardedRWLock
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/ShardedRWLock.h"
+#include "Poco/Environment.h"
+#include "Poco/Thread.h"
+#if defined(POCO_OS_FAMILY_WINDOWS)
+#include "Poco/UnWindows.h"
+#else
+#include <pthread.h>
+#endif
+
+
+namespace Poco {
+
+
+ShardedRWLock::ShardedRWLock(int slots):
+	_mask(0),
+	_slots(0),
+	_writeLocked(false)
+{
+	poco_assert (slots >= 0 && slots <= 0x10000);
+
+	if (slots == 0) slots = 2*static_cast<int>(Environment::processorCount());
+	int n = 1;
+	while (n < slots) n <<= 1;
+	_mask = n - 1;
+	_slots = new Slot[n];
+}
+
+
+ShardedRWLock::~ShardedRWLock()
+{
+	delete [] _slots;
+}
+
+
+void ShardedRWLock::writeLock()
+{
+	_writeMutex.lock();
+	++_writer;
+	waitForReaders();
+	_writeLocked = true;
+}
+
+
+bool ShardedRWLock::tryWriteLock()
+{
+	if (!_writeMutex.tryLock()) return false;
+
+	++_writer;
+	for (int i = 0; i <= _mask; ++i)
+	{
+		if (_slots[i].readers.value() != 0)
+		{
+			--_writer;
+			_writeMutex.unlock();
+			return false;
+		}
+	}
+	_writeLocked = true;
+	return true;
+}
+
+
+void ShardedRWLock::writeUnlock()
+{
+	_writeLocked = false;
+	--_writer;
+	_writeMutex.unlock();
+}
+
+
+ShardedRWLock::Slot& ShardedRWLock::slot()
+{
+	// Thread::currentTid() is a system call on Linux, so use
+	// the cheapest thread identity the platform offers. Hash it
+	// byte by byte (FNV-1a), since pthread_t is an opaque type
+	// on some platforms and often an aligned address whose low
+	// bits are all zero.
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	DWORD id = GetCurrentThreadId();
+#else
+	pthread_t id = pthread_self();
+#endif
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(&id);
+	UInt32 h = 2166136261U;
+	for (std::size_t i = 0; i < sizeof(id); ++i)
+	{
+		h = (h ^ p[i])*16777619U;
+	}
+	return _slots[(h ^ (h >> 16)) & _mask];
+}
+
+
+void ShardedRWLock::waitForReaders()
+{
+	// New readers back off as soon as they see the writer flag,
+	// so we only have to wait for the ones already inside.
+	for (int i = 0; i <= _mask; ++i)
+	{
+		while (_slots[i].readers.value() != 0)
+		{
+			Thread::yield();
+		}
+	}
+}
+
+
+} // namespace Poco
@@ -0,0 +1,112 @@
+//
+// SpinMutex.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Threading
+// Module:  SpinMutex
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/SpinMutex.h"
+#include "Poco/Environment.h"
+#include "Poco/Clock.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+
+
+namespace
+{
+	const bool multiProcessor = Environment::processorCount() > 1;
+}
+
+
+const int SpinMutex::MAX_SPINS = 1000;
+
+
+SpinMutex::SpinMutex():
+	_state(UNLOCKED),
+	_spinLimit(100),
+	_wakeup(Event::EVENT_AUTORESET)
+{
+}
+
+
+SpinMutex::~SpinMutex()
+{
+}
+
+
+void SpinMutex::lock(long milliseconds)
+{
+	if (!tryLock(milliseconds))
+		throw TimeoutException();
+}
+
+
+bool SpinMutex::tryLock(long milliseconds)
+{
+	if (_state.compareAndSet(UNLOCKED, LOCKED) || spin()) return true;
+	return park(milliseconds);
+}
+
+
+bool SpinMutex::spin()
+{
+	if (!multiProcessor) return false;
+
+	// Like glibc's adaptive mutexes, spin for up to twice the
+	// average number of spins that were needed in the past.
+	// _spinLimit is only a hint, so racy updates do no harm.
+	int limit = _spinLimit;
+	int maxSpins = 2*limit + 10 < MAX_SPINS ? 2*limit + 10 : MAX_SPINS;
+	for (int spins = 1; spins <= maxSpins; ++spins)
+	{
+		pause();
+		if (_state.value() == UNLOCKED && _state.compareAndSet(UNLOCKED, LOCKED))
+		{
+			_spinLimit = limit + (spins - limit)/8;
+			return true;
+		}
+	}
+	_spinLimit = limit + (maxSpins - limit)/8;
+	return false;
+}
+
+
+void SpinMutex::park()
+{
+	// Marking the SpinMutex as contended makes the holder wake
+	// up a parked thread when unlocking it. A thread taking the
+	// SpinMutex here cannot know whether others are still parked,
+	// so it leaves it marked, too.
+	while (exchange(CONTENDED) != UNLOCKED)
+	{
+		_wakeup.wait();
+	}
+}
+
+
+bool SpinMutex::park(long milliseconds)
+{
+	Clock clock;
+	Clock::ClockDiff timeout = Clock::ClockDiff(milliseconds)*1000;
+	while (exchange(CONTENDED) != UNLOCKED)
+	{
+		Clock::ClockDiff remaining = timeout - clock.elapsed();
+		if (remaining <= 0 || !_wakeup.tryWait(static_cast<long>((remaining + 999)/1000)))
+			return false;
+	}
+	return true;
+}
+
+
+} // namespace Poco
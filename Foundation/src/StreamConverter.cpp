@@ -16,6 +16,8 @@
 
 #include "Poco/StreamConverter.h"
 #include "Poco/TextEncoding.h"
+#include "Poco/UTF8Encoding.h"
+#include "Poco/UTF8Codec.h"
 
 
 namespace Poco {
@@ -29,7 +31,8 @@ StreamConverterBuf::StreamConverterBuf(std::istream& istr, const TextEncoding& i
 	_defaultChar(defaultChar),
 	_sequenceLength(0),
 	_pos(0),
-	_errors(0)
+	_errors(0),
+	_utf8(dynamic_cast<const UTF8Encoding*>(&inEncoding) && dynamic_cast<const UTF8Encoding*>(&outEncoding))
 {
 }
 
@@ -42,7 +45,8 @@ StreamConverterBuf::StreamConverterBuf(std::ostream& ostr, const TextEncoding& i
 	_defaultChar(defaultChar),
 	_sequenceLength(0),
 	_pos(0),
-	_errors(0)
+	_errors(0),
+	_utf8(dynamic_cast<const UTF8Encoding*>(&inEncoding) && dynamic_cast<const UTF8Encoding*>(&outEncoding))
 {
 }
 
@@ -130,6 +134,31 @@ int StreamConverterBuf::writeToDevice(char c)
 }
 
 
+std::streamsize StreamConverterBuf::xsputn(const char* s, std::streamsize count)
+{
+	poco_assert_dbg (_pOstr);
+
+	static const int eof = std::char_traits<char>::eof();
+
+	const char* p = s;
+	const char* end = s + count;
+	while (p < end)
+	{
+		if (_utf8 && _pos == 0)
+		{
+			// Valid UTF-8 is written as it is.
+			std::size_t n = UTF8Codec::validLength(p, end - p);
+			_pOstr->write(p, static_cast<std::streamsize>(n));
+			p += n;
+			if (p == end) break;
+		}
+		if (writeToDevice(*p) == eof) return p - s;
+		++p;
+	}
+	return count;
+}
+
+
 int StreamConverterBuf::errors() const
 {
 	return _errors;
@@ -0,0 +1,208 @@
+//
+// StringPool.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  StringPool
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/StringPool.h"
+#include "Poco/SingletonHolder.h"
+#include <cstring>
+
+
+namespace Poco {
+
+
+//
+// InternedString
+//
+
+
+const InternedString::Entry InternedString::EMPTY = { std::string(), StringPool::hash("", 0) };
+
+
+//
+// StringPool
+//
+
+
+StringPool::Shard::Shard():
+	table(16),
+	count(0)
+{
+}
+
+
+StringPool::StringPool(int shards)
+{
+	poco_assert (shards > 0 && shards <= 256);
+
+	int n = 1;
+	while (n < shards) n <<= 1;
+	_mask = n - 1;
+	_shards = new Shard[n];
+}
+
+
+StringPool::~StringPool()
+{
+	for (int i = 0; i <= _mask; ++i)
+	{
+		std::vector<Entry*>& table = _shards[i].table;
+		for (std::vector<Entry*>::iterator it = table.begin(); it != table.end(); ++it)
+		{
+			delete *it;
+		}
+	}
+	delete [] _shards;
+}
+
+
+InternedString StringPool::intern(const char* str, std::size_t length)
+{
+	if (length == 0) return InternedString();
+
+	std::size_t h = hash(str, length);
+	Shard& shard = shardFor(h);
+	{
+		RWLock::ScopedReadLock lock(shard.lock);
+		const Entry* pEntry = lookup(shard, str, length, h);
+		if (pEntry) return InternedString(pEntry);
+	}
+
+	RWLock::ScopedWriteLock lock(shard.lock);
+	// Another thread may have added the string
+	// while we did not hold the lock.
+	const Entry* pEntry = lookup(shard, str, length, h);
+	if (pEntry) return InternedString(pEntry);
+
+	Entry* pNewEntry = new Entry;
+	try
+	{
+		pNewEntry->str.assign(str, length);
+		pNewEntry->hash = h;
+		insert(shard, pNewEntry);
+	}
+	catch (...)
+	{
+		delete pNewEntry;
+		throw;
+	}
+	return InternedString(pNewEntry);
+}
+
+
+bool StringPool::find(const std::string& str, InternedString& result) const
+{
+	if (str.empty())
+	{
+		result = InternedString();
+		return true;
+	}
+
+	std::size_t h = hash(str.data(), str.size());
+	Shard& shard = shardFor(h);
+	RWLock::ScopedReadLock lock(shard.lock);
+	const Entry* pEntry = lookup(shard, str.data(), str.size(), h);
+	if (pEntry)
+	{
+		result = InternedString(pEntry);
+		return true;
+	}
+	return false;
+}
+
+
+std::size_t StringPool::size() const
+{
+	std::size_t n = 0;
+	for (int i = 0; i <= _mask; ++i)
+	{
+		RWLock::ScopedReadLock lock(_shards[i].lock);
+		n += _shards[i].count;
+	}
+	return n;
+}
+
+
+std::size_t StringPool::hash(const char* str, std::size_t length)
+{
+	UInt64 h = 14695981039346656037ULL;
+	for (std::size_t i = 0; i < length; ++i)
+	{
+		h ^= static_cast<unsigned char>(str[i]);
+		h *= 1099511628211ULL;
+	}
+	return static_cast<std::size_t>(h ^ (h >> 32));
+}
+
+
+const StringPool::Entry* StringPool::lookup(const Shard& shard, const char* str, std::size_t length, std::size_t h) const
+{
+	std::size_t mask = shard.table.size() - 1;
+	std::size_t i = h & mask;
+	for (;;)
+	{
+		const Entry* pEntry = shard.table[i];
+		if (!pEntry) return 0;
+		if (pEntry->hash == h && pEntry->str.size() == length && std::memcmp(pEntry->str.data(), str, length) == 0)
+			return pEntry;
+		i = (i + 1) & mask;
+	}
+}
+
+
+void StringPool::insert(Shard& shard, Entry* pEntry)
+{
+	if (2*(shard.count + 1) > shard.table.size())
+	{
+		// Keep the table at most half full.
+		std::vector<Entry*> table(2*shard.table.size());
+		std::size_t mask = table.size() - 1;
+		for (std::vector<Entry*>::iterator it = shard.table.begin(); it != shard.table.end(); ++it)
+		{
+			if (*it)
+			{
+				std::size_t i = (*it)->hash & mask;
+				while (table[i]) i = (i + 1) & mask;
+				table[i] = *it;
+			}
+		}
+		shard.table.swap(table);
+	}
+	std::size_t mask = shard.table.size() - 1;
+	std::size_t i = pEntry->hash & mask;
+	while (shard.table[i]) i = (i + 1) & mask;
+	shard.table[i] = pEntry;
+	++shard.count;
+}
+
+
+std::size_t hash(const InternedString& str)
+{
+	return str.hash();
+}
+
+
+namespace
+{
+	static SingletonHolder<StringPool> sh;
+}
+
+
+StringPool& StringPool::defaultPool()
+{
+	return *sh.get();
+}
+
+
+} // namespace Poco
@@ -17,6 +17,8 @@
 #include "Poco/TextConverter.h"
 #include "Poco/TextIterator.h"
 #include "Poco/TextEncoding.h"
+#include "Poco/UTF8Encoding.h"
+#include "Poco/UTF8Codec.h"
 
 
 namespace {
@@ -24,6 +26,33 @@ namespace {
 	{
 		return ch;
 	}
+
+	const unsigned char* appendUTF8Run(const unsigned char* it, const unsigned char* end, std::string& destination, Poco::TextConverter::Transform trans)
+		/// For conversion from UTF-8 to UTF-8, appends the characters
+		/// at it that need not be decoded to destination, all at once:
+		/// any valid characters without a transform function, otherwise
+		/// ASCII characters the transform function maps to ASCII.
+		/// Returns the position of the first character not appended.
+	{
+		const char* p = reinterpret_cast<const char*>(it);
+		if (trans == nullTransform)
+		{
+			std::size_t n = Poco::UTF8Codec::validLength(p, end - it);
+			destination.append(p, n);
+			return it + n;
+		}
+		else
+		{
+			const unsigned char* runEnd = it + Poco::UTF8Codec::asciiLength(p, end - it);
+			for (; it < runEnd; ++it)
+			{
+				int c = trans(*it);
+				if (c < 0 || c >= 0x80) break;
+				destination += static_cast<char>(c);
+			}
+			return it;
+		}
+	}
 }
 
 
@@ -33,7 +62,8 @@ namespace Poco {
 TextConverter::TextConverter(const TextEncoding& inEncoding, const TextEncoding& outEncoding, int defaultChar):
 	_inEncoding(inEncoding),
 	_outEncoding(outEncoding),
-	_defaultChar(defaultChar)
+	_defaultChar(defaultChar),
+	_utf8(dynamic_cast<const UTF8Encoding*>(&inEncoding) && dynamic_cast<const UTF8Encoding*>(&outEncoding))
 {
 }
 
@@ -45,6 +75,12 @@ TextConverter::~TextConverter()
 
 int TextConverter::convert(const std::string& source, std::string& destination, Transform trans)
 {
+	// Valid UTF-8 converts the same way from a buffer, which can be
+	// done in bulk. Invalid sequences are handled differently by
+	// TextIterator, so invalid UTF-8 still goes through it.
+	if (_utf8 && UTF8Codec::isValid(source.data(), source.size()))
+		return source.empty() ? 0 : convert(source.data(), static_cast<int>(source.size()), destination, trans);
+
 	int errors = 0;
 	TextIterator it(source, _inEncoding);
 	TextIterator end(source);
@@ -73,9 +109,16 @@ int TextConverter::convert(const void* source, int length, std::string& destinat
 	const unsigned char* it  = (const unsigned char*) source;
 	const unsigned char* end = (const unsigned char*) source + length;
 	unsigned char buffer[TextEncoding::MAX_SEQUENCE_LENGTH];
+	if (_utf8) destination.reserve(destination.size() + length);
 	
 	while (it < end)
 	{
+		if (_utf8)
+		{
+			it = appendUTF8Run(it, end, destination, trans);
+			if (it == end) break;
+		}
+
 		int n = _inEncoding.queryConvert(it, 1);
 		int uc;
 		int read = 1;
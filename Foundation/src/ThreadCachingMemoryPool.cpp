@@ -0,0 +1,265 @@
+//
+// ThreadCachingMemoryPool.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  ThreadCachingMemoryPool
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/ThreadCachingMemoryPool.h"
+#include "Poco/Thread.h"
+#include "Poco/AllocationTracker.h"
+
+
+namespace Poco {
+
+
+namespace
+{
+	inline char*& next(char* pBlock)
+		/// Free blocks are linked through their first bytes.
+	{
+		return *reinterpret_cast<char**>(pBlock);
+	}
+
+	inline void add(AtomicCounter& counter, int n)
+	{
+		if (n != 0) BatchStore<char>::add(counter, n);
+	}
+}
+
+
+//
+// ThreadCachingMemoryPool::Central
+//
+
+
+ThreadCachingMemoryPool::Central::Central(std::size_t size, int batch, int maxBatches):
+	blockSize(size),
+	batchSize(batch),
+	_store(maxBatches)
+{
+}
+
+
+ThreadCachingMemoryPool::Central::~Central()
+{
+	while (char* pBatch = _store.pop()) free(pBatch);
+}
+
+
+char* ThreadCachingMemoryPool::Central::pop()
+{
+	if (available.value() <= 0) return 0;
+
+	char* pBatch = _store.pop();
+	if (pBatch) add(available, -batchSize);
+	return pBatch;
+}
+
+
+void ThreadCachingMemoryPool::Central::push(char* pBatch)
+{
+	add(available, batchSize);
+	if (!_store.push(pBatch))
+	{
+		add(available, -batchSize);
+		free(pBatch);
+	}
+}
+
+
+char* ThreadCachingMemoryPool::Central::allocate()
+{
+	std::size_t size = blockSize < sizeof(char*) ? sizeof(char*) : blockSize;
+	char* pBatch = 0;
+	try
+	{
+		for (int i = 0; i < batchSize; ++i)
+		{
+			char* pBlock = new char[size];
+			next(pBlock) = pBatch;
+			pBatch = pBlock;
+			++allocated;
+		}
+	}
+	catch (...)
+	{
+		free(pBatch);
+		throw;
+	}
+	return pBatch;
+}
+
+
+void ThreadCachingMemoryPool::Central::free(char* pBatch)
+{
+	while (pBatch)
+	{
+		char* pBlock = pBatch;
+		pBatch = next(pBlock);
+		delete [] pBlock;
+		--allocated;
+	}
+}
+
+
+//
+// ThreadCachingMemoryPool::Cache
+//
+
+
+ThreadCachingMemoryPool::Cache::Cache():
+	_pHead(0),
+	_count(0),
+	_hits(0),
+	_misses(0),
+	_outstanding(0)
+{
+}
+
+
+ThreadCachingMemoryPool::Cache::~Cache()
+{
+	if (!pCentral) return;
+
+	try
+	{
+		flush();
+		while (_count >= pCentral->batchSize)
+		{
+			char* pBatch = _pHead;
+			char* pLast = pBatch;
+			for (int i = 1; i < pCentral->batchSize; ++i) pLast = next(pLast);
+			_pHead = next(pLast);
+			next(pLast) = 0;
+			_count -= pCentral->batchSize;
+			pCentral->push(pBatch);
+		}
+		pCentral->free(_pHead);
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void* ThreadCachingMemoryPool::Cache::get()
+{
+	if (_pHead)
+	{
+		++_hits;
+	}
+	else
+	{
+		_pHead = pCentral->pop();
+		if (!_pHead) _pHead = pCentral->allocate();
+		_count = pCentral->batchSize;
+		++_misses;
+		flush();
+	}
+	char* pBlock = _pHead;
+	_pHead = next(pBlock);
+	--_count;
+	++_outstanding;
+	return pBlock;
+}
+
+
+void ThreadCachingMemoryPool::Cache::release(void* ptr)
+{
+	poco_check_ptr (ptr);
+
+	char* pBlock = reinterpret_cast<char*>(ptr);
+	next(pBlock) = _pHead;
+	_pHead = pBlock;
+	++_count;
+	--_outstanding;
+	if (_count >= 2*pCentral->batchSize)
+	{
+		// Keep one batch, give the other one back.
+		char* pLast = _pHead;
+		for (int i = 1; i < pCentral->batchSize; ++i) pLast = next(pLast);
+		char* pBatch = next(pLast);
+		next(pLast) = 0;
+		_count -= pCentral->batchSize;
+		pCentral->push(pBatch);
+		flush();
+	}
+}
+
+
+void ThreadCachingMemoryPool::Cache::flush()
+{
+	add(pCentral->hits, _hits);
+	add(pCentral->misses, _misses);
+	add(pCentral->outstanding, _outstanding);
+	_hits = 0;
+	_misses = 0;
+	_outstanding = 0;
+}
+
+
+//
+// ThreadCachingMemoryPool
+//
+
+
+ThreadCachingMemoryPool::ThreadCachingMemoryPool(std::size_t blockSize, int batchSize, int maxBatches):
+	_pCentral(new Central(blockSize, batchSize, maxBatches))
+{
+	poco_assert (batchSize > 0 && maxBatches >= 0);
+
+	_sharedCache.pCentral = _pCentral;
+}
+
+
+ThreadCachingMemoryPool::~ThreadCachingMemoryPool()
+{
+}
+
+
+void* ThreadCachingMemoryPool::get()
+{
+	void* ptr;
+	// The thread local storage of threads that are not
+	// Poco threads is shared, so they use the shared cache.
+	if (Thread::current())
+	{
+		ptr = cache().get();
+	}
+	else
+	{
+		FastMutex::ScopedLock lock(_sharedMutex);
+		ptr = _sharedCache.get();
+	}
+	AllocationTracker::poolAllocated(_pCentral->blockSize);
+	return ptr;
+}
+
+
+void ThreadCachingMemoryPool::release(void* ptr)
+{
+	if (Thread::current())
+	{
+		cache().release(ptr);
+	}
+	else
+	{
+		FastMutex::ScopedLock lock(_sharedMutex);
+		_sharedCache.release(ptr);
+	}
+	AllocationTracker::poolDeallocated(_pCentral->blockSize);
+}
+
+
+} // namespace Poco
@@ -17,6 +17,16 @@
 #include "Poco/ThreadLocal.h"
 #include "Poco/SingletonHolder.h"
 #include "Poco/Thread.h"
+#include "Poco/Mutex.h"
+
+
+#if !defined(POCO_NO_THREAD_LOCAL)
+	#if defined(_MSC_VER) && _MSC_VER >= 1900
+		#define POCO_THREAD_LOCAL __declspec(thread)
+	#elif defined(__GNUC__) && (POCO_OS == POCO_OS_LINUX || POCO_OS == POCO_OS_FREE_BSD) && !defined(POCO_ANDROID)
+		#define POCO_THREAD_LOCAL __thread
+	#endif
+#endif
 
 
 namespace Poco {
@@ -39,40 +49,108 @@ ThreadLocalStorage::ThreadLocalStorage()
 
 ThreadLocalStorage::~ThreadLocalStorage()
 {
-	for (TLSMap::iterator it = _map.begin(); it != _map.end(); ++it)
+	for (EntryVec::iterator it = _entries.begin(); it != _entries.end(); ++it)
 	{
-		delete it->second;	
+		delete it->pSlot;
 	}
 }
 
 
-TLSAbstractSlot*& ThreadLocalStorage::get(const void* key)
+TLSAbstractSlot*& ThreadLocalStorage::add(int index, UInt32 generation)
 {
-	TLSMap::iterator it = _map.find(key);
-	if (it == _map.end())
-		return _map.insert(TLSMap::value_type(key, reinterpret_cast<Poco::TLSAbstractSlot*>(0))).first->second;
-	else
-		return it->second;
+	poco_assert (index >= 0);
+
+	if (index >= static_cast<int>(_entries.size()))
+	{
+		Entry entry;
+		entry.pSlot = 0;
+		entry.generation = 0;
+		_entries.resize(index + 1, entry);
+	}
+	Entry& entry = _entries[index];
+	// The slot may have been left behind by a destroyed
+	// ThreadLocal that had the same index.
+	delete entry.pSlot;
+	entry.pSlot = 0;
+	entry.generation = generation;
+	return entry.pSlot;
 }
 
 
 namespace
 {
 	static SingletonHolder<ThreadLocalStorage> sh;
+
+	class TLSIndexAllocator
+	{
+	public:
+		TLSIndexAllocator():
+			_next(0),
+			_generation(0)
+		{
+		}
+
+		int allocate(UInt32& generation)
+		{
+			FastMutex::ScopedLock lock(_mutex);
+
+			// Generation 0 marks unused entries in ThreadLocalStorage.
+			if (++_generation == 0) ++_generation;
+			generation = _generation;
+			if (_free.empty()) return _next++;
+			int index = _free.back();
+			_free.pop_back();
+			return index;
+		}
+
+		void release(int index)
+		{
+			FastMutex::ScopedLock lock(_mutex);
+
+			_free.push_back(index);
+		}
+
+	private:
+		int              _next;
+		UInt32           _generation;
+		std::vector<int> _free;
+		FastMutex        _mutex;
+	};
+
+	TLSIndexAllocator& indexAllocator()
+	{
+		// ThreadLocal objects may be static, so the allocator is
+		// created on first use and never destroyed.
+		static TLSIndexAllocator* pAllocator = new TLSIndexAllocator;
+		return *pAllocator;
+	}
+
+#if defined(POCO_THREAD_LOCAL)
+	POCO_THREAD_LOCAL ThreadLocalStorage* pCurrentTLS = 0;
+#endif
 }
 
 
 ThreadLocalStorage& ThreadLocalStorage::current()
 {
+#if defined(POCO_THREAD_LOCAL)
+	if (pCurrentTLS) return *pCurrentTLS;
+#endif
+
+	ThreadLocalStorage* pTLS;
 	Thread* pThread = Thread::current();
 	if (pThread)
 	{
-		return pThread->tls();
+		pTLS = &pThread->tls();
 	}
 	else
 	{
-		return *sh.get();
+		pTLS = sh.get();
 	}
+#if defined(POCO_THREAD_LOCAL)
+	pCurrentTLS = pTLS;
+#endif
+	return *pTLS;
 }
 
 
@@ -80,7 +158,24 @@ void ThreadLocalStorage::clear()
 {
 	Thread* pThread = Thread::current();
 	if (pThread)
+	{
 		pThread->clearTLS();
+#if defined(POCO_THREAD_LOCAL)
+		pCurrentTLS = 0;
+#endif
+	}
+}
+
+
+int ThreadLocalStorage::allocateIndex(UInt32& generation)
+{
+	return indexAllocator().allocate(generation);
+}
+
+
+void ThreadLocalStorage::releaseIndex(int index)
+{
+	indexAllocator().release(index);
 }
 
 
@@ -20,6 +20,7 @@
 #include "Poco/Event.h"
 #include "Poco/ThreadLocal.h"
 #include "Poco/ErrorHandler.h"
+#include "Poco/CPUTopology.h"
 #include <sstream>
 #include <ctime>
 #if defined(_WIN32_WCE) && _WIN32_WCE < 0x800
@@ -44,6 +45,8 @@ public:
 	void join();
 	void activate();
 	void release();
+	void setCPUSet(const std::vector<int>& cpus, int serial);
+	int cpuSerial() const;
 	void run();
 
 private:
@@ -56,6 +59,9 @@ private:
 	Event                _targetCompleted;
 	Event                _started;
 	FastMutex            _mutex;
+	std::vector<int>     _cpus;
+	int                  _cpuSerial;
+	bool                 _rebind;
 };
 
 
@@ -68,7 +74,9 @@ PooledThread::PooledThread(const std::string& name, int stackSize):
 	_targetReady(),
 	_targetCompleted(Event::EVENT_MANUALRESET),
 	_started(),
-	_mutex()
+	_mutex(),
+	_cpuSerial(0),
+	_rebind(false)
 {
 	poco_assert_dbg (stackSize >= 0);
 	_thread.setStackSize(stackSize);
@@ -108,6 +116,7 @@ void PooledThread::start(Thread::Priority priority, Runnable& target, int cpu)
 	if (cpu >= 0) 
 	{
 		_thread.setAffinity(static_cast<unsigned>(cpu));
+		_rebind = false;
 	}
 }
 
@@ -137,6 +146,7 @@ void PooledThread::start(Thread::Priority priority, Runnable& target, const std:
 	if (cpu >= 0) 
 	{
 		_thread.setAffinity(static_cast<unsigned>(cpu));
+		_rebind = false;
 	}
 }
 
@@ -180,6 +190,24 @@ void PooledThread::activate()
 }
 
 
+void PooledThread::setCPUSet(const std::vector<int>& cpus, int serial)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	// The thread binds itself before running its next target,
+	// as not all platforms can bind another thread.
+	_cpus      = cpus;
+	_cpuSerial = serial;
+	_rebind    = true;
+}
+
+
+inline int PooledThread::cpuSerial() const
+{
+	return _cpuSerial;
+}
+
+
 void PooledThread::release()
 {
 	const long JOIN_TIMEOUT = 10000;
@@ -210,7 +238,20 @@ void PooledThread::run()
 		if (_pTarget) // a NULL target means kill yourself
 		{
 			Runnable* pTarget = _pTarget;
+			bool rebind = _rebind;
+			_rebind = false;
 			_mutex.unlock();
+			if (rebind)
+			{
+				try
+				{
+					CPUTopology::bindCurrentThread(_cpus);
+				}
+				catch (Exception& exc)
+				{
+					ErrorHandler::handle(exc);
+				}
+			}
 			try
 			{
 				pTarget->run();
@@ -261,7 +302,8 @@ ThreadPool::ThreadPool(int minCapacity,
 	_age(0),
 	_stackSize(stackSize),
 	_affinityPolicy(affinityPolicy),
-	_lastCpu(0)
+	_lastCpu(0),
+	_cpuSerial(0)
 {
 	poco_assert (minCapacity >= 1 && maxCapacity >= minCapacity && idleTime > 0);
 
@@ -296,7 +338,8 @@ ThreadPool::ThreadPool(const std::string& name,
 	_age(0),
 	_stackSize(stackSize),
 	_affinityPolicy(affinityPolicy),
-	_lastCpu(0)
+	_lastCpu(0),
+	_cpuSerial(0)
 {
 	poco_assert (minCapacity >= 1 && maxCapacity >= minCapacity && idleTime > 0);
 
@@ -346,6 +389,23 @@ int ThreadPool::capacity() const
 }
 
 
+void ThreadPool::setCPUSet(const std::vector<int>& cpus)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	_cpus = cpus;
+	++_cpuSerial;
+}
+
+
+std::vector<int> ThreadPool::getCPUSet() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _cpus;
+}
+
+
 int ThreadPool::available() const
 {
 	FastMutex::ScopedLock lock(_mutex);
@@ -535,6 +595,8 @@ PooledThread* ThreadPool::getThread()
 		}
 		else throw NoThreadAvailableException();
 	}
+	if (pThread->cpuSerial() != _cpuSerial)
+		pThread->setCPUSet(_cpus, _cpuSerial);
 	pThread->activate();
 	return pThread;
 }
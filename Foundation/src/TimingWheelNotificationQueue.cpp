@@ -0,0 +1,431 @@
+//
+// TimingWheelNotificationQueue.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Notifications
+// Module:  TimingWheelNotificationQueue
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/TimingWheelNotificationQueue.h"
+#include <limits>
+
+
+namespace Poco {
+
+
+namespace
+{
+	const Int64 NO_TICK = std::numeric_limits<Int64>::max();
+	const Int64 NO_WAITER = std::numeric_limits<Int64>::min();
+}
+
+
+TimingWheelNotificationQueue::TimingWheelNotificationQueue(Clock::ClockDiff resolution):
+	_resolution(resolution),
+	_tick(0),
+	_free(-1),
+	_count(0),
+	_wakeUpTick(NO_WAITER)
+{
+	poco_assert (resolution > 0);
+
+	for (int i = 0; i < LIST_COUNT; ++i)
+	{
+		_head[i] = _tail[i] = -1;
+	}
+	for (int i = 0; i < WHEELS; ++i)
+	{
+		_wheelCount[i] = 0;
+	}
+}
+
+
+TimingWheelNotificationQueue::~TimingWheelNotificationQueue()
+{
+	try
+	{
+		clear();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+TimingWheelNotificationQueue::Handle TimingWheelNotificationQueue::enqueueNotification(Notification::Ptr pNotification, Timestamp timestamp)
+{
+	poco_check_ptr (pNotification);
+
+	Timestamp tsNow;
+	Clock clock;
+	Timestamp::TimeDiff diff = timestamp - tsNow;
+	clock += diff;
+
+	return insert(pNotification, clock);
+}
+
+
+TimingWheelNotificationQueue::Handle TimingWheelNotificationQueue::enqueueNotification(Notification::Ptr pNotification, Clock clock)
+{
+	poco_check_ptr (pNotification);
+
+	return insert(pNotification, clock);
+}
+
+
+bool TimingWheelNotificationQueue::cancel(const Handle& handle)
+{
+	Notification::Ptr pNf;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		if (handle._index < 0 || handle._index >= static_cast<int>(_entries.size())) return false;
+		Entry& entry = _entries[handle._index];
+		if (entry.list == FREE_LIST || entry.generation != handle._generation) return false;
+
+		pNf.assign(entry.pNf);
+		unlink(handle._index);
+		release(handle._index);
+	}
+	// The notification is released after the mutex has been
+	// unlocked, so that its destructor may use the queue.
+	return true;
+}
+
+
+Notification* TimingWheelNotificationQueue::dequeueNotification()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	advance(currentTick());
+	return popReady();
+}
+
+
+Notification* TimingWheelNotificationQueue::waitDequeueNotification()
+{
+	for (;;)
+	{
+		Int64 tick;
+		{
+			FastMutex::ScopedLock lock(_mutex);
+
+			advance(currentTick());
+			Notification* pNf = popReady();
+			if (pNf)
+			{
+				_wakeUpTick = NO_WAITER;
+				return pNf;
+			}
+			tick = nextTick();
+			_wakeUpTick = tick;
+		}
+		sleep(tick, -1);
+	}
+}
+
+
+Notification* TimingWheelNotificationQueue::waitDequeueNotification(long milliseconds)
+{
+	Clock deadline;
+	deadline += 1000*Clock::ClockDiff(milliseconds);
+	for (;;)
+	{
+		Int64 tick;
+		{
+			FastMutex::ScopedLock lock(_mutex);
+
+			advance(currentTick());
+			Notification* pNf = popReady();
+			Clock::ClockDiff remaining = deadline - Clock();
+			if (pNf || remaining <= 0)
+			{
+				_wakeUpTick = NO_WAITER;
+				return pNf;
+			}
+			tick = nextTick();
+			_wakeUpTick = tick;
+		}
+		Clock::ClockDiff remaining = deadline - Clock();
+		if (remaining > 0) sleep(tick, remaining);
+	}
+}
+
+
+bool TimingWheelNotificationQueue::empty() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _count == 0;
+}
+
+
+int TimingWheelNotificationQueue::size() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _count;
+}
+
+
+void TimingWheelNotificationQueue::clear()
+{
+	std::vector<Notification*> notifications;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		notifications.reserve(_count);
+		for (int i = 0; i < static_cast<int>(_entries.size()); ++i)
+		{
+			if (_entries[i].list != FREE_LIST)
+			{
+				notifications.push_back(_entries[i].pNf);
+				release(i);
+			}
+		}
+		for (int i = 0; i < LIST_COUNT; ++i)
+		{
+			_head[i] = _tail[i] = -1;
+		}
+		for (int i = 0; i < WHEELS; ++i)
+		{
+			_wheelCount[i] = 0;
+		}
+	}
+	for (std::vector<Notification*>::iterator it = notifications.begin(); it != notifications.end(); ++it)
+	{
+		(*it)->release();
+	}
+}
+
+
+TimingWheelNotificationQueue::Handle TimingWheelNotificationQueue::insert(Notification::Ptr pNotification, Clock clock)
+{
+	// Round up, so that a notification is never delivered early.
+	Clock::ClockDiff diff = clock - _base;
+	Int64 tick = diff > 0 ? (diff + _resolution - 1)/_resolution : diff/_resolution;
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	int index = allocate();
+	Entry& entry = _entries[index];
+	entry.pNf = pNotification.duplicate();
+	entry.tick = tick;
+	schedule(index);
+	++_count;
+
+	// Only wake up the dequeuing thread if it would otherwise
+	// sleep past the new notification's due time.
+	if (tick < _wakeUpTick) _nfAvailable.set();
+
+	return Handle(index, entry.generation);
+}
+
+
+void TimingWheelNotificationQueue::schedule(int index)
+{
+	Int64 tick = _entries[index].tick;
+	Int64 delta = tick - _tick;
+	if (delta <= 0)
+	{
+		append(READY_LIST, index);
+		return;
+	}
+
+	// Find the finest wheel that reaches the due time. Entries
+	// too far in the future for the coarsest wheel are put into
+	// the slot that comes up next in it, and rescheduled when
+	// that slot is cascaded.
+	int wheel = 0;
+	while (wheel < WHEELS - 1 && delta >= (Int64(1) << (WHEEL_BITS*(wheel + 1))))
+	{
+		++wheel;
+	}
+	int slot = static_cast<int>((tick >> (WHEEL_BITS*wheel)) & WHEEL_MASK);
+	append(wheel*WHEEL_SIZE + slot, index);
+}
+
+
+void TimingWheelNotificationQueue::advance(Int64 tick)
+{
+	while (_tick < tick)
+	{
+		// Skip ticks where nothing happens, so that advancing over
+		// a long idle period does not take time proportional to
+		// its length.
+		Int64 next = nextTick();
+		if (next > tick)
+		{
+			_tick = tick;
+			break;
+		}
+		_tick = next;
+		for (int wheel = WHEELS - 1; wheel >= 0; --wheel)
+		{
+			Int64 mask = (Int64(1) << (WHEEL_BITS*wheel)) - 1;
+			if ((_tick & mask) == 0 && _wheelCount[wheel] > 0)
+				cascade(wheel);
+		}
+	}
+}
+
+
+void TimingWheelNotificationQueue::cascade(int wheel)
+{
+	int slot = static_cast<int>((_tick >> (WHEEL_BITS*wheel)) & WHEEL_MASK);
+	int list = wheel*WHEEL_SIZE + slot;
+	int index = _head[list];
+	_head[list] = _tail[list] = -1;
+	while (index >= 0)
+	{
+		int next = _entries[index].next;
+		--_wheelCount[wheel];
+		schedule(index);
+		index = next;
+	}
+}
+
+
+Int64 TimingWheelNotificationQueue::nextTick() const
+{
+	// Entries in the first wheel are due within the next
+	// WHEEL_SIZE ticks. Entries in the other wheels move down
+	// when the current tick reaches a multiple of the wheel's
+	// slot size, so the nearest such boundary of a non-empty
+	// wheel is the earliest tick at which anything can happen.
+	Int64 next = NO_TICK;
+	if (_wheelCount[0] > 0)
+	{
+		for (int i = 1; i < WHEEL_SIZE; ++i)
+		{
+			if (_head[(_tick + i) & WHEEL_MASK] >= 0)
+			{
+				next = _tick + i;
+				break;
+			}
+		}
+	}
+	for (int wheel = 1; wheel < WHEELS; ++wheel)
+	{
+		if (_wheelCount[wheel] > 0)
+		{
+			Int64 boundary = ((_tick >> (WHEEL_BITS*wheel)) + 1) << (WHEEL_BITS*wheel);
+			if (boundary < next) next = boundary;
+			break;
+		}
+	}
+	return next;
+}
+
+
+Int64 TimingWheelNotificationQueue::currentTick() const
+{
+	Clock now;
+	return (now - _base)/_resolution;
+}
+
+
+Notification* TimingWheelNotificationQueue::popReady()
+{
+	int index = _head[READY_LIST];
+	if (index < 0) return 0;
+
+	Notification* pNf = _entries[index].pNf;
+	unlink(index);
+	release(index);
+	return pNf;
+}
+
+
+int TimingWheelNotificationQueue::allocate()
+{
+	int index = _free;
+	if (index >= 0)
+	{
+		_free = _entries[index].next;
+	}
+	else
+	{
+		Entry entry;
+		entry.pNf = 0;
+		entry.tick = 0;
+		entry.prev = entry.next = -1;
+		entry.list = FREE_LIST;
+		entry.generation = 0;
+		index = static_cast<int>(_entries.size());
+		_entries.push_back(entry);
+	}
+	return index;
+}
+
+
+void TimingWheelNotificationQueue::release(int index)
+{
+	Entry& entry = _entries[index];
+	entry.pNf = 0;
+	entry.list = FREE_LIST;
+	entry.prev = -1;
+	entry.next = _free;
+	++entry.generation;
+	_free = index;
+	--_count;
+}
+
+
+void TimingWheelNotificationQueue::append(int list, int index)
+{
+	Entry& entry = _entries[index];
+	entry.list = list;
+	entry.prev = _tail[list];
+	entry.next = -1;
+	if (entry.prev >= 0)
+		_entries[entry.prev].next = index;
+	else
+		_head[list] = index;
+	_tail[list] = index;
+	if (list < READY_LIST) ++_wheelCount[list/WHEEL_SIZE];
+}
+
+
+void TimingWheelNotificationQueue::unlink(int index)
+{
+	Entry& entry = _entries[index];
+	if (entry.prev >= 0)
+		_entries[entry.prev].next = entry.next;
+	else
+		_head[entry.list] = entry.next;
+	if (entry.next >= 0)
+		_entries[entry.next].prev = entry.prev;
+	else
+		_tail[entry.list] = entry.prev;
+	if (entry.list < READY_LIST) --_wheelCount[entry.list/WHEEL_SIZE];
+}
+
+
+void TimingWheelNotificationQueue::sleep(Int64 tick, Clock::ClockDiff maxInterval)
+{
+	const Clock::ClockDiff MAX_SLEEP = 8*60*60*Clock::ClockDiff(1000000); // sleep at most 8 hours at a time
+
+	Clock::ClockDiff interval = MAX_SLEEP;
+	if (tick != NO_TICK)
+	{
+		Clock now;
+		Clock::ClockDiff untilDue = tick*_resolution - (now - _base);
+		if (untilDue < interval) interval = untilDue;
+	}
+	if (maxInterval >= 0 && maxInterval < interval) interval = maxInterval;
+	if (interval > 0)
+		_nfAvailable.tryWait(static_cast<long>((interval + 999)/1000));
+}
+
+
+} // namespace Poco
@@ -0,0 +1,468 @@
+//
+// UTF8Codec.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Text
+// Module:  UTF8Codec
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/UTF8Codec.h"
+#include "Poco/Exception.h"
+#include "Poco/CPUFeatures.h"
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define POCO_UTF8_SSE2
+	#include <emmintrin.h>
+#endif
+#if defined(POCO_X86_SIMD)
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#endif
+	#include <immintrin.h>
+#endif
+
+
+namespace Poco {
+
+
+const std::size_t UTF8Codec::INVALID = static_cast<std::size_t>(-1);
+
+
+namespace
+{
+	inline int sequenceLength(unsigned char lead)
+		/// Returns the length of the sequence introduced by the
+		/// given lead byte, or 0 if it cannot start a sequence.
+	{
+		if (lead < 0x80)
+			return 1;
+		else if (lead >= 0xC2 && lead <= 0xDF)
+			return 2;
+		else if (lead >= 0xE0 && lead <= 0xEF)
+			return 3;
+		else if (lead >= 0xF0 && lead <= 0xF4)
+			return 4;
+		else
+			return 0;
+	}
+
+	inline bool isLegal(const unsigned char* p, int n)
+		/// Returns true if the n bytes at p, which start with a lead
+		/// byte for which sequenceLength() returns n, are valid.
+	{
+		unsigned char lo = 0x80;
+		unsigned char hi = 0xBF;
+		switch (p[0])
+		{
+		case 0xE0: lo = 0xA0; break; // overlong
+		case 0xED: hi = 0x9F; break; // surrogate
+		case 0xF0: lo = 0x90; break; // overlong
+		case 0xF4: hi = 0x8F; break; // above U+10FFFF
+		}
+		if (p[1] < lo || p[1] > hi) return false;
+		for (int k = 2; k < n; ++k)
+		{
+			if ((p[k] & 0xC0) != 0x80) return false;
+		}
+		return true;
+	}
+
+	inline bool isASCII8(const unsigned char* p)
+	{
+		UInt64 v;
+		std::memcpy(&v, p, sizeof(v));
+		return (v & 0x8080808080808080ULL) == 0;
+	}
+
+	std::size_t validateScalar(const unsigned char* p, std::size_t length)
+	{
+		std::size_t i = 0;
+		while (i < length)
+		{
+			if (p[i] < 0x80)
+			{
+				++i;
+				while (length - i >= 8 && isASCII8(p + i)) i += 8;
+				continue;
+			}
+			int n = sequenceLength(p[i]);
+			if (n == 0 || length - i < static_cast<std::size_t>(n) || !isLegal(p + i, n))
+				break;
+			i += n;
+		}
+		return i;
+	}
+
+#if defined(POCO_X86_SIMD)
+
+	// Validation looks at every byte together with the three bytes
+	// before it (see Keiser and Lemire, "Validating UTF-8 In Less
+	// Than One Instruction Per Byte", 2021). Three tables, indexed by
+	// the high and low nibbles of the previous byte and the high nibble
+	// of the current byte, give a set of possible errors each; a byte
+	// pair is invalid if an error is in all three sets. Continuation
+	// bytes expected as the third and fourth bytes of a sequence are
+	// checked separately.
+
+	enum
+	{
+		TOO_SHORT      = 0x01, // lead byte not followed by continuation byte
+		TOO_LONG       = 0x02, // ASCII followed by continuation byte
+		OVERLONG_3     = 0x04,
+		TOO_LARGE      = 0x08,
+		SURROGATE      = 0x10,
+		OVERLONG_2     = 0x20,
+		TOO_LARGE_1000 = 0x40,
+		OVERLONG_4     = 0x40,
+		TWO_CONTS      = 0x80, // two continuation bytes in a row
+		CARRY          = TOO_SHORT | TOO_LONG | TWO_CONTS
+	};
+
+	const unsigned char BYTE_1_HIGH[16] =
+	{
+		TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+		TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+		TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+		TOO_SHORT | OVERLONG_2,
+		TOO_SHORT,
+		TOO_SHORT | OVERLONG_3 | SURROGATE,
+		TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+	};
+
+	const unsigned char BYTE_1_LOW[16] =
+	{
+		CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+		CARRY | OVERLONG_2,
+		CARRY,
+		CARRY,
+		CARRY | TOO_LARGE,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000
+	};
+
+	const unsigned char BYTE_2_HIGH[16] =
+	{
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+	};
+
+	// Largest values of the last three bytes of a block
+	// that do not start a sequence reaching past its end.
+	const unsigned char MAX_LAST[16] =
+	{
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF
+	};
+
+	POCO_SIMD_TARGET("ssse3")
+	inline __m128i checkBlockSSSE3(__m128i in, __m128i prev, __m128i byte1High, __m128i byte1Low, __m128i byte2High)
+	{
+		const __m128i nibble = _mm_set1_epi8(0x0F);
+		__m128i prev1 = _mm_alignr_epi8(in, prev, 15);
+		__m128i prev2 = _mm_alignr_epi8(in, prev, 14);
+		__m128i prev3 = _mm_alignr_epi8(in, prev, 13);
+		__m128i special = _mm_and_si128(
+			_mm_and_si128(
+				_mm_shuffle_epi8(byte1High, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+				_mm_shuffle_epi8(byte1Low, _mm_and_si128(prev1, nibble))),
+			_mm_shuffle_epi8(byte2High, _mm_and_si128(_mm_srli_epi16(in, 4), nibble)));
+		__m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+		__m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+		__m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+		return _mm_xor_si128(must23, special);
+	}
+
+	POCO_SIMD_TARGET("ssse3")
+	std::size_t validateSSSE3(const unsigned char* p, std::size_t length)
+		/// Returns the length of a prefix, a multiple of 16 bytes, that
+		/// contains no invalid sequences. The prefix may end with an
+		/// incomplete sequence.
+	{
+		const __m128i byte1High = _mm_loadu_si128(reinterpret_cast<const __m128i*>(BYTE_1_HIGH));
+		const __m128i byte1Low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(BYTE_1_LOW));
+		const __m128i byte2High = _mm_loadu_si128(reinterpret_cast<const __m128i*>(BYTE_2_HIGH));
+		const __m128i maxLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(MAX_LAST));
+		const __m128i zero = _mm_setzero_si128();
+		__m128i prev = zero;
+		__m128i incomplete = zero;
+		std::size_t i = 0;
+		for (; length - i >= 16; i += 16)
+		{
+			__m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+			if (_mm_movemask_epi8(in) == 0)
+			{
+				if (_mm_movemask_epi8(_mm_cmpeq_epi8(incomplete, zero)) != 0xFFFF) break;
+			}
+			else
+			{
+				__m128i error = checkBlockSSSE3(in, prev, byte1High, byte1Low, byte2High);
+				if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, zero)) != 0xFFFF) break;
+			}
+			incomplete = _mm_subs_epu8(in, maxLast);
+			prev = in;
+		}
+		return i;
+	}
+
+	POCO_SIMD_TARGET("avx2")
+	std::size_t validateAVX2(const unsigned char* p, std::size_t length)
+		/// Like validateSSSE3(), but works on 32 bytes at a time.
+	{
+		const __m256i byte1High = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(BYTE_1_HIGH)));
+		const __m256i byte1Low = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(BYTE_1_LOW)));
+		const __m256i byte2High = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(BYTE_2_HIGH)));
+		const __m256i maxLast = _mm256_inserti128_si256(_mm256_set1_epi8(static_cast<char>(0xFF)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(MAX_LAST)), 1);
+		const __m256i nibble = _mm256_set1_epi8(0x0F);
+		const __m256i zero = _mm256_setzero_si256();
+		__m256i prev = zero;
+		__m256i incomplete = zero;
+		std::size_t i = 0;
+		for (; length - i >= 32; i += 32)
+		{
+			__m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+			if (_mm256_movemask_epi8(in) == 0)
+			{
+				if (!_mm256_testz_si256(incomplete, incomplete)) break;
+			}
+			else
+			{
+				// The last 16 bytes of prev, followed by the first 16 bytes of in.
+				__m256i shifted = _mm256_permute2x128_si256(prev, in, 0x21);
+				__m256i prev1 = _mm256_alignr_epi8(in, shifted, 15);
+				__m256i prev2 = _mm256_alignr_epi8(in, shifted, 14);
+				__m256i prev3 = _mm256_alignr_epi8(in, shifted, 13);
+				__m256i special = _mm256_and_si256(
+					_mm256_and_si256(
+						_mm256_shuffle_epi8(byte1High, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+						_mm256_shuffle_epi8(byte1Low, _mm256_and_si256(prev1, nibble))),
+					_mm256_shuffle_epi8(byte2High, _mm256_and_si256(_mm256_srli_epi16(in, 4), nibble)));
+				__m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+				__m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+				__m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+				__m256i error = _mm256_xor_si256(must23, special);
+				if (!_mm256_testz_si256(error, error)) break;
+			}
+			incomplete = _mm256_subs_epu8(in, maxLast);
+			prev = in;
+		}
+		return i;
+	}
+
+#endif // POCO_X86_SIMD
+
+	void checkSupported(UTF8Codec::Implementation impl)
+	{
+		if (!UTF8Codec::isSupported(impl))
+			throw InvalidArgumentException("UTF-8 implementation not supported by this processor", UTF8Codec::name(impl));
+	}
+}
+
+
+std::size_t UTF8Codec::asciiLength(const char* utf8, std::size_t length)
+{
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(utf8);
+	std::size_t i = 0;
+#if defined(POCO_UTF8_SSE2)
+	while (length - i >= 16 && _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i))) == 0) i += 16;
+#endif
+	while (length - i >= 8 && isASCII8(p + i)) i += 8;
+	while (i < length && p[i] < 0x80) ++i;
+	return i;
+}
+
+
+std::size_t UTF8Codec::validLength(const char* utf8, std::size_t length, Implementation impl)
+{
+	checkSupported(impl);
+
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(utf8);
+	std::size_t done = 0;
+#if defined(POCO_X86_SIMD)
+	if (impl == IMPL_AVX2)
+		done = validateAVX2(p, length);
+	else if (impl == IMPL_SSSE3)
+		done = validateSSSE3(p, length);
+
+	// The kernels stop at a block boundary, which may split a
+	// sequence. If so, or if the last lead byte of the prefix
+	// cannot start a sequence at all (which the kernels only
+	// notice when looking at the following byte), continue at
+	// that lead byte.
+	for (std::size_t k = 1; k <= 3 && k <= done; ++k)
+	{
+		unsigned char c = p[done - k];
+		if (c >= 0xC0)
+		{
+			int n = sequenceLength(c);
+			if (n == 0 || static_cast<int>(k) < n) done -= k;
+			break;
+		}
+		else if (c < 0x80) break;
+	}
+#endif
+	return done + validateScalar(p + done, length - done);
+}
+
+
+std::size_t UTF8Codec::toUTF16(const char* utf8, std::size_t length, UTF16Char* utf16)
+{
+	poco_static_assert (sizeof(UTF16Char) == 2);
+
+	if (validLength(utf8, length) != length) return INVALID;
+
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(utf8);
+	UTF16Char* q = utf16;
+	std::size_t i = 0;
+	while (i < length)
+	{
+#if defined(POCO_UTF8_SSE2)
+		if (length - i >= 16)
+		{
+			__m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+			if (_mm_movemask_epi8(in) == 0)
+			{
+				const __m128i zero = _mm_setzero_si128();
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(q), _mm_unpacklo_epi8(in, zero));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(q + 8), _mm_unpackhi_epi8(in, zero));
+				i += 16;
+				q += 16;
+				continue;
+			}
+		}
+#endif
+		UInt32 c = p[i];
+		if (c < 0x80)
+		{
+			*q++ = static_cast<UTF16Char>(c);
+			i += 1;
+		}
+		else if (c < 0xE0)
+		{
+			*q++ = static_cast<UTF16Char>(((c & 0x1F) << 6) | (p[i + 1] & 0x3F));
+			i += 2;
+		}
+		else if (c < 0xF0)
+		{
+			*q++ = static_cast<UTF16Char>(((c & 0x0F) << 12) | ((p[i + 1] & 0x3F) << 6) | (p[i + 2] & 0x3F));
+			i += 3;
+		}
+		else
+		{
+			c = ((c & 0x07) << 18) | ((p[i + 1] & 0x3F) << 12) | ((p[i + 2] & 0x3F) << 6) | (p[i + 3] & 0x3F);
+			c -= 0x10000;
+			*q++ = static_cast<UTF16Char>(0xD800 | (c >> 10));
+			*q++ = static_cast<UTF16Char>(0xDC00 | (c & 0x3FF));
+			i += 4;
+		}
+	}
+	return q - utf16;
+}
+
+
+std::size_t UTF8Codec::fromUTF16(const UTF16Char* utf16, std::size_t length, char* utf8)
+{
+	poco_static_assert (sizeof(UTF16Char) == 2);
+
+	char* q = utf8;
+	std::size_t i = 0;
+	while (i < length)
+	{
+#if defined(POCO_UTF8_SSE2)
+		if (length - i >= 8)
+		{
+			__m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(utf16 + i));
+			__m128i high = _mm_and_si128(in, _mm_set1_epi16(static_cast<short>(0xFF80)));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) == 0xFFFF)
+			{
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(q), _mm_packus_epi16(in, in));
+				i += 8;
+				q += 8;
+				continue;
+			}
+		}
+#endif
+		UInt32 c = static_cast<UInt16>(utf16[i++]);
+		if (c < 0x80)
+		{
+			*q++ = static_cast<char>(c);
+		}
+		else if (c < 0x800)
+		{
+			*q++ = static_cast<char>(0xC0 | (c >> 6));
+			*q++ = static_cast<char>(0x80 | (c & 0x3F));
+		}
+		else if (c >= 0xD800 && c <= 0xDFFF)
+		{
+			if (c >= 0xDC00 || i == length) return INVALID;
+			UInt32 d = static_cast<UInt16>(utf16[i]);
+			if (d < 0xDC00 || d > 0xDFFF) return INVALID;
+			++i;
+			c = 0x10000 + (((c & 0x3FF) << 10) | (d & 0x3FF));
+			*q++ = static_cast<char>(0xF0 | (c >> 18));
+			*q++ = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+			*q++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+			*q++ = static_cast<char>(0x80 | (c & 0x3F));
+		}
+		else
+		{
+			*q++ = static_cast<char>(0xE0 | (c >> 12));
+			*q++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+			*q++ = static_cast<char>(0x80 | (c & 0x3F));
+		}
+	}
+	return q - utf8;
+}
+
+
+UTF8Codec::Implementation UTF8Codec::implementation()
+{
+	if (CPUFeatures::hasAVX2())
+		return IMPL_AVX2;
+	else if (CPUFeatures::hasSSSE3())
+		return IMPL_SSSE3;
+	else
+		return IMPL_SCALAR;
+}
+
+
+bool UTF8Codec::isSupported(Implementation impl)
+{
+	return impl >= IMPL_SCALAR && impl <= implementation();
+}
+
+
+const char* UTF8Codec::name(Implementation impl)
+{
+	switch (impl)
+	{
+	case IMPL_SCALAR: return "scalar";
+	case IMPL_SSSE3:  return "SSSE3";
+	case IMPL_AVX2:   return "AVX2";
+	default:          return "unknown";
+	}
+}
+
+
+} // namespace Poco
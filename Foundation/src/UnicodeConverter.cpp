@@ -20,12 +20,47 @@
 #include "Poco/UTF8Encoding.h"
 #include "Poco/UTF16Encoding.h"
 #include "Poco/UTF32Encoding.h"
+#include "Poco/UTF8Codec.h"
 #include <cstring>
 
 
 namespace Poco {
 
 
+namespace
+{
+	bool convertValid(const char* utf8String, std::size_t length, UTF16String& utf16String)
+		/// Converts valid UTF-8 in bulk. Returns false, leaving
+		/// utf16String empty, if utf8String is not valid UTF-8.
+	{
+		utf16String.resize(length);
+		std::size_t n = length ? UTF8Codec::toUTF16(utf8String, length, &utf16String[0]) : 0;
+		if (n == UTF8Codec::INVALID)
+		{
+			utf16String.clear();
+			return false;
+		}
+		utf16String.resize(n);
+		return true;
+	}
+
+	bool convertValid(const UTF16Char* utf16String, std::size_t length, std::string& utf8String)
+		/// Converts valid UTF-16 in bulk. Returns false, leaving
+		/// utf8String empty, if utf16String is not valid UTF-16.
+	{
+		utf8String.resize(3*length);
+		std::size_t n = length ? UTF8Codec::fromUTF16(utf16String, length, &utf8String[0]) : 0;
+		if (n == UTF8Codec::INVALID)
+		{
+			utf8String.clear();
+			return false;
+		}
+		utf8String.resize(n);
+		return true;
+	}
+}
+
+
 void UnicodeConverter::convert(const std::string& utf8String, UTF32String& utf32String)
 {
 	utf32String.clear();
@@ -67,7 +102,8 @@ void UnicodeConverter::convert(const char* utf8String, UTF32String& utf32String)
 
 void UnicodeConverter::convert(const std::string& utf8String, UTF16String& utf16String)
 {
-	utf16String.clear();
+	if (convertValid(utf8String.data(), utf8String.size(), utf16String)) return;
+
 	UTF8Encoding utf8Encoding;
 	TextIterator it(utf8String, utf8Encoding);
 	TextIterator end(utf8String);
@@ -96,7 +132,8 @@ void UnicodeConverter::convert(const char* utf8String,  std::size_t length, UTF1
 		return;
 	}
 
-	convert(std::string(utf8String, utf8String + length), utf16String);
+	if (!convertValid(utf8String, length, utf16String))
+		convert(std::string(utf8String, utf8String + length), utf16String);
 }
 
 
@@ -114,7 +151,8 @@ void UnicodeConverter::convert(const char* utf8String, UTF16String& utf16String)
 
 void UnicodeConverter::convert(const UTF16String& utf16String, std::string& utf8String)
 {
-	utf8String.clear();
+	if (convertValid(utf16String.data(), utf16String.size(), utf8String)) return;
+
 	UTF8Encoding utf8Encoding;
 	UTF16Encoding utf16Encoding;
 	TextConverter converter(utf16Encoding, utf8Encoding);
@@ -134,7 +172,8 @@ void UnicodeConverter::convert(const UTF32String& utf32String, std::string& utf8
 
 void UnicodeConverter::convert(const UTF16Char* utf16String,  std::size_t length, std::string& utf8String)
 {
-	utf8String.clear();
+	if (convertValid(utf16String, length, utf8String)) return;
+
 	UTF8Encoding utf8Encoding;
 	UTF16Encoding utf16Encoding;
 	TextConverter converter(utf16Encoding, utf8Encoding);
@@ -54,8 +54,7 @@ Var::Var(const Var& other)
 }
 #else
 {
-	if ((this != &other) && !other.isEmpty())
-			construct(other);
+	construct(other);
 }
 #endif
 
@@ -72,10 +71,19 @@ Var& Var::operator = (const Var& rhs)
 	Var tmp(rhs);
 	swap(tmp);
 #else
-	if ((this != &rhs) && !rhs.isEmpty())
+	if (this == &rhs) return *this;
+
+	if (isEmpty())
+	{
 		construct(rhs);
-	else if ((this != &rhs) && rhs.isEmpty())
-		_placeholder.erase();
+	}
+	else
+	{
+		// rhs may be part of our own content
+		Var tmp(rhs);
+		destruct();
+		take(tmp);
+	}
 #endif
 	return *this;
 }
@@ -332,9 +340,7 @@ void Var::empty()
 	delete _pHolder;
 	_pHolder = 0;
 #else
-	if (_placeholder.isLocal()) this->~Var();
-	else delete content();
-	_placeholder.erase();
+	destruct();
 #endif
 }
 
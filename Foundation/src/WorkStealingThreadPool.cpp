@@ -0,0 +1,348 @@
+//
+// WorkStealingThreadPool.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Threading
+// Module:  WorkStealingThreadPool
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/WorkStealingThreadPool.h"
+#include "Poco/Runnable.h"
+#include "Poco/Environment.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Exception.h"
+#include <sstream>
+
+
+namespace Poco {
+
+
+class WorkStealingWorker: public Runnable
+{
+public:
+	WorkStealingWorker(WorkStealingThreadPool& pool, const std::string& name, std::size_t index, int stackSize);
+	~WorkStealingWorker();
+
+	void start();
+	void join();
+	void push(Runnable* pTarget);
+	Runnable* pop();
+	Runnable* steal();
+	std::size_t index() const;
+	void run();
+
+private:
+	typedef std::deque<Runnable*> TaskQueue;
+
+	WorkStealingThreadPool& _pool;
+	std::size_t _index;
+	TaskQueue   _tasks;
+	FastMutex   _mutex;
+	Thread      _thread;
+};
+
+
+WorkStealingWorker::WorkStealingWorker(WorkStealingThreadPool& pool, const std::string& name, std::size_t index, int stackSize):
+	_pool(pool),
+	_index(index),
+	_thread(name)
+{
+	poco_assert_dbg (stackSize >= 0);
+	_thread.setStackSize(stackSize);
+}
+
+
+WorkStealingWorker::~WorkStealingWorker()
+{
+}
+
+
+void WorkStealingWorker::start()
+{
+	_thread.start(*this);
+}
+
+
+void WorkStealingWorker::join()
+{
+	_thread.join();
+}
+
+
+void WorkStealingWorker::push(Runnable* pTarget)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	_tasks.push_back(pTarget);
+}
+
+
+Runnable* WorkStealingWorker::pop()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (_tasks.empty()) return 0;
+	Runnable* pTarget = _tasks.back();
+	_tasks.pop_back();
+	return pTarget;
+}
+
+
+Runnable* WorkStealingWorker::steal()
+{
+	// Do not wait for a busy victim - there may be others.
+	if (!_mutex.tryLock()) return 0;
+
+	Runnable* pTarget = 0;
+	if (!_tasks.empty())
+	{
+		pTarget = _tasks.front();
+		_tasks.pop_front();
+	}
+	_mutex.unlock();
+	return pTarget;
+}
+
+
+inline std::size_t WorkStealingWorker::index() const
+{
+	return _index;
+}
+
+
+void WorkStealingWorker::run()
+{
+	_pool._currentWorker.get() = this;
+	for (;;)
+	{
+		Runnable* pTarget = _pool.next(this);
+		if (!pTarget) break; // pool has been stopped
+		try
+		{
+			pTarget->run();
+		}
+		catch (Exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (std::exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (...)
+		{
+			ErrorHandler::handle();
+		}
+		_pool.completed();
+	}
+}
+
+
+WorkStealingThreadPool::WorkStealingThreadPool(int threads, int queueCapacity, int stackSize):
+	_queueCapacity(queueCapacity),
+	_stopped(false)
+{
+	init(threads, stackSize);
+}
+
+
+WorkStealingThreadPool::WorkStealingThreadPool(const std::string& name, int threads, int queueCapacity, int stackSize):
+	_name(name),
+	_queueCapacity(queueCapacity),
+	_stopped(false)
+{
+	init(threads, stackSize);
+}
+
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+	try
+	{
+		stopAll();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void WorkStealingThreadPool::init(int threads, int stackSize)
+{
+	poco_assert (threads >= 0 && _queueCapacity > 0);
+
+	if (threads == 0) threads = Environment::processorCount();
+	_workers.reserve(threads);
+	for (int i = 0; i < threads; i++)
+	{
+		std::ostringstream name;
+		name << _name << "[#" << i + 1 << "]";
+		_workers.push_back(new WorkStealingWorker(*this, name.str(), i, stackSize));
+	}
+	// Workers look at each other's queues, so the vector
+	// must be complete before the first one starts.
+	for (WorkerVec::iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		(*it)->start();
+	}
+}
+
+
+void WorkStealingThreadPool::start(Runnable& target)
+{
+	if (!tryStart(target))
+		throw NoThreadAvailableException("submission queue is full");
+}
+
+
+bool WorkStealingThreadPool::tryStart(Runnable& target)
+{
+	poco_assert (!_stopped);
+
+	++_pending;
+	WorkStealingWorker* pWorker = currentWorker();
+	if (pWorker)
+	{
+		pWorker->push(&target);
+	}
+	else
+	{
+		FastMutex::ScopedLock lock(_queueMutex);
+
+		if (_queue.size() >= static_cast<std::size_t>(_queueCapacity))
+		{
+			--_pending;
+			return false;
+		}
+		_queue.push_back(&target);
+	}
+	// Both counters are updated with full memory barriers: a worker
+	// increments _idle before it checks _queued, and we increment
+	// _queued before we check _idle, so at least one of us will
+	// see the other's update.
+	++_queued;
+	if (_idle.value() > 0) wakeUp();
+	return true;
+}
+
+
+void WorkStealingThreadPool::joinAll()
+{
+	poco_assert (!currentWorker());
+
+	FastMutex::ScopedLock lock(_doneMutex);
+	while (_pending.value() > 0)
+	{
+		_done.wait(_doneMutex);
+	}
+}
+
+
+void WorkStealingThreadPool::stopAll()
+{
+	{
+		FastMutex::ScopedLock lock(_parkMutex);
+		_stopped = true;
+		_workAvailable.broadcast();
+	}
+	for (WorkerVec::iterator it = _workers.begin(); it != _workers.end(); ++it)
+	{
+		(*it)->join();
+		delete *it;
+	}
+	_workers.clear();
+	{
+		FastMutex::ScopedLock lock(_queueMutex);
+		_queue.clear();
+	}
+	_queued = 0;
+	{
+		FastMutex::ScopedLock lock(_doneMutex);
+		_pending = 0;
+		_done.broadcast();
+	}
+}
+
+
+Runnable* WorkStealingThreadPool::next(WorkStealingWorker* pWorker)
+{
+	while (!_stopped)
+	{
+		Runnable* pTarget = pWorker->pop();
+		if (!pTarget)
+		{
+			FastMutex::ScopedLock lock(_queueMutex);
+			if (!_queue.empty())
+			{
+				pTarget = _queue.front();
+				_queue.pop_front();
+			}
+		}
+		std::size_t n = _workers.size();
+		for (std::size_t i = 1; !pTarget && i < n; i++)
+		{
+			pTarget = _workers[(pWorker->index() + i) % n]->steal();
+		}
+		if (pTarget)
+		{
+			--_queued;
+			return pTarget;
+		}
+		park();
+	}
+	return 0;
+}
+
+
+void WorkStealingThreadPool::completed()
+{
+	if (--_pending == 0)
+	{
+		FastMutex::ScopedLock lock(_doneMutex);
+		_done.broadcast();
+	}
+}
+
+
+void WorkStealingThreadPool::park()
+{
+	FastMutex::ScopedLock lock(_parkMutex);
+
+	++_idle;
+	if (_queued.value() <= 0 && !_stopped)
+	{
+		_workAvailable.wait(_parkMutex);
+	}
+	--_idle;
+}
+
+
+void WorkStealingThreadPool::wakeUp()
+{
+	FastMutex::ScopedLock lock(_parkMutex);
+
+	_workAvailable.signal();
+}
+
+
+WorkStealingWorker* WorkStealingThreadPool::currentWorker()
+{
+	// Threads not created by Poco share a single thread-local
+	// storage, so only Poco threads may look at _currentWorker.
+	if (Thread::current())
+		return _currentWorker.get();
+	else
+		return 0;
+}
+
+
+} // namespace Poco
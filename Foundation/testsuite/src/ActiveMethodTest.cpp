@@ -17,10 +17,18 @@
 #include "Poco/Thread.h"
 #include "Poco/Event.h"
 #include "Poco/Exception.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/WorkStealingThreadPool.h"
+#include "Poco/ActiveExecutor.h"
+#include <vector>
 
 
 using Poco::ActiveMethod;
 using Poco::ActiveResult;
+using Poco::ThreadPool;
+using Poco::ThreadPoolExecutor;
+using Poco::WorkStealingThreadPool;
+using Poco::WorkStealingExecutor;
 using Poco::Thread;
 using Poco::Event;
 using Poco::Exception;
@@ -89,6 +97,49 @@ namespace
 	private:
 		Event _continue;
 	};
+
+	class PooledObject
+	{
+	public:
+		PooledObject(Poco::ActiveExecutor& executor):
+			square(this, &PooledObject::squareImpl, executor)
+		{
+		}
+
+		ActiveMethod<int, int, PooledObject> square;
+
+		int addOne(const ActiveResult<int>& result)
+		{
+			return result.data() + 1;
+		}
+
+		std::string describe(const ActiveResult<int>& result)
+		{
+			return result.failed() ? result.error() : std::string("ok");
+		}
+
+	protected:
+		int squareImpl(const int& n)
+		{
+			if (n < 0) throw Poco::InvalidArgumentException("negative");
+			return n*n;
+		}
+	};
+
+	int twice(const ActiveResult<int>& result)
+	{
+		return 2*result.data();
+	}
+
+	int failContinuation(const ActiveResult<int>& /*result*/)
+	{
+		throw Poco::IllegalStateException("fail");
+	}
+
+	void checkVoid(const ActiveResult<void>& result)
+	{
+		if (result.failed()) throw Poco::IllegalStateException("failed");
+	}
 }
 
 
@@ -236,6 +287,131 @@ void ActiveMethodTest::testVoidIn()
 }
 
 
+void ActiveMethodTest::testThen()
+{
+	ActiveObject activeObj;
+	ActiveResult<int> result = activeObj.testMethod(21);
+	ActiveResult<int> doubled = result.then(&twice);
+	assert (!doubled.available());
+	activeObj.cont();
+	doubled.wait();
+	assert (doubled.data() == 42);
+
+	// already available
+	ActiveResult<int> again = result.then(&twice);
+	assert (again.available());
+	assert (again.data() == 42);
+
+	ActiveResult<void> voidResult = activeObj.testVoidInOut();
+	ActiveResult<void> checked = voidResult.then(&checkVoid);
+	activeObj.cont();
+	checked.wait();
+	assert (!checked.failed());
+}
+
+
+void ActiveMethodTest::testThenFailure()
+{
+	ActiveObject activeObj;
+	ActiveResult<int> result = activeObj.testMethod(100);
+	ActiveResult<int> failed = result.then(&failContinuation);
+	failed.wait();
+	assert (failed.failed());
+	assert (failed.error() == "fail");
+
+	ActiveResult<int> chained = result.then(&twice).then(&twice);
+	chained.wait();
+	assert (chained.failed());
+}
+
+
+void ActiveMethodTest::testExecutor()
+{
+	ThreadPool pool(2, 4);
+	ThreadPoolExecutor executor(pool);
+	PooledObject obj(executor);
+
+	ActiveResult<int> result = obj.square(7);
+	result.wait();
+	assert (result.data() == 49);
+
+	ActiveResult<int> failed = obj.square(-1);
+	failed.wait();
+	assert (failed.failed());
+	pool.joinAll();
+}
+
+
+void ActiveMethodTest::testThenExecutor()
+{
+	WorkStealingThreadPool pool(2);
+	WorkStealingExecutor executor(pool);
+	PooledObject obj(executor);
+
+	ActiveResult<int> result = obj.square(3)
+		.then(&obj, &PooledObject::addOne, &executor)
+		.then(&twice, &executor)
+		.then(&obj, &PooledObject::addOne);
+	result.wait();
+	assert (result.data() == 21);
+
+	ActiveResult<std::string> description = obj.square(-1).then(&obj, &PooledObject::describe, &executor);
+	description.wait();
+	assert (description.data() == "negative");
+	pool.joinAll();
+}
+
+
+void ActiveMethodTest::testWhenAll()
+{
+	ActiveObject activeObj;
+	std::vector<ActiveResult<int> > results;
+	results.push_back(activeObj.testMethod(1));
+	results.push_back(activeObj.testMethod(2));
+	results.push_back(activeObj.testMethod(100));
+	ActiveResult<void> all = Poco::whenAll(results);
+	assert (!all.available());
+	activeObj.cont();
+	assert (!all.tryWait(100));
+	activeObj.cont();
+	all.wait();
+	assert (!all.failed());
+	assert (results[0].available() && results[1].available() && results[2].available());
+	assert (results[2].failed());
+
+	ActiveResult<void> none = Poco::whenAll(std::vector<ActiveResult<int> >());
+	assert (none.available());
+}
+
+
+void ActiveMethodTest::testWhenAny()
+{
+	ActiveObject activeObj;
+	std::vector<ActiveResult<int> > results;
+	results.push_back(activeObj.testMethod(1));
+	results.push_back(activeObj.testMethod(2));
+	ActiveResult<std::size_t> any = Poco::whenAny(results);
+	assert (!any.available());
+	activeObj.cont();
+	any.wait();
+	std::size_t first = any.data();
+	assert (first < 2);
+	assert (results[first].available());
+	activeObj.cont();
+	results[1 - first].wait();
+	assert (any.data() == first);
+
+	try
+	{
+		Poco::whenAny(std::vector<ActiveResult<int> >());
+		fail("empty - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
 void ActiveMethodTest::setUp()
 {
 }
@@ -258,6 +434,12 @@ CppUnit::Test* ActiveMethodTest::suite()
 	CppUnit_addTest(pSuite, ActiveMethodTest, testVoidOut);
 	CppUnit_addTest(pSuite, ActiveMethodTest, testVoidIn);
 	CppUnit_addTest(pSuite, ActiveMethodTest, testVoidInOut);
+	CppUnit_addTest(pSuite, ActiveMethodTest, testThen);
+	CppUnit_addTest(pSuite, ActiveMethodTest, testThenFailure);
+	CppUnit_addTest(pSuite, ActiveMethodTest, testExecutor);
+	CppUnit_addTest(pSuite, ActiveMethodTest, testThenExecutor);
+	CppUnit_addTest(pSuite, ActiveMethodTest, testWhenAll);
+	CppUnit_addTest(pSuite, ActiveMethodTest, testWhenAny);
 
 	return pSuite;
 }
@@ -34,6 +34,12 @@ public:
 	void testVoidOut();
 	void testVoidInOut();
 	void testVoidIn();
+	void testThen();
+	void testThenFailure();
+	void testExecutor();
+	void testThenExecutor();
+	void testWhenAll();
+	void testWhenAny();
 
 	void setUp();
 	void tearDown();
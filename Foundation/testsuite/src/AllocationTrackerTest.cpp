@@ -0,0 +1,158 @@
+//
+// AllocationTrackerTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "AllocationTrackerTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/AllocationTracker.h"
+#include "Poco/MemoryPool.h"
+#include <sstream>
+
+
+using Poco::AllocationTracker;
+using Poco::AllocationScope;
+
+
+AllocationTrackerTest::AllocationTrackerTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+AllocationTrackerTest::~AllocationTrackerTest()
+{
+}
+
+
+void AllocationTrackerTest::testScope()
+{
+	assert (AllocationTracker::current() == AllocationTracker::COMPONENT_OTHER);
+	{
+		AllocationScope scope(AllocationTracker::COMPONENT_JSON);
+		{
+			AllocationScope innerScope(AllocationTracker::COMPONENT_LOGGING);
+			if (AllocationTracker::enabled())
+				assert (AllocationTracker::current() == AllocationTracker::COMPONENT_LOGGING);
+		}
+		if (AllocationTracker::enabled())
+			assert (AllocationTracker::current() == AllocationTracker::COMPONENT_JSON);
+	}
+	assert (AllocationTracker::current() == AllocationTracker::COMPONENT_OTHER);
+}
+
+
+void AllocationTrackerTest::testHeap()
+{
+	AllocationTracker::Statistics before;
+	AllocationTracker::statistics(AllocationTracker::COMPONENT_XML, before);
+
+	std::string* pStr;
+	{
+		AllocationScope scope(AllocationTracker::COMPONENT_XML);
+		pStr = new std::string(1000, 'x');
+	}
+	assert (pStr->size() == 1000);
+
+	AllocationTracker::Statistics after;
+	AllocationTracker::statistics(AllocationTracker::COMPONENT_XML, after);
+	if (AllocationTracker::enabled())
+	{
+		assert (after.allocations >= before.allocations + 1);
+		assert (after.bytesAllocated >= before.bytesAllocated + 1000);
+	}
+	else
+	{
+		assert (after.allocations == 0);
+		assert (after.bytesAllocated == 0);
+	}
+
+	// freeing outside of the scope is still counted for XML
+	delete pStr;
+	AllocationTracker::statistics(AllocationTracker::COMPONENT_XML, after);
+	if (AllocationTracker::enabled())
+	{
+		assert (after.deallocations >= before.deallocations + 1);
+		assert (after.bytesDeallocated >= before.bytesDeallocated + 1000);
+	}
+	else
+	{
+		assert (after.deallocations == 0);
+		assert (after.bytesDeallocated == 0);
+	}
+}
+
+
+void AllocationTrackerTest::testPool()
+{
+	Poco::MemoryPool pool(64);
+	AllocationTracker::Statistics before;
+	AllocationTracker::statistics(AllocationTracker::COMPONENT_DATA, before);
+	{
+		AllocationScope scope(AllocationTracker::COMPONENT_DATA);
+		void* p1 = pool.get();
+		void* p2 = pool.get();
+		pool.release(p1);
+		pool.release(p2);
+	}
+	AllocationTracker::Statistics after;
+	AllocationTracker::statistics(AllocationTracker::COMPONENT_DATA, after);
+	if (AllocationTracker::enabled())
+	{
+		assert (after.poolAllocations == before.poolAllocations + 2);
+		assert (after.poolDeallocations == before.poolDeallocations + 2);
+		assert (after.poolBytes == before.poolBytes + 128);
+		assert (after.poolBytesDeallocated == before.poolBytesDeallocated + 128);
+	}
+	else
+	{
+		assert (after.poolAllocations == 0);
+		assert (after.poolDeallocations == 0);
+		assert (after.poolBytes == 0);
+		assert (after.poolBytesDeallocated == 0);
+	}
+}
+
+
+void AllocationTrackerTest::testReport()
+{
+	assert (std::string(AllocationTracker::name(AllocationTracker::COMPONENT_NET)) == "Net");
+	assert (std::string(AllocationTracker::name(AllocationTracker::COMPONENT_LOGGING)) == "Logging");
+
+	std::ostringstream ostr;
+	AllocationTracker::report(ostr);
+	std::string report = ostr.str();
+	assert (report.find("Other: allocations=") == 0);
+	assert (report.find("\nJSON: allocations=") != std::string::npos);
+	assert (report.find("\nLogging: allocations=") != std::string::npos);
+}
+
+
+void AllocationTrackerTest::setUp()
+{
+}
+
+
+void AllocationTrackerTest::tearDown()
+{
+}
+
+
+CppUnit::Test* AllocationTrackerTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("AllocationTrackerTest");
+
+	CppUnit_addTest(pSuite, AllocationTrackerTest, testScope);
+	CppUnit_addTest(pSuite, AllocationTrackerTest, testHeap);
+	CppUnit_addTest(pSuite, AllocationTrackerTest, testPool);
+	CppUnit_addTest(pSuite, AllocationTrackerTest, testReport);
+
+	return pSuite;
+}
@@ -0,0 +1,43 @@
+//
+// AllocationTrackerTest.h
+//
+// $Id$
+//
+// Definition of the AllocationTrackerTest class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef AllocationTrackerTest_INCLUDED
+#define AllocationTrackerTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+
+
+class AllocationTrackerTest: public CppUnit::TestCase
+{
+public:
+	AllocationTrackerTest(const std::string& name);
+	~AllocationTrackerTest();
+
+	void testScope();
+	void testHeap();
+	void testPool();
+	void testReport();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // AllocationTrackerTest_INCLUDED
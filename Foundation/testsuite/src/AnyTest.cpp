@@ -272,6 +272,43 @@ void AnyTest::testVector()
 }
 
 
+void AnyTest::testAssignOwnContent()
+{
+	Any a = std::string("hello");
+	a = RefAnyCast<std::string>(a);
+	assert (AnyCast<std::string>(a) == "hello");
+
+	std::vector<int> vec;
+	vec.push_back(42);
+	Any b = vec;
+	b = RefAnyCast<std::vector<int> >(b)[0];
+	assert (b.type() == typeid(int));
+	assert (AnyCast<int>(b) == 42);
+
+	b = b;
+	assert (AnyCast<int>(b) == 42);
+}
+
+
+void AnyTest::testSwapMixed()
+{
+	std::vector<int> vec(100, 7);
+	Any small = 42;
+	Any large = vec;
+	small.swap(large);
+	assert (AnyCast<std::vector<int> >(small).size() == 100);
+	assert (AnyCast<int>(large) == 42);
+	large.swap(small);
+	assert (AnyCast<int>(small) == 42);
+	assert (AnyCast<std::vector<int> >(large).size() == 100);
+
+	Any empty;
+	empty.swap(small);
+	assert (small.empty());
+	assert (AnyCast<int>(empty) == 42);
+}
+
+
 void AnyTest::setUp()
 {
 }
@@ -298,6 +335,8 @@ CppUnit::Test* AnyTest::suite()
 	CppUnit_addTest(pSuite, AnyTest, testInt);
 	CppUnit_addTest(pSuite, AnyTest, testComplexType);
 	CppUnit_addTest(pSuite, AnyTest, testVector);
+	CppUnit_addTest(pSuite, AnyTest, testAssignOwnContent);
+	CppUnit_addTest(pSuite, AnyTest, testSwapMixed);
 
 	return pSuite;
 }
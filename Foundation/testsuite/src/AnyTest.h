@@ -38,6 +38,8 @@ public:
 	void testInt();
 	void testComplexType();
 	void testVector();
+	void testAssignOwnContent();
+	void testSwapMixed();
 	
 	void setUp();
 	void tearDown();
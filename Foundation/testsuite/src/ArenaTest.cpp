@@ -0,0 +1,204 @@
+//
+// ArenaTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "ArenaTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Arena.h"
+#include <vector>
+#include <list>
+#include <map>
+#include <cstring>
+
+
+using Poco::Arena;
+using Poco::ArenaAllocator;
+
+
+ArenaTest::ArenaTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+ArenaTest::~ArenaTest()
+{
+}
+
+
+void ArenaTest::testAllocate()
+{
+	Arena arena(1024);
+	assert (arena.chunkSize() == 1024);
+	assert (arena.capacity() == 0);
+	assert (arena.used() == 0);
+
+	char* p1 = static_cast<char*>(arena.allocate(100, 1));
+	char* p2 = static_cast<char*>(arena.allocate(100, 1));
+	assert (p2 == p1 + 100);
+	assert (arena.used() == 200);
+	assert (arena.capacity() == 1024);
+
+	std::memset(p1, 'a', 100);
+	std::memset(p2, 'b', 100);
+	for (int i = 0; i < 100; ++i)
+	{
+		assert (p1[i] == 'a');
+	}
+
+	for (int i = 0; i < 20; ++i)
+	{
+		arena.allocate(100, 1);
+	}
+	assert (arena.used() >= 2200);
+	assert (arena.capacity() >= 3*1024);
+}
+
+
+void ArenaTest::testAlignment()
+{
+	Arena arena;
+	for (std::size_t alignment = 1; alignment <= 64; alignment *= 2)
+	{
+		arena.allocate(1, 1);
+		void* p = arena.allocate(8, alignment);
+		assert (reinterpret_cast<std::size_t>(p) % alignment == 0);
+	}
+	assert (ArenaAllocator<char>::alignment() == 1);
+	assert (ArenaAllocator<double>::alignment() == 8);
+	assert (ArenaAllocator<char[3]>::alignment() == 1);
+	assert (ArenaAllocator<char[64]>::alignment() == Arena::DEFAULT_ALIGNMENT);
+}
+
+
+void ArenaTest::testLargeBlock()
+{
+	Arena arena(1024);
+	char* p1 = static_cast<char*>(arena.allocate(16));
+	char* p2 = static_cast<char*>(arena.allocate(10000));
+	std::memset(p2, 0, 10000);
+	char* p3 = static_cast<char*>(arena.allocate(16));
+	// the large block must not end the current chunk
+	assert (p3 == p1 + 16);
+	assert (arena.capacity() > 10000);
+}
+
+
+void ArenaTest::testReset()
+{
+	Arena arena(1024);
+	void* p1 = arena.allocate(100);
+	for (int i = 0; i < 50; ++i)
+	{
+		arena.allocate(100);
+	}
+	assert (arena.capacity() > 1024);
+
+	arena.reset();
+	assert (arena.used() == 0);
+	assert (arena.capacity() == 1024);
+	void* p2 = arena.allocate(100);
+	assert (p1 == p2);
+
+	arena.release();
+	assert (arena.used() == 0);
+	assert (arena.capacity() == 0);
+	arena.allocate(100);
+	assert (arena.capacity() == 1024);
+}
+
+
+void ArenaTest::testBuffer()
+{
+	char buffer[256];
+	Arena arena(buffer, sizeof(buffer), 1024);
+	char* p1 = static_cast<char*>(arena.allocate(100, 1));
+	assert (p1 == buffer);
+	assert (arena.capacity() == 0);
+	arena.allocate(100, 1);
+	char* p3 = static_cast<char*>(arena.allocate(100, 1));
+	assert (p3 < buffer || p3 >= buffer + sizeof(buffer));
+	assert (arena.capacity() == 1024);
+
+	arena.reset();
+	assert (arena.capacity() == 0);
+	assert (arena.allocate(10, 1) == buffer);
+}
+
+
+void ArenaTest::testAllocator()
+{
+	Arena arena;
+	{
+		std::vector<int, ArenaAllocator<int> > vec(arena);
+		for (int i = 0; i < 1000; ++i) vec.push_back(i);
+		for (int i = 0; i < 1000; ++i)
+		{
+			assert (vec[i] == i);
+		}
+		assert (vec.get_allocator().arena() == &arena);
+	}
+	std::size_t used = arena.used();
+	assert (used >= 1000*sizeof(int));
+
+	{
+		typedef std::map<int, std::string, std::less<int>, ArenaAllocator<std::pair<const int, std::string> > > Map;
+		Map map(std::less<int>(), arena);
+		map[1] = "one";
+		map[2] = "two";
+		map[3] = "three";
+		assert (map.size() == 3);
+		assert (map[2] == "two");
+		map.erase(2);
+		assert (map.size() == 2);
+
+		std::list<int, ArenaAllocator<int> > list(arena);
+		list.push_back(1);
+		list.push_back(2);
+		assert (list.size() == 2);
+	}
+	assert (arena.used() > used);
+
+	// default constructed allocators use the heap
+	std::vector<int, ArenaAllocator<int> > heapVec;
+	heapVec.push_back(42);
+	assert (heapVec.get_allocator().arena() == 0);
+	assert (heapVec.get_allocator() != ArenaAllocator<int>(arena));
+	assert (ArenaAllocator<char>(arena) == ArenaAllocator<int>(arena));
+
+	arena.reset();
+	assert (arena.used() == 0);
+}
+
+
+void ArenaTest::setUp()
+{
+}
+
+
+void ArenaTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ArenaTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ArenaTest");
+
+	CppUnit_addTest(pSuite, ArenaTest, testAllocate);
+	CppUnit_addTest(pSuite, ArenaTest, testAlignment);
+	CppUnit_addTest(pSuite, ArenaTest, testLargeBlock);
+	CppUnit_addTest(pSuite, ArenaTest, testReset);
+	CppUnit_addTest(pSuite, ArenaTest, testBuffer);
+	CppUnit_addTest(pSuite, ArenaTest, testAllocator);
+
+	return pSuite;
+}
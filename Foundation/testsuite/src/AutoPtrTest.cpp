@@ -18,6 +18,7 @@
 
 
 using Poco::AutoPtr;
+using Poco::makeAuto;
 using Poco::NullPointerException;
 
 
@@ -167,6 +168,19 @@ void AutoPtrTest::testOps()
 }
 
 
+void AutoPtrTest::testMakeAuto()
+{
+	AutoPtr<TestObj> ptr = makeAuto<TestObj>();
+	assert (ptr->rc() == 1);
+	assert (TestObj::count() == 1);
+	AutoPtr<TestObj> ptr2 = ptr;
+	assert (ptr->rc() == 2);
+	ptr = 0;
+	ptr2 = 0;
+	assert (TestObj::count() == 0);
+}
+
+
 void AutoPtrTest::setUp()
 {
 }
@@ -183,6 +197,7 @@ CppUnit::Test* AutoPtrTest::suite()
 
 	CppUnit_addTest(pSuite, AutoPtrTest, testAutoPtr);
 	CppUnit_addTest(pSuite, AutoPtrTest, testOps);
+	CppUnit_addTest(pSuite, AutoPtrTest, testMakeAuto);
 
 	return pSuite;
 }
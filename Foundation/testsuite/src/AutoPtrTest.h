@@ -28,6 +28,7 @@ public:
 
 	void testAutoPtr();
 	void testOps();
+	void testMakeAuto();
 
 	void setUp();
 	void tearDown();
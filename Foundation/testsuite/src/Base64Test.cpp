@@ -15,15 +15,44 @@
 #include "CppUnit/TestSuite.h"
 #include "Poco/Base64Encoder.h"
 #include "Poco/Base64Decoder.h"
+#include "Poco/Base64Codec.h"
 #include "Poco/Exception.h"
+#include "Poco/Random.h"
 #include <sstream>
+#include <algorithm>
 
 
 using Poco::Base64Encoder;
 using Poco::Base64Decoder;
+using Poco::Base64Codec;
 using Poco::DataFormatException;
 
 
+namespace
+{
+	std::string randomData(std::size_t length)
+	{
+		Poco::Random rnd;
+		rnd.seed(static_cast<Poco::UInt32>(length));
+		std::string data;
+		for (std::size_t i = 0; i < length; ++i)
+			data += rnd.nextChar();
+		return data;
+	}
+
+	std::string encodeByteByByte(const std::string& data, int lineLength)
+	{
+		std::ostringstream str;
+		Base64Encoder encoder(str);
+		encoder.rdbuf()->setLineLength(lineLength);
+		for (std::string::const_iterator it = data.begin(); it != data.end(); ++it)
+			encoder.put(*it);
+		encoder.close();
+		return str.str();
+	}
+}
+
+
 Base64Test::Base64Test(const std::string& name): CppUnit::TestCase(name)
 {
 }
@@ -157,6 +186,163 @@ void Base64Test::testEncodeDecode()
 }
 
 
+void Base64Test::testCodec()
+{
+	assert (Base64Codec::encode(std::string("")) == "");
+	assert (Base64Codec::encode(std::string("f")) == "Zg==");
+	assert (Base64Codec::encode(std::string("fo")) == "Zm8=");
+	assert (Base64Codec::encode(std::string("foo")) == "Zm9v");
+	assert (Base64Codec::encode(std::string("foob")) == "Zm9vYg==");
+	assert (Base64Codec::encode(std::string("fooba")) == "Zm9vYmE=");
+	assert (Base64Codec::encode(std::string("foobar")) == "Zm9vYmFy");
+
+	assert (Base64Codec::decode(std::string("")) == "");
+	assert (Base64Codec::decode(std::string("Zg==")) == "f");
+	assert (Base64Codec::decode(std::string("Zm8=")) == "fo");
+	assert (Base64Codec::decode(std::string("Zm9v")) == "foo");
+	assert (Base64Codec::decode(std::string("Zm9vYmFy")) == "foobar");
+
+	assert (Base64Codec::encodedLength(0) == 0);
+	assert (Base64Codec::encodedLength(1) == 4);
+	assert (Base64Codec::encodedLength(3) == 4);
+	assert (Base64Codec::encodedLength(4) == 8);
+	assert (Base64Codec::decodedLength(8) == 6);
+
+	const char* invalid[] = { "Zm9", "Zm9vY", "Zm#v", "Zg==Zm9v", "Z===", "Zm=v", "Zm9v\r\nYmFy" };
+	for (std::size_t i = 0; i < sizeof(invalid)/sizeof(invalid[0]); ++i)
+	{
+		try
+		{
+			Base64Codec::decode(std::string(invalid[i]));
+			fail("invalid data - must throw");
+		}
+		catch (DataFormatException&)
+		{
+		}
+	}
+}
+
+
+void Base64Test::testCodecImplementations()
+{
+	assert (Base64Codec::isSupported(Base64Codec::IMPL_SCALAR));
+	assert (Base64Codec::isSupported(Base64Codec::implementation()));
+
+	for (int impl = Base64Codec::IMPL_SCALAR; impl <= Base64Codec::implementation(); ++impl)
+	{
+		Base64Codec::Implementation im = static_cast<Base64Codec::Implementation>(impl);
+		for (std::size_t length = 0; length < 300; ++length)
+		{
+			std::string data = randomData(length);
+			std::string expected = encodeByteByByte(data, 0);
+
+			std::string encoded(Base64Codec::encodedLength(length) + 1, '\0');
+			std::size_t n = Base64Codec::encode(data.data(), length, &encoded[0], im);
+			assert (n == expected.size());
+			assert (encoded.compare(0, n, expected) == 0);
+
+			std::string decoded(Base64Codec::decodedLength(n) + 1, '\0');
+			std::size_t m = Base64Codec::decode(encoded.data(), n, &decoded[0], im);
+			assert (m == length);
+			assert (decoded.compare(0, m, data) == 0);
+
+			if (length >= 6)
+			{
+				// An invalid character anywhere must be detected.
+				std::string corrupt(encoded);
+				corrupt[(length*7) % (n - 4)] = '*';
+				try
+				{
+					Base64Codec::decode(corrupt.data(), n, &decoded[0], im);
+					fail("invalid data - must throw");
+				}
+				catch (DataFormatException&)
+				{
+				}
+			}
+		}
+	}
+}
+
+
+void Base64Test::testBlockEncoder()
+{
+	int lineLengths[] = { 0, 4, 17, 72, 76 };
+	for (std::size_t k = 0; k < sizeof(lineLengths)/sizeof(lineLengths[0]); ++k)
+	{
+		for (std::size_t length = 0; length < 2000; length += 97)
+		{
+			std::string data = randomData(length);
+			std::ostringstream str;
+			Base64Encoder encoder(str);
+			encoder.rdbuf()->setLineLength(lineLengths[k]);
+			// Mix block writes with single characters.
+			std::size_t pos = 0;
+			std::size_t chunk = 1;
+			while (pos < length)
+			{
+				std::size_t n = std::min(chunk, length - pos);
+				if (n == 1)
+					encoder.put(data[pos]);
+				else
+					encoder.write(data.data() + pos, static_cast<std::streamsize>(n));
+				pos += n;
+				chunk = chunk*3 + 1;
+			}
+			encoder.close();
+			assert (str.str() == encodeByteByByte(data, lineLengths[k]));
+		}
+	}
+}
+
+
+void Base64Test::testBlockDecoder()
+{
+	for (std::size_t length = 0; length < 20000; length += 997)
+	{
+		std::string data = randomData(length);
+		std::string encoded = encodeByteByByte(data, 76);
+		std::istringstream istr(encoded);
+		Base64Decoder decoder(istr);
+		std::string decoded;
+		if (length > 0)
+		{
+			// peek() leaves a character that read() has to pick up.
+			decoder.peek();
+		}
+		char buffer[1000];
+		std::streamsize chunk = 1;
+		while (decoder.read(buffer, chunk) || decoder.gcount() > 0)
+		{
+			decoded.append(buffer, static_cast<std::size_t>(decoder.gcount()));
+			chunk = chunk < 500 ? chunk*2 + 1 : 7;
+		}
+		assert (decoded == data);
+	}
+	{
+		std::istringstream istr("QUJD\r\nRA==\r\nRUY=\r\nRw");
+		Base64Decoder decoder(istr);
+		char buffer[16];
+		try
+		{
+			decoder.read(buffer, sizeof(buffer));
+			assert (decoder.bad());
+		}
+		catch (DataFormatException&)
+		{
+		}
+	}
+	{
+		std::istringstream istr("QUJD\r\nRA==\r\nRUY=\r\nR0hJ");
+		Base64Decoder decoder(istr);
+		char buffer[16];
+		decoder.read(buffer, sizeof(buffer));
+		assert (decoder.gcount() == 9);
+		assert (std::string(buffer, 9) == "ABCDEFGHI");
+	}
+}
+
+
 void Base64Test::setUp()
 {
 }
@@ -174,6 +360,10 @@ CppUnit::Test* Base64Test::suite()
 	CppUnit_addTest(pSuite, Base64Test, testEncoder);
 	CppUnit_addTest(pSuite, Base64Test, testDecoder);
 	CppUnit_addTest(pSuite, Base64Test, testEncodeDecode);
+	CppUnit_addTest(pSuite, Base64Test, testCodec);
+	CppUnit_addTest(pSuite, Base64Test, testCodecImplementations);
+	CppUnit_addTest(pSuite, Base64Test, testBlockEncoder);
+	CppUnit_addTest(pSuite, Base64Test, testBlockDecoder);
 
 	return pSuite;
 }
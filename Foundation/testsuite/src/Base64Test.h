@@ -29,6 +29,10 @@ public:
 	void testEncoder();
 	void testDecoder();
 	void testEncodeDecode();
+	void testCodec();
+	void testCodecImplementations();
+	void testBlockEncoder();
+	void testBlockDecoder();
 
 	void setUp();
 	void tearDown();
@@ -18,6 +18,7 @@
 #include "Poco/Delegate.h"
 #include "Poco/FunctionDelegate.h"
 #include "Poco/Thread.h"
+#include "Poco/RunnableAdapter.h"
 #include "Poco/Exception.h"
 
 
@@ -317,6 +318,69 @@ void BasicEventTest::testAsyncNotify()
 	assert (_count == LARGEINC);
 }
 
+void BasicEventTest::testModifyDuringNotify()
+{
+	// A delegate removing itself and registering another one
+	// affects the next notification only.
+	int tmp = 0;
+	Simple += delegate(this, &BasicEventTest::onRemoveSelf);
+	Simple += delegate(this, &BasicEventTest::onSimple);
+	Simple.notify(this, tmp);
+	assert (_count == 2);
+	Simple.notify(this, tmp);
+	assert (_count == 4);
+	Simple.clear();
+	assert (Simple.empty());
+	Simple.notify(this, tmp);
+	assert (_count == 4);
+}
+
+
+void BasicEventTest::testConcurrentNotify()
+{
+	_concurrentEvent += delegate(this, &BasicEventTest::onConcurrent);
+
+	Poco::RunnableAdapter<BasicEventTest> ra(*this, &BasicEventTest::notifyLoop);
+	Poco::Thread t1;
+	Poco::Thread t2;
+	t1.start(ra);
+	t2.start(ra);
+	for (int i = 0; i < 1000; ++i)
+	{
+		_concurrentEvent += delegate(&BasicEventTest::onStaticSimple3);
+		_concurrentEvent -= delegate(&BasicEventTest::onStaticSimple3);
+	}
+	t1.join();
+	t2.join();
+	assert (_concurrentCount.value() == 20000);
+	_concurrentEvent.clear();
+}
+
+
+void BasicEventTest::notifyLoop()
+{
+	int tmp = 0;
+	for (int i = 0; i < 10000; ++i)
+	{
+		_concurrentEvent.notify(this, tmp);
+	}
+}
+
+
+void BasicEventTest::onRemoveSelf(const void* pSender, int& i)
+{
+	Simple -= delegate(this, &BasicEventTest::onRemoveSelf);
+	Simple += delegate(this, &BasicEventTest::onSimple);
+	_count++;
+}
+
+
+void BasicEventTest::onConcurrent(const void* pSender, int& i)
+{
+	++_concurrentCount;
+}
+
+
 void BasicEventTest::onStaticVoid(const void* pSender)
 {
 	BasicEventTest* p = const_cast<BasicEventTest*>(reinterpret_cast<const BasicEventTest*>(pSender));
@@ -436,5 +500,7 @@ CppUnit::Test* BasicEventTest::suite()
 	CppUnit_addTest(pSuite, BasicEventTest, testOverwriteDelegate);
 	CppUnit_addTest(pSuite, BasicEventTest, testAsyncNotify);
 	CppUnit_addTest(pSuite, BasicEventTest, testNullMutex);
+	CppUnit_addTest(pSuite, BasicEventTest, testModifyDuringNotify);
+	CppUnit_addTest(pSuite, BasicEventTest, testConcurrentNotify);
 	return pSuite;
 }
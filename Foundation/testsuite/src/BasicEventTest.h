@@ -18,6 +18,7 @@
 
 #include "Poco/Foundation.h"
 #include "CppUnit/TestCase.h"
+#include "Poco/AtomicCounter.h"
 #include "Poco/BasicEvent.h"
 #include "Poco/EventArgs.h"
 
@@ -46,6 +47,8 @@ public:
 	void testOverwriteDelegate();
 	void testAsyncNotify();
 	void testNullMutex();
+	void testModifyDuringNotify();
+	void testConcurrentNotify();
 	
 	void setUp();
 	void tearDown();
@@ -70,10 +73,15 @@ protected:
 	void onConstComplex(const void* pSender, const Poco::EventArgs*& i);
 	void onConst2Complex(const void* pSender, const Poco::EventArgs * const & i);
 	void onAsync(const void* pSender, int& i);
+	void onRemoveSelf(const void* pSender, int& i);
+	void onConcurrent(const void* pSender, int& i);
+	void notifyLoop();
 
 	int getCount() const;
 private:
 	int		_count;
+	Poco::AtomicCounter _concurrentCount;
+	Poco::BasicEvent<int> _concurrentEvent;
 };
 
 
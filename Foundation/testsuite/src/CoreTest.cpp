@@ -336,6 +336,11 @@ void CoreTest::testAtomicCounter()
 	
 	AtomicCounter ac2(2);
 	assert (ac2.value() == 2);
+
+	assert (!ac2.compareAndSet(1, 3));
+	assert (ac2.value() == 2);
+	assert (ac2.compareAndSet(2, 3));
+	assert (ac2.value() == 3);
 	
 	ACTRunnable act(ac);
 	Thread t1;
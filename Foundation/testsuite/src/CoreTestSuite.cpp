@@ -28,6 +28,7 @@
 #include "NumberParserTest.h"
 #include "DynamicFactoryTest.h"
 #include "MemoryPoolTest.h"
+#include "ArenaTest.h"
 #include "AnyTest.h"
 #include "VarTest.h"
 #include "FormatTest.h"
@@ -37,6 +38,8 @@
 #endif
 #include "TypeListTest.h"
 #include "ObjectPoolTest.h"
+#include "StringPoolTest.h"
+#include "AllocationTrackerTest.h"
 #include "ListMapTest.h"
 
 
@@ -61,6 +64,7 @@ CppUnit::Test* CoreTestSuite::suite()
 	pSuite->addTest(NumberParserTest::suite());
 	pSuite->addTest(DynamicFactoryTest::suite());
 	pSuite->addTest(MemoryPoolTest::suite());
+	pSuite->addTest(ArenaTest::suite());
 	pSuite->addTest(AnyTest::suite());
 	pSuite->addTest(VarTest::suite());
 	pSuite->addTest(FormatTest::suite());
@@ -70,6 +74,8 @@ CppUnit::Test* CoreTestSuite::suite()
 #endif
 	pSuite->addTest(TypeListTest::suite());
 	pSuite->addTest(ObjectPoolTest::suite());
+	pSuite->addTest(StringPoolTest::suite());
+	pSuite->addTest(AllocationTrackerTest::suite());
 	pSuite->addTest(ListMapTest::suite());
 
 	return pSuite;
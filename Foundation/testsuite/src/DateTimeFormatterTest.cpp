@@ -17,6 +17,7 @@
 #include "Poco/DateTimeFormat.h"
 #include "Poco/DateTime.h"
 #include "Poco/Timespan.h"
+#include "Poco/Random.h"
 
 
 using Poco::DateTime;
@@ -200,6 +201,34 @@ void DateTimeFormatterTest::testTimespan()
 }
 
 
+void DateTimeFormatterTest::testFixedFormats()
+{
+	// HTTP_FORMAT and ISO8601_FORMAT have their own code; compare it
+	// with the generic one, which the appended " " makes use.
+	static const std::string* formats[] =
+	{
+		&DateTimeFormat::HTTP_FORMAT,
+		&DateTimeFormat::ISO8601_FORMAT,
+		&DateTimeFormat::ISO8601_FRAC_FORMAT
+	};
+	static const int tzds[] = {DateTimeFormatter::UTC, 0, 3600, -5*3600 - 1800};
+
+	Poco::Random rnd;
+	rnd.seed(9);
+	for (int i = 0; i < 1000; ++i)
+	{
+		int year = i < 10 ? i*1111 : 1900 + rnd.next(200);
+		DateTime dt(year, 1 + rnd.next(12), 1 + rnd.next(28), rnd.next(24), rnd.next(60), rnd.next(60), rnd.next(1000), rnd.next(1000));
+		for (int f = 0; f < 3; ++f)
+		{
+			int tzd = tzds[i % 4];
+			std::string str = DateTimeFormatter::format(dt, *formats[f], tzd);
+			assert (str + " " == DateTimeFormatter::format(dt, *formats[f] + " ", tzd));
+		}
+	}
+}
+
+
 void DateTimeFormatterTest::setUp()
 {
 }
@@ -225,6 +254,7 @@ CppUnit::Test* DateTimeFormatterTest::suite()
 	CppUnit_addTest(pSuite, DateTimeFormatterTest, testSORTABLE);
 	CppUnit_addTest(pSuite, DateTimeFormatterTest, testCustom);
 	CppUnit_addTest(pSuite, DateTimeFormatterTest, testTimespan);
+	CppUnit_addTest(pSuite, DateTimeFormatterTest, testFixedFormats);
 
 	return pSuite;
 }
@@ -37,6 +37,7 @@ public:
 	void testSORTABLE();
 	void testCustom();
 	void testTimespan();
+	void testFixedFormats();
 	
 	void setUp();
 	void tearDown();
@@ -18,11 +18,14 @@
 #include "Poco/DateTime.h"
 #include "Poco/Timestamp.h"
 #include "Poco/Exception.h"
+#include "Poco/DateTimeFormatter.h"
+#include "Poco/Random.h"
 
 
 using Poco::DateTime;
 using Poco::DateTimeFormat;
 using Poco::DateTimeParser;
+using Poco::DateTimeFormatter;
 using Poco::Timestamp;
 using Poco::SyntaxException;
 
@@ -760,6 +763,81 @@ void DateTimeParserTest::testParseDayOfWeek()
 }
 
 
+void DateTimeParserTest::testFixedFormats()
+{
+	// HTTP_FORMAT and ISO8601_FORMAT have their own code; compare it
+	// with the generic one, which the appended " " makes use.
+	static const char* strings[] =
+	{
+		"Sun, 06 Nov 1994 08:49:37 GMT",
+		"sun, 06 nov 1994 08:49:37 GMT",
+		"Sun, 06 Nov 1994 08:49:37 UTC",
+		"Sun, 6 Nov 1994 08:49:37 GMT",
+		"Sun, 06 Nov 1994 08:49:37 +0100",
+		"Sun, 31 Feb 1994 08:49:37 GMT",
+		"123, 06 Nov 1994 08:49:37 GMT",
+		"2005-01-08T12:30:00Z",
+		"2005-01-08T12:30:00",
+		"2005-01-08T12:30:00+01:00",
+		"2005-01-08T12:30:00-05:30",
+		"2005-01-08T12:30:00+0100",
+		"2005-01-08T12:30:00.1Z",
+		"2005-01-08T12:30:00.123456789+01:00",
+		"2005-01-08T12:30:00,5Z",
+		"2005-01-08T12:30:00.Z",
+		"2005-01-08T12:30:60Z",
+		"2005-01-08 12:30:00Z",
+		"2005-1-08T12:30:00Z",
+		"0000-01-01T00:00:00Z"
+	};
+	static const std::string* formats[] =
+	{
+		&DateTimeFormat::HTTP_FORMAT,
+		&DateTimeFormat::ISO8601_FORMAT,
+		&DateTimeFormat::ISO8601_FRAC_FORMAT
+	};
+	for (std::size_t i = 0; i < sizeof(strings)/sizeof(strings[0]); ++i)
+	{
+		for (int f = 0; f < 3; ++f)
+		{
+			DateTime dt1;
+			DateTime dt2;
+			int tzd1 = 1;
+			int tzd2 = 1;
+			bool ok1 = DateTimeParser::tryParse(*formats[f], strings[i], dt1, tzd1);
+			bool ok2 = DateTimeParser::tryParse(*formats[f] + " ", strings[i], dt2, tzd2);
+			assert (ok1 == ok2);
+			if (ok1)
+			{
+				assert (dt1 == dt2);
+				assert (tzd1 == tzd2);
+			}
+		}
+	}
+
+	Poco::Random rnd;
+	rnd.seed(13);
+	for (int i = 0; i < 1000; ++i)
+	{
+		DateTime dt(1900 + rnd.next(200), 1 + rnd.next(12), 1 + rnd.next(28), rnd.next(24), rnd.next(60), rnd.next(60), rnd.next(1000), rnd.next(1000));
+		int tzd = (static_cast<int>(rnd.next(49)) - 24)*1800;
+		int parsedTzd = 1;
+
+		std::string str = DateTimeFormatter::format(dt, DateTimeFormat::HTTP_FORMAT);
+		DateTime parsed = DateTimeParser::parse(DateTimeFormat::HTTP_FORMAT, str, parsedTzd);
+		assert (parsed == DateTime(dt.year(), dt.month(), dt.day(), dt.hour(), dt.minute(), dt.second()));
+		assert (parsedTzd == 0);
+		assert (DateTimeParser::parse(str, parsedTzd) == parsed);
+
+		str = DateTimeFormatter::format(dt, DateTimeFormat::ISO8601_FRAC_FORMAT, tzd);
+		parsed = DateTimeParser::parse(DateTimeFormat::ISO8601_FRAC_FORMAT, str, parsedTzd);
+		assert (parsed == dt);
+		assert (parsedTzd == tzd);
+		assert (DateTimeParser::parse(str, parsedTzd) == dt);
+	}
+}
+
+
 void DateTimeParserTest::setUp()
 {
 }
@@ -787,6 +865,7 @@ CppUnit::Test* DateTimeParserTest::suite()
 	CppUnit_addTest(pSuite, DateTimeParserTest, testGuess);
 	CppUnit_addTest(pSuite, DateTimeParserTest, testParseMonth);
 	CppUnit_addTest(pSuite, DateTimeParserTest, testParseDayOfWeek);
+	CppUnit_addTest(pSuite, DateTimeParserTest, testFixedFormats);
 
 	return pSuite;
 }
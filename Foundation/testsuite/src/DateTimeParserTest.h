@@ -39,6 +39,7 @@ public:
 	void testGuess();
 	void testParseMonth();
 	void testParseDayOfWeek();
+	void testFixedFormats();
 
 	void setUp();
 	void tearDown();
@@ -671,6 +671,97 @@ void FIFOBufferTest::testInt()
 	assert (f.isEmpty());
 }
 
+void FIFOBufferTest::testRing()
+{
+	FIFOBuffer f(8, false, FIFOBuffer::MODE_RING);
+	assert (f.mode() == FIFOBuffer::MODE_RING);
+	assert (f.write("abcdef", 6) == 6);
+
+	char buffer[8];
+	assert (f.read(buffer, 4) == 4);
+	assert (std::string(buffer, 4) == "abcd");
+	assert (f.used() == 2);
+	assert (f.buffer().begin()[0] == 'a');
+
+	// wraps around the end, data is not moved
+	assert (f.write("ghijklmn", 8) == 6);
+	assert (f.isFull());
+	assert (f.buffer().begin()[0] == 'i');
+	assert (f[0] == 'e');
+	assert (f[7] == 'l');
+
+	assert (f.peek(buffer, 8) == 8);
+	assert (std::string(buffer, 8) == "efghijkl");
+
+	f.drain(3);
+	assert (f.used() == 5);
+	assert (f.read(buffer, 8) == 5);
+	assert (std::string(buffer, 5) == "hijkl");
+	assert (f.isEmpty());
+
+	f.write("12345678", 8);
+	f.drain(6);
+	f.copy("90ab", 4);
+	assert (f.used() == 6);
+	assert (f.buffer().begin()[0] == '9');
+
+	// begin() makes the data contiguous again
+	assert (std::string(f.begin(), f.used()) == "7890ab");
+	assert (f.next() == f.begin() + 6);
+
+	f.resize(16);
+	assert (f.used() == 6);
+	assert (f.peek(buffer, 8) == 6);
+	assert (std::string(buffer, 6) == "7890ab");
+}
+
+
+void FIFOBufferTest::testSegments()
+{
+	FIFOBuffer f(8, false, FIFOBuffer::MODE_RING);
+	FIFOBuffer::Segment segments[2];
+
+	assert (f.readSegments(segments) == 0);
+	assert (f.writeSegments(segments) == 1);
+	assert (segments[0].base == f.buffer().begin());
+	assert (segments[0].length == 8);
+
+	std::memcpy(segments[0].base, "abcdef", 6);
+	f.advance(6);
+	assert (f.used() == 6);
+	assert (f.readSegments(segments) == 1);
+	assert (std::string(segments[0].base, segments[0].length) == "abcdef");
+
+	f.drain(5);
+	assert (f.writeSegments(segments) == 2);
+	assert (segments[0].base == f.buffer().begin() + 6);
+	assert (segments[0].length == 2);
+	assert (segments[1].base == f.buffer().begin());
+	assert (segments[1].length == 5);
+
+	std::memcpy(segments[0].base, "gh", 2);
+	std::memcpy(segments[1].base, "ijk", 3);
+	f.advance(5);
+	assert (f.used() == 6);
+
+	assert (f.readSegments(segments) == 2);
+	assert (std::string(segments[0].base, segments[0].length) == "fgh");
+	assert (std::string(segments[1].base, segments[1].length) == "ijk");
+
+	f.drain(3);
+	assert (f.readSegments(segments) == 1);
+	assert (std::string(segments[0].base, segments[0].length) == "ijk");
+
+	FIFOBuffer l(8);
+	l.write("abcdef", 6);
+	l.drain(4);
+	assert (l.writeSegments(segments) == 1);
+	assert (segments[0].base == l.buffer().begin() + 2);
+	assert (segments[0].length == 6);
+	assert (std::string(l.begin(), 2) == "ef");
+}
+
+
 void FIFOBufferTest::setUp()
 {
 	_notToReadable = 0;
@@ -693,6 +784,8 @@ CppUnit::Test* FIFOBufferTest::suite()
 	CppUnit_addTest(pSuite, FIFOBufferTest, testChar);
 	CppUnit_addTest(pSuite, FIFOBufferTest, testInt);
 	CppUnit_addTest(pSuite, FIFOBufferTest, testEOFAndError);
+	CppUnit_addTest(pSuite, FIFOBufferTest, testRing);
+	CppUnit_addTest(pSuite, FIFOBufferTest, testSegments);
 
 	return pSuite;
 }
@@ -30,6 +30,8 @@ public:
 	void testChar();
 	void testInt();
 	void testEOFAndError();
+	void testRing();
+	void testSegments();
 
 	void setUp();
 	void tearDown();
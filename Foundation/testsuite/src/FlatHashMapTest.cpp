@@ -0,0 +1,375 @@
+//
+// FlatHashMapTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "FlatHashMapTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/FlatHashMap.h"
+#include "Poco/FlatHashSet.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Random.h"
+#include "Poco/Exception.h"
+#include <map>
+
+
+using Poco::FlatHashMap;
+using Poco::FlatHashSet;
+
+
+FlatHashMapTest::FlatHashMapTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+FlatHashMapTest::~FlatHashMapTest()
+{
+}
+
+
+void FlatHashMapTest::testInsert()
+{
+	const int N = 1000;
+
+	typedef FlatHashMap<int, int> IntMap;
+	IntMap hm;
+	
+	assert (hm.empty());
+	
+	for (int i = 0; i < N; ++i)
+	{
+		std::pair<IntMap::Iterator, bool> res = hm.insert(IntMap::ValueType(i, i*2));
+		assert (res.first->first == i);
+		assert (res.first->second == i*2);
+		assert (res.second);
+		IntMap::Iterator it = hm.find(i);
+		assert (it != hm.end());
+		assert (it->first == i);
+		assert (it->second == i*2);
+		assert (hm.count(i) == 1);
+		assert (hm.size() == static_cast<std::size_t>(i + 1));
+	}		
+	
+	assert (!hm.empty());
+	
+	for (int i = 0; i < N; ++i)
+	{
+		IntMap::Iterator it = hm.find(i);
+		assert (it != hm.end());
+		assert (it->first == i);
+		assert (it->second == i*2);
+	}
+	
+	for (int i = 0; i < N; ++i)
+	{
+		std::pair<IntMap::Iterator, bool> res = hm.insert(IntMap::ValueType(i, 0));
+		assert (res.first->first == i);
+		assert (res.first->second == i*2);
+		assert (!res.second);
+	}		
+}
+
+
+void FlatHashMapTest::testErase()
+{
+	const int N = 1000;
+
+	typedef FlatHashMap<int, int> IntMap;
+	IntMap hm;
+
+	for (int i = 0; i < N; ++i)
+	{
+		hm.insert(IntMap::ValueType(i, i*2));
+	}
+	assert (hm.size() == N);
+	
+	for (int i = 0; i < N; i += 2)
+	{
+		hm.erase(i);
+		IntMap::Iterator it = hm.find(i);
+		assert (it == hm.end());
+	}
+	assert (hm.size() == N/2);
+	
+	for (int i = 0; i < N; i += 2)
+	{
+		IntMap::Iterator it = hm.find(i);
+		assert (it == hm.end());
+	}
+	
+	for (int i = 1; i < N; i += 2)
+	{
+		IntMap::Iterator it = hm.find(i);
+		assert (it != hm.end());
+		assert (*it == i);
+	}
+
+	for (int i = 0; i < N; i += 2)
+	{
+		hm.insert(IntMap::ValueType(i, i*2));
+	}
+	
+	for (int i = 0; i < N; ++i)
+	{
+		IntMap::Iterator it = hm.find(i);
+		assert (it != hm.end());
+		assert (it->first == i);
+		assert (it->second == i*2);		
+	}
+}
+
+
+void FlatHashMapTest::testIterator()
+{
+	const int N = 1000;
+
+	typedef FlatHashMap<int, int> IntMap;
+	IntMap hm;
+
+	for (int i = 0; i < N; ++i)
+	{
+		hm.insert(IntMap::ValueType(i, i*2));
+	}
+	
+	std::map<int, int> values;
+	IntMap::Iterator it; // do not initialize here to test proper behavior of uninitialized iterators
+	it = hm.begin();
+	while (it != hm.end())
+	{
+		assert (values.find(it->first) == values.end());
+		values[it->first] = it->second;
+		++it;
+	}
+	
+	assert (values.size() == N);
+}
+
+
+void FlatHashMapTest::testConstIterator()
+{
+	const int N = 1000;
+
+	typedef FlatHashMap<int, int> IntMap;
+	IntMap hm;
+
+	for (int i = 0; i < N; ++i)
+	{
+		hm.insert(IntMap::ValueType(i, i*2));
+	}
+	
+	std::map<int, int> values;
+	IntMap::ConstIterator it = hm.begin();
+	while (it != hm.end())
+	{
+		assert (values.find(it->first) == values.end());
+		values[it->first] = it->second;
+		++it;
+	}
+	
+	assert (values.size() == N);
+}
+
+
+void FlatHashMapTest::testIndex()
+{
+	typedef FlatHashMap<int, int> IntMap;
+	IntMap hm;
+
+	hm[1] = 2;
+	hm[2] = 4;
+	hm[3] = 6;
+	
+	assert (hm.size() == 3);
+	assert (hm[1] == 2);
+	assert (hm[2] == 4);
+	assert (hm[3] == 6);
+	
+	try
+	{
+		const IntMap& im = hm;
+		im[4];
+		fail("no such key - must throw");
+	}
+	catch (Poco::NotFoundException&)
+	{
+	}
+}
+
+
+void FlatHashMapTest::testSet()
+{
+	const int N = 1000;
+
+	typedef FlatHashSet<int> IntSet;
+	IntSet hs;
+	assert (hs.empty());
+
+	for (int i = 0; i < N; ++i)
+	{
+		std::pair<IntSet::Iterator, bool> res = hs.insert(i);
+		assert (*res.first == i);
+		assert (res.second);
+		assert (!hs.insert(i).second);
+	}
+	assert (hs.size() == N);
+
+	for (int i = 0; i < N; i += 2)
+	{
+		hs.erase(i);
+	}
+	assert (hs.size() == N/2);
+	for (int i = 0; i < N; ++i)
+	{
+		assert (hs.count(i) == static_cast<std::size_t>(i % 2));
+	}
+
+	int n = 0;
+	for (IntSet::ConstIterator it = hs.begin(); it != hs.end(); ++it)
+	{
+		assert (*it % 2 == 1);
+		++n;
+	}
+	assert (n == N/2);
+
+	hs.clear();
+	assert (hs.empty());
+	assert (hs.begin() == hs.end());
+	assert (hs.find(1) == hs.end());
+}
+
+
+void FlatHashMapTest::testRandom()
+{
+	// Mixes insertions and erasures, so that the table has to
+	// deal with deleted slots and rebuild itself.
+	typedef FlatHashMap<int, int> IntMap;
+	IntMap hm;
+	std::map<int, int> ref;
+	Poco::Random rnd;
+	rnd.seed(42);
+
+	for (int i = 0; i < 100000; ++i)
+	{
+		int key = static_cast<int>(rnd.next(2000));
+		if (rnd.next(3) == 0)
+		{
+			hm.erase(key);
+			ref.erase(key);
+		}
+		else
+		{
+			hm[key] = i;
+			ref[key] = i;
+		}
+		assert (hm.size() == ref.size());
+	}
+
+	for (std::map<int, int>::const_iterator it = ref.begin(); it != ref.end(); ++it)
+	{
+		IntMap::ConstIterator hit = hm.find(it->first);
+		assert (hit != hm.end());
+		assert (hit->second == it->second);
+	}
+	std::size_t n = 0;
+	for (IntMap::ConstIterator it = hm.begin(); it != hm.end(); ++it)
+	{
+		assert (ref[it->first] == it->second);
+		++n;
+	}
+	assert (n == ref.size());
+}
+
+
+void FlatHashMapTest::testStringKeys()
+{
+	typedef FlatHashMap<std::string, int> StringMap;
+	StringMap hm;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		hm[Poco::NumberFormatter::format(i)] = i;
+	}
+	assert (hm.size() == 1000);
+	for (int i = 0; i < 1000; ++i)
+	{
+		std::string key = Poco::NumberFormatter::format(i);
+		assert (hm.count(key) == 1);
+		assert (hm[key] == i);
+	}
+	assert (hm.find("1000") == hm.end());
+	hm.erase("500");
+	assert (hm.find("500") == hm.end());
+
+	typedef FlatHashMap<std::string, int, Poco::Hash<std::string> > PocoHashMap;
+	PocoHashMap phm;
+	phm["one"] = 1;
+	phm["two"] = 2;
+	assert (phm["one"] == 1);
+	assert (phm["two"] == 2);
+	assert (phm.size() == 2);
+}
+
+
+void FlatHashMapTest::testCopy()
+{
+	typedef FlatHashMap<int, std::string> StringMap;
+	StringMap hm1;
+	for (int i = 0; i < 100; ++i)
+	{
+		hm1[i] = Poco::NumberFormatter::format(i);
+	}
+
+	StringMap hm2;
+	hm2 = hm1;
+	assert (hm2.size() == 100);
+	for (int i = 0; i < 100; ++i)
+	{
+		assert (hm2[i] == Poco::NumberFormatter::format(i));
+	}
+
+	hm1.clear();
+	assert (hm1.empty());
+	assert (hm2.size() == 100);
+
+	hm1.swap(hm2);
+	assert (hm1.size() == 100);
+	assert (hm2.empty());
+	hm2.reserve(1000);
+	assert (hm2.empty());
+}
+
+
+void FlatHashMapTest::setUp()
+{
+}
+
+
+void FlatHashMapTest::tearDown()
+{
+}
+
+
+CppUnit::Test* FlatHashMapTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("FlatHashMapTest");
+
+	CppUnit_addTest(pSuite, FlatHashMapTest, testInsert);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testErase);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testIterator);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testConstIterator);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testIndex);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testSet);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testRandom);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testStringKeys);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testCopy);
+
+	return pSuite;
+}
@@ -0,0 +1,48 @@
+//
+// FlatHashMapTest.h
+//
+// $Id$
+//
+// Definition of the FlatHashMapTest class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef FlatHashMapTest_INCLUDED
+#define FlatHashMapTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+
+
+class FlatHashMapTest: public CppUnit::TestCase
+{
+public:
+	FlatHashMapTest(const std::string& name);
+	~FlatHashMapTest();
+
+	void testInsert();
+	void testErase();
+	void testIterator();
+	void testConstIterator();
+	void testIndex();
+	void testSet();
+	void testRandom();
+	void testStringKeys();
+	void testCopy();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // FlatHashMapTest_INCLUDED
@@ -276,6 +276,30 @@ void LoggerTest::testDump()
 }
 
 
+void LoggerTest::testDestroy()
+{
+	Logger& logger1 = Logger::get("Logger1");
+	assert (logger1.name() == "Logger1");
+	assert (Logger::has("Logger1") == &logger1);
+	assert (Logger::has("Logger3") == 0);
+	assert (Logger::has("Logger1.Logger3") == 0);
+
+	Logger::destroy("Logger1");
+	assert (Logger::has("Logger1") == 0);
+	Logger::destroy("Logger3");
+
+	Logger& logger1b = Logger::get("Logger1");
+	assert (logger1b.name() == "Logger1");
+	assert (Logger::has("Logger1") == &logger1b);
+
+	std::vector<std::string> loggers;
+	Logger::names(loggers);
+	assert (loggers.size() == 2);
+	assert (loggers[0] == "");
+	assert (loggers[1] == "Logger1");
+}
+
+
 void LoggerTest::setUp()
 {
 	Logger::shutdown();
@@ -295,6 +319,7 @@ CppUnit::Test* LoggerTest::suite()
 	CppUnit_addTest(pSuite, LoggerTest, testFormat);
 	CppUnit_addTest(pSuite, LoggerTest, testFormatAny);
 	CppUnit_addTest(pSuite, LoggerTest, testDump);
+	CppUnit_addTest(pSuite, LoggerTest, testDestroy);
 
 	return pSuite;
 }
@@ -30,6 +30,7 @@ public:
 	void testFormat();
 	void testFormatAny();
 	void testDump();
+	void testDestroy();
 
 	void setUp();
 	void tearDown();
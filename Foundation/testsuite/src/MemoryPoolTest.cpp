@@ -14,10 +14,77 @@
 #include "CppUnit/TestCaller.h"
 #include "CppUnit/TestSuite.h"
 #include "Poco/MemoryPool.h"
+#include "Poco/ThreadCachingMemoryPool.h"
+#include "Poco/Runnable.h"
+#include "Poco/Thread.h"
 #include <vector>
+#include <cstring>
+#if defined(POCO_OS_FAMILY_UNIX)
+#include <pthread.h>
+#endif
 
 
 using Poco::MemoryPool;
+using Poco::ThreadCachingMemoryPool;
+using Poco::Thread;
+
+
+namespace
+{
+	class PoolUser: public Poco::Runnable
+	{
+	public:
+		PoolUser(ThreadCachingMemoryPool& pool, int rounds, int blocks):
+			_pool(pool),
+			_rounds(rounds),
+			_blocks(blocks),
+			_ok(true)
+		{
+		}
+
+		void run()
+		{
+			std::vector<char*> ptrs;
+			for (int r = 0; r < _rounds; ++r)
+			{
+				for (int i = 0; i < _blocks; ++i)
+				{
+					char* p = reinterpret_cast<char*>(_pool.get());
+					std::memset(p, i & 0xFF, _pool.blockSize());
+					ptrs.push_back(p);
+				}
+				for (int i = 0; i < _blocks; ++i)
+				{
+					for (std::size_t k = 0; k < _pool.blockSize(); ++k)
+					{
+						if (ptrs[i][k] != static_cast<char>(i & 0xFF)) _ok = false;
+					}
+					_pool.release(ptrs[i]);
+				}
+				ptrs.clear();
+			}
+		}
+
+		bool ok() const
+		{
+			return _ok;
+		}
+
+	private:
+		ThreadCachingMemoryPool& _pool;
+		int _rounds;
+		int _blocks;
+		bool _ok;
+	};
+
+#if defined(POCO_OS_FAMILY_UNIX)
+	void* runPoolUser(void* pUser)
+	{
+		reinterpret_cast<PoolUser*>(pUser)->run();
+		return 0;
+	}
+#endif
+}
 
 
 MemoryPoolTest::MemoryPoolTest(const std::string& name): CppUnit::TestCase(name)
@@ -70,6 +137,112 @@ void MemoryPoolTest::testMemoryPool()
 }
 
 
+void MemoryPoolTest::testThreadCachingMemoryPool()
+{
+	ThreadCachingMemoryPool pool(100, 8, 2);
+	assert (pool.blockSize() == 100);
+	assert (pool.batchSize() == 8);
+	assert (pool.allocated() == 0);
+	assert (pool.available() == 0);
+
+	// The statistics of a thread's cache are complete
+	// once the Thread object has been destroyed.
+	PoolUser user1(pool, 1, 20);
+	{
+		Thread t1;
+		t1.start(user1);
+		t1.join();
+	}
+	assert (user1.ok());
+	assert (pool.outstanding() == 0);
+	assert (pool.misses() == 3);
+	assert (pool.hits() == 17);
+	assert (pool.allocated() == 16);
+	assert (pool.available() == 16);
+
+	// Batches are taken from the central free list.
+	PoolUser user2(pool, 1, 16);
+	{
+		Thread t2;
+		t2.start(user2);
+		t2.join();
+	}
+	assert (pool.misses() == 5);
+	assert (pool.allocated() == 16);
+	assert (pool.available() == 16);
+
+	void* p = pool.get();
+	assert (p != 0);
+	assert (pool.allocated() == 16);
+	assert (pool.available() == 8);
+	pool.release(p);
+}
+
+
+void MemoryPoolTest::testThreadCachingMemoryPoolThreads()
+{
+	ThreadCachingMemoryPool pool(64, 4, 4);
+	PoolUser user1(pool, 200, 10);
+	PoolUser user2(pool, 200, 10);
+	PoolUser user3(pool, 200, 10);
+	{
+		Thread t1;
+		Thread t2;
+		Thread t3;
+		t1.start(user1);
+		t2.start(user2);
+		t3.start(user3);
+		t1.join();
+		t2.join();
+		t3.join();
+	}
+	assert (user1.ok());
+	assert (user2.ok());
+	assert (user3.ok());
+	assert (pool.outstanding() == 0);
+	assert (pool.hits() + pool.misses() == 6000);
+	assert (pool.available() <= 16);
+	assert (pool.allocated() == pool.available());
+}
+
+
+void MemoryPoolTest::testThreadCachingMemoryPoolNativeThreads()
+{
+	// Threads that are not Poco threads share a cache.
+	ThreadCachingMemoryPool pool(64, 4, 4);
+	PoolUser user1(pool, 200, 10);
+	PoolUser user2(pool, 200, 10);
+	PoolUser user3(pool, 200, 10);
+#if defined(POCO_OS_FAMILY_UNIX)
+	pthread_t t1;
+	pthread_t t2;
+	pthread_t t3;
+	assert (pthread_create(&t1, 0, runPoolUser, &user1) == 0);
+	assert (pthread_create(&t2, 0, runPoolUser, &user2) == 0);
+	assert (pthread_create(&t3, 0, runPoolUser, &user3) == 0);
+	pthread_join(t1, 0);
+	pthread_join(t2, 0);
+	pthread_join(t3, 0);
+#else
+	user1.run();
+	user2.run();
+	user3.run();
+#endif
+	assert (user1.ok());
+	assert (user2.ok());
+	assert (user3.ok());
+
+	// Poco threads use their own caches at the same time.
+	PoolUser user4(pool, 200, 10);
+	Thread t4;
+	t4.start(user4);
+	user1.run();
+	t4.join();
+	assert (user1.ok());
+	assert (user4.ok());
+}
+
+
 void MemoryPoolTest::setUp()
 {
 }
@@ -85,6 +258,9 @@ CppUnit::Test* MemoryPoolTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("MemoryPoolTest");
 
 	CppUnit_addTest(pSuite, MemoryPoolTest, testMemoryPool);
+	CppUnit_addTest(pSuite, MemoryPoolTest, testThreadCachingMemoryPool);
+	CppUnit_addTest(pSuite, MemoryPoolTest, testThreadCachingMemoryPoolThreads);
+	CppUnit_addTest(pSuite, MemoryPoolTest, testThreadCachingMemoryPoolNativeThreads);
 
 	return pSuite;
 }
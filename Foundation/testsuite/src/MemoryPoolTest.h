@@ -27,6 +27,9 @@ public:
 	~MemoryPoolTest();
 
 	void testMemoryPool();
+	void testThreadCachingMemoryPool();
+	void testThreadCachingMemoryPoolThreads();
+	void testThreadCachingMemoryPoolNativeThreads();
 
 	void setUp();
 	void tearDown();
@@ -15,12 +15,22 @@
 #include "CppUnit/TestSuite.h"
 #include "Poco/Exception.h"
 #include "Poco/Mutex.h"
+#include "Poco/SpinMutex.h"
+#include "Poco/ProfilingMutex.h"
 #include "Poco/Runnable.h"
 #include "Poco/Thread.h"
 #include "Poco/Timestamp.h"
+#include "Poco/Event.h"
+#include <sstream>
+#include <vector>
 
 
 using Poco::Mutex;
+using Poco::FastMutex;
+using Poco::SpinMutex;
+using Poco::ProfilingMutex;
+using Poco::MutexProfile;
+using Poco::MutexProfileRegistry;
 using Poco::Runnable;
 using Poco::SystemException;
 using Poco::Thread;
@@ -59,6 +69,57 @@ namespace
 	private:
 		bool _ran;
 	};
+
+	template <class M>
+	class Incrementer: public Runnable
+	{
+	public:
+		Incrementer(M& mutex, int& counter, int iterations):
+			_mutex(mutex),
+			_counter(counter),
+			_iterations(iterations)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < _iterations; ++i)
+			{
+				typename M::ScopedLock lock(_mutex);
+				++_counter;
+			}
+		}
+
+	private:
+		M& _mutex;
+		int& _counter;
+		int _iterations;
+	};
+
+	class Holder: public Runnable
+	{
+	public:
+		Holder(ProfilingMutex<>& mutex):
+			_mutex(mutex)
+		{
+		}
+
+		void run()
+		{
+			ProfilingMutex<>::ScopedLock lock(_mutex, "holder");
+			_locked.set();
+			Thread::sleep(100);
+		}
+
+		void waitUntilLocked()
+		{
+			_locked.wait();
+		}
+
+	private:
+		ProfilingMutex<>& _mutex;
+		Poco::Event _locked;
+	};
 }
 
 
@@ -122,6 +183,123 @@ void MutexTest::testRecursiveMutexRecursion()
 	assert (success);
 }
 
+
+void MutexTest::testSpinMutex()
+{
+	SpinMutex mtx;
+	assert (mtx.tryLock());
+	assert (!mtx.tryLock());
+	mtx.unlock();
+
+	int counter = 0;
+	Incrementer<SpinMutex> inc1(mtx, counter, 100000);
+	Incrementer<SpinMutex> inc2(mtx, counter, 100000);
+	Incrementer<SpinMutex> inc3(mtx, counter, 100000);
+	Incrementer<SpinMutex> inc4(mtx, counter, 100000);
+	Thread t1;
+	Thread t2;
+	Thread t3;
+	Thread t4;
+	t1.start(inc1);
+	t2.start(inc2);
+	t3.start(inc3);
+	t4.start(inc4);
+	t1.join();
+	t2.join();
+	t3.join();
+	t4.join();
+	assert (counter == 400000);
+	assert (mtx.tryLock());
+	mtx.unlock();
+}
+
+
+void MutexTest::testSpinMutexTimeout()
+{
+	SpinMutex mtx;
+	mtx.lock();
+
+	Timestamp mark;
+	bool success = mtx.tryLock(500);
+	assert (!success);
+	Timestamp::TimeDiff elapsed = mark.elapsed();
+	assert (elapsed > 400000);
+	assert (elapsed < 2000000);
+
+	try
+	{
+		mtx.lock(100);
+		fail("must time out");
+	}
+	catch (Poco::TimeoutException&)
+	{
+	}
+
+	mtx.unlock();
+	assert (mtx.tryLock(100));
+	mtx.unlock();
+}
+
+
+void MutexTest::testProfilingMutex()
+{
+	ProfilingMutex<> mtx("MutexTest");
+	MutexProfile& profile = mtx.profile();
+	profile.reset();
+	assert (profile.name() == "MutexTest");
+	assert (MutexProfileRegistry::defaultRegistry().has("MutexTest"));
+
+	mtx.lock();
+	assert (!mtx.tryLock());
+	mtx.unlock();
+	assert (profile.acquisitions() == 1);
+	assert (profile.contentions() == 0);
+
+	int counter = 0;
+	Incrementer<ProfilingMutex<> > inc1(mtx, counter, 10000);
+	Incrementer<ProfilingMutex<> > inc2(mtx, counter, 10000);
+	Thread t1;
+	Thread t2;
+	t1.start(inc1);
+	t2.start(inc2);
+	t1.join();
+	t2.join();
+	assert (counter == 20000);
+	assert (profile.acquisitions() == 20001);
+
+	profile.reset();
+	Holder holder(mtx);
+	Thread t3;
+	t3.start(holder);
+	holder.waitUntilLocked();
+	{
+		ProfilingMutex<>::ScopedLock lock(mtx, POCO_LOCK_SITE);
+	}
+	t3.join();
+	assert (profile.acquisitions() == 2);
+	assert (profile.contentions() == 1);
+	assert (profile.maxWaitTime() > 10000);
+	assert (profile.totalWaitTime() == profile.maxWaitTime());
+	int waits = 0;
+	for (int i = 0; i < MutexProfile::HISTOGRAM_BUCKETS; ++i) waits += profile.histogram(i);
+	assert (waits == 1);
+
+	std::vector<MutexProfile::Site> sites;
+	profile.holderSites(sites);
+	assert (sites.size() == 1);
+	assert (std::string(sites[0].site) == "holder");
+	assert (sites[0].count == 1);
+
+	std::ostringstream ostr;
+	MutexProfileRegistry::defaultRegistry().dump(ostr);
+	assert (ostr.str().find("MutexTest: acquisitions=2 contended=1") != std::string::npos);
+	assert (ostr.str().find("held at holder: 1") != std::string::npos);
+
+	ProfilingMutex<> mtx2("MutexTest");
+	assert (&mtx2.profile() == &profile);
+}
+
+
 void MutexTest::setUp()
 {
 }
@@ -138,6 +316,9 @@ CppUnit::Test* MutexTest::suite()
 
 	CppUnit_addTest(pSuite, MutexTest, testMutexRecursion);
 	CppUnit_addTest(pSuite, MutexTest, testRecursiveMutexRecursion);
+	CppUnit_addTest(pSuite, MutexTest, testSpinMutex);
+	CppUnit_addTest(pSuite, MutexTest, testSpinMutexTimeout);
+	CppUnit_addTest(pSuite, MutexTest, testProfilingMutex);
 
 	return pSuite;
 }
@@ -28,6 +28,9 @@ public:
 
 	void testMutexRecursion();
 	void testRecursiveMutexRecursion();
+	void testSpinMutex();
+	void testSpinMutexTimeout();
+	void testProfilingMutex();
 
 	void setUp();
 	void tearDown();
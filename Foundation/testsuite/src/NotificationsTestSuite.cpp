@@ -15,6 +15,8 @@
 #include "NotificationQueueTest.h"
 #include "PriorityNotificationQueueTest.h"
 #include "TimedNotificationQueueTest.h"
+#include "BoundedNotificationQueueTest.h"
+#include "TimingWheelNotificationQueueTest.h"
 
 
 CppUnit::Test* NotificationsTestSuite::suite()
@@ -25,6 +27,8 @@ CppUnit::Test* NotificationsTestSuite::suite()
 	pSuite->addTest(NotificationQueueTest::suite());
 	pSuite->addTest(PriorityNotificationQueueTest::suite());
 	pSuite->addTest(TimedNotificationQueueTest::suite());
+	pSuite->addTest(BoundedNotificationQueueTest::suite());
+	pSuite->addTest(TimingWheelNotificationQueueTest::suite());
 
 	return pSuite;
 }
@@ -14,7 +14,11 @@
 #include "CppUnit/TestCaller.h"
 #include "CppUnit/TestSuite.h"
 #include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Exception.h"
+#include "Poco/Random.h"
 #include <sstream>
+#include <limits>
 
 using Poco::NumberFormatter;
 using Poco::Int64;
@@ -274,6 +278,76 @@ void NumberFormatterTest::testAppend()
 }
 
 
+void NumberFormatterTest::testFormatTo()
+{
+	char buffer[NumberFormatter::NF_MAX_SHORTEST_STRING_LEN];
+	assert (std::string(buffer, NumberFormatter::formatTo(buffer, sizeof(buffer), 0)) == "0");
+	assert (std::string(buffer, NumberFormatter::formatTo(buffer, sizeof(buffer), 7)) == "7");
+	assert (std::string(buffer, NumberFormatter::formatTo(buffer, sizeof(buffer), 10)) == "10");
+	assert (std::string(buffer, NumberFormatter::formatTo(buffer, sizeof(buffer), -123)) == "-123");
+	assert (std::string(buffer, NumberFormatter::formatTo(buffer, sizeof(buffer), std::numeric_limits<int>::max())) == "2147483647");
+	assert (std::string(buffer, NumberFormatter::formatTo(buffer, sizeof(buffer), std::numeric_limits<int>::min())) == "-2147483648");
+	assert (std::string(buffer, NumberFormatter::formatTo(buffer, sizeof(buffer), std::numeric_limits<unsigned>::max())) == "4294967295");
+	assert (std::string(buffer, NumberFormatter::formatTo(buffer, sizeof(buffer), -1L)) == "-1");
+	assert (std::string(buffer, NumberFormatter::formatTo(buffer, sizeof(buffer), 1000UL)) == "1000");
+
+#if defined(POCO_HAVE_INT64)
+	assert (std::string(buffer, NumberFormatter::formatTo(buffer, sizeof(buffer), std::numeric_limits<Int64>::max())) == "9223372036854775807");
+	assert (std::string(buffer, NumberFormatter::formatTo(buffer, sizeof(buffer), std::numeric_limits<Int64>::min())) == "-9223372036854775808");
+	assert (std::string(buffer, NumberFormatter::formatTo(buffer, sizeof(buffer), std::numeric_limits<UInt64>::max())) == "18446744073709551615");
+
+	Poco::Random rnd;
+	rnd.seed(5);
+	for (int i = 0; i < 10000; ++i)
+	{
+		Int64 n = static_cast<Int64>((static_cast<UInt64>(rnd.next()) << 32) | rnd.next()) >> rnd.next(64);
+		std::string s(buffer, NumberFormatter::formatTo(buffer, sizeof(buffer), n));
+		assert (Poco::NumberParser::parse64(s) == n);
+		std::ostringstream ostr;
+		ostr << n;
+		assert (s == ostr.str());
+	}
+#endif // POCO_HAVE_INT64
+
+	assert (std::string(buffer, NumberFormatter::formatTo(buffer, sizeof(buffer), 0.0)) == "0");
+	assert (std::string(buffer, NumberFormatter::formatTo(buffer, sizeof(buffer), 0.1)) == "0.1");
+	assert (std::string(buffer, NumberFormatter::formatTo(buffer, sizeof(buffer), -1.5)) == "-1.5");
+	assert (std::string(buffer, NumberFormatter::formatTo(buffer, sizeof(buffer), 1e100)) == "1e+100");
+	assert (std::string(buffer, NumberFormatter::formatTo(buffer, sizeof(buffer), 0.1f)) == "0.1");
+
+	static const double values[] =
+	{
+		1.0/3, -2.0/3, 1.2345678901234567e-15, -1.2345678901234567e-15, 123456789012345.67,
+		1.7976931348623157e308, -4.9406564584124654e-324, 2.2250738585072014e-308
+	};
+	for (std::size_t i = 0; i < sizeof(values)/sizeof(values[0]); ++i)
+	{
+		std::string s(buffer, NumberFormatter::formatTo(buffer, sizeof(buffer), values[i]));
+		assert (s == NumberFormatter::format(values[i]));
+		assert (Poco::NumberParser::parseFloat(s) == values[i]);
+	}
+
+	char small[3];
+	assert (NumberFormatter::formatTo(small, sizeof(small), 999) == 3);
+	try
+	{
+		NumberFormatter::formatTo(small, sizeof(small), 1000);
+		failmsg("must throw RangeException");
+	}
+	catch (Poco::RangeException&)
+	{
+	}
+	try
+	{
+		NumberFormatter::formatTo(small, sizeof(small), 0.25);
+		failmsg("must throw RangeException");
+	}
+	catch (Poco::RangeException&)
+	{
+	}
+}
+
+
 void NumberFormatterTest::setUp()
 {
 }
@@ -294,6 +368,7 @@ CppUnit::Test* NumberFormatterTest::suite()
 	CppUnit_addTest(pSuite, NumberFormatterTest, testFormatHex);
 	CppUnit_addTest(pSuite, NumberFormatterTest, testFormatFloat);
 	CppUnit_addTest(pSuite, NumberFormatterTest, testAppend);
+	CppUnit_addTest(pSuite, NumberFormatterTest, testFormatTo);
 
 	return pSuite;
 }
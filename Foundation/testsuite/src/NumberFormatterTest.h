@@ -32,6 +32,7 @@ public:
 	void testFormatHex();
 	void testFormatFloat();
 	void testAppend();
+	void testFormatTo();
 
 	void setUp();
 	void tearDown();
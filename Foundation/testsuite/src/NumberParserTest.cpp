@@ -19,9 +19,12 @@
 #include "Poco/NumericString.h"
 #include "Poco/MemoryStream.h"
 #include "Poco/Stopwatch.h"
+#include "Poco/Random.h"
 #include <iostream>
 #include <iomanip>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 
 using Poco::NumberParser;
@@ -42,6 +45,44 @@ using Poco::decimalSeparator;
 using Poco::thousandSeparator;
 
 
+namespace
+{
+	bool tryParseRange(const std::string& s, int& value)
+	{
+		return NumberParser::tryParse(s.data(), s.data() + s.size(), value);
+	}
+
+	bool tryParseUnsignedRange(const std::string& s, unsigned& value)
+	{
+		return NumberParser::tryParseUnsigned(s.data(), s.data() + s.size(), value);
+	}
+
+#if defined(POCO_HAVE_INT64)
+
+	bool tryParse64Range(const std::string& s, Int64& value)
+	{
+		return NumberParser::tryParse64(s.data(), s.data() + s.size(), value);
+	}
+
+	bool tryParseUnsigned64Range(const std::string& s, UInt64& value)
+	{
+		return NumberParser::tryParseUnsigned64(s.data(), s.data() + s.size(), value);
+	}
+
+#endif // POCO_HAVE_INT64
+
+	bool tryParseFloatRange(const std::string& s, double& value)
+	{
+		return NumberParser::tryParseFloat(s.data(), s.data() + s.size(), value);
+	}
+
+	bool sameDouble(double a, double b)
+	{
+		return std::memcmp(&a, &b, sizeof(double)) == 0;
+	}
+}
+
+
 NumberParserTest::NumberParserTest(const std::string& name): CppUnit::TestCase(name)
 {
 }
@@ -305,6 +346,126 @@ void NumberParserTest::testParseError()
 }
 
 
+void NumberParserTest::testParseRange()
+{
+	int i = 0;
+	assert (tryParseRange("0", i) && i == 0);
+	assert (tryParseRange("-0", i) && i == 0);
+	assert (tryParseRange("+123", i) && i == 123);
+	assert (tryParseRange("-123", i) && i == -123);
+	assert (tryParseRange("000000000000000000000000000012", i) && i == 12);
+	assert (tryParseRange("123456789", i) && i == 123456789);
+	assert (tryParseRange("2147483647", i) && i == 2147483647);
+	assert (tryParseRange("-2147483648", i) && i == std::numeric_limits<int>::min());
+	assert (!tryParseRange("2147483648", i));
+	assert (!tryParseRange("-2147483649", i));
+	assert (!tryParseRange("99999999999999999999", i));
+	assert (!tryParseRange("", i));
+	assert (!tryParseRange("-", i));
+	assert (!tryParseRange(" 1", i));
+	assert (!tryParseRange("1 ", i));
+	assert (!tryParseRange("1,000", i));
+	assert (!tryParseRange("1234567a", i));
+	assert (!tryParseRange("12345678a", i));
+	assert (!tryParseRange("0x10", i));
+
+	unsigned u = 0;
+	assert (tryParseUnsignedRange("4294967295", u) && u == 4294967295U);
+	assert (tryParseUnsignedRange("+1", u) && u == 1);
+	assert (!tryParseUnsignedRange("4294967296", u));
+	assert (!tryParseUnsignedRange("-1", u));
+
+#if defined(POCO_HAVE_INT64)
+	Int64 i64 = 0;
+	assert (tryParse64Range("9223372036854775807", i64) && i64 == std::numeric_limits<Int64>::max());
+	assert (tryParse64Range("-9223372036854775808", i64) && i64 == std::numeric_limits<Int64>::min());
+	assert (!tryParse64Range("9223372036854775808", i64));
+	assert (!tryParse64Range("-9223372036854775809", i64));
+	assert (!tryParse64Range("12345678901234567890123", i64));
+
+	UInt64 u64 = 0;
+	assert (tryParseUnsigned64Range("18446744073709551615", u64) && u64 == std::numeric_limits<UInt64>::max());
+	assert (tryParseUnsigned64Range("0018446744073709551615", u64) && u64 == std::numeric_limits<UInt64>::max());
+	assert (!tryParseUnsigned64Range("18446744073709551616", u64));
+	assert (!tryParseUnsigned64Range("19999999999999999999", u64));
+	assert (!tryParseUnsigned64Range("1844674407370955161a", u64));
+
+	Poco::Random rnd;
+	rnd.seed(17);
+	for (int k = 0; k < 10000; ++k)
+	{
+		Int64 n = (static_cast<Int64>(rnd.next()) << 32 | rnd.next()) >> rnd.next(64);
+		assert (tryParse64Range(NumberFormatter::format(n), i64) && i64 == n);
+	}
+#endif // POCO_HAVE_INT64
+
+	// The std::string overloads still accept what the range ones do not.
+	assert (NumberParser::parse(" 123") == 123);
+	assert (NumberParser::parse("1,234", ',') == 1234);
+}
+
+
+void NumberParserTest::testParseFloatRange()
+{
+	static const char* numbers[] =
+	{
+		"0", "-0", "0.0", "1", "-1", "1.5", ".5", "1.", "+3.25", "1e10", "1E-10", "1e+22", "1e23",
+		"123456789012345678901234567890", "0.1", "0.3", "3.141592653589793", "9007199254740993",
+		"9007199254740992", "2.2250738585072011e-308", "2.2250738585072014e-308",
+		"4.9406564584124654e-324", "2.4703282292062327e-324", "2.4703282292062328e-324",
+		"1.7976931348623157e308", "1.7976931348623158e308", "1e-400", "0.000000000000000000001",
+		"00000001.2500000000", "123.456e-2", "7.3177701707893310e+15", "8.98846567431158e307"
+	};
+	for (std::size_t k = 0; k < sizeof(numbers)/sizeof(numbers[0]); ++k)
+	{
+		double d = 0;
+		assert (tryParseFloatRange(numbers[k], d));
+		assert (sameDouble(d, std::strtod(numbers[k], 0)));
+	}
+
+	static const char* invalid[] =
+	{
+		"", "-", ".", "e5", "1e", "1e+", "1.2.3", " 1", "1 ", "1,5", "1x", "inf", "nan", "0x10", "1e400", "-1e400"
+	};
+	for (std::size_t k = 0; k < sizeof(invalid)/sizeof(invalid[0]); ++k)
+	{
+		double d = 0;
+		assert (!tryParseFloatRange(invalid[k], d));
+	}
+
+	// Long inputs, with more digits than double-conversion considers
+	std::string longNumber = "0." + std::string(800, '0') + "1";
+	double d = 1;
+	assert (tryParseFloatRange(longNumber, d) && d == 0);
+	longNumber = "1." + std::string(800, '0') + "1";
+	assert (tryParseFloatRange(longNumber, d) && d == 1);
+	longNumber = "9007199254740993" + std::string(800, '0') + "1e-800";
+	assert (tryParseFloatRange(longNumber, d) && sameDouble(d, std::strtod(longNumber.c_str(), 0)));
+
+	Poco::Random rnd;
+	rnd.seed(23);
+	for (int k = 0; k < 20000; ++k)
+	{
+		std::string s;
+		if (rnd.next(4) == 0) s += '-';
+		int digits = 1 + rnd.next(k % 2 ? 20 : 40);
+		int point = rnd.next(digits + 1);
+		for (int j = 0; j < digits; ++j)
+		{
+			if (j == point) s += '.';
+			s += static_cast<char>('0' + rnd.next(10));
+		}
+		if (rnd.nextBool()) s += format("e%d", static_cast<int>(rnd.next(640)) - 330);
+		double value = std::strtod(s.c_str(), 0);
+		if (value == std::numeric_limits<double>::infinity() || value == -std::numeric_limits<double>::infinity())
+			continue;
+		assert (tryParseFloatRange(s, d));
+		assert (sameDouble(d, value));
+		assert (sameDouble(NumberParser::parseFloat(s), value));
+	}
+}
+
+
 void NumberParserTest::setUp()
 {
 }
@@ -322,6 +483,8 @@ CppUnit::Test* NumberParserTest::suite()
 	CppUnit_addTest(pSuite, NumberParserTest, testParse);
 	CppUnit_addTest(pSuite, NumberParserTest, testLimits);
 	CppUnit_addTest(pSuite, NumberParserTest, testParseError);
+	CppUnit_addTest(pSuite, NumberParserTest, testParseRange);
+	CppUnit_addTest(pSuite, NumberParserTest, testParseFloatRange);
 
 	return pSuite;
 }
@@ -33,6 +33,8 @@ public:
 	void testParse();
 	void testLimits();
 	void testParseError();
+	void testParseRange();
+	void testParseFloatRange();
 
 	void setUp();
 	void tearDown();
@@ -14,10 +14,148 @@
 #include "CppUnit/TestCaller.h"
 #include "CppUnit/TestSuite.h"
 #include "Poco/ObjectPool.h"
+#include "Poco/ConcurrentObjectPool.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Event.h"
 #include "Poco/Exception.h"
+#include <vector>
 
 
 using Poco::ObjectPool;
+using Poco::ConcurrentObjectPool;
+using Poco::PoolableObjectFactory;
+using Poco::Thread;
+
+
+namespace
+{
+	class CountingFactory: public PoolableObjectFactory<int>
+	{
+	public:
+		CountingFactory(): _created(0), _valid(true)
+		{
+		}
+
+		int* createObject()
+		{
+			++_created;
+			return new int(0);
+		}
+
+		bool validateObject(int* pObject)
+		{
+			return _valid && *pObject >= 0;
+		}
+
+		int created() const
+		{
+			return _created.value();
+		}
+
+	private:
+		Poco::AtomicCounter _created;
+		bool _valid;
+	};
+
+	class Borrower: public Poco::Runnable
+	{
+	public:
+		Borrower(ConcurrentObjectPool<int, int*, CountingFactory>& pool): _pool(pool), _errors(0)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < 10000; ++i)
+			{
+				int* p = _pool.borrowObject(1000);
+				if (!p || *p != 0) ++_errors;
+				else
+				{
+					*p = 1;
+					*p = 0;
+					_pool.returnObject(p);
+				}
+			}
+			_pool.flush();
+		}
+
+		int errors() const
+		{
+			return _errors;
+		}
+
+	private:
+		ConcurrentObjectPool<int, int*, CountingFactory>& _pool;
+		int _errors;
+	};
+
+	class Hoarder: public Poco::Runnable
+		/// Borrows and returns objects, then keeps running,
+		/// with the objects in its cache, until told to finish.
+	{
+	public:
+		Hoarder(ConcurrentObjectPool<int, int*, CountingFactory>& pool, int count): _pool(pool), _count(count)
+		{
+		}
+
+		void run()
+		{
+			std::vector<int*> objects;
+			for (int i = 0; i < _count; ++i)
+			{
+				objects.push_back(_pool.borrowObject());
+			}
+			for (std::vector<int*>::iterator it = objects.begin(); it != objects.end(); ++it)
+			{
+				_pool.returnObject(*it);
+			}
+			_returned.set();
+			_finish.wait();
+		}
+
+		void waitReturned()
+		{
+			_returned.wait();
+		}
+
+		void finish()
+		{
+			_finish.set();
+		}
+
+	private:
+		ConcurrentObjectPool<int, int*, CountingFactory>& _pool;
+		int _count;
+		Poco::Event _returned;
+		Poco::Event _finish;
+	};
+
+	class SingleBorrower: public Poco::Runnable
+	{
+	public:
+		SingleBorrower(ConcurrentObjectPool<int, int*, CountingFactory>& pool): _pool(pool), _ok(false)
+		{
+		}
+
+		void run()
+		{
+			int* p = _pool.borrowObject(1000);
+			_ok = p != 0;
+			if (p) _pool.returnObject(p);
+		}
+
+		bool ok() const
+		{
+			return _ok;
+		}
+
+	private:
+		ConcurrentObjectPool<int, int*, CountingFactory>& _pool;
+		bool _ok;
+	};
+}
 
 
 ObjectPoolTest::ObjectPoolTest(const std::string& name): CppUnit::TestCase(name)
@@ -90,6 +228,135 @@ void ObjectPoolTest::testObjectPool()
 }
 
 
+void ObjectPoolTest::testConcurrentObjectPool()
+{
+	ConcurrentObjectPool<std::string, Poco::SharedPtr<std::string> > pool(2, 3, 1);
+
+	assert (pool.capacity() == 2);
+	assert (pool.peakCapacity() == 3);
+	assert (pool.size() == 0);
+
+	Poco::SharedPtr<std::string> pStr1 = pool.borrowObject();
+	Poco::SharedPtr<std::string> pStr2 = pool.borrowObject();
+	Poco::SharedPtr<std::string> pStr3 = pool.borrowObject();
+	assert (pool.size() == 3);
+	assert (pool.borrowObject().isNull());
+	assert (pool.borrowObject(10).isNull());
+	pStr1->assign("first");
+
+	// returned objects stay in this thread's cache
+	pool.returnObject(pStr1);
+	assert (pool.idle() == 0);
+	pStr1 = pool.borrowObject();
+	assert (*pStr1 == "first");
+
+	// a full cache gives a batch to the central store
+	pool.returnObject(pStr1);
+	pool.returnObject(pStr2);
+	pool.returnObject(pStr3);
+	assert (pool.size() == 3);
+	assert (pool.idle() == 2);
+
+	// the central store keeps at most capacity objects
+	pool.flush();
+	assert (pool.idle() == 2);
+	assert (pool.size() == 2);
+
+	pStr1 = pool.borrowObject();
+	pStr2 = pool.borrowObject();
+	assert (pool.idle() == 0);
+	assert (pool.size() == 2);
+	pool.returnObject(pStr1);
+	pool.returnObject(pStr2);
+}
+
+
+void ObjectPoolTest::testConcurrentObjectPoolThreads()
+{
+	ConcurrentObjectPool<int, int*, CountingFactory> pool(8, 8, 2);
+
+	Borrower b1(pool);
+	Borrower b2(pool);
+	Borrower b3(pool);
+	Thread t1;
+	Thread t2;
+	Thread t3;
+	t1.start(b1);
+	t2.start(b2);
+	t3.start(b3);
+	t1.join();
+	t2.join();
+	t3.join();
+
+	assert (b1.errors() == 0);
+	assert (b2.errors() == 0);
+	assert (b3.errors() == 0);
+	assert (pool.size() <= 8);
+	assert (pool.idle() == pool.size());
+}
+
+
+void ObjectPoolTest::testConcurrentObjectPoolThreadCaches()
+{
+	ConcurrentObjectPool<int, int*, CountingFactory> pool(4, 4, 8);
+
+	// All objects are idle in the cache of a thread that is still
+	// running; another thread must still be able to borrow one.
+	Hoarder hoarder(pool, 4);
+	Thread t1;
+	t1.start(hoarder);
+	hoarder.waitReturned();
+	assert (pool.size() == 4);
+	assert (pool.idle() == 0);
+
+	SingleBorrower borrower(pool);
+	Thread t2;
+	t2.start(borrower);
+	t2.join();
+	hoarder.finish();
+	t1.join();
+	assert (borrower.ok());
+	assert (pool.size() == 4);
+	int* p = pool.borrowObject();
+	assert (p != 0);
+	pool.returnObject(p);
+}
+
+
+void ObjectPoolTest::testConcurrentObjectPoolMaintenance()
+{
+	ConcurrentObjectPool<int, int*, CountingFactory> pool(8, 10, 2);
+
+	pool.startMaintenance(6, 10);
+	Thread::sleep(200);
+	assert (pool.idle() == 6);
+	assert (pool.size() == 6);
+
+	int* p1 = pool.borrowObject();
+	int* p2 = pool.borrowObject();
+	assert (pool.idle() == 4);
+	Thread::sleep(200);
+	assert (pool.idle() == 6);
+	assert (pool.size() == 8);
+
+	// validation happens in the background
+	*p1 = -1;
+	pool.returnObject(p1);
+	pool.returnObject(p2);
+	pool.flush();
+	assert (pool.size() == 8);
+	Thread::sleep(200);
+	assert (pool.size() == 7);
+	assert (pool.idle() == 7);
+
+	pool.stopMaintenance();
+	int* p3 = pool.borrowObject();
+	*p3 = -1;
+	pool.returnObject(p3);
+	assert (pool.size() == 6);
+}
+
+
 void ObjectPoolTest::setUp()
 {
 }
@@ -105,6 +372,10 @@ CppUnit::Test* ObjectPoolTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ObjectPoolTest");
 
 	CppUnit_addTest(pSuite, ObjectPoolTest, testObjectPool);
+	CppUnit_addTest(pSuite, ObjectPoolTest, testConcurrentObjectPool);
+	CppUnit_addTest(pSuite, ObjectPoolTest, testConcurrentObjectPoolThreads);
+	CppUnit_addTest(pSuite, ObjectPoolTest, testConcurrentObjectPoolThreadCaches);
+	CppUnit_addTest(pSuite, ObjectPoolTest, testConcurrentObjectPoolMaintenance);
 
 	return pSuite;
 }
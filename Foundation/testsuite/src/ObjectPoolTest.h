@@ -27,6 +27,10 @@ public:
 	~ObjectPoolTest();
 
 	void testObjectPool();
+	void testConcurrentObjectPool();
+	void testConcurrentObjectPoolThreads();
+	void testConcurrentObjectPoolThreadCaches();
+	void testConcurrentObjectPoolMaintenance();
 
 	void setUp();
 	void tearDown();
@@ -0,0 +1,281 @@
+//
+// PartitionedThreadPoolTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "PartitionedThreadPoolTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/PartitionedThreadPool.h"
+#include "Poco/CPUTopology.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/RunnableAdapter.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/FileStream.h"
+#include "Poco/File.h"
+#include "Poco/Path.h"
+#include "Poco/Exception.h"
+#include "Poco/Thread.h"
+
+
+using Poco::PartitionedThreadPool;
+using Poco::CPUTopology;
+using Poco::ThreadPool;
+using Poco::RunnableAdapter;
+using Poco::TemporaryFile;
+using Poco::FileOutputStream;
+using Poco::File;
+using Poco::Path;
+using Poco::Event;
+using Poco::Thread;
+
+
+namespace
+{
+	void writeNode(const Path& dir, const std::string& node, const std::string& cpuList)
+	{
+		Path nodeDir(dir, node);
+		File(nodeDir).createDirectories();
+		FileOutputStream ostr(Path(nodeDir, "cpulist").toString());
+		ostr << cpuList << "\n";
+	}
+}
+
+
+PartitionedThreadPoolTest::PartitionedThreadPoolTest(const std::string& name): 
+	CppUnit::TestCase(name), 
+	_event(Event::EVENT_MANUALRESET)
+{
+}
+
+
+PartitionedThreadPoolTest::~PartitionedThreadPoolTest()
+{
+}
+
+
+void PartitionedThreadPoolTest::testParseCPUList()
+{
+	CPUTopology::CPUSet cpus = CPUTopology::parseCPUList("0-3,8,10-11");
+	assert (cpus.size() == 7);
+	assert (cpus[0] == 0);
+	assert (cpus[3] == 3);
+	assert (cpus[4] == 8);
+	assert (cpus[5] == 10);
+	assert (cpus[6] == 11);
+
+	cpus = CPUTopology::parseCPUList("5,1-2,1");
+	assert (cpus.size() == 3);
+	assert (cpus[0] == 1);
+	assert (cpus[1] == 2);
+	assert (cpus[2] == 5);
+
+	assert (CPUTopology::parseCPUList("").empty());
+	assert (CPUTopology::parseCPUList("\n").empty());
+
+	try
+	{
+		CPUTopology::parseCPUList("1-");
+		failmsg("invalid list - must throw");
+	}
+	catch (Poco::SyntaxException&)
+	{
+	}
+	try
+	{
+		CPUTopology::parseCPUList("3-1");
+		failmsg("invalid range - must throw");
+	}
+	catch (Poco::SyntaxException&)
+	{
+	}
+	try
+	{
+		CPUTopology::parseCPUList("1;2");
+		failmsg("invalid separator - must throw");
+	}
+	catch (Poco::SyntaxException&)
+	{
+	}
+}
+
+
+void PartitionedThreadPoolTest::testTopology()
+{
+	TemporaryFile tmp;
+	File(tmp).createDirectories();
+	Path dir(tmp.path());
+	dir.makeDirectory();
+	writeNode(dir, "node1", "4-7");
+	writeNode(dir, "node0", "0-3");
+	writeNode(dir, "node2", "");
+	File(Path(dir, "possible")).createFile();
+
+	CPUTopology topology(dir.toString());
+	assert (topology.nodeCount() == 2);
+	assert (topology.nodeCPUs(0).size() == 4);
+	assert (topology.nodeCPUs(0)[0] == 0);
+	assert (topology.nodeCPUs(1).size() == 4);
+	assert (topology.nodeCPUs(1)[0] == 4);
+	assert (topology.nodeOf(2) == 0);
+	assert (topology.nodeOf(7) == 1);
+	assert (topology.nodeOf(8) == -1);
+	assert (topology.nodeOf(-1) == -1);
+}
+
+
+void PartitionedThreadPoolTest::testSystemTopology()
+{
+	CPUTopology topology;
+	assert (topology.nodeCount() >= 1);
+	int cpu = CPUTopology::currentCPU();
+	if (cpu >= 0)
+	{
+		assert (topology.nodeOf(cpu) >= 0);
+	}
+}
+
+
+void PartitionedThreadPoolTest::testCPUSet()
+{
+	ThreadPool pool(1, 1);
+	CPUTopology::CPUSet cpus;
+	cpus.push_back(0);
+	pool.setCPUSet(cpus);
+	assert (pool.getCPUSet() == cpus);
+
+	RunnableAdapter<PartitionedThreadPoolTest> ra(*this, &PartitionedThreadPoolTest::checkCPU);
+	for (int i = 0; i < 10; ++i)
+	{
+		pool.start(ra);
+		pool.joinAll();
+	}
+	assert (_count.value() == 10);
+	assert (_wrongCPU.value() == 0);
+
+	pool.setCPUSet(CPUTopology::CPUSet());
+	pool.start(ra);
+	pool.joinAll();
+	assert (_count.value() == 11);
+}
+
+
+void PartitionedThreadPoolTest::testPartitions()
+{
+	PartitionedThreadPool defaultPool(1, 2);
+	assert (defaultPool.partitions() >= 1);
+	assert (defaultPool.capacity() == 2*defaultPool.partitions());
+
+	std::vector<CPUTopology::CPUSet> cpuSets(2);
+	cpuSets[0].push_back(0);
+	PartitionedThreadPool pool(cpuSets, 1, 4);
+	assert (pool.partitions() == 2);
+	assert (pool.capacity() == 8);
+	assert (pool.allocated() == 2);
+	assert (pool.cpus(0).size() == 1);
+	assert (pool.cpus(1).empty());
+	assert (pool.partitionOf(0) == 0);
+	assert (pool.partitionOf(1) == -1);
+	assert (pool.partition(0).name() == "Partition0");
+	assert (pool.partition(1).name() == "Partition1");
+
+	int local = pool.localPartition();
+	assert (local >= 0 && local < 2);
+
+	RunnableAdapter<PartitionedThreadPoolTest> ra(*this, &PartitionedThreadPoolTest::count);
+	for (int i = 0; i < 100; ++i)
+	{
+		pool.start(ra);
+		if (i % 4 == 3) pool.joinAll();
+	}
+	pool.joinAll();
+	assert (_count.value() == 100);
+	assert (pool.used() == 0);
+
+	pool.start(ra, 1);
+	pool.joinAll();
+	assert (_count.value() == 101);
+}
+
+
+void PartitionedThreadPoolTest::testSpill()
+{
+	std::vector<CPUTopology::CPUSet> cpuSets(2);
+	PartitionedThreadPool pool(cpuSets, 1, 1);
+
+	RunnableAdapter<PartitionedThreadPoolTest> ra(*this, &PartitionedThreadPoolTest::block);
+	pool.start(ra, 0);
+	assert (pool.partition(0).used() == 1);
+	pool.start(ra, 0);
+	assert (pool.partition(1).used() == 1);
+	assert (pool.used() == 2);
+	assert (pool.available() == 0);
+	try
+	{
+		pool.start(ra);
+		failmsg("no thread available - must throw");
+	}
+	catch (Poco::NoThreadAvailableException&)
+	{
+	}
+	_event.set();
+	pool.joinAll();
+	assert (_count.value() == 2);
+	assert (pool.available() == 2);
+}
+
+
+void PartitionedThreadPoolTest::setUp()
+{
+	_event.reset();
+	_count = 0;
+	_wrongCPU = 0;
+}
+
+
+void PartitionedThreadPoolTest::tearDown()
+{
+}
+
+
+void PartitionedThreadPoolTest::count()
+{
+	++_count;
+}
+
+
+void PartitionedThreadPoolTest::block()
+{
+	_event.wait();
+	++_count;
+}
+
+
+void PartitionedThreadPoolTest::checkCPU()
+{
+	int cpu = CPUTopology::currentCPU();
+	if (cpu > 0) ++_wrongCPU;
+	++_count;
+}
+
+
+CppUnit::Test* PartitionedThreadPoolTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("PartitionedThreadPoolTest");
+
+	CppUnit_addTest(pSuite, PartitionedThreadPoolTest, testParseCPUList);
+	CppUnit_addTest(pSuite, PartitionedThreadPoolTest, testTopology);
+	CppUnit_addTest(pSuite, PartitionedThreadPoolTest, testSystemTopology);
+	CppUnit_addTest(pSuite, PartitionedThreadPoolTest, testCPUSet);
+	CppUnit_addTest(pSuite, PartitionedThreadPoolTest, testPartitions);
+	CppUnit_addTest(pSuite, PartitionedThreadPoolTest, testSpill);
+
+	return pSuite;
+}
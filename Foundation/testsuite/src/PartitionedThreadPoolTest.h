@@ -0,0 +1,55 @@
+//
+// PartitionedThreadPoolTest.h
+//
+// $Id$
+//
+// Definition of the PartitionedThreadPoolTest class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef PartitionedThreadPoolTest_INCLUDED
+#define PartitionedThreadPoolTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+#include "Poco/Event.h"
+#include "Poco/AtomicCounter.h"
+
+
+class PartitionedThreadPoolTest: public CppUnit::TestCase
+{
+public:
+	PartitionedThreadPoolTest(const std::string& name);
+	~PartitionedThreadPoolTest();
+
+	void testParseCPUList();
+	void testTopology();
+	void testSystemTopology();
+	void testCPUSet();
+	void testPartitions();
+	void testSpill();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+protected:
+	void count();
+	void block();
+	void checkCPU();
+
+private:
+	Poco::Event _event;
+	Poco::AtomicCounter _count;
+	Poco::AtomicCounter _wrongCPU;
+};
+
+
+#endif // PartitionedThreadPoolTest_INCLUDED
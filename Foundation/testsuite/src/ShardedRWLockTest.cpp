@@ -0,0 +1,241 @@
+//
+// ShardedRWLockTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "ShardedRWLockTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/ShardedRWLock.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+
+
+using Poco::ShardedRWLock;
+using Poco::Thread;
+using Poco::Runnable;
+
+
+class ShardedRWLockRunnable: public Runnable
+{
+public:
+	ShardedRWLockRunnable(ShardedRWLock& lock, volatile int& counter): _lock(lock), _counter(counter), _ok(true)
+	{
+	}
+	
+	void run()
+	{
+		int lastCount = 0;
+		for (int i = 0; i < 10000; ++i)
+		{
+			_lock.readLock();
+			lastCount = _counter;
+			for (int k = 0; k < 100; ++k)
+			{
+				if (_counter != lastCount) _ok = false;
+				Thread::yield();
+			}
+			_lock.unlock();
+			_lock.writeLock();
+			for (int k = 0; k < 100; ++k)
+			{
+				--_counter;
+				Thread::yield();
+			}
+			for (int k = 0; k < 100; ++k)
+			{
+				++_counter;
+				Thread::yield();
+			}
+			++_counter;
+			if (_counter <= lastCount) _ok = false;
+			_lock.unlock();
+		}
+	}
+	
+	bool ok() const
+	{
+		return _ok;
+	}
+	
+private:
+	ShardedRWLock& _lock;
+	volatile int& _counter;
+	bool _ok;
+};
+
+
+class ShardedRWTryLockRunnable: public Runnable
+{
+public:
+	ShardedRWTryLockRunnable(ShardedRWLock& lock, volatile int& counter): _lock(lock), _counter(counter), _ok(true)
+	{
+	}
+	
+	void run()
+	{
+		int lastCount = 0;
+		for (int i = 0; i < 10000; ++i)
+		{
+			while (!_lock.tryReadLock()) Thread::yield();
+			lastCount = _counter;
+			for (int k = 0; k < 100; ++k)
+			{
+				if (_counter != lastCount) _ok = false;
+				Thread::yield();
+			}
+			_lock.unlock();
+			while (!_lock.tryWriteLock()) Thread::yield();
+			for (int k = 0; k < 100; ++k)
+			{
+				--_counter;
+				Thread::yield();
+			}
+			for (int k = 0; k < 100; ++k)
+			{
+				++_counter;
+				Thread::yield();
+			}
+			++_counter;
+			if (_counter <= lastCount) _ok = false;
+			_lock.unlock();
+		}
+	}
+	
+	bool ok() const
+	{
+		return _ok;
+	}
+	
+private:
+	ShardedRWLock& _lock;
+	volatile int& _counter;
+	bool _ok;
+};
+
+
+ShardedRWLockTest::ShardedRWLockTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+ShardedRWLockTest::~ShardedRWLockTest()
+{
+}
+
+
+void ShardedRWLockTest::testLock()
+{
+	ShardedRWLock lock;
+	int counter = 0;
+	ShardedRWLockRunnable r1(lock, counter);
+	ShardedRWLockRunnable r2(lock, counter);
+	ShardedRWLockRunnable r3(lock, counter);
+	ShardedRWLockRunnable r4(lock, counter);
+	ShardedRWLockRunnable r5(lock, counter);
+	Thread t1;
+	Thread t2;
+	Thread t3;
+	Thread t4;
+	Thread t5;
+	t1.start(r1);
+	t2.start(r2);
+	t3.start(r3);
+	t4.start(r4);
+	t5.start(r5);
+	t1.join();
+	t2.join();
+	t3.join();
+	t4.join();
+	t5.join();
+	assert (counter == 50000);
+	assert (r1.ok());
+	assert (r2.ok());
+	assert (r3.ok());
+	assert (r4.ok());
+	assert (r5.ok());
+}
+
+
+void ShardedRWLockTest::testTryLock()
+{
+	ShardedRWLock lock;
+	int counter = 0;
+	ShardedRWTryLockRunnable r1(lock, counter);
+	ShardedRWTryLockRunnable r2(lock, counter);
+	ShardedRWTryLockRunnable r3(lock, counter);
+	ShardedRWTryLockRunnable r4(lock, counter);
+	ShardedRWTryLockRunnable r5(lock, counter);
+	Thread t1;
+	Thread t2;
+	Thread t3;
+	Thread t4;
+	Thread t5;
+	t1.start(r1);
+	t2.start(r2);
+	t3.start(r3);
+	t4.start(r4);
+	t5.start(r5);
+	t1.join();
+	t2.join();
+	t3.join();
+	t4.join();
+	t5.join();
+	assert (counter == 50000);
+	assert (r1.ok());
+	assert (r2.ok());
+	assert (r3.ok());
+	assert (r4.ok());
+	assert (r5.ok());
+}
+
+
+void ShardedRWLockTest::testScopedLock()
+{
+	ShardedRWLock lock(4);
+	assert (lock.slots() == 4);
+	{
+		ShardedRWLock::ScopedReadLock readLock(lock);
+		assert (!lock.tryWriteLock());
+	}
+	{
+		ShardedRWLock::ScopedWriteLock writeLock(lock);
+		assert (!lock.tryReadLock());
+	}
+	assert (lock.tryWriteLock());
+	assert (!lock.tryReadLock());
+	lock.unlock();
+	assert (lock.tryReadLock());
+	lock.unlock();
+	assert (lock.tryWriteLock());
+	lock.writeUnlock();
+}
+
+
+void ShardedRWLockTest::setUp()
+{
+}
+
+
+void ShardedRWLockTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ShardedRWLockTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ShardedRWLockTest");
+
+	CppUnit_addTest(pSuite, ShardedRWLockTest, testLock);
+	CppUnit_addTest(pSuite, ShardedRWLockTest, testTryLock);
+	CppUnit_addTest(pSuite, ShardedRWLockTest, testScopedLock);
+
+	return pSuite;
+}
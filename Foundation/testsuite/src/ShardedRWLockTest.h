@@ -0,0 +1,42 @@
+//
+// ShardedRWLockTest.h
+//
+// $Id$
+//
+// Definition of the ShardedRWLockTest class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef ShardedRWLockTest_INCLUDED
+#define ShardedRWLockTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+
+
+class ShardedRWLockTest: public CppUnit::TestCase
+{
+public:
+	ShardedRWLockTest(const std::string& name);
+	~ShardedRWLockTest();
+
+	void testLock();
+	void testTryLock();
+	void testScopedLock();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // ShardedRWLockTest_INCLUDED
@@ -18,6 +18,7 @@
 
 
 using Poco::SharedPtr;
+using Poco::makeShared;
 using Poco::NullPointerException;
 
 
@@ -197,6 +198,34 @@ void SharedPtrTest::testExplicitCast()
 }
 
 
+void SharedPtrTest::testMakeShared()
+{
+	SharedPtr<TestObject> ptr1 = makeShared<TestObject>(std::string("one"));
+	assert (ptr1->data() == "one");
+	assert (ptr1.referenceCount() == 1);
+	assert (TestObject::count() == 1);
+
+	SharedPtr<TestObject> ptr2 = ptr1;
+	assert (ptr2.referenceCount() == 2);
+	ptr1 = 0;
+	assert (TestObject::count() == 1);
+	assert (ptr2->data() == "one");
+	ptr2 = 0;
+	assert (TestObject::count() == 0);
+
+	SharedPtr<TestObject> ptr3 = makeShared<DerivedObject>(std::string("two"), 2);
+	assert (TestObject::count() == 1);
+	SharedPtr<DerivedObject> ptr4 = ptr3.cast<DerivedObject>();
+	assert (ptr4->number() == 2);
+	assert (ptr4.referenceCount() == 2);
+	ptr4 = 0;
+	ptr3 = new TestObject("three");
+	assert (TestObject::count() == 1);
+	ptr3 = 0;
+	assert (TestObject::count() == 0);
+}
+
+
 void SharedPtrTest::setUp()
 {
 }
@@ -214,6 +243,7 @@ CppUnit::Test* SharedPtrTest::suite()
 	CppUnit_addTest(pSuite, SharedPtrTest, testSharedPtr);
 	CppUnit_addTest(pSuite, SharedPtrTest, testImplicitCast);
 	CppUnit_addTest(pSuite, SharedPtrTest, testExplicitCast);
+	CppUnit_addTest(pSuite, SharedPtrTest, testMakeShared);
 
 	return pSuite;
 }
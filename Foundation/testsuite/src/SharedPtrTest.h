@@ -30,6 +30,7 @@ public:
 
 	void testImplicitCast();
 	void testExplicitCast();
+	void testMakeShared();
 
 	void setUp();
 	void tearDown();
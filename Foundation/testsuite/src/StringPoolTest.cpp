@@ -0,0 +1,190 @@
+//
+// StringPoolTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "StringPoolTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/StringPool.h"
+#include "Poco/HashMap.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include <vector>
+
+
+using Poco::StringPool;
+using Poco::InternedString;
+using Poco::NumberFormatter;
+
+
+namespace
+{
+	class Interner: public Poco::Runnable
+	{
+	public:
+		Interner(StringPool& pool): _pool(pool)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < 1000; ++i)
+			{
+				_strings.push_back(_pool.intern("key" + NumberFormatter::format(i)));
+			}
+		}
+
+		const std::vector<InternedString>& strings() const
+		{
+			return _strings;
+		}
+
+	private:
+		StringPool& _pool;
+		std::vector<InternedString> _strings;
+	};
+}
+
+
+StringPoolTest::StringPoolTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+StringPoolTest::~StringPoolTest()
+{
+}
+
+
+void StringPoolTest::testIntern()
+{
+	StringPool pool;
+	assert (pool.size() == 0);
+
+	InternedString s1 = pool.intern("Content-Type");
+	InternedString s2 = pool.intern(std::string("Content-") + "Type");
+	InternedString s3 = pool.intern("Content-Length");
+	assert (s1 == s2);
+	assert (s1 != s3);
+	assert (&s1.str() == &s2.str());
+	assert (s1.str() == "Content-Type");
+	assert (s3.str() == "Content-Length");
+	assert (s1.hash() == StringPool::hash("Content-Type", 12));
+	assert (pool.size() == 2);
+
+	const std::string& str = s3;
+	assert (str == "Content-Length");
+
+	InternedString empty;
+	assert (empty.empty());
+	assert (empty == pool.intern(""));
+	assert (pool.size() == 2);
+
+	s1.swap(s3);
+	assert (s1.str() == "Content-Length");
+	assert (s3 == s2);
+}
+
+
+void StringPoolTest::testFind()
+{
+	StringPool pool;
+	pool.intern("logger.name");
+
+	InternedString s;
+	assert (pool.find("logger.name", s));
+	assert (s.str() == "logger.name");
+	assert (s == pool.intern("logger.name"));
+	assert (!pool.find("logger", s));
+	assert (s.str() == "logger.name");
+	assert (pool.size() == 1);
+}
+
+
+void StringPoolTest::testGrow()
+{
+	StringPool pool(2);
+	std::vector<InternedString> strings;
+	for (int i = 0; i < 10000; ++i)
+	{
+		strings.push_back(pool.intern(NumberFormatter::format(i)));
+	}
+	assert (pool.size() == 10000);
+	for (int i = 0; i < 10000; ++i)
+	{
+		InternedString s = pool.intern(NumberFormatter::format(i));
+		assert (s == strings[i]);
+		assert (s.str() == NumberFormatter::format(i));
+	}
+	assert (pool.size() == 10000);
+}
+
+
+void StringPoolTest::testHashMap()
+{
+	StringPool pool;
+	Poco::HashMap<InternedString, int> map;
+	map[pool.intern("one")] = 1;
+	map[pool.intern("two")] = 2;
+	assert (map[pool.intern("one")] == 1);
+	assert (map[pool.intern("two")] == 2);
+	assert (map.find(pool.intern("three")) == map.end());
+}
+
+
+void StringPoolTest::testThreads()
+{
+	StringPool pool;
+	Interner i1(pool);
+	Interner i2(pool);
+	Interner i3(pool);
+	Poco::Thread t1;
+	Poco::Thread t2;
+	Poco::Thread t3;
+	t1.start(i1);
+	t2.start(i2);
+	t3.start(i3);
+	t1.join();
+	t2.join();
+	t3.join();
+
+	assert (pool.size() == 1000);
+	for (int i = 0; i < 1000; ++i)
+	{
+		assert (i1.strings()[i] == i2.strings()[i]);
+		assert (i1.strings()[i] == i3.strings()[i]);
+	}
+}
+
+
+void StringPoolTest::setUp()
+{
+}
+
+
+void StringPoolTest::tearDown()
+{
+}
+
+
+CppUnit::Test* StringPoolTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("StringPoolTest");
+
+	CppUnit_addTest(pSuite, StringPoolTest, testIntern);
+	CppUnit_addTest(pSuite, StringPoolTest, testFind);
+	CppUnit_addTest(pSuite, StringPoolTest, testGrow);
+	CppUnit_addTest(pSuite, StringPoolTest, testHashMap);
+	CppUnit_addTest(pSuite, StringPoolTest, testThreads);
+
+	return pSuite;
+}
@@ -0,0 +1,44 @@
+//
+// StringPoolTest.h
+//
+// $Id$
+//
+// Definition of the StringPoolTest class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef StringPoolTest_INCLUDED
+#define StringPoolTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+
+
+class StringPoolTest: public CppUnit::TestCase
+{
+public:
+	StringPoolTest(const std::string& name);
+	~StringPoolTest();
+
+	void testIntern();
+	void testFind();
+	void testGrow();
+	void testHashMap();
+	void testThreads();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // StringPoolTest_INCLUDED
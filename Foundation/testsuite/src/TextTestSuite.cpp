@@ -17,6 +17,7 @@
 #include "StreamConverterTest.h"
 #include "TextEncodingTest.h"
 #include "UTF8StringTest.h"
+#include "UTF8CodecTest.h"
 #ifndef POCO_NO_WSTRING
 #include "UnicodeConverterTest.h"
 #endif
@@ -31,6 +32,7 @@ CppUnit::Test* TextTestSuite::suite()
 	pSuite->addTest(StreamConverterTest::suite());
 	pSuite->addTest(TextEncodingTest::suite());
 	pSuite->addTest(UTF8StringTest::suite());
+	pSuite->addTest(UTF8CodecTest::suite());
 #ifndef POCO_NO_WSTRING
 	pSuite->addTest(UnicodeConverterTest::suite());
 #endif
@@ -103,6 +103,26 @@ void ThreadLocalTest::testAccessors()
 }
 
 
+void ThreadLocalTest::testReuse()
+{
+	{
+		ThreadLocal<int> tl;
+		*tl = 42;
+	}
+	{
+		// Gets the index of the destroyed ThreadLocal,
+		// but must not see its slot.
+		ThreadLocal<TLTestStruct> ts;
+		assert (ts->i == 0);
+		assert (ts->s.empty());
+		ts->s = "foo";
+		ThreadLocal<int> tl;
+		assert (*tl == 0);
+		assert (ts->s == "foo");
+	}
+}
+
+
 void ThreadLocalTest::setUp()
 {
 }
@@ -119,6 +139,7 @@ CppUnit::Test* ThreadLocalTest::suite()
 
 	CppUnit_addTest(pSuite, ThreadLocalTest, testLocality);
 	CppUnit_addTest(pSuite, ThreadLocalTest, testAccessors);
+	CppUnit_addTest(pSuite, ThreadLocalTest, testReuse);
 
 	return pSuite;
 }
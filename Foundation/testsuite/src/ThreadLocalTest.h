@@ -28,6 +28,7 @@ public:
 
 	void testLocality();
 	void testAccessors();
+	void testReuse();
 
 	void setUp();
 	void tearDown();
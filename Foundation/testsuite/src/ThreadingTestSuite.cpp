@@ -15,7 +15,10 @@
 #include "MutexTest.h"
 #include "SemaphoreTest.h"
 #include "RWLockTest.h"
+#include "ShardedRWLockTest.h"
 #include "ThreadPoolTest.h"
+#include "WorkStealingThreadPoolTest.h"
+#include "PartitionedThreadPoolTest.h"
 #include "TimerTest.h"
 #include "ThreadLocalTest.h"
 #include "ActivityTest.h"
@@ -32,7 +35,10 @@ CppUnit::Test* ThreadingTestSuite::suite()
 	pSuite->addTest(MutexTest::suite());
 	pSuite->addTest(SemaphoreTest::suite());
 	pSuite->addTest(RWLockTest::suite());
+	pSuite->addTest(ShardedRWLockTest::suite());
 	pSuite->addTest(ThreadPoolTest::suite());
+	pSuite->addTest(WorkStealingThreadPoolTest::suite());
+	pSuite->addTest(PartitionedThreadPoolTest::suite());
 	pSuite->addTest(TimerTest::suite());
 	pSuite->addTest(ThreadLocalTest::suite());
 	pSuite->addTest(ActivityTest::suite());
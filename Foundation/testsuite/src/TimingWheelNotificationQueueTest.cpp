@@ -0,0 +1,381 @@
+//
+// TimingWheelNotificationQueueTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "TimingWheelNotificationQueueTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/TimingWheelNotificationQueue.h"
+#include "Poco/Notification.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Clock.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Random.h"
+#include <vector>
+
+
+using Poco::TimingWheelNotificationQueue;
+using Poco::Notification;
+using Poco::Timestamp;
+using Poco::Clock;
+using Poco::Thread;
+
+
+namespace 
+{
+	class QTestNotification: public Notification
+	{
+	public:
+		QTestNotification(const std::string& data): _data(data)
+		{
+		}
+		~QTestNotification()
+		{
+		}
+		const std::string& data() const
+		{
+			return _data;
+		}
+
+	private:
+		std::string _data;
+	};
+
+	class DueNotification: public Notification
+	{
+	public:
+		DueNotification(const Clock& due): _due(due)
+		{
+		}
+		const Clock& due() const
+		{
+			return _due;
+		}
+
+	private:
+		Clock _due;
+	};
+}
+
+
+TimingWheelNotificationQueueTest::TimingWheelNotificationQueueTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+TimingWheelNotificationQueueTest::~TimingWheelNotificationQueueTest()
+{
+}
+
+
+void TimingWheelNotificationQueueTest::testDequeue()
+{
+	TimingWheelNotificationQueue queue;
+	assert (queue.empty());
+	assert (queue.size() == 0);
+	Notification* pNf = queue.dequeueNotification();
+	assertNullPtr(pNf);
+	queue.enqueueNotification(new Notification, Timestamp());
+	assert (!queue.empty());
+	assert (queue.size() == 1);
+	// may take up to one tick (1 ms)
+	pNf = queue.waitDequeueNotification(100);
+	assertNotNullPtr(pNf);
+	assert (queue.empty());
+	assert (queue.size() == 0);
+	pNf->release();
+
+	Poco::Timestamp ts1;
+	ts1 += 100000;
+	Poco::Timestamp ts2;
+	ts2 += 200000;
+	Poco::Timestamp ts3;
+	ts3 += 300000;
+	Poco::Timestamp ts4;
+	ts4 += 400000;
+
+	queue.enqueueNotification(new QTestNotification("first"), ts1);
+	queue.enqueueNotification(new QTestNotification("fourth"), ts4);
+	queue.enqueueNotification(new QTestNotification("third"), ts3);
+	queue.enqueueNotification(new QTestNotification("second"), ts2);
+	assert (!queue.empty());
+	assert (queue.size() == 4);
+
+	const char* expected[] = {"first", "second", "third", "fourth"};
+	Timestamp* timestamps[] = {&ts1, &ts2, &ts3, &ts4};
+	for (int i = 0; i < 4; ++i)
+	{
+		QTestNotification* pTNf = 0;
+		while (!pTNf)
+		{
+			pTNf = dynamic_cast<QTestNotification*>(queue.dequeueNotification());
+		}
+		assert (pTNf->data() == expected[i]);
+		pTNf->release();
+		assert (timestamps[i]->elapsed() >= 0);
+		assert (queue.size() == 3 - i);
+	}
+	assert (queue.empty());
+
+	pNf = queue.dequeueNotification();
+	assertNullPtr(pNf);
+}
+
+
+void TimingWheelNotificationQueueTest::testWaitDequeue()
+{
+	TimingWheelNotificationQueue queue;
+
+	Clock c1;
+	c1 += 100000;
+	Clock c2;
+	c2 += 200000;
+	Clock c3;
+	c3 += 300000;
+
+	queue.enqueueNotification(new QTestNotification("third"), c3);
+	queue.enqueueNotification(new QTestNotification("first"), c1);
+	queue.enqueueNotification(new QTestNotification("second"), c2);
+	assert (queue.size() == 3);
+
+	QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification());
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "first");
+	pTNf->release();
+	assert (c1.elapsed() >= 0);
+
+	pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification());
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "second");
+	pTNf->release();
+	assert (c2.elapsed() >= 0);
+
+	pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification());
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "third");
+	pTNf->release();
+	assert (c3.elapsed() >= 0);
+	assert (queue.empty());
+}
+
+
+void TimingWheelNotificationQueueTest::testWaitDequeueTimeout()
+{
+	TimingWheelNotificationQueue queue;
+
+	Clock c1;
+	c1 += 200000;
+	Clock c2;
+	c2 += 400000;
+
+	queue.enqueueNotification(new QTestNotification("second"), c2);
+	queue.enqueueNotification(new QTestNotification("first"), c1);
+
+	Notification* pNf = queue.waitDequeueNotification(10);
+	assertNullPtr(pNf);
+	pNf = queue.waitDequeueNotification(20);
+	assertNullPtr(pNf);
+	QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification(300));
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "first");
+	pTNf->release();
+	assert (c1.elapsed() >= 0);
+
+	pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification(300));
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "second");
+	pTNf->release();
+	assert (c2.elapsed() >= 0);
+	assert (queue.empty());
+}
+
+
+void TimingWheelNotificationQueueTest::testCancel()
+{
+	TimingWheelNotificationQueue queue;
+
+	TimingWheelNotificationQueue::Handle null;
+	assert (null.isNull());
+	assert (!queue.cancel(null));
+
+	Clock due;
+	due += 50000;
+	TimingWheelNotificationQueue::Handle h1 = queue.enqueueNotification(new QTestNotification("first"), due);
+	TimingWheelNotificationQueue::Handle h2 = queue.enqueueNotification(new QTestNotification("second"), due);
+	TimingWheelNotificationQueue::Handle h3 = queue.enqueueNotification(new QTestNotification("third"), due);
+	assert (!h1.isNull());
+	assert (h1 != h2);
+	assert (queue.size() == 3);
+
+	assert (queue.cancel(h2));
+	assert (!queue.cancel(h2));
+	assert (queue.size() == 2);
+
+	// the entry of the cancelled notification is reused,
+	// but the old handle must not refer to the new notification
+	TimingWheelNotificationQueue::Handle h4 = queue.enqueueNotification(new QTestNotification("fourth"), due);
+	assert (h4 != h2);
+	assert (!queue.cancel(h2));
+	assert (queue.size() == 3);
+
+	QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification(1000));
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "first");
+	pTNf->release();
+	assert (!queue.cancel(h1));
+
+	assert (queue.cancel(h4));
+	pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification(1000));
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "third");
+	pTNf->release();
+	assert (!queue.cancel(h3));
+	assert (queue.empty());
+}
+
+
+void TimingWheelNotificationQueueTest::testCascade()
+{
+	// With a resolution of 1 microsecond, delays above 256 us and
+	// 65536 us are placed in the second and third wheel.
+	TimingWheelNotificationQueue queue(1);
+	assert (queue.resolution() == 1);
+
+	Clock c1;
+	c1 += 100;
+	Clock c2;
+	c2 += 10000;
+	Clock c3;
+	c3 += 150000;
+
+	queue.enqueueNotification(new DueNotification(c3), c3);
+	queue.enqueueNotification(new DueNotification(c1), c1);
+	queue.enqueueNotification(new DueNotification(c2), c2);
+
+	Clock::ClockDiff last = 0;
+	for (int i = 0; i < 3; ++i)
+	{
+		Notification::Ptr pNf = queue.waitDequeueNotification(1000);
+		DueNotification* pDNf = dynamic_cast<DueNotification*>(pNf.get());
+		assertNotNullPtr(pDNf);
+		assert (pDNf->due().elapsed() >= 0);
+		assert (pDNf->due().raw() > last);
+		last = pDNf->due().raw();
+	}
+	assert (queue.empty());
+}
+
+
+void TimingWheelNotificationQueueTest::testMany()
+{
+	const int COUNT = 10000;
+	TimingWheelNotificationQueue queue(10);
+	Poco::Random rnd;
+	std::vector<TimingWheelNotificationQueue::Handle> handles;
+	handles.reserve(COUNT);
+	Clock start;
+	for (int i = 0; i < COUNT; ++i)
+	{
+		Clock due(start);
+		due += rnd.next(200000);
+		handles.push_back(queue.enqueueNotification(new DueNotification(due), due));
+	}
+	assert (queue.size() == COUNT);
+	for (int i = 0; i < COUNT; i += 2)
+	{
+		assert (queue.cancel(handles[i]));
+	}
+	assert (queue.size() == COUNT/2);
+
+	int received = 0;
+	Notification::Ptr pNf = queue.waitDequeueNotification(1000);
+	while (pNf)
+	{
+		DueNotification* pDNf = dynamic_cast<DueNotification*>(pNf.get());
+		assertNotNullPtr(pDNf);
+		assert (pDNf->due().elapsed() >= 0);
+		++received;
+		pNf = queue.waitDequeueNotification(received < COUNT/2 ? 1000 : 0);
+	}
+	assert (received == COUNT/2);
+	assert (queue.empty());
+	for (int i = 0; i < COUNT; ++i)
+	{
+		assert (!queue.cancel(handles[i]));
+	}
+}
+
+
+void TimingWheelNotificationQueueTest::testWakeUp()
+{
+	// A notification enqueued while the dequeuing thread sleeps
+	// must wake it up if it is due earlier than anything else.
+	TimingWheelNotificationQueue queue;
+	Clock late;
+	late += 5000000;
+	queue.enqueueNotification(new QTestNotification("late"), late);
+
+	class Enqueuer: public Poco::Runnable
+	{
+	public:
+		Enqueuer(TimingWheelNotificationQueue& queue): _queue(queue)
+		{
+		}
+		void run()
+		{
+			Thread::sleep(100);
+			_queue.enqueueNotification(new QTestNotification("early"), Clock());
+		}
+	private:
+		TimingWheelNotificationQueue& _queue;
+	};
+
+	Enqueuer enqueuer(queue);
+	Thread thread;
+	Clock start;
+	thread.start(enqueuer);
+	QTestNotification* pTNf = dynamic_cast<QTestNotification*>(queue.waitDequeueNotification());
+	thread.join();
+	assertNotNullPtr(pTNf);
+	assert (pTNf->data() == "early");
+	pTNf->release();
+	assert (start.elapsed() < 2000000);
+	assert (queue.size() == 1);
+	queue.clear();
+	assert (queue.empty());
+}
+
+
+void TimingWheelNotificationQueueTest::setUp()
+{
+}
+
+
+void TimingWheelNotificationQueueTest::tearDown()
+{
+}
+
+
+CppUnit::Test* TimingWheelNotificationQueueTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("TimingWheelNotificationQueueTest");
+
+	CppUnit_addTest(pSuite, TimingWheelNotificationQueueTest, testDequeue);
+	CppUnit_addTest(pSuite, TimingWheelNotificationQueueTest, testWaitDequeue);
+	CppUnit_addTest(pSuite, TimingWheelNotificationQueueTest, testWaitDequeueTimeout);
+	CppUnit_addTest(pSuite, TimingWheelNotificationQueueTest, testCancel);
+	CppUnit_addTest(pSuite, TimingWheelNotificationQueueTest, testCascade);
+	CppUnit_addTest(pSuite, TimingWheelNotificationQueueTest, testMany);
+	CppUnit_addTest(pSuite, TimingWheelNotificationQueueTest, testWakeUp);
+
+	return pSuite;
+}
@@ -0,0 +1,44 @@
+//
+// TimingWheelNotificationQueueTest.h
+//
+// $Id$
+//
+// Definition of the TimingWheelNotificationQueueTest class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef TimingWheelNotificationQueueTest_INCLUDED
+#define TimingWheelNotificationQueueTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+
+
+class TimingWheelNotificationQueueTest: public CppUnit::TestCase
+{
+public:
+	TimingWheelNotificationQueueTest(const std::string& name);
+	~TimingWheelNotificationQueueTest();
+
+	void testDequeue();
+	void testWaitDequeue();
+	void testWaitDequeueTimeout();
+	void testCancel();
+	void testCascade();
+	void testMany();
+	void testWakeUp();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // TimingWheelNotificationQueueTest_INCLUDED
@@ -0,0 +1,310 @@
+//
+// UTF8CodecTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "UTF8CodecTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/UTF8Codec.h"
+#include "Poco/UTF8Encoding.h"
+#include "Poco/UTF8String.h"
+#include "Poco/TextConverter.h"
+#include "Poco/StreamConverter.h"
+#include "Poco/Random.h"
+#include <sstream>
+
+
+using Poco::UTF8Codec;
+using Poco::UTF8Encoding;
+using Poco::UTF16Char;
+using Poco::UTF16String;
+using Poco::TextConverter;
+using Poco::OutputStreamConverter;
+
+
+namespace
+{
+	std::string randomText(Poco::Random& rnd, std::size_t length)
+		/// Returns valid UTF-8 text of about the given length, mostly ASCII.
+	{
+		static const char* chars[] =
+		{
+			"a", "Z", "0", " ", "\xC3\xA4", "\xDF\xBF", "\xE0\xA0\x80", "\xE2\x82\xAC",
+			"\xED\x9F\xBF", "\xEE\x80\x80", "\xF0\x90\x80\x80", "\xF0\x9F\x98\x80", "\xF4\x8F\xBF\xBF"
+		};
+		std::string text;
+		while (text.size() < length)
+		{
+			if (rnd.next(2) == 0)
+				text += chars[rnd.next(4)];
+			else
+				text += chars[rnd.next(sizeof(chars)/sizeof(chars[0]))];
+		}
+		return text;
+	}
+}
+
+
+UTF8CodecTest::UTF8CodecTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+UTF8CodecTest::~UTF8CodecTest()
+{
+}
+
+
+void UTF8CodecTest::testAsciiLength()
+{
+	assert (UTF8Codec::asciiLength("", 0) == 0);
+	assert (UTF8Codec::asciiLength("abc", 3) == 3);
+	assert (UTF8Codec::asciiLength("\xC3\xA4", 2) == 0);
+
+	for (std::size_t length = 1; length < 80; ++length)
+	{
+		std::string text(length, 'x');
+		assert (UTF8Codec::asciiLength(text.data(), length) == length);
+		for (std::size_t pos = 0; pos < length; ++pos)
+		{
+			text[pos] = '\x80';
+			assert (UTF8Codec::asciiLength(text.data(), length) == pos);
+			text[pos] = 'x';
+		}
+	}
+}
+
+
+void UTF8CodecTest::testValidLength()
+{
+	struct Case
+	{
+		const char* text;
+		std::size_t valid;
+	};
+	static const Case cases[] =
+	{
+		{"abc", 3},
+		{"\xC3\xA4", 2},
+		{"\xE2\x82\xAC", 3},
+		{"\xF0\x9F\x98\x80", 4},
+		{"\xF4\x8F\xBF\xBF", 4},
+		{"a\x80", 1},             // lone continuation byte
+		{"a\xC3", 1},             // incomplete sequence
+		{"a\xE2\x82", 1},
+		{"a\xC0\x80", 1},         // overlong
+		{"a\xC1\xBF", 1},
+		{"a\xE0\x9F\xBF", 1},
+		{"a\xF0\x8F\xBF\xBF", 1},
+		{"a\xED\xA0\x80", 1},     // surrogate
+		{"a\xED\x04\xBF", 1},
+		{"a\xF4\x90\x80\x80", 1}, // above U+10FFFF
+		{"a\xF5\x80\x80\x80", 1},
+		{"a\xC3\xA4\xFF", 3},
+		{"a\xC3\xA4\xFE", 3}
+	};
+	for (std::size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); ++i)
+	{
+		std::string text(cases[i].text);
+		for (int impl = UTF8Codec::IMPL_SCALAR; impl <= UTF8Codec::implementation(); ++impl)
+		{
+			UTF8Codec::Implementation im = static_cast<UTF8Codec::Implementation>(impl);
+			assert (UTF8Codec::validLength(text.data(), text.size(), im) == cases[i].valid);
+
+			// The same, after a block of ASCII text and a block of other text
+			std::string prefix = std::string(37, 'x') + std::string(20, '\0');
+			for (int k = 0; k < 10; ++k) prefix += "\xE2\x82\xAC";
+			std::string longText = prefix + text;
+			assert (UTF8Codec::validLength(longText.data(), longText.size(), im) == prefix.size() + cases[i].valid);
+		}
+		assert (UTF8Codec::isValid(text.data(), text.size()) == (cases[i].valid == text.size()));
+	}
+}
+
+
+void UTF8CodecTest::testImplementations()
+{
+	assert (UTF8Codec::isSupported(UTF8Codec::IMPL_SCALAR));
+	assert (UTF8Codec::isSupported(UTF8Codec::implementation()));
+
+	Poco::Random rnd;
+	rnd.seed(42);
+	for (int i = 0; i < 2000; ++i)
+	{
+		std::string text = randomText(rnd, rnd.next(200));
+		assert (UTF8Codec::validLength(text.data(), text.size(), UTF8Codec::IMPL_SCALAR) == text.size());
+		if (!text.empty() && i % 2)
+		{
+			// Put an arbitrary byte anywhere.
+			text[rnd.next(static_cast<Poco::UInt32>(text.size()))] = rnd.nextChar();
+		}
+		std::size_t expected = UTF8Codec::validLength(text.data(), text.size(), UTF8Codec::IMPL_SCALAR);
+		for (int impl = UTF8Codec::IMPL_SSSE3; impl <= UTF8Codec::implementation(); ++impl)
+		{
+			UTF8Codec::Implementation im = static_cast<UTF8Codec::Implementation>(impl);
+			assert (UTF8Codec::validLength(text.data(), text.size(), im) == expected);
+		}
+	}
+}
+
+
+void UTF8CodecTest::testToUTF16()
+{
+	std::string text("a\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80");
+	UTF16Char utf16[16];
+	std::size_t n = UTF8Codec::toUTF16(text.data(), text.size(), utf16);
+	assert (n == 5);
+	assert (utf16[0] == 'a');
+	assert (utf16[1] == 0x00E4);
+	assert (utf16[2] == 0x20AC);
+	assert (utf16[3] == 0xD83D);
+	assert (utf16[4] == 0xDE00);
+
+	assert (UTF8Codec::toUTF16("a\xC3", 2, utf16) == UTF8Codec::INVALID);
+	assert (UTF8Codec::toUTF16("", 0, utf16) == 0);
+
+	Poco::Random rnd;
+	rnd.seed(7);
+	UTF8Encoding utf8;
+	for (int i = 0; i < 200; ++i)
+	{
+		std::string text = randomText(rnd, rnd.next(100));
+		UTF16String utf16(text.size(), 0);
+		std::size_t n = UTF8Codec::toUTF16(text.data(), text.size(), &utf16[0] + 0);
+		assert (n != UTF8Codec::INVALID);
+
+		// Compare against decoding character by character.
+		UTF16String expected;
+		const unsigned char* p = reinterpret_cast<const unsigned char*>(text.data());
+		const unsigned char* end = p + text.size();
+		while (p < end)
+		{
+			int length = utf8.sequenceLength(p, static_cast<int>(end - p));
+			int ch = utf8.queryConvert(p, length);
+			if (ch > 0xFFFF)
+			{
+				ch -= 0x10000;
+				expected += static_cast<UTF16Char>(0xD800 | (ch >> 10));
+				expected += static_cast<UTF16Char>(0xDC00 | (ch & 0x3FF));
+			}
+			else expected += static_cast<UTF16Char>(ch);
+			p += length;
+		}
+		assert (utf16.substr(0, n) == expected);
+	}
+}
+
+
+void UTF8CodecTest::testFromUTF16()
+{
+	UTF16Char utf16[] = {'a', 0x00E4, 0x20AC, 0xD83D, 0xDE00};
+	char utf8[16];
+	std::size_t n = UTF8Codec::fromUTF16(utf16, 5, utf8);
+	assert (std::string(utf8, n) == "a\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80");
+
+	assert (UTF8Codec::fromUTF16(utf16, 4, utf8) == UTF8Codec::INVALID);     // high surrogate at end
+	assert (UTF8Codec::fromUTF16(utf16 + 4, 1, utf8) == UTF8Codec::INVALID); // lone low surrogate
+	UTF16Char unpaired[] = {0xD83D, 'a'};
+	assert (UTF8Codec::fromUTF16(unpaired, 2, utf8) == UTF8Codec::INVALID);
+
+	Poco::Random rnd;
+	rnd.seed(11);
+	for (int i = 0; i < 200; ++i)
+	{
+		std::string text = randomText(rnd, rnd.next(100));
+		UTF16String utf16(text.size(), 0);
+		std::size_t n = UTF8Codec::toUTF16(text.data(), text.size(), &utf16[0] + 0);
+		std::string utf8(3*n, '\0');
+		std::size_t m = UTF8Codec::fromUTF16(utf16.data(), n, &utf8[0] + 0);
+		assert (m != UTF8Codec::INVALID);
+		assert (utf8.substr(0, m) == text);
+	}
+}
+
+
+void UTF8CodecTest::testTextConverter()
+{
+	UTF8Encoding utf8;
+	TextConverter converter(utf8, utf8);
+
+	Poco::Random rnd;
+	rnd.seed(3);
+	for (int i = 0; i < 100; ++i)
+	{
+		std::string text = randomText(rnd, rnd.next(100));
+		std::string result;
+		assert (converter.convert(text, result) == 0);
+		assert (result == text);
+	}
+
+	// Invalid sequences are replaced, the rest is copied.
+	std::string text = std::string(40, 'a') + "\xFF" + std::string(40, 'b') + "\xC3\xA4";
+	std::string result;
+	assert (converter.convert(text.data(), static_cast<int>(text.size()), result) == 1);
+	assert (result == std::string(40, 'a') + "?" + std::string(40, 'b') + "\xC3\xA4");
+
+	result.clear();
+	assert (converter.convert(text, result) == 1);
+	assert (result == std::string(40, 'a') + "?" + std::string(40, 'b') + "\xC3\xA4");
+
+	assert (Poco::UTF8::toUpper(std::string(20, 'a') + "\xC3\xA4" + std::string(20, 'x')) == std::string(20, 'A') + "\xC3\x84" + std::string(20, 'X'));
+	assert (Poco::UTF8::toLower(std::string(20, 'A') + "\xC3\x84" + std::string(20, 'X')) == std::string(20, 'a') + "\xC3\xA4" + std::string(20, 'x'));
+}
+
+
+void UTF8CodecTest::testStreamConverter()
+{
+	UTF8Encoding utf8;
+	std::string text = std::string(30, 'a') + "\xE2\x82\xAC" + std::string(30, 'b');
+	for (std::size_t split = 0; split <= text.size(); ++split)
+	{
+		// Write the text in two parts, splitting a character at some point.
+		std::ostringstream ostr;
+		OutputStreamConverter converter(ostr, utf8, utf8);
+		converter.write(text.data(), static_cast<std::streamsize>(split));
+		converter.write(text.data() + split, static_cast<std::streamsize>(text.size() - split));
+		assert (converter.good());
+		assert (converter.errors() == 0);
+		assert (ostr.str() == text);
+	}
+
+	std::ostringstream ostr;
+	OutputStreamConverter converter(ostr, utf8, utf8);
+	converter.write("abc\xC0\x80xyz", 8);
+	assert (converter.errors() == 1);
+	assert (ostr.str() == "abc");
+}
+
+
+void UTF8CodecTest::setUp()
+{
+}
+
+
+void UTF8CodecTest::tearDown()
+{
+}
+
+
+CppUnit::Test* UTF8CodecTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("UTF8CodecTest");
+
+	CppUnit_addTest(pSuite, UTF8CodecTest, testAsciiLength);
+	CppUnit_addTest(pSuite, UTF8CodecTest, testValidLength);
+	CppUnit_addTest(pSuite, UTF8CodecTest, testImplementations);
+	CppUnit_addTest(pSuite, UTF8CodecTest, testToUTF16);
+	CppUnit_addTest(pSuite, UTF8CodecTest, testFromUTF16);
+	CppUnit_addTest(pSuite, UTF8CodecTest, testTextConverter);
+	CppUnit_addTest(pSuite, UTF8CodecTest, testStreamConverter);
+
+	return pSuite;
+}
@@ -0,0 +1,46 @@
+//
+// UTF8CodecTest.h
+//
+// $Id$
+//
+// Definition of the UTF8CodecTest class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef UTF8CodecTest_INCLUDED
+#define UTF8CodecTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+
+
+class UTF8CodecTest: public CppUnit::TestCase
+{
+public:
+	UTF8CodecTest(const std::string& name);
+	~UTF8CodecTest();
+
+	void testAsciiLength();
+	void testValidLength();
+	void testImplementations();
+	void testToUTF16();
+	void testFromUTF16();
+	void testTextConverter();
+	void testStreamConverter();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // UTF8CodecTest_INCLUDED
@@ -2588,6 +2588,33 @@ void VarTest::testIterator()
 }
 
 
+void VarTest::testAssignOwnContent()
+{
+	Var str = std::string("hello");
+	str = str.extract<std::string>();
+	assert (str == "hello");
+
+	std::vector<Var> vec;
+	vec.push_back(1);
+	vec.push_back(std::string("two"));
+	Var arr = vec;
+	arr = arr[1];
+	assert (arr == "two");
+
+	arr = vec;
+	arr = arr[0];
+	assert (arr == 1);
+
+	Var num = 42;
+	num = num;
+	assert (num == 42);
+	num.empty();
+	assert (num.isEmpty());
+	num = 3.5;
+	assert (num == 3.5);
+}
+
+
 void VarTest::setUp()
 {
 }
@@ -2645,6 +2672,7 @@ CppUnit::Test* VarTest::suite()
 	CppUnit_addTest(pSuite, VarTest, testDate);
 	CppUnit_addTest(pSuite, VarTest, testEmpty);
 	CppUnit_addTest(pSuite, VarTest, testIterator);
+	CppUnit_addTest(pSuite, VarTest, testAssignOwnContent);
 
 	return pSuite;
 }
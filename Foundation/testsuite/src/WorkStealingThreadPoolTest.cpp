@@ -0,0 +1,205 @@
+//
+// WorkStealingThreadPoolTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "WorkStealingThreadPoolTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/WorkStealingThreadPool.h"
+#include "Poco/RunnableAdapter.h"
+#include "Poco/Exception.h"
+#include "Poco/Thread.h"
+#include <vector>
+
+
+using Poco::Event;
+using Poco::WorkStealingThreadPool;
+using Poco::RunnableAdapter;
+using Poco::Runnable;
+using Poco::Thread;
+
+
+namespace
+{
+	class FanOut: public Runnable
+		/// Starts a number of child tasks from within the pool,
+		/// which end up in the worker's own queue and can be
+		/// stolen by the other workers.
+	{
+	public:
+		FanOut(WorkStealingThreadPool& pool, Runnable& child, int n):
+			_pool(pool),
+			_child(child),
+			_n(n)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < _n; ++i)
+			{
+				_pool.start(_child);
+			}
+		}
+
+	private:
+		WorkStealingThreadPool& _pool;
+		Runnable& _child;
+		int _n;
+	};
+}
+
+
+WorkStealingThreadPoolTest::WorkStealingThreadPoolTest(const std::string& name): 
+	CppUnit::TestCase(name), 
+	_event(Event::EVENT_MANUALRESET)
+{
+}
+
+
+WorkStealingThreadPoolTest::~WorkStealingThreadPoolTest()
+{
+}
+
+
+void WorkStealingThreadPoolTest::testStart()
+{
+	WorkStealingThreadPool pool("test", 4, 1000);
+	assert (pool.capacity() == 4);
+	assert (pool.queueCapacity() == 1000);
+	assert (pool.name() == "test");
+	assert (pool.pending() == 0);
+
+	RunnableAdapter<WorkStealingThreadPoolTest> ra(*this, &WorkStealingThreadPoolTest::count);
+	for (int i = 0; i < 1000; ++i)
+	{
+		pool.start(ra);
+	}
+	pool.joinAll();
+	assert (_count.value() == 1000);
+	assert (pool.pending() == 0);
+	assert (pool.queued() == 0);
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		pool.start(ra);
+	}
+	pool.joinAll();
+	assert (_count.value() == 2000);
+}
+
+
+void WorkStealingThreadPoolTest::testQueueCapacity()
+{
+	WorkStealingThreadPool pool(2, 4);
+
+	RunnableAdapter<WorkStealingThreadPoolTest> ra(*this, &WorkStealingThreadPoolTest::block);
+	// occupy both workers
+	pool.start(ra);
+	pool.start(ra);
+	while (pool.queued() > 0) Thread::sleep(10);
+
+	for (int i = 0; i < 4; ++i)
+	{
+		assert (pool.tryStart(ra));
+	}
+	assert (pool.queued() == 4);
+	assert (!pool.tryStart(ra));
+	try
+	{
+		pool.start(ra);
+		failmsg("submission queue full - must throw exception");
+	}
+	catch (Poco::NoThreadAvailableException&)
+	{
+	}
+	catch (...)
+	{
+		failmsg("wrong exception thrown");
+	}
+	assert (pool.pending() == 6);
+
+	_event.set();
+	pool.joinAll();
+	assert (_count.value() == 6);
+	assert (pool.pending() == 0);
+}
+
+
+void WorkStealingThreadPoolTest::testNested()
+{
+	WorkStealingThreadPool pool(4, 16);
+
+	RunnableAdapter<WorkStealingThreadPoolTest> ra(*this, &WorkStealingThreadPoolTest::count);
+	FanOut fanOut(pool, ra, 1000);
+	for (int i = 0; i < 10; ++i)
+	{
+		pool.start(fanOut);
+	}
+	pool.joinAll();
+	assert (_count.value() == 10000);
+	assert (pool.pending() == 0);
+}
+
+
+void WorkStealingThreadPoolTest::testStop()
+{
+	WorkStealingThreadPool pool(2, 16);
+
+	RunnableAdapter<WorkStealingThreadPoolTest> ra(*this, &WorkStealingThreadPoolTest::count);
+	for (int i = 0; i < 10; ++i)
+	{
+		pool.start(ra);
+	}
+	pool.stopAll();
+	assert (pool.capacity() == 0);
+	assert (pool.pending() == 0);
+	assert (_count.value() <= 10);
+	pool.joinAll();
+}
+
+
+void WorkStealingThreadPoolTest::setUp()
+{
+	_event.reset();
+	_count = 0;
+}
+
+
+void WorkStealingThreadPoolTest::tearDown()
+{
+}
+
+
+void WorkStealingThreadPoolTest::count()
+{
+	++_count;
+}
+
+
+void WorkStealingThreadPoolTest::block()
+{
+	_event.wait();
+	++_count;
+}
+
+
+CppUnit::Test* WorkStealingThreadPoolTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("WorkStealingThreadPoolTest");
+
+	CppUnit_addTest(pSuite, WorkStealingThreadPoolTest, testStart);
+	CppUnit_addTest(pSuite, WorkStealingThreadPoolTest, testQueueCapacity);
+	CppUnit_addTest(pSuite, WorkStealingThreadPoolTest, testNested);
+	CppUnit_addTest(pSuite, WorkStealingThreadPoolTest, testStop);
+
+	return pSuite;
+}
@@ -0,0 +1,51 @@
+//
+// WorkStealingThreadPoolTest.h
+//
+// $Id$
+//
+// Definition of the WorkStealingThreadPoolTest class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef WorkStealingThreadPoolTest_INCLUDED
+#define WorkStealingThreadPoolTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+#include "Poco/Event.h"
+#include "Poco/AtomicCounter.h"
+
+
+class WorkStealingThreadPoolTest: public CppUnit::TestCase
+{
+public:
+	WorkStealingThreadPoolTest(const std::string& name);
+	~WorkStealingThreadPoolTest();
+
+	void testStart();
+	void testQueueCapacity();
+	void testNested();
+	void testStop();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+protected:
+	void count();
+	void block();
+
+private:
+	Poco::Event _event;
+	Poco::AtomicCounter _count;
+};
+
+
+#endif // WorkStealingThreadPoolTest_INCLUDED
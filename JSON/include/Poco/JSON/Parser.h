@@ -268,6 +268,12 @@ private:
 
 	void parseBufferPopBackChar();
 
+	std::size_t parseBufferAppendString(const char* begin, const char* end);
+		/// Appends the characters of a string value starting at begin that
+		/// need no further parsing (valid UTF-8 up to the next quote,
+		/// backslash or control character) to the parse buffer, and
+		/// returns their number.
+
 	void addCharToParseBuffer(CharIntType nextChar, int nextClass);
 
 	void addEscapedCharToParseBuffer(CharIntType nextChar);
@@ -300,6 +306,21 @@ private:
 			return true;
 		}
 
+		const IT& position() const
+		{
+			return _it;
+		}
+
+		const IT& end() const
+		{
+			return _end;
+		}
+
+		void skip(std::size_t n)
+		{
+			_it += n;
+		}
+
 	private:
 		IT _it;
 		IT _end;
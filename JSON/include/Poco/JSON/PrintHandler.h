@@ -111,6 +111,9 @@ private:
 	void arrayValue();
 	bool array() const;
 
+	template <typename T>
+	void writeNumber(T value);
+
 	std::ostream& _out;
 	unsigned      _indent;
 	std::string   _tab;
@@ -21,8 +21,73 @@
 #include "Poco/FileStream.h"
 #include "Poco/StreamCopier.h"
 #include "Poco/Stopwatch.h"
+#include "Poco/AllocationTracker.h"
 #include <iostream>
 #include <iomanip>
+#include <cstdlib>
+#include <new>
+
+
+//
+// Count heap allocations, to show how many of them
+// parsing a document takes.
+//
+
+
+#if defined(POCO_ENABLE_ALLOCATION_TRACKING)
+
+
+// Foundation already replaces operator new and delete,
+// and counts the allocations for each component.
+static unsigned long allocations()
+{
+	Poco::Int64 count = 0;
+	for (int i = 0; i < Poco::AllocationTracker::COMPONENT_COUNT; ++i)
+	{
+		Poco::AllocationTracker::Statistics stats;
+		Poco::AllocationTracker::statistics(static_cast<Poco::AllocationTracker::Component>(i), stats);
+		count += stats.allocations;
+	}
+	return static_cast<unsigned long>(count);
+}
+
+
+#else
+
+
+#if __cplusplus < 201103L
+	#define BENCHMARK_THROW_BAD_ALLOC throw(std::bad_alloc)
+#else
+	#define BENCHMARK_THROW_BAD_ALLOC
+#endif
+
+
+// The sample is single threaded, so a plain counter is sufficient.
+static unsigned long allocationCount = 0;
+
+
+void* operator new(std::size_t size) BENCHMARK_THROW_BAD_ALLOC
+{
+	++allocationCount;
+	void* p = std::malloc(size ? size : 1);
+	if (!p) throw std::bad_alloc();
+	return p;
+}
+
+
+void operator delete(void* p) throw()
+{
+	std::free(p);
+}
+
+
+static unsigned long allocations()
+{
+	return allocationCount;
+}
+
+
+#endif // POCO_ENABLE_ALLOCATION_TRACKING
 
 
 int main(int argc, char** argv)
@@ -60,19 +125,25 @@ int main(int argc, char** argv)
 	std::cout << std::endl << "POCO JSON barebone parse" << std::endl;
 	Poco::JSON::Parser sparser(0);
 	sw.restart();
+	unsigned long count = allocations();
 	sparser.parse(jsonStr);
+	count = allocations() - count;
 	sw.stop();
 	std::cout << "---------------------------------" << std::endl;
 	std::cout << "[std::string] parsed in " << sw.elapsed() << " [us]" << std::endl;
+	std::cout << count << " allocations" << std::endl;
 	std::cout << "---------------------------------" << std::endl;
 
 	Poco::JSON::Parser iparser(0);
 	std::istringstream istr(jsonStr);
 	sw.restart();
+	count = allocations();
 	iparser.parse(istr);
+	count = allocations() - count;
 	sw.stop();
 	std::cout << "----------------------------------------" << std::endl;
 	std::cout << "[std::istringstream] parsed in " << sw.elapsed() << " [us]" << std::endl;
+	std::cout << count << " allocations" << std::endl;
 	std::cout << "----------------------------------------" << std::endl;
 
 	std::cout << std::endl << "POCO JSON Handle/Stringify" << std::endl;
@@ -80,21 +151,27 @@ int main(int argc, char** argv)
 	{
 		Poco::JSON::Parser sparser;
 		sw.restart();
+		count = allocations();
 		sparser.parse(jsonStr);
 		Poco::DynamicAny result = sparser.result();
+		count = allocations() - count;
 		sw.stop();
 		std::cout << "-----------------------------------------" << std::endl;
 		std::cout << "[std::string] parsed/handled in " << sw.elapsed() << " [us]" << std::endl;
+		std::cout << count << " allocations" << std::endl;
 		std::cout << "-----------------------------------------" << std::endl;
 
 		Poco::JSON::Parser isparser;
 		std::istringstream istr(jsonStr);
 		sw.restart();
+		count = allocations();
 		isparser.parse(istr);
 		result = isparser.result();
+		count = allocations() - count;
 		sw.stop();
 		std::cout << "------------------------------------------------" << std::endl;
 		std::cout << "[std::istringstream] parsed/handled in " << sw.elapsed() << " [us]" << std::endl;
+		std::cout << count << " allocations" << std::endl;
 		std::cout << "------------------------------------------------" << std::endl;
 
 		//Serialize to string
@@ -104,10 +181,13 @@ int main(int argc, char** argv)
 
 		std::ostringstream out;
 		sw.restart();
+		count = allocations();
 		obj->stringify(out);
+		count = allocations() - count;
 		sw.stop();
 		std::cout << "-----------------------------------" << std::endl;
 		std::cout << "stringified in " << sw.elapsed() << " [us]" << std::endl;
+		std::cout << count << " allocations" << std::endl;
 		std::cout << "-----------------------------------" << std::endl;
 		std::cout << std::endl;
 	}
@@ -46,7 +46,7 @@ void ParseHandler::reset()
 
 void ParseHandler::startObject()
 {
-	Object::Ptr newObj = new Object(_preserveObjectOrder);
+	Object::Ptr newObj = makeShared<Object>(_preserveObjectOrder);
 
 	if ( _stack.empty() ) // The first object
 	{
@@ -82,7 +82,7 @@ void ParseHandler::endObject()
 
 void ParseHandler::startArray()
 {
-	Array::Ptr newArr = new Array();
+	Array::Ptr newArr = makeShared<Array>();
 
 	if ( _stack.empty() ) // The first array
 	{
@@ -19,7 +19,9 @@
 #include "Poco/Ascii.h"
 #include "Poco/Token.h"
 #include "Poco/UTF8Encoding.h"
+#include "Poco/UTF8Codec.h"
 #include "Poco/String.h"
+#include "Poco/AllocationTracker.h"
 #undef min
 #undef max
 #include <limits>
@@ -144,15 +146,21 @@ void Parser::reset()
 
 Dynamic::Var Parser::parse(const std::string& json)
 {
-	std::string::const_iterator it = json.begin();
-	std::string::const_iterator end = json.end();
-	Source<std::string::const_iterator> source(it, end);
+	AllocationScope scope(AllocationTracker::COMPONENT_JSON);
+
+	const char* it = json.data();
+	const char* end = it + json.size();
+	Source<const char*> source(it, end);
 
 	int c = 0;
 	while(source.nextChar(c))
 	{
 		if (0 == parseChar(c, source))
 			throw SyntaxException("JSON syntax error");
+
+		// Within strings, go through runs of ordinary characters at once.
+		if (_state == ST && !_escaped)
+			source.skip(parseBufferAppendString(source.position(), source.end()));
 	}
 
 	if (!done())
@@ -164,6 +172,8 @@ Dynamic::Var Parser::parse(const std::string& json)
 
 Dynamic::Var Parser::parse(std::istream& in)
 {
+	AllocationScope scope(AllocationTracker::COMPONENT_JSON);
+
 	std::istreambuf_iterator<char> it(in.rdbuf());
 	std::istreambuf_iterator<char> end;
 	Source<std::istreambuf_iterator<char> > source(it, end);
@@ -231,6 +241,21 @@ void Parser::parseBufferPushBackChar(char c)
 }
 
 
+std::size_t Parser::parseBufferAppendString(const char* begin, const char* end)
+{
+	const char* it = begin;
+	while (it != end && *it != '"' && *it != '\\' && static_cast<unsigned char>(*it) >= 0x20) ++it;
+	std::size_t n = UTF8Codec::validLength(begin, it - begin);
+	if (n == 0) return 0;
+
+	std::size_t size = _parseBuffer.size() + n + 1;
+	if (size > _parseBuffer.capacity())
+		_parseBuffer.setCapacity(size > 2*_parseBuffer.capacity() ? size : 2*_parseBuffer.capacity());
+	_parseBuffer.append(begin, n);
+	return n;
+}
+
+
 void Parser::addEscapedCharToParseBuffer(CharIntType nextChar)
 {
 	_escaped = 0;
@@ -401,18 +426,30 @@ void Parser::parseBuffer()
 					// Float can't end with a dot
 					if (_parseBuffer[_parseBuffer.size() - 1] == '.' ) throw SyntaxException("JSON syntax error");
 
-					double float_value = NumberParser::parseFloat(std::string(_parseBuffer.begin(), _parseBuffer.size()));
+					double float_value;
+					if (!NumberParser::tryParseFloat(_parseBuffer.begin(), _parseBuffer.begin() + _parseBuffer.size(), float_value))
+						float_value = NumberParser::parseFloat(std::string(_parseBuffer.begin(), _parseBuffer.size()));
 					_pHandler->value(float_value);
 					break;
 				}
 			case JSON_T_INTEGER:
 				{
 #if defined(POCO_HAVE_INT64)
-					std::string numStr(_parseBuffer.begin(), _parseBuffer.size());
-					try
+					const char* begin = _parseBuffer.begin();
+					const char* end = begin + _parseBuffer.size();
+					Int64 value = 0;
+					UInt64 uvalue = 0;
+					bool isSigned = NumberParser::tryParse64(begin, end, value);
+					// try to handle error as unsigned in case of overflow
+					if (!isSigned && !NumberParser::tryParseUnsigned64(begin, end, uvalue))
 					{
+						std::string numStr(begin, end);
 						Poco::trimInPlace(numStr);
-						Int64 value = NumberParser::parse64(numStr);
+						isSigned = NumberParser::tryParse64(numStr, value);
+						if (!isSigned) uvalue = NumberParser::parseUnsigned64(numStr);
+					}
+					if (isSigned)
+					{
 						// if number is 32-bit, then handle as such
 						if (value > std::numeric_limits<int>::max()
 						 || value < std::numeric_limits<int>::min() )
@@ -424,18 +461,16 @@ void Parser::parseBuffer()
 							_pHandler->value(static_cast<int>(value));
 						}
 					}
-					// try to handle error as unsigned in case of overflow
-					catch ( const SyntaxException& )
+					else
 					{
-						UInt64 value = NumberParser::parseUnsigned64(numStr);
 						// if number is 32-bit, then handle as such
-						if ( value > std::numeric_limits<unsigned>::max() )
+						if ( uvalue > std::numeric_limits<unsigned>::max() )
 						{
-							_pHandler->value(value);
+							_pHandler->value(uvalue);
 						}
 						else
 						{
-							_pHandler->value(static_cast<unsigned>(value));
+							_pHandler->value(static_cast<unsigned>(uvalue));
 						}
 					}
 #else
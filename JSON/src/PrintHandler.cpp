@@ -16,6 +16,7 @@
 
 #include "Poco/JSON/PrintHandler.h"
 #include "Poco/JSON/Stringifier.h"
+#include "Poco/NumberFormatter.h"
 #include <iostream>
 
 
@@ -141,7 +142,7 @@ void PrintHandler::null()
 void PrintHandler::value(int v)
 {
 	arrayValue();
-	_out << v;
+	writeNumber(v);
 	_objStart = false;
 }
 
@@ -149,7 +150,7 @@ void PrintHandler::value(int v)
 void PrintHandler::value(unsigned v)
 {
 	arrayValue();
-	_out << v;
+	writeNumber(v);
 	_objStart = false;
 }
 
@@ -158,7 +159,7 @@ void PrintHandler::value(unsigned v)
 void PrintHandler::value(Int64 v)
 {
 	arrayValue();
-	_out << v;
+	writeNumber(v);
 	_objStart = false;
 }
 
@@ -166,7 +167,7 @@ void PrintHandler::value(Int64 v)
 void PrintHandler::value(UInt64 v)
 {
 	arrayValue();
-	_out << v;
+	writeNumber(v);
 	_objStart = false;
 }
 #endif
@@ -196,6 +197,14 @@ void PrintHandler::value(bool b)
 }
 
 
+template <typename T>
+void PrintHandler::writeNumber(T value)
+{
+	char buffer[NumberFormatter::NF_MAX_INT_STRING_LEN];
+	_out.write(buffer, static_cast<std::streamsize>(NumberFormatter::formatTo(buffer, sizeof(buffer), value)));
+}
+
+
 void PrintHandler::comma()
 {
 	_out << ',' << endLine();
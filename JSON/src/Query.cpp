@@ -51,7 +51,7 @@ Object::Ptr Query::findObject(const std::string& path) const
 	if (result.type() == typeid(Object::Ptr))
 		return result.extract<Object::Ptr>();
 	else if (result.type() == typeid(Object))
-		return new Object(result.extract<Object>());
+		return makeShared<Object>(result.extract<Object>());
 
 	return 0;
 }
@@ -79,7 +79,7 @@ Array::Ptr Query::findArray(const std::string& path) const
 	if (result.type() == typeid(Array::Ptr))
 		return result.extract<Array::Ptr>();
 	else if (result.type() == typeid(Array))
-		return new Array(result.extract<Array>());
+		return makeShared<Array>(result.extract<Array>());
 
 	return 0;
 }
@@ -18,12 +18,43 @@
 #include "Poco/JSON/Array.h"
 #include "Poco/JSON/Object.h"
 #include "Poco/JSONString.h"
+#include "Poco/NumberFormatter.h"
 #include <iomanip>
 
 
 using Poco::Dynamic::Var;
 
 
+namespace
+{
+	template <typename T, typename F>
+	bool writeNumber(const Var& any, std::ostream& out)
+		/// Writes the value of any, if it holds a T, formatted
+		/// as F without a temporary string.
+	{
+		if (any.type() != typeid(T)) return false;
+		char buffer[Poco::NumberFormatter::NF_MAX_SHORTEST_STRING_LEN];
+		std::size_t n = Poco::NumberFormatter::formatTo(buffer, sizeof(buffer), static_cast<F>(any.extract<T>()));
+		out.write(buffer, static_cast<std::streamsize>(n));
+		return true;
+	}
+
+	bool writeNumber(const Var& any, std::ostream& out)
+	{
+		return writeNumber<int, int>(any, out)
+			|| writeNumber<double, double>(any, out)
+			|| writeNumber<Poco::Int64, Poco::Int64>(any, out)
+			|| writeNumber<Poco::UInt64, Poco::UInt64>(any, out)
+			|| writeNumber<unsigned, unsigned>(any, out)
+			|| writeNumber<float, float>(any, out)
+			|| writeNumber<Poco::Int16, int>(any, out)
+			|| writeNumber<Poco::UInt16, unsigned>(any, out)
+			|| writeNumber<Poco::Int8, int>(any, out)
+			|| writeNumber<Poco::UInt8, unsigned>(any, out);
+	}
+}
+
+
 namespace Poco {
 namespace JSON {
 
@@ -58,9 +89,12 @@ void Stringifier::stringify(const Var& any, std::ostream& out, unsigned int inde
 	}
 	else if (any.isNumeric() || any.isBoolean())
 	{
-		std::string value = any.convert<std::string>();
-		if (any.type() == typeid(char)) formatString(value, out);
-		else out << value;
+		if (!writeNumber(any, out))
+		{
+			std::string value = any.convert<std::string>();
+			if (any.type() == typeid(char)) formatString(value, out);
+			else out << value;
+		}
 	}
 	else
 	{
@@ -1783,6 +1783,46 @@ void JSONTest::testSmallBuffer()
 }
 
 
+void JSONTest::testLongStrings()
+{
+	// Parsing from a string takes a shortcut through ordinary
+	// characters in strings; from a stream it does not.
+	std::string text;
+	for (int i = 0; i < 20; ++i) text += "abcdefgh \xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80";
+	std::string json = "{ \"" + text + "\" : [ \"" + text + "\\n\\u00e4\\\"" + text + "\", \"\", \"x\" ] }";
+
+	Parser parser;
+	Var result = parser.parse(json);
+	Object::Ptr pObject = result.extract<Object::Ptr>();
+	Poco::JSON::Array::Ptr pArray = pObject->getArray(text);
+	assert (!pArray.isNull());
+	assert (pArray->size() == 3);
+	assert (pArray->getElement<std::string>(0) == text + "\n\xC3\xA4\"" + text);
+	assert (pArray->getElement<std::string>(1) == "");
+	assert (pArray->getElement<std::string>(2) == "x");
+
+	std::istringstream istr(json);
+	parser.reset();
+	Var streamResult = parser.parse(istr);
+	assert (streamResult.extract<Object::Ptr>()->getArray(text)->getElement<std::string>(0) == text + "\n\xC3\xA4\"" + text);
+
+	// Invalid UTF-8 and control characters are still rejected.
+	std::string invalid[] = {text + "\xC3", text + "\xC0\x80" + text, text + "\t" + text};
+	for (int i = 0; i < 3; ++i)
+	{
+		parser.reset();
+		try
+		{
+			parser.parse("[ \"" + invalid[i] + "\" ]");
+			fail("invalid string - must throw");
+		}
+		catch (Poco::Exception&)
+		{
+		}
+	}
+}
+
+
 std::string JSONTest::getTestFilesPath(const std::string& type)
 {
 	std::ostringstream ostr;
@@ -1855,6 +1895,7 @@ CppUnit::Test* JSONTest::suite()
 	CppUnit_addTest(pSuite, JSONTest, testTemplate);
 	CppUnit_addTest(pSuite, JSONTest, testUnicode);
 	CppUnit_addTest(pSuite, JSONTest, testSmallBuffer);
+	CppUnit_addTest(pSuite, JSONTest, testLongStrings);
 
 	return pSuite;
 }
@@ -77,6 +77,7 @@ public:
 	void testUnicode(); 
 	void testInvalidUnicodeJanssonFiles();
 	void testSmallBuffer();
+	void testLongStrings();
 
 	void setUp();
 	void tearDown();
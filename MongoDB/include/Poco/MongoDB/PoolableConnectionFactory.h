@@ -22,6 +22,7 @@
 
 #include "Poco/MongoDB/Connection.h"
 #include "Poco/ObjectPool.h"
+#include "Poco/ConcurrentObjectPool.h"
 
 
 namespace Poco {
@@ -77,16 +78,24 @@ class PooledConnection
 	/// Helper class for borrowing and returning a connection automatically from a pool.
 {
 public:
-	PooledConnection(Poco::ObjectPool<Connection, Connection::Ptr>& pool, long timeoutMilliseconds = 0) : _pool(pool)
+	PooledConnection(Poco::ObjectPool<Connection, Connection::Ptr>& pool, long timeoutMilliseconds = 0) : _pPool(&pool), _pConcurrentPool(0)
 	{
-		_connection = _pool.borrowObject(timeoutMilliseconds);
+		_connection = pool.borrowObject(timeoutMilliseconds);
+	}
+
+	PooledConnection(Poco::ConcurrentObjectPool<Connection, Connection::Ptr>& pool, long timeoutMilliseconds = 0) : _pPool(0), _pConcurrentPool(&pool)
+	{
+		_connection = pool.borrowObject(timeoutMilliseconds);
 	}
 
 	virtual ~PooledConnection()
 	{
 		try
 		{
-			_pool.returnObject(_connection);
+			if (_pPool)
+				_pPool->returnObject(_connection);
+			else
+				_pConcurrentPool->returnObject(_connection);
 		}
 		catch (...)
 		{
@@ -100,7 +109,8 @@ public:
 	}
 
 private:
-	Poco::ObjectPool<Connection, Connection::Ptr>& _pool;
+	Poco::ObjectPool<Connection, Connection::Ptr>* _pPool;
+	Poco::ConcurrentObjectPool<Connection, Connection::Ptr>* _pConcurrentPool;
 	Connection::Ptr _connection;
 };
 
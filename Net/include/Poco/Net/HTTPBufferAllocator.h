@@ -21,7 +21,7 @@
 
 
 #include "Poco/Net/Net.h"
-#include "Poco/MemoryPool.h"
+#include "Poco/ThreadCachingMemoryPool.h"
 #include <ios>
 
 
@@ -42,7 +42,7 @@ public:
 	};
 
 private:
-	static Poco::MemoryPool _pool;
+	static Poco::ThreadCachingMemoryPool _pool;
 };
 
 
@@ -22,7 +22,7 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/HTTPBasicStreamBuf.h"
-#include "Poco/MemoryPool.h"
+#include "Poco/ThreadCachingMemoryPool.h"
 #include <cstddef>
 #include <istream>
 #include <ostream>
@@ -82,7 +82,7 @@ public:
 	void operator delete(void* ptr);
 	
 private:
-	static Poco::MemoryPool _pool;
+	static Poco::ThreadCachingMemoryPool _pool;
 };
 
 
@@ -97,7 +97,7 @@ public:
 	void operator delete(void* ptr);
 	
 private:
-	static Poco::MemoryPool _pool;
+	static Poco::ThreadCachingMemoryPool _pool;
 };
 
 
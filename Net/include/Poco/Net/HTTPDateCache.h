@@ -0,0 +1,70 @@
+//
+// HTTPDateCache.h
+//
+// $Id$
+//
+// Library: Net
+// Package: HTTP
+// Module:  HTTPDateCache
+//
+// Definition of the HTTPDateCache class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Net_HTTPDateCache_INCLUDED
+#define Net_HTTPDateCache_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Timestamp.h"
+
+
+namespace Poco {
+namespace Net {
+
+
+class Net_API HTTPDateCache
+	/// HTTPDateCache formats timestamps for the Date header
+	/// of HTTP messages, in DateTimeFormat::HTTP_FORMAT.
+	///
+	/// A server sends the current time with every response,
+	/// but its text changes only once a second. HTTPDateCache
+	/// therefore keeps the text for the most recent second in
+	/// a ThreadLocal, and formats a timestamp only if it belongs
+	/// to another second. Threads never wait for each other.
+	///
+	/// Threads not created by Poco share a single thread-local
+	/// storage, so they format every timestamp.
+{
+public:
+	static std::string format(const Poco::Timestamp& timestamp);
+		/// Returns the given timestamp in HTTP format.
+
+	static void format(const Poco::Timestamp& timestamp, std::string& date);
+		/// Assigns the given timestamp in HTTP format to date.
+
+private:
+	HTTPDateCache();
+};
+
+
+//
+// inlines
+//
+inline std::string HTTPDateCache::format(const Poco::Timestamp& timestamp)
+{
+	std::string date;
+	format(timestamp, date);
+	return date;
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_HTTPDateCache_INCLUDED
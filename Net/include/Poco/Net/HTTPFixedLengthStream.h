@@ -87,7 +87,7 @@ public:
 	void operator delete(void* ptr);
 	
 private:
-	static Poco::MemoryPool _pool;
+	static Poco::ThreadCachingMemoryPool _pool;
 };
 
 
@@ -102,7 +102,7 @@ public:
 	void operator delete(void* ptr);
 	
 private:
-	static Poco::MemoryPool _pool;
+	static Poco::ThreadCachingMemoryPool _pool;
 };
 
 
@@ -81,6 +81,30 @@ public:
 		///
 		/// New threads are taken from the given thread pool.
 
+	HTTPServer(HTTPRequestHandlerFactory::Ptr pFactory, Poco::PartitionedThreadPool& threadPool, const ServerSocket& socket, HTTPServerParams::Ptr pParams);
+		/// Creates the HTTPServer, using the given ServerSocket.
+		///
+		/// The server takes ownership of the HTTPRequstHandlerFactory
+		/// and deletes it when it's no longer needed.
+		///
+		/// The server also takes ownership of the HTTPServerParams object.
+		///
+		/// New threads are taken from all partitions of the
+		/// given thread pool in turn.
+
+	HTTPServer(HTTPRequestHandlerFactory::Ptr pFactory, Poco::PartitionedThreadPool& threadPool, int partition, const ServerSocket& socket, HTTPServerParams::Ptr pParams);
+		/// Creates the HTTPServer, using the given ServerSocket.
+		///
+		/// The server takes ownership of the HTTPRequstHandlerFactory
+		/// and deletes it when it's no longer needed.
+		///
+		/// The server also takes ownership of the HTTPServerParams object.
+		///
+		/// The thread accepting connections runs on the processors
+		/// of the given partition, and new threads are taken from
+		/// that partition only. See TCPServer for how to serve
+		/// connections in all partitions.
+
 	~HTTPServer();
 		/// Destroys the HTTPServer and its HTTPRequestHandlerFactory.
 
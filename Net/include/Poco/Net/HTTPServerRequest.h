@@ -23,6 +23,7 @@
 #include "Poco/Net/Net.h"
 #include "Poco/Net/HTTPRequest.h"
 #include "Poco/Net/SocketAddress.h"
+#include "Poco/Arena.h"
 #include <istream>
 
 
@@ -73,9 +74,32 @@ public:
 		/// connection. Returns false if no secure connection
 		/// is used, or if it is not known whether a secure
 		/// connection is used.
+
+	Poco::Arena& arena();
+		/// Returns an Arena for data that is only needed while the
+		/// request is handled. All memory taken from it is released
+		/// at once when the request object is destroyed, after the
+		/// request handler has returned. For example:
+		///
+		///     typedef std::vector<std::string, Poco::ArenaAllocator<std::string> > Vec;
+		///     Vec names(request.arena());
+		///
+		/// The Arena does not allocate memory until it is used.
+
+private:
+	Poco::Arena _arena;
 };
 
 
+//
+// inlines
+//
+inline Poco::Arena& HTTPServerRequest::arena()
+{
+	return _arena;
+}
+
+
 } } // namespace Poco::Net
 
 
@@ -0,0 +1,114 @@
+//
+// PollSet.h
+//
+// $Id$
+//
+// Library: Net
+// Package: Sockets
+// Module:  PollSet
+//
+// Definition of the PollSet class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Net_PollSet_INCLUDED
+#define Net_PollSet_INCLUDED
+
+
+#include "Poco/Net/Socket.h"
+#include <map>
+
+
+namespace Poco {
+namespace Net {
+
+
+class PollSetImpl;
+
+
+class Net_API PollSet
+	/// A set of sockets that can be efficiently polled as a whole.
+	///
+	/// In contrast to Socket::select(), which must build and tear
+	/// down the underlying kernel structures on every call, a PollSet
+	/// keeps its state across calls and is updated incrementally
+	/// by add(), update() and remove().
+	///
+	/// If supported by the platform, PollSet is implemented using
+	/// epoll (Linux). Otherwise poll() or select() is used, in which
+	/// case the set of sockets is still maintained incrementally, but
+	/// the system call itself is O(n) in the number of sockets.
+	///
+	/// It is safe to call add(), update() and remove() from another
+	/// thread while poll() is in progress.
+{
+public:
+	enum Mode
+	{
+		POLL_READ  = Socket::SELECT_READ,
+		POLL_WRITE = Socket::SELECT_WRITE,
+		POLL_ERROR = Socket::SELECT_ERROR
+	};
+
+	typedef std::map<Poco::Net::Socket, int> SocketModeMap;
+
+	PollSet();
+		/// Creates an empty PollSet.
+
+	~PollSet();
+		/// Destroys the PollSet.
+
+	void add(const Poco::Net::Socket& socket, int mode);
+		/// Adds the given socket to the set, for polling with
+		/// the given mode, which is a combination of POLL_READ,
+		/// POLL_WRITE and POLL_ERROR.
+		///
+		/// If the socket is already in the set, its mode is
+		/// replaced with the given one.
+
+	void remove(const Poco::Net::Socket& socket);
+		/// Removes the given socket from the set.
+		///
+		/// Does nothing if the socket is not in the set.
+
+	void update(const Poco::Net::Socket& socket, int mode);
+		/// Updates the mode of the given socket.
+		///
+		/// Does nothing if the socket is not in the set.
+
+	bool has(const Poco::Net::Socket& socket) const;
+		/// Returns true iff the given socket is in the set.
+
+	bool empty() const;
+		/// Returns true iff the set contains no sockets.
+
+	void clear();
+		/// Removes all sockets from the set.
+
+	SocketModeMap poll(const Poco::Timespan& timeout);
+		/// Waits until the state of at least one of the sockets
+		/// in the set changes accordingly to its mode, or the
+		/// timeout expires.
+		///
+		/// Returns a map containing the sockets that are ready,
+		/// together with their ready state (combination of
+		/// POLL_READ, POLL_WRITE and POLL_ERROR). The map is
+		/// empty if the timeout expired.
+
+private:
+	PollSetImpl* _pImpl;
+
+	PollSet(const PollSet&);
+	PollSet& operator = (const PollSet&);
+};
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_PollSet_INCLUDED
@@ -428,6 +428,7 @@ private:
 	
 	friend class Socket;
 	friend class SecureSocketImpl;
+	friend class PollSetImpl;
 };
 
 
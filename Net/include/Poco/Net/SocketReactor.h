@@ -22,6 +22,7 @@
 
 #include "Poco/Net/Net.h"
 #include "Poco/Net/Socket.h"
+#include "Poco/Net/PollSet.h"
 #include "Poco/Runnable.h"
 #include "Poco/Timespan.h"
 #include "Poco/Observer.h"
@@ -71,7 +72,10 @@ class Net_API SocketReactor: public Poco::Runnable
 	/// as argument.
 	///
 	/// Once started, the SocketReactor waits for events
-	/// on the registered sockets, using Socket::select().
+	/// on the registered sockets, using a PollSet. The PollSet
+	/// is updated incrementally as event handlers are added and
+	/// removed, so the cost of waiting does not grow with the
+	/// number of idle sockets (if the platform supports epoll).
 	/// If an event is detected, the corresponding event handler
 	/// is invoked. There are five event types (and corresponding
 	/// notification classes) defined: ReadableNotification, WritableNotification,
@@ -89,8 +93,8 @@ class Net_API SocketReactor: public Poco::Runnable
 	/// which can be overridden by subclasses to perform custom
 	/// timeout processing.
 	///
-	/// If there are no sockets for the SocketReactor to pass to
-	/// Socket::select(), an IdleNotification will be dispatched to
+	/// If there are no sockets for the SocketReactor to wait
+	/// for, an IdleNotification will be dispatched to
 	/// all event handlers registered for it. This is done in the
 	/// onIdle() method which can be overridden by subclasses
 	/// to perform custom idle processing. Since onIdle() will be
@@ -144,7 +148,7 @@ public:
 		///
 		/// The default timeout is 250 milliseconds;
 		///
-		/// The timeout is passed to the Socket::select()
+		/// The timeout is passed to the PollSet::poll()
 		/// method.
 		
 	const Poco::Timespan& getTimeout() const;
@@ -176,7 +180,7 @@ protected:
 		/// implementations.
 
 	virtual void onIdle();
-		/// Called if no sockets are available to call select() on.
+		/// Called if no sockets are available to poll.
 		///
 		/// Can be overridden by subclasses. The default implementation
 		/// dispatches the IdleNotification and thus should be called by overriding
@@ -209,6 +213,7 @@ private:
 	typedef std::map<Socket, NotifierPtr>     EventHandlerMap;
 
 	void dispatch(NotifierPtr& pNotifier, SocketNotification* pNotification);
+	void updatePollSet(const Socket& socket, NotifierPtr& pNotifier);
 
 	enum
 	{
@@ -218,6 +223,7 @@ private:
 	bool            _stop;
 	Poco::Timespan  _timeout;
 	EventHandlerMap _handlers;
+	PollSet         _pollSet;
 	NotificationPtr _pReadableNotification;
 	NotificationPtr _pWritableNotification;
 	NotificationPtr _pErrorNotification;
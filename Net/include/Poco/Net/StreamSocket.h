@@ -116,6 +116,9 @@ public:
 		/// the buffer transitions between empty, partially full and
 		/// full states.
 		///
+		/// The data is sent directly out of the buffer's
+		/// read segments (see FIFOBuffer::readSegments()).
+		///
 		/// Returns the number of bytes sent, which may be
 		/// less than the number of bytes specified.
 		///
@@ -141,6 +144,9 @@ public:
 		/// to notify the caller when the buffer transitions between empty, 
 		/// partially full and full states.
 		///
+		/// The data is received directly into the buffer's
+		/// first write segment (see FIFOBuffer::writeSegments()).
+		///
 		/// Returns the number of bytes received. 
 		/// A return value of 0 means a graceful shutdown 
 		/// of the connection from the peer.
@@ -27,6 +27,8 @@
 #include "Poco/Runnable.h"
 #include "Poco/Thread.h"
 #include "Poco/ThreadPool.h"
+#include "Poco/PartitionedThreadPool.h"
+#include <vector>
 
 
 namespace Poco {
@@ -76,6 +78,21 @@ class Net_API TCPServer: public Poco::Runnable
 	/// After calling stop(), no new connections will be accepted and
 	/// all queued connections will be discarded.
 	/// Already served connections, however, will continue being served.
+	///
+	/// If the server is given a PartitionedThreadPool, each partition
+	/// has a connection queue of its own, and the limits set in the
+	/// TCPServerParams apply to each partition. Accepted connections
+	/// are handed to the partitions in turn.
+	///
+	/// If the server is given a partition index as well, the thread
+	/// accepting connections is bound to the processors of that
+	/// partition, and all connections are served by threads from it.
+	/// Connections are then accepted and served on the same processors.
+	/// To use all partitions, create one such server per partition,
+	/// each with a ServerSocket of its own bound to the same address
+	/// with reuseAddress set to true, which also sets SO_REUSEPORT.
+	/// The operating system then spreads the incoming connections
+	/// over the sockets.
 {
 public:
 	TCPServer(TCPServerConnectionFactory::Ptr pFactory, Poco::UInt16 portNumber = 0, TCPServerParams::Ptr pParams = 0);
@@ -116,6 +133,33 @@ public:
 		///
 		/// New threads are taken from the given thread pool.
 
+	TCPServer(TCPServerConnectionFactory::Ptr pFactory, Poco::PartitionedThreadPool& threadPool, const ServerSocket& socket, TCPServerParams::Ptr pParams = 0);
+		/// Creates the TCPServer, using the given ServerSocket.
+		///
+		/// The server takes ownership of the TCPServerConnectionFactory
+		/// and deletes it when it's no longer needed.
+		///
+		/// The server also takes ownership of the TCPServerParams object.
+		/// If no TCPServerParams object is given, the server creates
+		/// its own one.
+		///
+		/// New threads are taken from all partitions of the
+		/// given thread pool in turn.
+
+	TCPServer(TCPServerConnectionFactory::Ptr pFactory, Poco::PartitionedThreadPool& threadPool, int partition, const ServerSocket& socket, TCPServerParams::Ptr pParams = 0);
+		/// Creates the TCPServer, using the given ServerSocket.
+		///
+		/// The server takes ownership of the TCPServerConnectionFactory
+		/// and deletes it when it's no longer needed.
+		///
+		/// The server also takes ownership of the TCPServerParams object.
+		/// If no TCPServerParams object is given, the server's TCPServerDispatcher
+		/// creates its own one.
+		///
+		/// The thread accepting connections runs on the processors
+		/// of the given partition, and new threads are taken from
+		/// that partition only.
+
 	virtual ~TCPServer();
 		/// Destroys the TCPServer and its TCPServerConnectionFactory.
 
@@ -181,10 +225,15 @@ private:
 	TCPServer(const TCPServer&);
 	TCPServer& operator = (const TCPServer&);
 	
-	ServerSocket         _socket;
-	TCPServerDispatcher* _pDispatcher;
-	Poco::Thread         _thread;
-	bool                 _stopped;
+	typedef std::vector<TCPServerDispatcher*> DispatcherVec;
+
+	ServerSocket                  _socket;
+	DispatcherVec                 _dispatchers;
+	DispatcherVec::size_type      _nextDispatcher;
+	Poco::PartitionedThreadPool*  _pPartitionedPool;
+	int                           _partition;
+	Poco::Thread                  _thread;
+	bool                          _stopped;
 };
 
 
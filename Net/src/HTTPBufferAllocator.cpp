@@ -17,14 +17,14 @@
 #include "Poco/Net/HTTPBufferAllocator.h"
 
 
-using Poco::MemoryPool;
+using Poco::ThreadCachingMemoryPool;
 
 
 namespace Poco {
 namespace Net {
 
 
-MemoryPool HTTPBufferAllocator::_pool(HTTPBufferAllocator::BUFFER_SIZE, 16);
+ThreadCachingMemoryPool HTTPBufferAllocator::_pool(HTTPBufferAllocator::BUFFER_SIZE, 16, 32);
 
 
 char* HTTPBufferAllocator::allocate(std::streamsize size)
@@ -138,7 +138,7 @@ HTTPChunkedStreamBuf* HTTPChunkedIOS::rdbuf()
 //
 
 
-Poco::MemoryPool HTTPChunkedInputStream::_pool(sizeof(HTTPChunkedInputStream));
+Poco::ThreadCachingMemoryPool HTTPChunkedInputStream::_pool(sizeof(HTTPChunkedInputStream));
 
 
 HTTPChunkedInputStream::HTTPChunkedInputStream(HTTPSession& session):
@@ -177,7 +177,7 @@ void HTTPChunkedInputStream::operator delete(void* ptr)
 //
 
 
-Poco::MemoryPool HTTPChunkedOutputStream::_pool(sizeof(HTTPChunkedOutputStream));
+Poco::ThreadCachingMemoryPool HTTPChunkedOutputStream::_pool(sizeof(HTTPChunkedOutputStream));
 
 
 HTTPChunkedOutputStream::HTTPChunkedOutputStream(HTTPSession& session):
@@ -0,0 +1,71 @@
+//
+// HTTPDateCache.cpp
+//
+// $Id$
+//
+// Library: Net
+// Package: HTTP
+// Module:  HTTPDateCache
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/HTTPDateCache.h"
+#include "Poco/DateTimeFormatter.h"
+#include "Poco/DateTimeFormat.h"
+#include "Poco/ThreadLocal.h"
+#include "Poco/Thread.h"
+#include <ctime>
+
+
+using Poco::DateTimeFormatter;
+using Poco::DateTimeFormat;
+
+
+namespace Poco {
+namespace Net {
+
+
+namespace
+{
+	struct CachedDate
+	{
+		CachedDate():
+			second(-1)
+		{
+		}
+
+		std::time_t second;
+		std::string date;
+	};
+
+	static Poco::ThreadLocal<CachedDate> cachedDate;
+}
+
+
+void HTTPDateCache::format(const Poco::Timestamp& timestamp, std::string& date)
+{
+	if (!Poco::Thread::current())
+	{
+		date.clear();
+		DateTimeFormatter::append(date, timestamp, DateTimeFormat::HTTP_FORMAT);
+		return;
+	}
+
+	std::time_t second = timestamp.epochTime();
+	CachedDate& cached = cachedDate.get();
+	if (second != cached.second)
+	{
+		cached.date.clear();
+		DateTimeFormatter::append(cached.date, timestamp, DateTimeFormat::HTTP_FORMAT);
+		cached.second = second;
+	}
+	date = cached.date;
+}
+
+
+} } // namespace Poco::Net
@@ -104,7 +104,7 @@ HTTPHeaderStreamBuf* HTTPHeaderIOS::rdbuf()
 //
 
 
-Poco::MemoryPool HTTPHeaderInputStream::_pool(sizeof(HTTPHeaderInputStream));
+Poco::ThreadCachingMemoryPool HTTPHeaderInputStream::_pool(sizeof(HTTPHeaderInputStream));
 
 
 HTTPHeaderInputStream::HTTPHeaderInputStream(HTTPSession& session):
@@ -143,7 +143,7 @@ void HTTPHeaderInputStream::operator delete(void* ptr)
 //
 
 
-Poco::MemoryPool HTTPHeaderOutputStream::_pool(sizeof(HTTPHeaderOutputStream));
+Poco::ThreadCachingMemoryPool HTTPHeaderOutputStream::_pool(sizeof(HTTPHeaderOutputStream));
 
 
 HTTPHeaderOutputStream::HTTPHeaderOutputStream(HTTPSession& session):
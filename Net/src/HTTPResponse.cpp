@@ -16,11 +16,10 @@
 
 #include "Poco/Net/HTTPResponse.h"
 #include "Poco/Net/NetException.h"
+#include "Poco/Net/HTTPDateCache.h"
 #include "Poco/NumberFormatter.h"
 #include "Poco/NumberParser.h"
 #include "Poco/DateTime.h"
-#include "Poco/DateTimeFormatter.h"
-#include "Poco/DateTimeFormat.h"
 #include "Poco/DateTimeParser.h"
 #include "Poco/Ascii.h"
 #include "Poco/String.h"
@@ -29,8 +28,6 @@
 using Poco::DateTime;
 using Poco::NumberFormatter;
 using Poco::NumberParser;
-using Poco::DateTimeFormatter;
-using Poco::DateTimeFormat;
 using Poco::DateTimeParser;
 
 
@@ -159,7 +156,7 @@ void HTTPResponse::setStatusAndReason(HTTPStatus status)
 
 void HTTPResponse::setDate(const Poco::Timestamp& dateTime)
 {
-	set(DATE, DateTimeFormatter::format(dateTime, DateTimeFormat::HTTP_FORMAT));
+	set(DATE, HTTPDateCache::format(dateTime));
 }
 
 	
@@ -193,7 +190,11 @@ void HTTPResponse::getCookies(std::vector<HTTPCookie>& cookies) const
 
 void HTTPResponse::write(std::ostream& ostr) const
 {
-	ostr << getVersion() << " " << static_cast<int>(_status) << " " << _reason << "\r\n";
+	char status[NumberFormatter::NF_MAX_INT_STRING_LEN];
+	std::size_t n = NumberFormatter::formatTo(status, sizeof(status), static_cast<int>(_status));
+	ostr << getVersion() << " ";
+	ostr.write(status, static_cast<std::streamsize>(n));
+	ostr << " " << _reason << "\r\n";
 	HTTPMessage::write(ostr);
 	ostr << "\r\n";
 }
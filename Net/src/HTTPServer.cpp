@@ -43,6 +43,20 @@ HTTPServer::HTTPServer(HTTPRequestHandlerFactory::Ptr pFactory, Poco::ThreadPool
 }
 
 
+HTTPServer::HTTPServer(HTTPRequestHandlerFactory::Ptr pFactory, Poco::PartitionedThreadPool& threadPool, const ServerSocket& socket, HTTPServerParams::Ptr pParams):
+	TCPServer(new HTTPServerConnectionFactory(pParams, pFactory), threadPool, socket, pParams),
+	_pFactory(pFactory)
+{
+}
+
+
+HTTPServer::HTTPServer(HTTPRequestHandlerFactory::Ptr pFactory, Poco::PartitionedThreadPool& threadPool, int partition, const ServerSocket& socket, HTTPServerParams::Ptr pParams):
+	TCPServer(new HTTPServerConnectionFactory(pParams, pFactory), threadPool, partition, socket, pParams),
+	_pFactory(pFactory)
+{
+}
+
+
 HTTPServer::~HTTPServer()
 {
 }
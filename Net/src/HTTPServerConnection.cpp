@@ -24,6 +24,7 @@
 #include "Poco/NumberFormatter.h"
 #include "Poco/Timestamp.h"
 #include "Poco/Delegate.h"
+#include "Poco/AllocationTracker.h"
 #include <memory>
 
 
@@ -58,6 +59,8 @@ HTTPServerConnection::~HTTPServerConnection()
 
 void HTTPServerConnection::run()
 {
+	Poco::AllocationScope scope(Poco::AllocationTracker::COMPONENT_NET);
+
 	std::string server = _pParams->getSoftwareVersion();
 	HTTPServerSession session(socket(), _pParams);
 	while (!_stopped && session.hasMoreRequests())
@@ -84,7 +87,12 @@ void HTTPServerConnection::run()
 						if (request.getExpectContinue() && response.getStatus() == HTTPResponse::HTTP_OK)
 							response.sendContinue();
 					
-						pHandler->handleRequest(request, response);
+						{
+							// Allocations made by the application's handler
+							// are not counted as the server's.
+							Poco::AllocationScope handlerScope(Poco::AllocationTracker::COMPONENT_OTHER);
+							pHandler->handleRequest(request, response);
+						}
 						session.setKeepAlive(_pParams->getKeepAlive() && response.getKeepAlive() && session.canKeepAlive());
 					}
 					else sendErrorResponse(session, HTTPResponse::HTTP_NOT_IMPLEMENTED);
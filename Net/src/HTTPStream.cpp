@@ -98,7 +98,7 @@ HTTPStreamBuf* HTTPIOS::rdbuf()
 //
 
 
-Poco::MemoryPool HTTPInputStream::_pool(sizeof(HTTPInputStream));
+Poco::ThreadCachingMemoryPool HTTPInputStream::_pool(sizeof(HTTPInputStream));
 
 
 HTTPInputStream::HTTPInputStream(HTTPSession& session):
@@ -137,7 +137,7 @@ void HTTPInputStream::operator delete(void* ptr)
 //
 
 
-Poco::MemoryPool HTTPOutputStream::_pool(sizeof(HTTPOutputStream));
+Poco::ThreadCachingMemoryPool HTTPOutputStream::_pool(sizeof(HTTPOutputStream));
 
 
 HTTPOutputStream::HTTPOutputStream(HTTPSession& session):
@@ -0,0 +1,476 @@
+//
+// PollSet.cpp
+//
+// $Id$
+//
+// Library: Net
+// Package: Sockets
+// Module:  PollSet
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/PollSet.h"
+#include "Poco/Net/SocketImpl.h"
+#include "Poco/Mutex.h"
+#include "Poco/Timestamp.h"
+#include <string.h> // FD_SET needs memset on some platforms, so we can't use <cstring>
+#if defined(POCO_HAVE_FD_EPOLL)
+#include <sys/epoll.h>
+#include <unistd.h>
+#elif defined(POCO_HAVE_FD_POLL)
+#include <poll.h>
+#endif
+#include <vector>
+
+
+namespace Poco {
+namespace Net {
+
+
+#if defined(POCO_HAVE_FD_EPOLL)
+
+
+//
+// Linux implementation using epoll
+//
+class PollSetImpl
+{
+public:
+	PollSetImpl():
+		_epollfd(-1),
+		_events(INITIAL_EVENTS)
+	{
+		_epollfd = epoll_create(INITIAL_EVENTS);
+		if (_epollfd < 0) SocketImpl::error();
+	}
+
+	~PollSetImpl()
+	{
+		if (_epollfd >= 0) ::close(_epollfd);
+	}
+
+	void add(const Socket& socket, int mode)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		SocketImpl* pSocketImpl = socket.impl();
+		struct epoll_event ev;
+		memset(&ev, 0, sizeof(ev));
+		ev.events = toEvents(mode);
+		ev.data.ptr = pSocketImpl;
+		if (pSocketImpl->sockfd() != POCO_INVALID_SOCKET)
+		{
+			int rc = epoll_ctl(_epollfd, EPOLL_CTL_ADD, pSocketImpl->sockfd(), &ev);
+			if (rc < 0 && errno == EEXIST)
+				rc = epoll_ctl(_epollfd, EPOLL_CTL_MOD, pSocketImpl->sockfd(), &ev);
+			if (rc < 0) SocketImpl::error();
+		}
+		_socketMap[pSocketImpl] = socket;
+	}
+
+	void remove(const Socket& socket)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		SocketImpl* pSocketImpl = socket.impl();
+		SocketMap::iterator it = _socketMap.find(pSocketImpl);
+		if (it != _socketMap.end())
+		{
+			// The kernel removes closed descriptors from the epoll set
+			// on its own, so a failure here is not an error.
+			struct epoll_event ev;
+			memset(&ev, 0, sizeof(ev));
+			if (pSocketImpl->sockfd() != POCO_INVALID_SOCKET)
+				epoll_ctl(_epollfd, EPOLL_CTL_DEL, pSocketImpl->sockfd(), &ev);
+			_socketMap.erase(it);
+		}
+	}
+
+	void update(const Socket& socket, int mode)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		SocketImpl* pSocketImpl = socket.impl();
+		if (_socketMap.find(pSocketImpl) != _socketMap.end() && pSocketImpl->sockfd() != POCO_INVALID_SOCKET)
+		{
+			struct epoll_event ev;
+			memset(&ev, 0, sizeof(ev));
+			ev.events = toEvents(mode);
+			ev.data.ptr = pSocketImpl;
+			if (epoll_ctl(_epollfd, EPOLL_CTL_MOD, pSocketImpl->sockfd(), &ev) < 0)
+				SocketImpl::error();
+		}
+	}
+
+	bool has(const Socket& socket) const
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		return _socketMap.find(socket.impl()) != _socketMap.end();
+	}
+
+	bool empty() const
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		return _socketMap.empty();
+	}
+
+	void clear()
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		for (SocketMap::iterator it = _socketMap.begin(); it != _socketMap.end(); ++it)
+		{
+			struct epoll_event ev;
+			memset(&ev, 0, sizeof(ev));
+			poco_socket_t fd = it->second.impl()->sockfd();
+			if (fd != POCO_INVALID_SOCKET)
+				epoll_ctl(_epollfd, EPOLL_CTL_DEL, fd, &ev);
+		}
+		_socketMap.clear();
+	}
+
+	PollSet::SocketModeMap poll(const Poco::Timespan& timeout)
+	{
+		PollSet::SocketModeMap result;
+
+		if (empty()) return result;
+
+		Poco::Timespan remainingTime(timeout);
+		int rc;
+		do
+		{
+			Poco::Timestamp start;
+			rc = epoll_wait(_epollfd, &_events[0], static_cast<int>(_events.size()), static_cast<int>(remainingTime.totalMilliseconds()));
+			if (rc < 0 && SocketImpl::lastError() == POCO_EINTR)
+			{
+				Poco::Timestamp end;
+				Poco::Timespan waited = end - start;
+				if (waited < remainingTime)
+					remainingTime -= waited;
+				else
+					remainingTime = 0;
+			}
+		}
+		while (rc < 0 && SocketImpl::lastError() == POCO_EINTR);
+		if (rc < 0) SocketImpl::error();
+
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		for (int i = 0; i < rc; i++)
+		{
+			SocketMap::iterator it = _socketMap.find(_events[i].data.ptr);
+			if (it != _socketMap.end())
+			{
+				int mode = 0;
+				if (_events[i].events & EPOLLIN)
+					mode |= PollSet::POLL_READ;
+				if (_events[i].events & EPOLLOUT)
+					mode |= PollSet::POLL_WRITE;
+				if (_events[i].events & EPOLLERR)
+					mode |= PollSet::POLL_ERROR;
+				if (mode) result[it->second] |= mode;
+			}
+		}
+		if (rc == static_cast<int>(_events.size()) && _events.size() < _socketMap.size())
+		{
+			// All slots have been used, so there may be more ready
+			// sockets than we can report at once. Grow the buffer
+			// for the next call.
+			_events.resize(_events.size()*2);
+		}
+		return result;
+	}
+
+private:
+	typedef std::map<void*, Socket> SocketMap;
+
+	enum
+	{
+		INITIAL_EVENTS = 64
+	};
+
+	static unsigned toEvents(int mode)
+	{
+		unsigned events = 0;
+		if (mode & PollSet::POLL_READ)
+			events |= EPOLLIN;
+		if (mode & PollSet::POLL_WRITE)
+			events |= EPOLLOUT;
+		if (mode & PollSet::POLL_ERROR)
+			events |= EPOLLERR;
+		return events;
+	}
+
+	mutable Poco::FastMutex _mutex;
+	int _epollfd;
+	SocketMap _socketMap;
+	std::vector<struct epoll_event> _events;
+};
+
+
+#else
+
+
+//
+// Portable implementation using poll() or select().
+//
+// The set of sockets is maintained incrementally, but the
+// descriptor arrays passed to the system call have to be
+// rebuilt on every call to poll().
+//
+class PollSetImpl
+{
+public:
+	void add(const Socket& socket, int mode)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		_socketMap[socket] = mode;
+	}
+
+	void remove(const Socket& socket)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		_socketMap.erase(socket);
+	}
+
+	void update(const Socket& socket, int mode)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		PollSet::SocketModeMap::iterator it = _socketMap.find(socket);
+		if (it != _socketMap.end())
+			it->second = mode;
+	}
+
+	bool has(const Socket& socket) const
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		return _socketMap.find(socket) != _socketMap.end();
+	}
+
+	bool empty() const
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		return _socketMap.empty();
+	}
+
+	void clear()
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+
+		_socketMap.clear();
+	}
+
+#if defined(POCO_HAVE_FD_POLL)
+
+	PollSet::SocketModeMap poll(const Poco::Timespan& timeout)
+	{
+		PollSet::SocketModeMap result;
+		std::vector<Socket> sockets;
+		std::vector<pollfd> pollfds;
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			if (_socketMap.empty()) return result;
+
+			sockets.reserve(_socketMap.size());
+			pollfds.reserve(_socketMap.size());
+			for (PollSet::SocketModeMap::const_iterator it = _socketMap.begin(); it != _socketMap.end(); ++it)
+			{
+				pollfd pfd;
+				pfd.fd = int(it->first.impl()->sockfd());
+				pfd.events = 0;
+				pfd.revents = 0;
+				if (it->second & PollSet::POLL_READ)
+					pfd.events |= POLLIN;
+				if (it->second & PollSet::POLL_WRITE)
+					pfd.events |= POLLOUT;
+				pollfds.push_back(pfd);
+				sockets.push_back(it->first);
+			}
+		}
+
+		Poco::Timespan remainingTime(timeout);
+		int rc;
+		do
+		{
+			Poco::Timestamp start;
+			rc = ::poll(&pollfds[0], pollfds.size(), remainingTime.totalMilliseconds());
+			if (rc < 0 && SocketImpl::lastError() == POCO_EINTR)
+			{
+				Poco::Timestamp end;
+				Poco::Timespan waited = end - start;
+				if (waited < remainingTime)
+					remainingTime -= waited;
+				else
+					remainingTime = 0;
+			}
+		}
+		while (rc < 0 && SocketImpl::lastError() == POCO_EINTR);
+		if (rc < 0) SocketImpl::error();
+
+		for (std::size_t i = 0; i < pollfds.size(); i++)
+		{
+			int mode = 0;
+			if (pollfds[i].revents & POLLIN)
+				mode |= PollSet::POLL_READ;
+			if (pollfds[i].revents & POLLOUT)
+				mode |= PollSet::POLL_WRITE;
+			if (pollfds[i].revents & POLLERR)
+				mode |= PollSet::POLL_ERROR;
+			if (mode) result[sockets[i]] = mode;
+		}
+		return result;
+	}
+
+#else
+
+	PollSet::SocketModeMap poll(const Poco::Timespan& timeout)
+	{
+		PollSet::SocketModeMap result;
+		std::vector<Socket> sockets;
+		fd_set fdRead;
+		fd_set fdWrite;
+		fd_set fdExcept;
+		int nfd = 0;
+		FD_ZERO(&fdRead);
+		FD_ZERO(&fdWrite);
+		FD_ZERO(&fdExcept);
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+
+			sockets.reserve(_socketMap.size());
+			for (PollSet::SocketModeMap::const_iterator it = _socketMap.begin(); it != _socketMap.end(); ++it)
+			{
+				poco_socket_t fd = it->first.impl()->sockfd();
+				if (fd != POCO_INVALID_SOCKET && it->second)
+				{
+					if (int(fd) > nfd)
+						nfd = int(fd);
+					if (it->second & PollSet::POLL_READ)
+						FD_SET(fd, &fdRead);
+					if (it->second & PollSet::POLL_WRITE)
+						FD_SET(fd, &fdWrite);
+					if (it->second & PollSet::POLL_ERROR)
+						FD_SET(fd, &fdExcept);
+					sockets.push_back(it->first);
+				}
+			}
+		}
+		if (sockets.empty()) return result;
+
+		Poco::Timespan remainingTime(timeout);
+		int rc;
+		do
+		{
+			struct timeval tv;
+			tv.tv_sec  = (long) remainingTime.totalSeconds();
+			tv.tv_usec = (long) remainingTime.useconds();
+			Poco::Timestamp start;
+			rc = ::select(nfd + 1, &fdRead, &fdWrite, &fdExcept, &tv);
+			if (rc < 0 && SocketImpl::lastError() == POCO_EINTR)
+			{
+				Poco::Timestamp end;
+				Poco::Timespan waited = end - start;
+				if (waited < remainingTime)
+					remainingTime -= waited;
+				else
+					remainingTime = 0;
+			}
+		}
+		while (rc < 0 && SocketImpl::lastError() == POCO_EINTR);
+		if (rc < 0) SocketImpl::error();
+
+		for (std::vector<Socket>::const_iterator it = sockets.begin(); it != sockets.end(); ++it)
+		{
+			poco_socket_t fd = it->impl()->sockfd();
+			if (fd == POCO_INVALID_SOCKET) continue;
+			int mode = 0;
+			if (FD_ISSET(fd, &fdRead))
+				mode |= PollSet::POLL_READ;
+			if (FD_ISSET(fd, &fdWrite))
+				mode |= PollSet::POLL_WRITE;
+			if (FD_ISSET(fd, &fdExcept))
+				mode |= PollSet::POLL_ERROR;
+			if (mode) result[*it] = mode;
+		}
+		return result;
+	}
+
+#endif // POCO_HAVE_FD_POLL
+
+private:
+	mutable Poco::FastMutex _mutex;
+	PollSet::SocketModeMap _socketMap;
+};
+
+
+#endif // POCO_HAVE_FD_EPOLL
+
+
+PollSet::PollSet():
+	_pImpl(new PollSetImpl)
+{
+}
+
+
+PollSet::~PollSet()
+{
+	delete _pImpl;
+}
+
+
+void PollSet::add(const Socket& socket, int mode)
+{
+	_pImpl->add(socket, mode);
+}
+
+
+void PollSet::remove(const Socket& socket)
+{
+	_pImpl->remove(socket);
+}
+
+
+void PollSet::update(const Socket& socket, int mode)
+{
+	_pImpl->update(socket, mode);
+}
+
+
+bool PollSet::has(const Socket& socket) const
+{
+	return _pImpl->has(socket);
+}
+
+
+bool PollSet::empty() const
+{
+	return _pImpl->empty();
+}
+
+
+void PollSet::clear()
+{
+	_pImpl->clear();
+}
+
+
+PollSet::SocketModeMap PollSet::poll(const Poco::Timespan& timeout)
+{
+	return _pImpl->poll(timeout);
+}
+
+
+} } // namespace Poco::Net
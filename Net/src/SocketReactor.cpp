@@ -68,56 +68,34 @@ void SocketReactor::run()
 {
 	_pThread = Thread::current();
 
-	Socket::SocketList readable;
-	Socket::SocketList writable;
-	Socket::SocketList except;
-	
 	while (!_stop)
 	{
 		try
 		{
-			readable.clear();
-			writable.clear();
-			except.clear();
-			int nSockets = 0;
-			{
-				FastMutex::ScopedLock lock(_mutex);
-				for (EventHandlerMap::iterator it = _handlers.begin(); it != _handlers.end(); ++it)
-				{
-					if (it->second->accepts(_pReadableNotification))
-					{
-						readable.push_back(it->first);
-						nSockets++;
-					}
-					if (it->second->accepts(_pWritableNotification))
-					{
-						writable.push_back(it->first);
-						nSockets++;
-					}
-					if (it->second->accepts(_pErrorNotification))
-					{
-						except.push_back(it->first);
-						nSockets++;
-					}
-				}
-			}
-			if (nSockets == 0)
+			if (_pollSet.empty())
 			{
 				onIdle();
 				Thread::trySleep(_timeout.milliseconds());
 			}
-			else if (Socket::select(readable, writable, except, _timeout))
+			else
 			{
-				onBusy();
-
-				for (Socket::SocketList::iterator it = readable.begin(); it != readable.end(); ++it)
-					dispatch(*it, _pReadableNotification);
-				for (Socket::SocketList::iterator it = writable.begin(); it != writable.end(); ++it)
-					dispatch(*it, _pWritableNotification);
-				for (Socket::SocketList::iterator it = except.begin(); it != except.end(); ++it)
-					dispatch(*it, _pErrorNotification);
+				PollSet::SocketModeMap sm = _pollSet.poll(_timeout);
+				if (!sm.empty())
+				{
+					onBusy();
+
+					for (PollSet::SocketModeMap::iterator it = sm.begin(); it != sm.end(); ++it)
+					{
+						if (it->second & PollSet::POLL_READ)
+							dispatch(it->first, _pReadableNotification);
+						if (it->second & PollSet::POLL_WRITE)
+							dispatch(it->first, _pWritableNotification);
+						if (it->second & PollSet::POLL_ERROR)
+							dispatch(it->first, _pErrorNotification);
+					}
+				}
+				else onTimeout();
 			}
-			else onTimeout();
 		}
 		catch (Exception& exc)
 		{
@@ -176,6 +154,7 @@ void SocketReactor::addEventHandler(const Socket& socket, const Poco::AbstractOb
 	}
 	if (!pNotifier->hasObserver(observer))
 		pNotifier->addObserver(this, observer);
+	updatePollSet(socket, pNotifier);
 }
 
 
@@ -210,17 +189,41 @@ void SocketReactor::removeEventHandler(const Socket& socket, const Poco::Abstrac
 			if (pNotifier->hasObserver(observer) && pNotifier->countObservers() == 1)
 			{
 				_handlers.erase(it);
+				_pollSet.remove(socket);
 			}
 		}
 	}
 	if (pNotifier && pNotifier->hasObserver(observer))
 	{
 		pNotifier->removeObserver(this, observer);
+		updatePollSet(socket, pNotifier);
 	}
 
 }
 
 
+void SocketReactor::updatePollSet(const Socket& socket, NotifierPtr& pNotifier)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	EventHandlerMap::iterator it = _handlers.find(socket);
+	if (it == _handlers.end() || it->second != pNotifier) return;
+
+	int mode = 0;
+	if (pNotifier->accepts(_pReadableNotification))
+		mode |= PollSet::POLL_READ;
+	if (pNotifier->accepts(_pWritableNotification))
+		mode |= PollSet::POLL_WRITE;
+	if (pNotifier->accepts(_pErrorNotification))
+		mode |= PollSet::POLL_ERROR;
+
+	if (mode)
+		_pollSet.add(socket, mode);
+	else
+		_pollSet.remove(socket);
+}
+
+
 void SocketReactor::onTimeout()
 {
 	dispatch(_pTimeoutNotification);
@@ -121,8 +121,23 @@ int StreamSocket::sendBytes(FIFOBuffer& fifoBuf)
 {
 	ScopedLock<Mutex> l(fifoBuf.mutex());
 
-	int ret = impl()->sendBytes(fifoBuf.begin(), (int) fifoBuf.used());
-	if (ret > 0) fifoBuf.drain(ret);
+	// Send straight out of the buffer; wrapped data in a
+	// ring buffer takes a second call.
+	FIFOBuffer::Segment segments[2];
+	int n = fifoBuf.readSegments(segments);
+	int ret = 0;
+	for (int i = 0; i < n; ++i)
+	{
+		int sent = impl()->sendBytes(segments[i].base, (int) segments[i].length);
+		if (sent <= 0)
+		{
+			if (ret == 0) ret = sent;
+			break;
+		}
+		fifoBuf.drain(sent);
+		ret += sent;
+		if (sent < (int) segments[i].length) break;
+	}
 	return ret;
 }
 
@@ -137,7 +152,11 @@ int StreamSocket::receiveBytes(FIFOBuffer& fifoBuf)
 {
 	ScopedLock<Mutex> l(fifoBuf.mutex());
 
-	int ret = impl()->receiveBytes(fifoBuf.next(), (int)fifoBuf.available());
+	// Receive straight into the buffer. Only the first segment
+	// of free space is filled, as a second receive could block.
+	FIFOBuffer::Segment segments[2];
+	if (fifoBuf.writeSegments(segments) == 0) return 0;
+	int ret = impl()->receiveBytes(segments[0].base, (int) segments[0].length);
 	if (ret > 0) fifoBuf.advance(ret);
 	return ret;
 }
@@ -18,6 +18,7 @@
 #include "Poco/Net/TCPServerDispatcher.h"
 #include "Poco/Net/TCPServerConnection.h"
 #include "Poco/Net/TCPServerConnectionFactory.h"
+#include "Poco/CPUTopology.h"
 #include "Poco/Timespan.h"
 #include "Poco/Exception.h"
 #include "Poco/ErrorHandler.h"
@@ -32,6 +33,9 @@ namespace Net {
 
 TCPServer::TCPServer(TCPServerConnectionFactory::Ptr pFactory, Poco::UInt16 portNumber, TCPServerParams::Ptr pParams):
 	_socket(ServerSocket(portNumber)),
+	_nextDispatcher(0),
+	_pPartitionedPool(0),
+	_partition(-1),
 	_thread(threadName(_socket)),
 	_stopped(true)
 {	
@@ -41,13 +45,15 @@ TCPServer::TCPServer(TCPServerConnectionFactory::Ptr pFactory, Poco::UInt16 port
 		int toAdd = pParams->getMaxThreads() - pool.capacity();
 		if (toAdd > 0) pool.addCapacity(toAdd);
 	}
-	_pDispatcher = new TCPServerDispatcher(pFactory, pool, pParams);
-	
+	_dispatchers.push_back(new TCPServerDispatcher(pFactory, pool, pParams));
 }
 
 
 TCPServer::TCPServer(TCPServerConnectionFactory::Ptr pFactory, const ServerSocket& socket, TCPServerParams::Ptr pParams):
 	_socket(socket),
+	_nextDispatcher(0),
+	_pPartitionedPool(0),
+	_partition(-1),
 	_thread(threadName(socket)),
 	_stopped(true)
 {
@@ -57,16 +63,50 @@ TCPServer::TCPServer(TCPServerConnectionFactory::Ptr pFactory, const ServerSocke
 		int toAdd = pParams->getMaxThreads() - pool.capacity();
 		if (toAdd > 0) pool.addCapacity(toAdd);
 	}
-	_pDispatcher = new TCPServerDispatcher(pFactory, pool, pParams);
+	_dispatchers.push_back(new TCPServerDispatcher(pFactory, pool, pParams));
 }
 
 
 TCPServer::TCPServer(TCPServerConnectionFactory::Ptr pFactory, Poco::ThreadPool& threadPool, const ServerSocket& socket, TCPServerParams::Ptr pParams):
 	_socket(socket),
-	_pDispatcher(new TCPServerDispatcher(pFactory, threadPool, pParams)),
+	_nextDispatcher(0),
+	_pPartitionedPool(0),
+	_partition(-1),
 	_thread(threadName(socket)),
 	_stopped(true)
 {
+	_dispatchers.push_back(new TCPServerDispatcher(pFactory, threadPool, pParams));
+}
+
+
+TCPServer::TCPServer(TCPServerConnectionFactory::Ptr pFactory, Poco::PartitionedThreadPool& threadPool, const ServerSocket& socket, TCPServerParams::Ptr pParams):
+	_socket(socket),
+	_nextDispatcher(0),
+	_pPartitionedPool(&threadPool),
+	_partition(-1),
+	_thread(threadName(socket)),
+	_stopped(true)
+{
+	// All partitions share the same parameters.
+	if (!pParams) pParams = new TCPServerParams;
+	for (int i = 0; i < threadPool.partitions(); ++i)
+	{
+		_dispatchers.push_back(new TCPServerDispatcher(pFactory, threadPool.partition(i), pParams));
+	}
+}
+
+
+TCPServer::TCPServer(TCPServerConnectionFactory::Ptr pFactory, Poco::PartitionedThreadPool& threadPool, int partition, const ServerSocket& socket, TCPServerParams::Ptr pParams):
+	_socket(socket),
+	_nextDispatcher(0),
+	_pPartitionedPool(&threadPool),
+	_partition(partition),
+	_thread(threadName(socket)),
+	_stopped(true)
+{
+	poco_assert (partition >= 0 && partition < threadPool.partitions());
+
+	_dispatchers.push_back(new TCPServerDispatcher(pFactory, threadPool.partition(partition), pParams));
 }
 
 
@@ -75,7 +115,10 @@ TCPServer::~TCPServer()
 	try
 	{
 		stop();
-		_pDispatcher->release();
+		for (DispatcherVec::iterator it = _dispatchers.begin(); it != _dispatchers.end(); ++it)
+		{
+			(*it)->release();
+		}
 	}
 	catch (...)
 	{
@@ -86,7 +129,7 @@ TCPServer::~TCPServer()
 
 const TCPServerParams& TCPServer::params() const
 {
-	return _pDispatcher->params();
+	return _dispatchers.front()->params();
 }
 
 
@@ -105,13 +148,27 @@ void TCPServer::stop()
 	{
 		_stopped = true;
 		_thread.join();
-		_pDispatcher->stop();
+		for (DispatcherVec::iterator it = _dispatchers.begin(); it != _dispatchers.end(); ++it)
+		{
+			(*it)->stop();
+		}
 	}
 }
 
 
 void TCPServer::run()
 {
+	if (_partition >= 0)
+	{
+		try
+		{
+			Poco::CPUTopology::bindCurrentThread(_pPartitionedPool->cpus(_partition));
+		}
+		catch (Poco::Exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+	}
 	while (!_stopped)
 	{
 		Poco::Timespan timeout(250000);
@@ -127,7 +184,8 @@ void TCPServer::run()
 				{
 					ss.setNoDelay(true);
 				}
-				_pDispatcher->enqueue(ss);
+				_dispatchers[_nextDispatcher]->enqueue(ss);
+				if (++_nextDispatcher == _dispatchers.size()) _nextDispatcher = 0;
 			}
 			catch (Poco::Exception& exc)
 			{
@@ -148,42 +206,77 @@ void TCPServer::run()
 
 int TCPServer::currentThreads() const
 {
-	return _pDispatcher->currentThreads();
+	int result = 0;
+	for (DispatcherVec::const_iterator it = _dispatchers.begin(); it != _dispatchers.end(); ++it)
+	{
+		result += (*it)->currentThreads();
+	}
+	return result;
 }
 
 int TCPServer::maxThreads() const
 {
-	return _pDispatcher->maxThreads();
+	int result = 0;
+	for (DispatcherVec::const_iterator it = _dispatchers.begin(); it != _dispatchers.end(); ++it)
+	{
+		result += (*it)->maxThreads();
+	}
+	return result;
 }
 
 	
 int TCPServer::totalConnections() const
 {
-	return _pDispatcher->totalConnections();
+	int result = 0;
+	for (DispatcherVec::const_iterator it = _dispatchers.begin(); it != _dispatchers.end(); ++it)
+	{
+		result += (*it)->totalConnections();
+	}
+	return result;
 }
 
 
 int TCPServer::currentConnections() const
 {
-	return _pDispatcher->currentConnections();
+	int result = 0;
+	for (DispatcherVec::const_iterator it = _dispatchers.begin(); it != _dispatchers.end(); ++it)
+	{
+		result += (*it)->currentConnections();
+	}
+	return result;
 }
 
 
 int TCPServer::maxConcurrentConnections() const
 {
-	return _pDispatcher->maxConcurrentConnections();
+	int result = 0;
+	for (DispatcherVec::const_iterator it = _dispatchers.begin(); it != _dispatchers.end(); ++it)
+	{
+		result += (*it)->maxConcurrentConnections();
+	}
+	return result;
 }
 
 	
 int TCPServer::queuedConnections() const
 {
-	return _pDispatcher->queuedConnections();
+	int result = 0;
+	for (DispatcherVec::const_iterator it = _dispatchers.begin(); it != _dispatchers.end(); ++it)
+	{
+		result += (*it)->queuedConnections();
+	}
+	return result;
 }
 
 
 int TCPServer::refusedConnections() const
 {
-	return _pDispatcher->refusedConnections();
+	int result = 0;
+	for (DispatcherVec::const_iterator it = _dispatchers.begin(); it != _dispatchers.end(); ++it)
+	{
+		result += (*it)->refusedConnections();
+	}
+	return result;
 }
 
 
@@ -16,6 +16,12 @@
 #include "Poco/Net/HTTPResponse.h"
 #include "Poco/Net/HTTPCookie.h"
 #include "Poco/Net/NetException.h"
+#include "Poco/Net/HTTPDateCache.h"
+#include "Poco/DateTime.h"
+#include "Poco/DateTimeFormatter.h"
+#include "Poco/DateTimeFormat.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
 #include <sstream>
 
 
@@ -23,6 +29,41 @@ using Poco::Net::HTTPResponse;
 using Poco::Net::HTTPMessage;
 using Poco::Net::HTTPCookie;
 using Poco::Net::MessageException;
+using Poco::Net::HTTPDateCache;
+using Poco::DateTime;
+using Poco::DateTimeFormatter;
+using Poco::DateTimeFormat;
+using Poco::Timestamp;
+
+
+namespace
+{
+	class DateFormatter: public Poco::Runnable
+	{
+	public:
+		DateFormatter():
+			_ok(false)
+		{
+		}
+
+		void run()
+		{
+			Timestamp ts = DateTime(1994, 11, 6, 8, 49, 37, 250).timestamp();
+			_ok = HTTPDateCache::format(ts) == "Sun, 06 Nov 1994 08:49:37 GMT"
+			   && HTTPDateCache::format(ts + 500000) == "Sun, 06 Nov 1994 08:49:37 GMT"
+			   && HTTPDateCache::format(ts + 750000) == "Sun, 06 Nov 1994 08:49:38 GMT"
+			   && HTTPDateCache::format(ts) == "Sun, 06 Nov 1994 08:49:37 GMT";
+		}
+
+		bool ok() const
+		{
+			return _ok;
+		}
+
+	private:
+		bool _ok;
+	};
+}
 
 
 HTTPResponseTest::HTTPResponseTest(const std::string& name): CppUnit::TestCase(name)
@@ -203,6 +244,31 @@ void HTTPResponseTest::testCookies()
 }
 
 
+void HTTPResponseTest::testDate()
+{
+	Timestamp ts = DateTime(1994, 11, 6, 8, 49, 37, 250).timestamp();
+	HTTPResponse response;
+	response.setDate(ts);
+	assert (response.get(HTTPResponse::DATE) == "Sun, 06 Nov 1994 08:49:37 GMT");
+	assert (response.getDate() == DateTime(1994, 11, 6, 8, 49, 37).timestamp());
+
+	// Timestamps in the same second share the text, others do not.
+	assert (HTTPDateCache::format(ts + 500000) == "Sun, 06 Nov 1994 08:49:37 GMT");
+	assert (HTTPDateCache::format(ts + 750000) == "Sun, 06 Nov 1994 08:49:38 GMT");
+	assert (HTTPDateCache::format(ts) == "Sun, 06 Nov 1994 08:49:37 GMT");
+
+	Timestamp now;
+	assert (HTTPDateCache::format(now) == DateTimeFormatter::format(now, DateTimeFormat::HTTP_FORMAT));
+
+	// Poco threads use their own cached text.
+	DateFormatter formatter;
+	Poco::Thread thread;
+	thread.start(formatter);
+	thread.join();
+	assert (formatter.ok());
+}
+
+
 void HTTPResponseTest::setUp()
 {
 }
@@ -226,6 +292,7 @@ CppUnit::Test* HTTPResponseTest::suite()
 	CppUnit_addTest(pSuite, HTTPResponseTest, testInvalid2);
 	CppUnit_addTest(pSuite, HTTPResponseTest, testInvalid3);
 	CppUnit_addTest(pSuite, HTTPResponseTest, testCookies);
+	CppUnit_addTest(pSuite, HTTPResponseTest, testDate);
 
 	return pSuite;
 }
@@ -35,6 +35,7 @@ public:
 	void testInvalid2();
 	void testInvalid3();
 	void testCookies();
+	void testDate();
 
 	void setUp();
 	void tearDown();
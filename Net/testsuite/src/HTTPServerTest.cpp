@@ -24,7 +24,9 @@
 #include "Poco/Net/HTTPServerResponse.h"
 #include "Poco/Net/ServerSocket.h"
 #include "Poco/StreamCopier.h"
+#include "Poco/Arena.h"
 #include <sstream>
+#include <vector>
 
 
 using Poco::Net::HTTPServer;
@@ -106,6 +108,27 @@ namespace
 		}
 	};
 	
+	class ArenaRequestHandler: public HTTPRequestHandler
+	{
+	public:
+		void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+		{
+			typedef std::vector<std::string, Poco::ArenaAllocator<std::string> > NameVec;
+			NameVec names(request.arena());
+			for (HTTPServerRequest::ConstIterator it = request.begin(); it != request.end(); ++it)
+			{
+				if (it->first.compare(0, 2, "X-") == 0) names.push_back(it->first);
+			}
+			std::string data;
+			for (NameVec::const_iterator it = names.begin(); it != names.end(); ++it)
+			{
+				if (!data.empty()) data += ",";
+				data += *it;
+			}
+			response.sendBuffer(data.data(), data.length());
+		}
+	};
+	
 	class RequestHandlerFactory: public HTTPRequestHandlerFactory
 	{
 	public:
@@ -121,6 +144,8 @@ namespace
 				return new AuthRequestHandler();
 			else if (request.getURI() == "/buffer")
 				return new BufferRequestHandler();
+			else if (request.getURI() == "/arena")
+				return new ArenaRequestHandler();
 			else
 				return 0;
 		}
@@ -518,6 +543,29 @@ void HTTPServerTest::testBuffer()
 }
 
 
+void HTTPServerTest::testArena()
+{
+	ServerSocket svs(0);
+	HTTPServer srv(new RequestHandlerFactory, svs, new HTTPServerParams);
+	srv.start();
+	
+	HTTPClientSession cs("localhost", svs.address().port());
+	cs.setKeepAlive(true);
+	for (int i = 0; i < 3; ++i)
+	{
+		HTTPRequest request("GET", "/arena", HTTPMessage::HTTP_1_1);
+		request.set("X-One", "1");
+		request.set("X-Two", "2");
+		cs.sendRequest(request);
+		HTTPResponse response;
+		std::string rbody;
+		cs.receiveResponse(response) >> rbody;
+		assert (response.getStatus() == HTTPResponse::HTTP_OK);
+		assert (rbody == "X-One,X-Two");
+	}
+}
+
+
 void HTTPServerTest::setUp()
 {
 }
@@ -546,6 +594,7 @@ CppUnit::Test* HTTPServerTest::suite()
 	CppUnit_addTest(pSuite, HTTPServerTest, testAuth);
 	CppUnit_addTest(pSuite, HTTPServerTest, testNotImpl);
 	CppUnit_addTest(pSuite, HTTPServerTest, testBuffer);
+	CppUnit_addTest(pSuite, HTTPServerTest, testArena);
 
 	return pSuite;
 }
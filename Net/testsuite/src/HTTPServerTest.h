@@ -40,6 +40,7 @@ public:
 	void testAuth();
 	void testNotImpl();
 	void testBuffer();
+	void testArena();
 
 	void setUp();
 	void tearDown();
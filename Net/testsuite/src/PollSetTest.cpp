@@ -0,0 +1,187 @@
+//
+// PollSetTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "PollSetTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "EchoServer.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include "Poco/Net/PollSet.h"
+#include "Poco/Stopwatch.h"
+
+
+using Poco::Net::Socket;
+using Poco::Net::StreamSocket;
+using Poco::Net::SocketAddress;
+using Poco::Net::PollSet;
+using Poco::Timespan;
+using Poco::Stopwatch;
+
+
+PollSetTest::PollSetTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+PollSetTest::~PollSetTest()
+{
+}
+
+
+void PollSetTest::testAddUpdate()
+{
+	EchoServer echoServer1;
+	EchoServer echoServer2;
+	StreamSocket ss1;
+	StreamSocket ss2;
+
+	ss1.connect(SocketAddress("localhost", echoServer1.port()));
+	ss2.connect(SocketAddress("localhost", echoServer2.port()));
+
+	PollSet ps;
+	assert (ps.empty());
+	ps.add(ss1, PollSet::POLL_READ);
+	assert (!ps.empty());
+	assert (ps.has(ss1));
+	assert (!ps.has(ss2));
+
+	// nothing readable
+	Timespan timeout(100000);
+	PollSet::SocketModeMap sm = ps.poll(timeout);
+	assert (sm.empty());
+
+	ps.add(ss2, PollSet::POLL_READ);
+
+	// ss1 must be writable, if polled for
+	ps.update(ss1, PollSet::POLL_READ | PollSet::POLL_WRITE);
+	sm = ps.poll(timeout);
+	assert (sm.size() == 1);
+	assert (sm.find(ss1) != sm.end());
+	assert (sm.find(ss1)->second == PollSet::POLL_WRITE);
+
+	ps.update(ss1, PollSet::POLL_READ);
+
+	ss1.sendBytes("hello", 5);
+	char buffer[256];
+	sm = ps.poll(timeout);
+	assert (sm.size() == 1);
+	assert (sm.find(ss1) != sm.end());
+	assert (sm.find(ss1)->second & PollSet::POLL_READ);
+	int n = ss1.receiveBytes(buffer, sizeof(buffer));
+	assert (n == 5);
+	assert (std::string(buffer, n) == "hello");
+
+	ss2.sendBytes("HELLO", 5);
+	sm = ps.poll(timeout);
+	assert (sm.size() == 1);
+	assert (sm.find(ss2) != sm.end());
+	assert (sm.find(ss2)->second & PollSet::POLL_READ);
+	n = ss2.receiveBytes(buffer, sizeof(buffer));
+	assert (n == 5);
+	assert (std::string(buffer, n) == "HELLO");
+
+	ss1.sendBytes("HELLO", 5);
+	ss2.sendBytes("hello", 5);
+	ss1.poll(Timespan(1000000), Socket::SELECT_READ);
+	ss2.poll(Timespan(1000000), Socket::SELECT_READ);
+	sm = ps.poll(timeout);
+	assert (sm.size() == 2);
+	n = ss1.receiveBytes(buffer, sizeof(buffer));
+	assert (n == 5);
+	n = ss2.receiveBytes(buffer, sizeof(buffer));
+	assert (n == 5);
+
+	ps.clear();
+	assert (ps.empty());
+
+	ss1.close();
+	ss2.close();
+}
+
+
+void PollSetTest::testTimeout()
+{
+	EchoServer echoServer;
+	StreamSocket ss;
+	ss.connect(SocketAddress("localhost", echoServer.port()));
+
+	PollSet ps;
+	ps.add(ss, PollSet::POLL_READ);
+	Timespan timeout(500000);
+	Stopwatch sw;
+	sw.start();
+	PollSet::SocketModeMap sm = ps.poll(timeout);
+	sw.stop();
+	assert (sm.empty());
+	assert (sw.elapsed() >= 400000);
+
+	ss.sendBytes("hello", 5);
+	sw.restart();
+	sm = ps.poll(timeout);
+	sw.stop();
+	assert (sm.size() == 1);
+	assert (sw.elapsed() < 400000);
+
+	char buffer[256];
+	int n = ss.receiveBytes(buffer, sizeof(buffer));
+	assert (n == 5);
+	ss.close();
+}
+
+
+void PollSetTest::testRemove()
+{
+	EchoServer echoServer;
+	StreamSocket ss;
+	ss.connect(SocketAddress("localhost", echoServer.port()));
+
+	PollSet ps;
+	ps.add(ss, PollSet::POLL_READ | PollSet::POLL_WRITE);
+	assert (ps.poll(Timespan(100000)).size() == 1);
+
+	ps.remove(ss);
+	assert (!ps.has(ss));
+	assert (ps.empty());
+	assert (ps.poll(Timespan(100000)).empty());
+
+	// removing a socket that is not in the set is harmless
+	ps.remove(ss);
+
+	// so is updating it
+	ps.update(ss, PollSet::POLL_WRITE);
+	assert (!ps.has(ss));
+
+	ss.close();
+}
+
+
+void PollSetTest::setUp()
+{
+}
+
+
+void PollSetTest::tearDown()
+{
+}
+
+
+CppUnit::Test* PollSetTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("PollSetTest");
+
+	CppUnit_addTest(pSuite, PollSetTest, testAddUpdate);
+	CppUnit_addTest(pSuite, PollSetTest, testTimeout);
+	CppUnit_addTest(pSuite, PollSetTest, testRemove);
+
+	return pSuite;
+}
@@ -165,6 +165,39 @@ void SocketTest::testFIFOBuffer()
 }
 
 
+void SocketTest::testFIFOBufferRing()
+{
+	FIFOBuffer f(8, false, FIFOBuffer::MODE_RING);
+	f.write("abcdef", 6);
+	char buffer[8];
+	f.read(buffer, 4);
+	f.write("ghijkl", 6);
+
+	// the data wraps around the end of the buffer
+	FIFOBuffer::Segment segments[2];
+	assert (f.readSegments(segments) == 2);
+
+	EchoServer echoServer;
+	StreamSocket ss;
+	ss.connect(SocketAddress("localhost", echoServer.port()));
+	int n = ss.sendBytes(f);
+	assert (n == 8);
+	assert (f.isEmpty());
+
+	int received = 0;
+	while (received < 8)
+	{
+		n = ss.receiveBytes(f);
+		assert (n > 0);
+		received += n;
+	}
+	assert (f.used() == 8);
+	assert (std::string(f.begin(), 8) == "efghijkl");
+
+	ss.close();
+}
+
+
 void SocketTest::testConnect()
 {
 	ServerSocket serv;
@@ -560,6 +593,7 @@ CppUnit::Test* SocketTest::suite()
 	CppUnit_addTest(pSuite, SocketTest, testPoll);
 	CppUnit_addTest(pSuite, SocketTest, testAvailable);
 	CppUnit_addTest(pSuite, SocketTest, testFIFOBuffer);
+	CppUnit_addTest(pSuite, SocketTest, testFIFOBufferRing);
 	CppUnit_addTest(pSuite, SocketTest, testConnect);
 	CppUnit_addTest(pSuite, SocketTest, testConnectRefused);
 	CppUnit_addTest(pSuite, SocketTest, testConnectRefusedNB);
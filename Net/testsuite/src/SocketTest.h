@@ -30,6 +30,7 @@ public:
 	void testPoll();
 	void testAvailable();
 	void testFIFOBuffer();
+	void testFIFOBufferRing();
 	void testConnect();
 	void testConnectRefused();
 	void testConnectRefusedNB();
@@ -20,6 +20,7 @@
 #include "Poco/Net/StreamSocket.h"
 #include "Poco/Net/ServerSocket.h"
 #include "Poco/Thread.h"
+#include "Poco/PartitionedThreadPool.h"
 #include <iostream>
 
 
@@ -32,6 +33,7 @@ using Poco::Net::StreamSocket;
 using Poco::Net::ServerSocket;
 using Poco::Net::SocketAddress;
 using Poco::Thread;
+using Poco::PartitionedThreadPool;
 
 
 namespace
@@ -243,6 +245,119 @@ void TCPServerTest::testThreadCapacity(){
 }
 
 
+void TCPServerTest::testPartitionedPool()
+{
+	std::vector<PartitionedThreadPool::CPUSet> cpuSets(2);
+	PartitionedThreadPool pool(cpuSets, 1, 4);
+	ServerSocket svs(0);
+	TCPServer srv(new TCPServerConnectionFactoryImpl<EchoConnection>(), pool, svs);
+	srv.start();
+	assert (srv.currentConnections() == 0);
+	assert (srv.currentThreads() == 0);
+	assert (srv.maxThreads() == 8);
+
+	SocketAddress sa("localhost", svs.address().port());
+	StreamSocket ss1(sa);
+	StreamSocket ss2(sa);
+	std::string data("hello, world");
+	ss1.sendBytes(data.data(), (int) data.size());
+	ss2.sendBytes(data.data(), (int) data.size());
+	char buffer[256];
+	int n = ss1.receiveBytes(buffer, sizeof(buffer));
+	assert (n > 0);
+	assert (std::string(buffer, n) == data);
+	n = ss2.receiveBytes(buffer, sizeof(buffer));
+	assert (n > 0);
+	assert (std::string(buffer, n) == data);
+	assert (srv.currentConnections() == 2);
+	assert (srv.totalConnections() == 2);
+	ss1.close();
+	ss2.close();
+	Thread::sleep(1000);
+	assert (srv.currentConnections() == 0);
+	srv.stop();
+	pool.joinAll();
+}
+
+
+void TCPServerTest::testPinnedPartition()
+{
+	std::vector<PartitionedThreadPool::CPUSet> cpuSets(2);
+	PartitionedThreadPool pool(cpuSets, 1, 8);
+	ServerSocket svs(0);
+	TCPServer srv(new TCPServerConnectionFactoryImpl<EchoConnection>(), pool, 1, svs);
+	srv.start();
+	assert (srv.maxThreads() == 8);
+
+	SocketAddress sa("localhost", svs.address().port());
+	StreamSocket ss1(sa);
+	StreamSocket ss2(sa);
+	std::string data("hello, world");
+	ss1.sendBytes(data.data(), (int) data.size());
+	ss2.sendBytes(data.data(), (int) data.size());
+	char buffer[256];
+	int n = ss1.receiveBytes(buffer, sizeof(buffer));
+	assert (n > 0);
+	assert (std::string(buffer, n) == data);
+	n = ss2.receiveBytes(buffer, sizeof(buffer));
+	assert (n > 0);
+	assert (std::string(buffer, n) == data);
+	assert (srv.currentConnections() == 2);
+	assert (pool.partition(0).used() == 0);
+	assert (pool.partition(1).used() == 2);
+	ss1.close();
+	ss2.close();
+	Thread::sleep(1000);
+	assert (srv.currentConnections() == 0);
+	srv.stop();
+	pool.joinAll();
+}
+
+
+void TCPServerTest::testReusePortPartitions()
+{
+	std::vector<PartitionedThreadPool::CPUSet> cpuSets(2);
+	PartitionedThreadPool pool(cpuSets, 1, 8);
+	ServerSocket svs0;
+	svs0.bind(SocketAddress("127.0.0.1", 0), true);
+	svs0.listen();
+	ServerSocket svs1;
+	svs1.bind(SocketAddress("127.0.0.1", svs0.address().port()), true);
+	svs1.listen();
+	TCPServer srv0(new TCPServerConnectionFactoryImpl<EchoConnection>(), pool, 0, svs0);
+	TCPServer srv1(new TCPServerConnectionFactoryImpl<EchoConnection>(), pool, 1, svs1);
+	srv0.start();
+	srv1.start();
+
+	SocketAddress sa("127.0.0.1", svs0.address().port());
+	std::vector<StreamSocket> sockets;
+	std::string data("hello, world");
+	for (int i = 0; i < 8; ++i)
+	{
+		sockets.push_back(StreamSocket(sa));
+		sockets.back().sendBytes(data.data(), (int) data.size());
+		char buffer[256];
+		int n = sockets.back().receiveBytes(buffer, sizeof(buffer));
+		assert (n > 0);
+		assert (std::string(buffer, n) == data);
+	}
+	// Each server must serve its connections with threads
+	// from its own partition.
+	assert (srv0.currentConnections() + srv1.currentConnections() == 8);
+	assert (pool.partition(0).used() == srv0.currentConnections());
+	assert (pool.partition(1).used() == srv1.currentConnections());
+	for (std::vector<StreamSocket>::iterator it = sockets.begin(); it != sockets.end(); ++it)
+	{
+		it->close();
+	}
+	Thread::sleep(1000);
+	assert (srv0.currentConnections() == 0);
+	assert (srv1.currentConnections() == 0);
+	srv0.stop();
+	srv1.stop();
+	pool.joinAll();
+}
+
 
 void TCPServerTest::setUp()
 {
@@ -262,6 +377,9 @@ CppUnit::Test* TCPServerTest::suite()
 	CppUnit_addTest(pSuite, TCPServerTest, testTwoConnections);
 	CppUnit_addTest(pSuite, TCPServerTest, testMultiConnections);
 	CppUnit_addTest(pSuite, TCPServerTest, testThreadCapacity);
+	CppUnit_addTest(pSuite, TCPServerTest, testPartitionedPool);
+	CppUnit_addTest(pSuite, TCPServerTest, testPinnedPartition);
+	CppUnit_addTest(pSuite, TCPServerTest, testReusePortPartitions);
 
 	return pSuite;
 }
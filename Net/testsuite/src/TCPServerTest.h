@@ -30,6 +30,9 @@ public:
 	void testTwoConnections();
 	void testMultiConnections();
 	void testThreadCapacity();
+	void testPartitionedPool();
+	void testPinnedPartition();
+	void testReusePortPartitions();
 
 	void setUp();
 	void tearDown();
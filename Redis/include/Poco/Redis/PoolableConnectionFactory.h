@@ -22,6 +22,7 @@
 
 #include "Poco/Redis/Client.h"
 #include "Poco/ObjectPool.h"
+#include "Poco/ConcurrentObjectPool.h"
 
 
 namespace Poco {
@@ -77,16 +78,24 @@ class Redis_API PooledConnection
 	/// Helper class for borrowing and returning a connection automatically from a pool.
 {
 public:
-	PooledConnection(ObjectPool<Client, Client::Ptr>& pool, long timeoutMilliseconds = 0) : _pool(pool)
+	PooledConnection(ObjectPool<Client, Client::Ptr>& pool, long timeoutMilliseconds = 0) : _pPool(&pool), _pConcurrentPool(0)
 	{
-		_client = _pool.borrowObject(timeoutMilliseconds);
+		_client = pool.borrowObject(timeoutMilliseconds);
+	}
+
+	PooledConnection(ConcurrentObjectPool<Client, Client::Ptr>& pool, long timeoutMilliseconds = 0) : _pPool(0), _pConcurrentPool(&pool)
+	{
+		_client = pool.borrowObject(timeoutMilliseconds);
 	}
 
 	virtual ~PooledConnection()
 	{
 		try
 		{
-			_pool.returnObject(_client);
+			if (_pPool)
+				_pPool->returnObject(_client);
+			else
+				_pConcurrentPool->returnObject(_client);
 		}
 		catch (...)
 		{
@@ -100,7 +109,8 @@ public:
 	}
 
 private:
-	ObjectPool<Client, Client::Ptr>& _pool;
+	ObjectPool<Client, Client::Ptr>* _pPool;
+	ConcurrentObjectPool<Client, Client::Ptr>* _pConcurrentPool;
 	Client::Ptr _client;
 };
 
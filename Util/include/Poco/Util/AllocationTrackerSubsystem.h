@@ -0,0 +1,72 @@
+//
+// AllocationTrackerSubsystem.h
+//
+// $Id$
+//
+// Library: Util
+// Package: Application
+// Module:  AllocationTrackerSubsystem
+//
+// Definition of the AllocationTrackerSubsystem class.
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Util_AllocationTrackerSubsystem_INCLUDED
+#define Util_AllocationTrackerSubsystem_INCLUDED
+
+
+#include "Poco/Util/Util.h"
+#include "Poco/Util/Subsystem.h"
+#include "Poco/Util/Timer.h"
+#include "Poco/Logger.h"
+#include <memory>
+
+
+namespace Poco {
+namespace Util {
+
+
+class Util_API AllocationTrackerSubsystem: public Subsystem
+	/// The AllocationTrackerSubsystem logs the allocation
+	/// counters collected by Poco::AllocationTracker.
+	///
+	/// The counters are logged when the application shuts down
+	/// and, if the "application.allocationTracker.interval"
+	/// property specifies a number of seconds greater than zero,
+	/// periodically at that interval. The logger is given by
+	/// the "application.allocationTracker.logger" property,
+	/// or "AllocationTracker" if the property is not specified.
+	///
+	/// Nothing is logged unless Foundation has been built
+	/// with POCO_ENABLE_ALLOCATION_TRACKING.
+	///
+	/// The subsystem is not added automatically; to use it,
+	/// call Application::addSubsystem():
+	///     addSubsystem(new AllocationTrackerSubsystem);
+{
+public:
+	AllocationTrackerSubsystem();
+	const char* name() const;
+
+protected:
+	void initialize(Application& self);
+	void uninitialize();
+	void onTimer(TimerTask& task);
+	void report();
+	~AllocationTrackerSubsystem();
+
+private:
+	Poco::Logger*        _pLogger;
+	std::auto_ptr<Timer> _pTimer;
+};
+
+
+} } // namespace Poco::Util
+
+
+#endif // Util_AllocationTrackerSubsystem_INCLUDED
@@ -22,23 +22,46 @@
 
 #include "Poco/Util/Util.h"
 #include "Poco/Util/TimerTask.h"
-#include "Poco/TimedNotificationQueue.h"
+#include "Poco/TimingWheelNotificationQueue.h"
 #include "Poco/Thread.h"
 #include "Poco/Runnable.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
 
 
 namespace Poco {
+
+
+class ActiveExecutor;
+
+
 namespace Util {
 
 
+class TaskNotification;
+
+
 class Util_API Timer: protected Poco::Runnable
 	/// A Timer allows to schedule tasks (TimerTask objects) for future execution 
 	/// in a background thread. Tasks may be scheduled for one-time execution, 
 	/// or for repeated execution at regular intervals. 
 	///
-	/// The Timer object creates a thread that executes all scheduled tasks
-	/// sequentially. Therefore, tasks should complete their work as quickly
-	/// as possible, otherwise subsequent tasks may be delayed.
+	/// The Timer object creates a thread that waits for tasks to become due.
+	/// By default, this thread also executes all tasks sequentially. Therefore,
+	/// tasks should complete their work as quickly as possible, otherwise
+	/// subsequent tasks may be delayed. Alternatively, a Timer can be created
+	/// with an ActiveExecutor, such as a ThreadPoolExecutor or a
+	/// WorkStealingExecutor, to which due tasks are handed for execution,
+	/// so that a slow task does not hold up others. If the executor
+	/// cannot accept a task, the task is executed by the timer thread.
+	///
+	/// Pending tasks are kept in a TimingWheelNotificationQueue, so scheduling
+	/// and cancelling a task take constant time, regardless of the number of
+	/// pending tasks. A task is removed from the queue as soon as it is cancelled.
+	/// The resolution of the queue can be given in the constructor; all tasks
+	/// that are due within the same resolution interval become ready together
+	/// and are dispatched in a single wakeup of the timer thread. Tasks are
+	/// never executed before their due time.
 	///
 	/// Timer is save for multithreaded use - multiple threads can schedule
 	/// new tasks simultaneously.
@@ -50,23 +73,39 @@ public:
 	Timer();
 		/// Creates the Timer.
 	
-	explicit Timer(Poco::Thread::Priority priority);
+	explicit Timer(Poco::Thread::Priority priority, long resolution = 1);
 		/// Creates the Timer, using a timer thread with
 		/// the given priority.
+		///
+		/// The resolution of the timer is given in milliseconds.
 	
+	explicit Timer(Poco::ActiveExecutor& executor, long resolution = 1);
+		/// Creates the Timer. Tasks that become due are handed
+		/// to the given ActiveExecutor.
+		///
+		/// The resolution of the timer is given in milliseconds.
+		///
+		/// The executor must outlive the Timer.
+
 	~Timer();
 		/// Destroys the Timer, cancelling all pending tasks.
+		///
+		/// Waits for tasks that are currently executing in
+		/// the executor to complete.
 		
 	void cancel(bool wait = false);
 		/// Cancels all pending tasks.
 		///
 		/// If a task is currently running, it is allowed to finish.
+		/// A periodic task that is running is not scheduled again.
 		///
 		/// Task cancellation is done asynchronously. If wait
 		/// is false, cancel() returns immediately and the
 		/// task queue will be purged as soon as the currently
 		/// running task finishes. If wait is true, waits
-		/// until the queue has been purged.
+		/// until the queue has been purged and all tasks
+		/// running in the executor have finished. In this
+		/// case, cancel() must not be called from a task.
 	
 	void schedule(TimerTask::Ptr pTask, Poco::Timestamp time);
 		/// Schedules a task for execution at the specified time.
@@ -152,16 +191,39 @@ public:
 		/// If task execution takes longer than the given interval,
 		/// further executions are delayed.
 
+	int pending() const;
+		/// Returns the number of scheduled tasks that have
+		/// not been executed or cancelled yet.
+
 protected:
 	void run();
 	static void validateTask(const TimerTask::Ptr& pTask);
+	void start();
+	void enqueue(TaskNotification* pNf, Poco::Clock clock);
+	void remove(const Poco::TimingWheelNotificationQueue::Handle& handle);
+	int generation();
+	void dispatch(TaskNotification* pNf);
+	void taskFinished();
+	void waitForRunningTasks();
 	
 private:
 	Timer(const Timer&);
 	Timer& operator = (const Timer&);
 	
-	Poco::TimedNotificationQueue _queue;
+	Poco::TimingWheelNotificationQueue _queue;
 	Poco::Thread _thread;
+	Poco::ActiveExecutor* _pExecutor;
+	int _running;
+	Poco::FastMutex _runningMutex;
+	Poco::Condition _runningDone;
+	int _generation;
+	Poco::FastMutex _generationMutex;
+
+	friend class TimerTask;
+	friend class TaskNotification;
+	friend class TaskRunner;
+	friend class StopNotification;
+	friend class CancelNotification;
 };
 
 
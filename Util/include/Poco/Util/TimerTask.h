@@ -25,12 +25,17 @@
 #include "Poco/RefCountedObject.h"
 #include "Poco/AutoPtr.h"
 #include "Poco/Timestamp.h"
+#include "Poco/Mutex.h"
+#include "Poco/TimingWheelNotificationQueue.h"
 
 
 namespace Poco {
 namespace Util {
 
 
+class Timer;
+
+
 class Util_API TimerTask: public Poco::RefCountedObject, public Poco::Runnable
 	/// A task that can be scheduled for one-time or 
 	/// repeated execution by a Timer.
@@ -52,6 +57,9 @@ public:
 		/// run again. If the task is running when this call occurs, the task 
 		/// will run to completion, but will never run again.
 		///
+		/// A pending task is removed from its Timer's queue
+		/// immediately.
+		///
 		/// Warning: A TimerTask that has been cancelled must not be scheduled again.
 		/// An attempt to do so results in a Poco::Util::IllegalStateException being thrown.
 	
@@ -74,7 +82,11 @@ private:
 	
 	Poco::Timestamp _lastExecution;
 	bool _isCancelled;
+	Poco::Mutex _mutex;
+	Timer* _pTimer;
+	Poco::TimingWheelNotificationQueue::Handle _handle;
 	
+	friend class Timer;
 	friend class TaskNotification;
 };
 
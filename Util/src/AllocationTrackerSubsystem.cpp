@@ -0,0 +1,94 @@
+//
+// AllocationTrackerSubsystem.cpp
+//
+// $Id$
+//
+// Library: Util
+// Package: Application
+// Module:  AllocationTrackerSubsystem
+//
+// Copyright (c) 2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Util/AllocationTrackerSubsystem.h"
+#include "Poco/Util/Application.h"
+#include "Poco/Util/TimerTaskAdapter.h"
+#include "Poco/AllocationTracker.h"
+#include "Poco/StringTokenizer.h"
+#include <sstream>
+
+
+using Poco::AllocationTracker;
+using Poco::Logger;
+
+
+namespace Poco {
+namespace Util {
+
+
+AllocationTrackerSubsystem::AllocationTrackerSubsystem():
+	_pLogger(0)
+{
+}
+
+
+AllocationTrackerSubsystem::~AllocationTrackerSubsystem()
+{
+}
+
+
+const char* AllocationTrackerSubsystem::name() const
+{
+	return "Allocation Tracker Subsystem";
+}
+
+
+void AllocationTrackerSubsystem::initialize(Application& app)
+{
+	_pLogger = &Logger::get(app.config().getString("application.allocationTracker.logger", "AllocationTracker"));
+	if (!AllocationTracker::enabled()) return;
+
+	int interval = app.config().getInt("application.allocationTracker.interval", 0);
+	if (interval > 0)
+	{
+		long ms = 1000L*interval;
+		_pTimer.reset(new Timer);
+		_pTimer->schedule(new TimerTaskAdapter<AllocationTrackerSubsystem>(*this, &AllocationTrackerSubsystem::onTimer), ms, ms);
+	}
+}
+
+
+void AllocationTrackerSubsystem::uninitialize()
+{
+	if (_pTimer.get())
+	{
+		_pTimer->cancel(true);
+		_pTimer.reset();
+	}
+	if (AllocationTracker::enabled()) report();
+}
+
+
+void AllocationTrackerSubsystem::onTimer(TimerTask& /*task*/)
+{
+	report();
+}
+
+
+void AllocationTrackerSubsystem::report()
+{
+	std::ostringstream ostr;
+	AllocationTracker::report(ostr);
+	StringTokenizer lines(ostr.str(), "\n", StringTokenizer::TOK_IGNORE_EMPTY);
+	for (StringTokenizer::Iterator it = lines.begin(); it != lines.end(); ++it)
+	{
+		_pLogger->information(*it);
+	}
+}
+
+
+} } // namespace Poco::Util
@@ -18,6 +18,8 @@
 #include "Poco/Notification.h"
 #include "Poco/ErrorHandler.h"
 #include "Poco/Event.h"
+#include "Poco/ActiveExecutor.h"
+#include "Poco/Exception.h"
 
 
 using Poco::ErrorHandler;
@@ -30,8 +32,8 @@ namespace Util {
 class TimerNotification: public Poco::Notification
 {
 public:
-	TimerNotification(Poco::TimedNotificationQueue& queue):
-		_queue(queue)
+	TimerNotification(Timer& timer):
+		_timer(timer)
 	{
 	}
 	
@@ -41,21 +43,21 @@ public:
 	
 	virtual bool execute() = 0;
 	
-	Poco::TimedNotificationQueue& queue()
+	Timer& timer()
 	{
-		return _queue;
+		return _timer;
 	}
 	
 private:
-	Poco::TimedNotificationQueue& _queue;
+	Timer& _timer;
 };
 
 
 class StopNotification: public TimerNotification
 {
 public:
-	StopNotification(Poco::TimedNotificationQueue& queue):
-		TimerNotification(queue)
+	StopNotification(Timer& timer):
+		TimerNotification(timer)
 	{
 	}
 	
@@ -65,7 +67,7 @@ public:
 	
 	bool execute()
 	{
-		queue().clear();
+		timer()._queue.clear();
 		return false;
 	}
 };
@@ -74,8 +76,8 @@ public:
 class CancelNotification: public TimerNotification
 {
 public:
-	CancelNotification(Poco::TimedNotificationQueue& queue):
-		TimerNotification(queue)
+	CancelNotification(Timer& timer):
+		TimerNotification(timer)
 	{
 	}
 	
@@ -85,7 +87,7 @@ public:
 	
 	bool execute()
 	{
-		queue().clear();
+		timer()._queue.clear();
 		_finished.set();
 		return true;
 	}
@@ -103,22 +105,55 @@ private:
 class TaskNotification: public TimerNotification
 {
 public:
-	TaskNotification(Poco::TimedNotificationQueue& queue, TimerTask::Ptr pTask):
-		TimerNotification(queue),
-		_pTask(pTask)
+	TaskNotification(Timer& timer, TimerTask::Ptr pTask):
+		TimerNotification(timer),
+		_pTask(pTask),
+		_generation(timer.generation())
 	{
 	}
 	
 	~TaskNotification()
 	{
+		// Unless the task has been scheduled again in the
+		// meantime, it is no longer pending in the timer.
+		try
+		{
+			Poco::Mutex::ScopedLock lock(_pTask->_mutex);
+			if (_pTask->_pTimer == &timer() && _pTask->_handle == _handle)
+			{
+				_pTask->_pTimer = 0;
+			}
+		}
+		catch (...)
+		{
+			poco_unexpected();
+		}
 	}
 	
 	TimerTask::Ptr task()
 	{
 		return _pTask;	
 	}
+
+	void setHandle(const Poco::TimingWheelNotificationQueue::Handle& handle)
+	{
+		_handle = handle;
+	}
+
+	int generation() const
+		/// Returns the number of calls to Timer::cancel()
+		/// before the task has been scheduled.
+	{
+		return _generation;
+	}
 	
 	bool execute()
+	{
+		timer().dispatch(this);
+		return true;
+	}
+
+	virtual void runTask()
 	{
 		if (!_pTask->isCancelled())
 		{
@@ -140,19 +175,26 @@ public:
 				ErrorHandler::handle();
 			}
 		}
-		return true;
+	}
+
+protected:
+	void reschedule(Poco::Clock clock)
+	{
+		timer().enqueue(this, clock);
 	}
 			
 private:
 	TimerTask::Ptr _pTask;
+	Poco::TimingWheelNotificationQueue::Handle _handle;
+	int _generation;
 };
 
 
 class PeriodicTaskNotification: public TaskNotification
 {
 public:
-	PeriodicTaskNotification(Poco::TimedNotificationQueue& queue, TimerTask::Ptr pTask, long interval):
-		TaskNotification(queue, pTask),
+	PeriodicTaskNotification(Timer& timer, TimerTask::Ptr pTask, long interval):
+		TaskNotification(timer, pTask),
 		_interval(interval)
 	{
 	}
@@ -161,9 +203,9 @@ public:
 	{
 	}
 	
-	bool execute()
+	void runTask()
 	{	
-		TaskNotification::execute();
+		TaskNotification::runTask();
 
 		if (!task()->isCancelled())
 		{
@@ -171,10 +213,8 @@ public:
 			Poco::Clock nextExecution;
 			nextExecution += static_cast<Poco::Clock::ClockDiff>(_interval)*1000;
 			if (nextExecution < now) nextExecution = now;
-			queue().enqueueNotification(this, nextExecution);
-			duplicate();
+			reschedule(nextExecution);
 		}
-		return true;		
 	}
 	
 private:
@@ -185,8 +225,8 @@ private:
 class FixedRateTaskNotification: public TaskNotification
 {
 public:
-	FixedRateTaskNotification(Poco::TimedNotificationQueue& queue, TimerTask::Ptr pTask, long interval, Poco::Clock clock):
-		TaskNotification(queue, pTask),
+	FixedRateTaskNotification(Timer& timer, TimerTask::Ptr pTask, long interval, Poco::Clock clock):
+		TaskNotification(timer, pTask),
 		_interval(interval),
 		_nextExecution(clock)
 	{
@@ -196,19 +236,17 @@ public:
 	{
 	}
 	
-	bool execute()
+	void runTask()
 	{	
-		TaskNotification::execute();
+		TaskNotification::runTask();
 
 		if (!task()->isCancelled())
 		{
 			Poco::Clock now;
 			_nextExecution += static_cast<Poco::Clock::ClockDiff>(_interval)*1000;
 			if (_nextExecution < now) _nextExecution = now;
-			queue().enqueueNotification(this, _nextExecution);
-			duplicate();
+			reschedule(_nextExecution);
 		}
-		return true;			
 	}
 	
 private:
@@ -217,16 +255,69 @@ private:
 };
 
 
-Timer::Timer()
+class TaskRunner: public Poco::Runnable
+	/// Executes a task in a pool thread.
 {
-	_thread.start(*this);
+public:
+	TaskRunner(TaskNotification* pNf):
+		_pNf(pNf, true)
+	{
+	}
+
+	void run()
+	{
+		Timer& timer = _pNf->timer();
+		_pNf->runTask();
+		delete this;
+		timer.taskFinished();
+	}
+
+private:
+	Poco::AutoPtr<TaskNotification> _pNf;
+};
+
+
+namespace
+{
+	Poco::Clock toClock(const Poco::Timestamp& time)
+	{
+		Poco::Timestamp tsNow;
+		Poco::Clock clock;
+		Poco::Timestamp::TimeDiff diff = time - tsNow;
+		clock += diff;
+		return clock;
+	}
 }
 
 
-Timer::Timer(Poco::Thread::Priority priority)
+Timer::Timer():
+	_queue(1000),
+	_pExecutor(0),
+	_running(0),
+	_generation(0)
+{
+	start();
+}
+
+
+Timer::Timer(Poco::Thread::Priority priority, long resolution):
+	_queue(static_cast<Poco::Clock::ClockDiff>(resolution)*1000),
+	_pExecutor(0),
+	_running(0),
+	_generation(0)
 {
 	_thread.setPriority(priority);
-	_thread.start(*this);
+	start();
+}
+
+
+Timer::Timer(Poco::ActiveExecutor& executor, long resolution):
+	_queue(static_cast<Poco::Clock::ClockDiff>(resolution)*1000),
+	_pExecutor(&executor),
+	_running(0),
+	_generation(0)
+{
+	start();
 }
 
 
@@ -234,8 +325,12 @@ Timer::~Timer()
 {
 	try
 	{
-		_queue.enqueueNotification(new StopNotification(_queue), Poco::Clock(0));
+		_queue.enqueueNotification(new StopNotification(*this), Poco::Clock(0));
 		_thread.join();
+		waitForRunningTasks();
+		// periodic tasks that were still running may have
+		// rescheduled themselves
+		_queue.clear();
 	}
 	catch (...)
 	{
@@ -246,26 +341,32 @@ Timer::~Timer()
 	
 void Timer::cancel(bool wait)
 {
-	Poco::AutoPtr<CancelNotification> pNf = new CancelNotification(_queue);
+	{
+		// Periodic tasks that are running now
+		// must not reschedule themselves.
+		Poco::FastMutex::ScopedLock lock(_generationMutex);
+		++_generation;
+	}
+	Poco::AutoPtr<CancelNotification> pNf = new CancelNotification(*this);
 	_queue.enqueueNotification(pNf, Poco::Clock(0));
 	if (wait)
 	{
 		pNf->wait();
+		waitForRunningTasks();
 	}
 }
 
 
 void Timer::schedule(TimerTask::Ptr pTask, Poco::Timestamp time)
 {
-	validateTask(pTask);
-	_queue.enqueueNotification(new TaskNotification(_queue, pTask), time);
+	schedule(pTask, toClock(time));
 }
 
 
 void Timer::schedule(TimerTask::Ptr pTask, Poco::Clock clock)
 {
 	validateTask(pTask);
-	_queue.enqueueNotification(new TaskNotification(_queue, pTask), clock);
+	enqueue(Poco::AutoPtr<TaskNotification>(new TaskNotification(*this, pTask)), clock);
 }
 
 	
@@ -279,15 +380,14 @@ void Timer::schedule(TimerTask::Ptr pTask, long delay, long interval)
 
 void Timer::schedule(TimerTask::Ptr pTask, Poco::Timestamp time, long interval)
 {
-	validateTask(pTask);
-	_queue.enqueueNotification(new PeriodicTaskNotification(_queue, pTask, interval), time);
+	schedule(pTask, toClock(time), interval);
 }
 
 
 void Timer::schedule(TimerTask::Ptr pTask, Poco::Clock clock, long interval)
 {
 	validateTask(pTask);
-	_queue.enqueueNotification(new PeriodicTaskNotification(_queue, pTask, interval), clock);
+	enqueue(Poco::AutoPtr<TaskNotification>(new PeriodicTaskNotification(*this, pTask, interval)), clock);
 }
 
 	
@@ -301,19 +401,20 @@ void Timer::scheduleAtFixedRate(TimerTask::Ptr pTask, long delay, long interval)
 
 void Timer::scheduleAtFixedRate(TimerTask::Ptr pTask, Poco::Timestamp time, long interval)
 {
-	validateTask(pTask);
-	Poco::Timestamp tsNow;
-	Poco::Clock clock;
-	Poco::Timestamp::TimeDiff diff = time - tsNow;
-	clock += diff;
-	_queue.enqueueNotification(new FixedRateTaskNotification(_queue, pTask, interval, clock), clock);
+	scheduleAtFixedRate(pTask, toClock(time), interval);
 }
 
 
 void Timer::scheduleAtFixedRate(TimerTask::Ptr pTask, Poco::Clock clock, long interval)
 {
 	validateTask(pTask);
-	_queue.enqueueNotification(new FixedRateTaskNotification(_queue, pTask, interval, clock), clock);
+	enqueue(Poco::AutoPtr<TaskNotification>(new FixedRateTaskNotification(*this, pTask, interval, clock)), clock);
+}
+
+
+int Timer::pending() const
+{
+	return _queue.size();
 }
 
 
@@ -328,6 +429,89 @@ void Timer::run()
 }
 
 
+void Timer::start()
+{
+	_thread.start(*this);
+}
+
+
+void Timer::enqueue(TaskNotification* pNf, Poco::Clock clock)
+{
+	TimerTask::Ptr pTask = pNf->task();
+	Poco::Mutex::ScopedLock lock(pTask->_mutex);
+
+	// The task may have been cancelled while it was running.
+	if (pTask->_isCancelled) return;
+
+	// The timer may have been cancelled while the task was running.
+	// Holding the lock while enqueueing ensures that the task is
+	// either dropped here or purged by the CancelNotification.
+	Poco::FastMutex::ScopedLock generationLock(_generationMutex);
+	if (pNf->generation() != _generation) return;
+
+	pTask->_handle = _queue.enqueueNotification(Poco::Notification::Ptr(pNf, true), clock);
+	pTask->_pTimer = this;
+	pNf->setHandle(pTask->_handle);
+}
+
+
+int Timer::generation()
+{
+	Poco::FastMutex::ScopedLock lock(_generationMutex);
+
+	return _generation;
+}
+
+
+void Timer::remove(const Poco::TimingWheelNotificationQueue::Handle& handle)
+{
+	_queue.cancel(handle);
+}
+
+
+void Timer::dispatch(TaskNotification* pNf)
+{
+	if (_pExecutor)
+	{
+		{
+			Poco::FastMutex::ScopedLock lock(_runningMutex);
+			++_running;
+		}
+		TaskRunner* pRunner = new TaskRunner(pNf);
+		try
+		{
+			_pExecutor->execute(*pRunner);
+			return;
+		}
+		catch (Poco::Exception&)
+		{
+			delete pRunner;
+			taskFinished();
+		}
+	}
+	pNf->runTask();
+}
+
+
+void Timer::taskFinished()
+{
+	Poco::FastMutex::ScopedLock lock(_runningMutex);
+
+	if (--_running == 0) _runningDone.broadcast();
+}
+
+
+void Timer::waitForRunningTasks()
+{
+	Poco::FastMutex::ScopedLock lock(_runningMutex);
+
+	while (_running > 0)
+	{
+		_runningDone.wait(_runningMutex);
+	}
+}
+
+
 void Timer::validateTask(const TimerTask::Ptr& pTask)
 {
 	if (pTask->isCancelled())
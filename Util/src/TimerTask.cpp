@@ -15,6 +15,7 @@
 
 
 #include "Poco/Util/TimerTask.h"
+#include "Poco/Util/Timer.h"
 
 
 namespace Poco {
@@ -23,7 +24,8 @@ namespace Util {
 
 TimerTask::TimerTask():
 	_lastExecution(0),
-	_isCancelled(false)
+	_isCancelled(false),
+	_pTimer(0)
 {
 }
 
@@ -35,7 +37,19 @@ TimerTask::~TimerTask()
 
 void TimerTask::cancel()
 {
+	// Removing the task from the queue may release the
+	// last reference to it other than this one.
+	Ptr pThis(this, true);
+
+	Poco::Mutex::ScopedLock lock(_mutex);
+
 	_isCancelled = true;
+	if (_pTimer)
+	{
+		Timer* pTimer = _pTimer;
+		_pTimer = 0;
+		pTimer->remove(_handle);
+	}
 }
 
 
@@ -15,6 +15,11 @@
 #include "CppUnit/TestSuite.h"
 #include "Poco/Util/Timer.h"
 #include "Poco/Util/TimerTaskAdapter.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/WorkStealingThreadPool.h"
+#include "Poco/ActiveExecutor.h"
+#include "Poco/Stopwatch.h"
+#include <vector>
 
 
 using Poco::Util::Timer;
@@ -22,6 +27,7 @@ using Poco::Util::TimerTask;
 using Poco::Util::TimerTaskAdapter;
 using Poco::Timestamp;
 using Poco::Clock;
+using Poco::Stopwatch;
 
 
 TimerTest::TimerTest(const std::string& name): CppUnit::TestCase(name)
@@ -226,6 +232,101 @@ void TimerTest::testCancel()
 }
 
 
+void TimerTest::testCancelRemovesTask()
+{
+	Timer timer;
+
+	std::vector<TimerTask::Ptr> tasks;
+	for (int i = 0; i < 1000; ++i)
+	{
+		TimerTask::Ptr pTask = new TimerTaskAdapter<TimerTest>(*this, &TimerTest::onTimer);
+		timer.schedule(pTask, 60000 + i, 1000);
+		tasks.push_back(pTask);
+	}
+	assert (timer.pending() == 1000);
+
+	for (std::vector<TimerTask::Ptr>::iterator it = tasks.begin(); it != tasks.end(); ++it)
+	{
+		(*it)->cancel();
+		// the timer no longer references the task
+		assert ((*it)->referenceCount() == 1);
+	}
+	assert (timer.pending() == 0);
+}
+
+
+void TimerTest::testCancelRunningPoolTask()
+{
+	Poco::ThreadPool pool(2, 4);
+	Poco::ThreadPoolExecutor executor(pool);
+	Timer timer(executor);
+
+	TimerTask::Ptr pTask = new TimerTaskAdapter<TimerTest>(*this, &TimerTest::onTimer);
+	timer.schedule(pTask, 0, 10);
+	Poco::Thread::sleep(50);
+
+	// The task is running; it must finish before cancel()
+	// returns, and must not be scheduled again.
+	timer.cancel(true);
+	assert (pTask->lastExecution() != 0);
+	assert (_event.tryWait(0));
+	assert (timer.pending() == 0);
+
+	Timestamp lastExecution = pTask->lastExecution();
+	Poco::Thread::sleep(300);
+	assert (timer.pending() == 0);
+	assert (pTask->lastExecution() == lastExecution);
+}
+
+
+void TimerTest::testThreadPool()
+{
+	Poco::ThreadPool pool(2, 4);
+	Poco::ThreadPoolExecutor executor(pool);
+	Timer timer(executor);
+
+	// A slow task must not delay a task that becomes due
+	// while it is running.
+	TimerTask::Ptr pSlowTask = new TimerTaskAdapter<TimerTest>(*this, &TimerTest::onSlowTimer);
+	TimerTask::Ptr pFastTask = new TimerTaskAdapter<TimerTest>(*this, &TimerTest::onFastTimer);
+
+	Stopwatch sw;
+	sw.start();
+	timer.schedule(pSlowTask, Clock());
+	Clock clock;
+	clock += 100000;
+	timer.schedule(pFastTask, clock);
+
+	_fastEvent.wait();
+	assert (sw.elapsed() < 800000);
+	_event.wait();
+	assert (sw.elapsed() >= 1000000);
+}
+
+
+void TimerTest::testWorkStealingThreadPool()
+{
+	Poco::WorkStealingThreadPool pool(2);
+	Poco::WorkStealingExecutor executor(pool);
+	Timer timer(executor, 10);
+
+	TimerTask::Ptr pSlowTask = new TimerTaskAdapter<TimerTest>(*this, &TimerTest::onSlowTimer);
+	TimerTask::Ptr pFastTask = new TimerTaskAdapter<TimerTest>(*this, &TimerTest::onFastTimer);
+
+	Stopwatch sw;
+	sw.start();
+	timer.schedule(pSlowTask, Clock());
+	timer.schedule(pFastTask, 100, 100);
+
+	_fastEvent.wait();
+	assert (sw.elapsed() < 800000);
+	_fastEvent.wait();
+	assert (sw.elapsed() < 800000);
+	pFastTask->cancel();
+	_event.wait();
+}
+
+
 void TimerTest::setUp()
 {
 }
@@ -243,6 +344,19 @@ void TimerTest::onTimer(TimerTask& task)
 }
 
 
+void TimerTest::onSlowTimer(TimerTask& task)
+{
+	Poco::Thread::sleep(1000);
+	_event.set();
+}
+
+
+void TimerTest::onFastTimer(TimerTask& task)
+{
+	_fastEvent.set();
+}
+
+
 CppUnit::Test* TimerTest::suite()
 {
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("TimerTest");
@@ -254,6 +368,10 @@ CppUnit::Test* TimerTest::suite()
 	CppUnit_addTest(pSuite, TimerTest, testScheduleIntervalClock);
 	CppUnit_addTest(pSuite, TimerTest, testScheduleAtFixedRate);
 	CppUnit_addTest(pSuite, TimerTest, testCancel);
+	CppUnit_addTest(pSuite, TimerTest, testCancelRemovesTask);
+	CppUnit_addTest(pSuite, TimerTest, testCancelRunningPoolTask);
+	CppUnit_addTest(pSuite, TimerTest, testThreadPool);
+	CppUnit_addTest(pSuite, TimerTest, testWorkStealingThreadPool);
 
 	return pSuite;
 }
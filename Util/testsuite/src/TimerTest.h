@@ -35,16 +35,23 @@ public:
 	void testScheduleIntervalTimestamp();
 	void testScheduleIntervalClock();
 	void testCancel();
+	void testCancelRemovesTask();
+	void testCancelRunningPoolTask();
+	void testThreadPool();
+	void testWorkStealingThreadPool();
 
 	void setUp();
 	void tearDown();
 
 	void onTimer(Poco::Util::TimerTask& task);
+	void onSlowTimer(Poco::Util::TimerTask& task);
+	void onFastTimer(Poco::Util::TimerTask& task);
 
 	static CppUnit::Test* suite();
 
 private:
 	Poco::Event _event;
+	Poco::Event _fastEvent;
 };
 
 
@@ -29,6 +29,7 @@
 #include "Poco/SAX/LocatorImpl.h"
 #include "Poco/SAX/SAXException.h"
 #include "Poco/URI.h"
+#include "Poco/AllocationTracker.h"
 #include <cstring>
 
 
@@ -222,6 +223,8 @@ void ParserEngine::setEnablePartialReads(bool flag)
 
 void ParserEngine::parse(InputSource* pInputSource)
 {
+	Poco::AllocationScope scope(Poco::AllocationTracker::COMPONENT_XML);
+
 	init();
 	resetContext();
 	pushContext(_parser, pInputSource);
@@ -239,6 +242,8 @@ void ParserEngine::parse(InputSource* pInputSource)
 
 void ParserEngine::parse(const char* pBuffer, std::size_t size)
 {
+	Poco::AllocationScope scope(Poco::AllocationTracker::COMPONENT_XML);
+
 	init();
 	resetContext();
 	InputSource src;
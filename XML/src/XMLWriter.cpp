@@ -312,13 +312,22 @@ void XMLWriter::characters(const XMLChar ch[], int start, int length)
 	_contentWritten = _contentWritten || length > 0;
 	if (_inCDATA)
 	{
-		while (length-- > 0) writeXML(ch[start++]);
+		_pTextConverter->write((const char*) (ch + start), length*sizeof(XMLChar));
 	}
 	else
 	{
-		while (length-- > 0)
+		const XMLChar* it = ch + start;
+		const XMLChar* end = it + length;
+		while (it != end)
 		{
-			XMLChar c = ch[start++];
+			// Characters that need no escaping are written in runs,
+			// which the text converter can pass on in bulk.
+			const XMLChar* run = it;
+			while (it != end && *it != '"' && *it != '&' && *it != '<' && *it != '>' && !(*it >= 0 && *it < 32)) ++it;
+			if (it != run) _pTextConverter->write((const char*) run, (it - run)*sizeof(XMLChar));
+			if (it == end) break;
+
+			XMLChar c = *it++;
 			switch (c)
 			{
 			case '"':  writeMarkup(MARKUP_QUOTENC); break;